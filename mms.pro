@@ -1,3 +1,3 @@
 TEMPLATE = subdirs
-SUBDIRS = src/sim src/test
+SUBDIRS = src/sim src/test src/bench
 CONFIG += ordered
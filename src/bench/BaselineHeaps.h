@@ -0,0 +1,266 @@
+#pragma once
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+namespace bench {
+
+// The heaps that the mouse algorithms used before they were ported to
+// indexedHeap::IndexedHeap, kept here so that it can be benchmarked against
+// them. Each is the same algorithm as the original, but its items are ordered
+// by a traits object (see IndexedHeap.h, only Item and less() are used) rather
+// than by the distance of a particular kind of cell, so that every heap can
+// run the same search.
+
+// mackAlgo::CellHeap: a binary heap that doubles its storage when it's full,
+// and has no decrease-key, so an item whose key decreases must be pushed
+// again, and is then popped once for each time that it was pushed
+template<class Traits>
+class GrowableHeap {
+
+public:
+
+    typedef typename Traits::Item Item;
+
+    GrowableHeap(const Traits& traits = Traits());
+
+    int size() const;
+    bool empty() const;
+
+    Item pop();
+    void push(Item item);
+    void clear();
+
+private:
+
+    static const int DEFAULT_CAPACITY = 16;
+
+    Traits m_traits;
+    int m_size;
+    int m_capacity;
+    std::unique_ptr<Item[]> m_data;
+
+    void increaseCapacity();
+
+    void swap(int indexOne, int indexTwo);
+    void heapifyUp(int index);
+    void heapifyDown(int index);
+};
+
+// mackAlgoTwo::Heap: a fixed-capacity binary heap whose update() finds the
+// item whose key decreased with a linear scan, since positions aren't tracked
+template<class Traits>
+class LinearUpdateHeap {
+
+public:
+
+    typedef typename Traits::Item Item;
+
+    LinearUpdateHeap(int capacity, const Traits& traits = Traits());
+
+    int size() const;
+    bool empty() const;
+
+    Item pop();
+    void push(Item item);
+    void update(Item item);
+    void clear();
+
+private:
+
+    Traits m_traits;
+    int m_size;
+    std::vector<Item> m_data;
+
+    int getMinChildIndex(int index) const;
+
+    void swap(int indexOne, int indexTwo);
+    void heapifyUp(int index);
+    void heapifyDown(int index);
+};
+
+template<class Traits>
+GrowableHeap<Traits>::GrowableHeap(const Traits& traits) :
+        m_traits(traits),
+        m_size(0),
+        m_capacity(DEFAULT_CAPACITY),
+        m_data(new Item[DEFAULT_CAPACITY]) {
+}
+
+template<class Traits>
+int GrowableHeap<Traits>::size() const {
+    return m_size;
+}
+
+template<class Traits>
+bool GrowableHeap<Traits>::empty() const {
+    return m_size == 0;
+}
+
+template<class Traits>
+typename GrowableHeap<Traits>::Item GrowableHeap<Traits>::pop() {
+    assert(0 < m_size);
+    Item item = m_data[0];
+    m_size -= 1;
+    m_data[0] = m_data[m_size];
+    heapifyDown(0);
+    return item;
+}
+
+template<class Traits>
+void GrowableHeap<Traits>::push(Item item) {
+    if (m_size == m_capacity) {
+        increaseCapacity();
+    }
+    m_data[m_size] = item;
+    m_size += 1;
+    heapifyUp(m_size - 1);
+}
+
+template<class Traits>
+void GrowableHeap<Traits>::clear() {
+    m_size = 0;
+}
+
+template<class Traits>
+void GrowableHeap<Traits>::increaseCapacity() {
+    m_capacity *= 2;
+    std::unique_ptr<Item[]> data(new Item[m_capacity]);
+    for (int i = 0; i < m_size; i += 1) {
+        data[i] = m_data[i];
+    }
+    m_data.swap(data);
+}
+
+template<class Traits>
+void GrowableHeap<Traits>::swap(int indexOne, int indexTwo) {
+    Item temp = m_data[indexOne];
+    m_data[indexOne] = m_data[indexTwo];
+    m_data[indexTwo] = temp;
+}
+
+template<class Traits>
+void GrowableHeap<Traits>::heapifyUp(int index) {
+    while (0 < index && m_traits.less(m_data[index], m_data[(index - 1) / 2])) {
+        swap(index, (index - 1) / 2);
+        index = (index - 1) / 2;
+    }
+}
+
+template<class Traits>
+void GrowableHeap<Traits>::heapifyDown(int index) {
+    while (true) {
+        int left = index * 2 + 1;
+        int right = index * 2 + 2;
+        int min = index;
+        if (left < m_size && m_traits.less(m_data[left], m_data[min])) {
+            min = left;
+        }
+        if (right < m_size && m_traits.less(m_data[right], m_data[min])) {
+            min = right;
+        }
+        if (min == index) {
+            break;
+        }
+        swap(index, min);
+        index = min;
+    }
+}
+
+template<class Traits>
+LinearUpdateHeap<Traits>::LinearUpdateHeap(int capacity, const Traits& traits) :
+        m_traits(traits),
+        m_size(0),
+        m_data(capacity) {
+}
+
+template<class Traits>
+int LinearUpdateHeap<Traits>::size() const {
+    return m_size;
+}
+
+template<class Traits>
+bool LinearUpdateHeap<Traits>::empty() const {
+    return m_size == 0;
+}
+
+template<class Traits>
+typename LinearUpdateHeap<Traits>::Item LinearUpdateHeap<Traits>::pop() {
+    assert(0 < m_size);
+    Item item = m_data[0];
+    m_data[0] = m_data[m_size - 1];
+    m_size -= 1;
+    if (1 < m_size) {
+        heapifyDown(0);
+    }
+    return item;
+}
+
+template<class Traits>
+void LinearUpdateHeap<Traits>::push(Item item) {
+    assert(m_size < static_cast<int>(m_data.size()));
+    m_data[m_size] = item;
+    m_size += 1;
+    if (1 < m_size) {
+        heapifyUp(m_size - 1);
+    }
+}
+
+template<class Traits>
+void LinearUpdateHeap<Traits>::update(Item item) {
+    int index = -1;
+    for (int i = 0; i < m_size; i += 1) {
+        if (m_data[i] == item) {
+            index = i;
+            break;
+        }
+    }
+    assert(index != -1);
+    heapifyUp(index);
+}
+
+template<class Traits>
+void LinearUpdateHeap<Traits>::clear() {
+    m_size = 0;
+}
+
+template<class Traits>
+int LinearUpdateHeap<Traits>::getMinChildIndex(int index) const {
+    int left = index * 2 + 1;
+    int right = index * 2 + 2;
+    if (m_size <= left) {
+        return -1;
+    }
+    if (m_size <= right) {
+        return left;
+    }
+    return m_traits.less(m_data[right], m_data[left]) ? right : left;
+}
+
+template<class Traits>
+void LinearUpdateHeap<Traits>::swap(int indexOne, int indexTwo) {
+    Item temp = m_data[indexOne];
+    m_data[indexOne] = m_data[indexTwo];
+    m_data[indexTwo] = temp;
+}
+
+template<class Traits>
+void LinearUpdateHeap<Traits>::heapifyUp(int index) {
+    while (0 < index && m_traits.less(m_data[index], m_data[(index - 1) / 2])) {
+        swap(index, (index - 1) / 2);
+        index = (index - 1) / 2;
+    }
+}
+
+template<class Traits>
+void LinearUpdateHeap<Traits>::heapifyDown(int index) {
+    int minChildIndex = getMinChildIndex(index);
+    while (minChildIndex != -1 && m_traits.less(m_data[minChildIndex], m_data[index])) {
+        swap(index, minChildIndex);
+        index = minChildIndex;
+        minChildIndex = getMinChildIndex(index);
+    }
+}
+
+} // namespace bench
@@ -0,0 +1,34 @@
+#include "Benchmark.h"
+
+#include <algorithm>
+
+#include "../sim/SimUtilities.h"
+
+namespace bench {
+
+Result Benchmarks::run(const Operation& operation, double minSeconds) {
+
+    // Like Google Benchmark, we grow each batch based on how long the previous
+    // one took, but never by more than a factor of ten at once, so that a
+    // fluke fast batch can't make the next one take forever
+    long long iterations = 1;
+    while (true) {
+        double start = sim::SimUtilities::getHighResTimestamp();
+        for (long long i = 0; i < iterations; i += 1) {
+            operation();
+        }
+        double elapsed = sim::SimUtilities::getHighResTimestamp() - start;
+        if (minSeconds <= elapsed) {
+            return {iterations, elapsed * 1e9 / static_cast<double>(iterations)};
+        }
+        double factor = (0.0 < elapsed ? 1.4 * minSeconds / elapsed : 10.0);
+        iterations = static_cast<long long>(iterations * std::min(10.0, std::max(2.0, factor)));
+    }
+}
+
+void Benchmarks::keep(double value) {
+    static volatile double sink = 0.0;
+    sink = value;
+}
+
+} // namespace bench
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+#include <functional>
+
+namespace bench {
+
+// The parameters that each benchmark is run with. Benchmarks that don't
+// depend on a mouse are run once per maze size, with an empty mouse file.
+struct Parameters {
+    int mazeSize;
+    QString mouseFile;
+};
+
+// The (only) part of a benchmark that's timed
+typedef std::function<void()> Operation;
+
+struct Benchmark {
+
+    // The name of the function being benchmarked, e.g., "Mouse::update"
+    QString name;
+
+    // Whether or not the benchmark is run once per mouse file
+    bool usesMouse;
+
+    // Does all of the (untimed) setup for the parameters, and returns the
+    // operation to be timed, or nullptr if the parameters aren't supported
+    std::function<Operation(const Parameters&)> setup;
+};
+
+struct Result {
+    long long iterations;
+    double nanosecondsPerIteration;
+};
+
+class Benchmarks {
+
+public:
+
+    // The Benchmarks class is not constructible
+    Benchmarks() = delete;
+
+    // All of the benchmarks, in the order in which they're run
+    static QVector<Benchmark> get();
+
+    // Runs the operation in batches, each larger than the last, until a
+    // batch takes at least minSeconds, and returns that batch's timing
+    static Result run(const Operation& operation, double minSeconds);
+
+    // Stores the value somewhere the compiler can't see, so that the
+    // computation of benchmarked return values can't be optimized away
+    static void keep(double value);
+
+};
+
+} // namespace bench
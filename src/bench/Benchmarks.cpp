@@ -0,0 +1,1082 @@
+#include "Benchmark.h"
+
+#include <QDebug>
+#include <QDir>
+
+#include <limits>
+#include <list>
+#include <memory>
+#include <queue>
+#include <random>
+#include <set>
+#include <stack>
+#include <vector>
+
+#include "../maze/algos/tomasz/TomaszMazeGeneratorCore.h"
+#include "../mouse/IMouseAlgorithm.h"
+#include "../mouse/indexedHeap/IndexedHeap.h"
+#include "../mouse/floodFill/FloodFill.h"
+#include "../mouse/mackAlgoTwo/MackAlgoTwo.h"
+#include "../mouse/mackAlgoTwo/Solver.h"
+#include "../mouse/planner/Planner.h"
+#include "../sim/BufferInterface.h"
+#include "../sim/Directory.h"
+#include "../sim/GeometryUtilities.h"
+#include "../sim/Maze.h"
+#include "../sim/MazeGraphic.h"
+#include "../sim/MazeChecker.h"
+#include "../sim/MazeFileType.h"
+#include "../sim/MazeFileUtilities.h"
+#include "../sim/Mouse.h"
+#include "../sim/MouseBatch.h"
+#include "../sim/MouseGeometry.h"
+#include "../sim/MouseInterface.h"
+#include "../sim/MouseParser.h"
+#include "../sim/Param.h"
+#include "../sim/Random.h"
+#include "../sim/TileTextAlignment.h"
+#include "../sim/TransformationMatrix.h"
+#include "../sim/View.h"
+#include "../sim/WallDistanceField.h"
+#include "../sim/units/Milliseconds.h"
+#include "../sim/units/Polar.h"
+#include "BaselineHeaps.h"
+
+namespace bench {
+
+namespace {
+
+using namespace sim;
+
+// A perfect maze (every tile is reachable by exactly one path) carved by a
+// randomized depth-first search, seeded by the size, so that every run of
+// the benchmarks sees the same mazes
+BasicMaze generateMaze(int size) {
+
+    BasicMaze maze;
+    for (int x = 0; x < size; x += 1) {
+        QVector<BasicTile> column;
+        for (int y = 0; y < size; y += 1) {
+            BasicTile tile;
+            for (Direction direction : DIRECTIONS) {
+                tile.insert(direction, true);
+            }
+            column.push_back(tile);
+        }
+        maze.push_back(column);
+    }
+
+    static const QMap<Direction, QPair<int, int>> OFFSETS {
+        {Direction::NORTH, { 0,  1}},
+        {Direction::EAST,  { 1,  0}},
+        {Direction::SOUTH, { 0, -1}},
+        {Direction::WEST,  {-1,  0}},
+    };
+    static const QMap<Direction, Direction> OPPOSITES {
+        {Direction::NORTH, Direction::SOUTH},
+        {Direction::EAST,  Direction::WEST},
+        {Direction::SOUTH, Direction::NORTH},
+        {Direction::WEST,  Direction::EAST},
+    };
+
+    std::mt19937 generator(size);
+    QVector<QVector<bool>> visited(size, QVector<bool>(size, false));
+    QVector<QPair<int, int>> stack {{0, 0}};
+    visited[0][0] = true;
+    while (!stack.isEmpty()) {
+        int x = stack.last().first;
+        int y = stack.last().second;
+        QVector<Direction> unvisited;
+        for (Direction direction : DIRECTIONS) {
+            int nx = x + OFFSETS.value(direction).first;
+            int ny = y + OFFSETS.value(direction).second;
+            if (0 <= nx && nx < size && 0 <= ny && ny < size && !visited.at(nx).at(ny)) {
+                unvisited.push_back(direction);
+            }
+        }
+        if (unvisited.isEmpty()) {
+            stack.pop_back();
+            continue;
+        }
+        Direction direction = unvisited.at(generator() % unvisited.size());
+        int nx = x + OFFSETS.value(direction).first;
+        int ny = y + OFFSETS.value(direction).second;
+        maze[x][y][direction] = false;
+        maze[nx][ny][OPPOSITES.value(direction)] = false;
+        visited[nx][ny] = true;
+        stack.push_back({nx, ny});
+    }
+
+    return maze;
+}
+
+Meters halfWallWidth() {
+    return Meters(P()->wallWidth() / 2.0);
+}
+
+Meters tileLength() {
+    return Meters(P()->wallLength() + P()->wallWidth());
+}
+
+// A mouse, initialized from the mouse file, in the first tile of the maze;
+// the maze is kept alive by the mouse's deleter, so that it outlives the mouse
+std::shared_ptr<Mouse> createMouse(
+        std::shared_ptr<Maze> maze, const Parameters& parameters) {
+    std::shared_ptr<Mouse> mouse(new Mouse(maze.get()), [maze](Mouse* mouse) {
+        delete mouse;
+    });
+    if (!mouse->initialize(parameters.mouseFile, Direction::NORTH)) {
+        qWarning().noquote()
+            << "Unable to initialize the mouse from \"" + parameters.mouseFile + "\".";
+        return nullptr;
+    }
+    return mouse;
+}
+
+std::shared_ptr<Mouse> createMouse(const Parameters& parameters) {
+    return createMouse(std::make_shared<Maze>(generateMaze(parameters.mazeSize)), parameters);
+}
+
+Operation mouseUpdate(const Parameters& parameters) {
+    std::shared_ptr<Mouse> mouse = createMouse(parameters);
+    if (mouse == nullptr) {
+        return nullptr;
+    }
+
+    // Drive forward, but teleport back every so often, so that the mouse
+    // never drives (very far) through the walls of the first tile
+    mouse->setWheelSpeedsForMoveForward(0.5);
+    int updates = 0;
+    return [mouse, updates]() mutable {
+        mouse->update(Milliseconds(1));
+        updates += 1;
+        if (updates % 100 == 0) {
+            mouse->teleport(mouse->getInitialTranslation(), mouse->getInitialRotation());
+        }
+    };
+}
+
+Operation mouseBatchStep(const Parameters& parameters) {
+
+    // Enough mice, all in the same maze, for the time per step to be
+    // dominated by the per-mouse arrays rather than by the fixed overhead
+    static const int MOUSE_COUNT = 64;
+    std::shared_ptr<Maze> maze = std::make_shared<Maze>(generateMaze(parameters.mazeSize));
+    QVector<std::shared_ptr<Mouse>> mice;
+    QVector<Mouse*> pointers;
+    for (int i = 0; i < MOUSE_COUNT; i += 1) {
+        std::shared_ptr<Mouse> mouse = createMouse(maze, parameters);
+        if (mouse == nullptr) {
+            return nullptr;
+        }
+        mouse->setWheelSpeedsForMoveForward(0.5);
+        mice.push_back(mouse);
+        pointers.push_back(mouse.get());
+    }
+    std::shared_ptr<MouseBatch> batch = std::make_shared<MouseBatch>(pointers);
+
+    // Just like the Mouse::update benchmark, but for every mouse at once
+    int steps = 0;
+    return [mice, batch, steps]() mutable {
+        batch->step(Milliseconds(1));
+        steps += 1;
+        if (steps % 100 == 0) {
+            for (const std::shared_ptr<Mouse>& mouse : mice) {
+                mouse->teleport(mouse->getInitialTranslation(), mouse->getInitialRotation());
+            }
+        }
+    };
+}
+
+Operation sensorUpdateReading(const Parameters& parameters) {
+    std::shared_ptr<Maze> maze = std::make_shared<Maze>(generateMaze(parameters.mazeSize));
+    std::shared_ptr<Mouse> mouse = createMouse(maze, parameters);
+    if (mouse == nullptr) {
+        return nullptr;
+    }
+
+    // The sensors are private to the mouse, so we parse a copy of them; since
+    // the mouse is at its initial position, so are the sensors
+    bool success = true;
+    MouseParser parser(Directory::get()->getResMouseDirectory() + parameters.mouseFile, &success);
+    if (!success) {
+        return nullptr;
+    }
+    QVector<Sensor> sensors = parser.getSensors(
+        mouse->getInitialTranslation(), mouse->getInitialRotation(), *maze).values().toVector();
+    if (sensors.isEmpty()) {
+        return nullptr;
+    }
+
+    // Each iteration updates a single sensor
+    int index = 0;
+    return [maze, sensors, index]() mutable {
+        Sensor& sensor = sensors[index];
+        sensor.updateReading(sensor.getInitialPosition(), sensor.getInitialDirection(), *maze);
+        Benchmarks::keep(sensor.read());
+        index = (index + 1) % sensors.size();
+    };
+}
+
+// Rays of about the length of a sensor's range, from the centers of random
+// tiles, in random directions
+QVector<QPair<Cartesian, Cartesian>> generateRays(int mazeSize) {
+    std::mt19937 generator(mazeSize);
+    std::uniform_int_distribution<int> tile(0, mazeSize - 1);
+    std::uniform_real_distribution<double> angle(0.0, 360.0);
+    QVector<QPair<Cartesian, Cartesian>> rays;
+    for (int i = 0; i < 1024; i += 1) {
+        Cartesian start(
+            tileLength() * (tile(generator) + 0.5),
+            tileLength() * (tile(generator) + 0.5));
+        Cartesian end = start + Polar(tileLength() * 1.5, Degrees(angle(generator)));
+        rays.push_back({start, end});
+    }
+    return rays;
+}
+
+Operation castRay(const Parameters& parameters) {
+    std::shared_ptr<Maze> maze = std::make_shared<Maze>(generateMaze(parameters.mazeSize));
+    QVector<QPair<Cartesian, Cartesian>> rays = generateRays(parameters.mazeSize);
+    Meters wallWidth = halfWallWidth();
+    Meters length = tileLength();
+    int index = 0;
+    return [maze, rays, wallWidth, length, index]() mutable {
+        const QPair<Cartesian, Cartesian>& ray = rays.at(index);
+        Cartesian intersection = GeometryUtilities::castRay(
+            ray.first, ray.second, *maze, wallWidth, length);
+        Benchmarks::keep(intersection.getX().getMeters());
+        index = (index + 1) % rays.size();
+    };
+}
+
+// The same rays, with the resolution suggested in parameters.xml
+Operation castRayWithWallDistanceField(const Parameters& parameters) {
+    std::shared_ptr<Maze> maze = std::make_shared<Maze>(generateMaze(parameters.mazeSize));
+    QVector<QPair<Cartesian, Cartesian>> rays = generateRays(parameters.mazeSize);
+    std::shared_ptr<WallDistanceField> field = std::make_shared<WallDistanceField>(
+        *maze, 8, 64, tileLength() * 1.5);
+    int index = 0;
+    return [maze, rays, field, index]() mutable {
+        const QPair<Cartesian, Cartesian>& ray = rays.at(index);
+        Cartesian intersection = field->castRay(ray.first, ray.second, *maze);
+        Benchmarks::keep(intersection.getX().getMeters());
+        index = (index + 1) % rays.size();
+    };
+}
+
+Operation convexHull(const Parameters& parameters) {
+    std::shared_ptr<Mouse> mouse = createMouse(parameters);
+    if (mouse == nullptr) {
+        return nullptr;
+    }
+
+    // The same polygons that the mouse's collision polygon is the hull of
+    Cartesian translation = mouse->getInitialTranslation();
+    Radians rotation = mouse->getInitialRotation();
+    QVector<Polygon> polygons {mouse->getCurrentBodyPolygon(translation, rotation)};
+    polygons += mouse->getCurrentWheelPolygons(translation, rotation);
+    polygons += mouse->getCurrentSensorPolygons(translation, rotation);
+    return [polygons]() {
+        Benchmarks::keep(GeometryUtilities::convexHull(polygons).getVertices().size());
+    };
+}
+
+Operation triangulate(const Parameters& parameters) {
+    std::shared_ptr<Mouse> mouse = createMouse(parameters);
+    if (mouse == nullptr) {
+        return nullptr;
+    }
+
+    // Triangulation is private, and happens lazily, on the first call to
+    // getTriangles() on a newly constructed polygon
+    QVector<Cartesian> vertices = mouse->getCurrentCollisionPolygon(
+        mouse->getInitialTranslation(), mouse->getInitialRotation()).getVertices();
+    return [vertices]() {
+        Benchmarks::keep(Polygon(vertices).getTriangles().size());
+    };
+}
+
+// A single transform of all of the mouse's rigid parts, as done once per frame
+Operation transformMouseGeometry(const Parameters& parameters) {
+    std::shared_ptr<Mouse> mouse = createMouse(parameters);
+    if (mouse == nullptr) {
+        return nullptr;
+    }
+    Cartesian translation = mouse->getInitialTranslation() + Cartesian(Meters(0.01), Meters(0.02));
+    Radians rotation = mouse->getInitialRotation() + Degrees(30);
+    MouseGeometry::Vertices vertices;
+    return [mouse, translation, rotation, vertices]() mutable {
+        mouse->getGeometry().transform(translation, rotation, &vertices);
+        Benchmarks::keep(vertices.xs.at(0));
+    };
+}
+
+// The zoomed map's matrix, rotated, for a mouse that has moved since the last
+// frame, which is when the View has to recompute it
+Operation zoomedMapTransformationMatrix(const Parameters& parameters) {
+    double size = parameters.mazeSize * tileLength().getMeters() + P()->wallWidth();
+    Cartesian initialTranslation(tileLength() * 0.5, tileLength() * 0.5);
+    Cartesian currentTranslation = initialTranslation + Cartesian(Meters(0.01), Meters(0.02));
+    Radians rotation(Degrees(30));
+    return [size, initialTranslation, currentTranslation, rotation]() {
+        Matrix4 matrix = TransformationMatrix::getZoomedMapTransformationMatrix(
+            {size, size}, {500, 10}, {480, 680}, {990, 700}, 4000.0, 1.0, true,
+            initialTranslation, currentTranslation, rotation);
+        Benchmarks::keep(matrix.at(0, 3));
+    };
+}
+
+std::function<Operation(const Parameters&)> loadBytes(MazeFileType type) {
+    return [type](const Parameters& parameters) -> Operation {
+        BasicMaze maze = generateMaze(parameters.mazeSize);
+
+        // Not every format supports every size, and not every format can be
+        // loaded, so we only benchmark the ones that round trip
+        QByteArray bytes;
+        try {
+            bytes = MazeFileUtilities::saveBytes(maze, type);
+            if (MazeFileUtilities::loadBytes(bytes) != maze) {
+                throw std::exception();
+            }
+        }
+        catch (...) {
+            return nullptr;
+        }
+
+        return [bytes]() {
+            Benchmarks::keep(MazeFileUtilities::loadBytes(bytes).size());
+        };
+    };
+}
+
+Operation isValidMaze(const Parameters& parameters) {
+    BasicMaze maze = generateMaze(parameters.mazeSize);
+    return [maze]() {
+        Benchmarks::keep(MazeChecker::isValidMaze(maze).first);
+    };
+}
+
+// The whole maze is a single chunk, with a single slot, so that each tile's
+// triangles are always at the same position
+std::shared_ptr<BufferInterface> createBufferInterface(int mazeSize) {
+
+    // The text index is cached the first time text is updated, so every
+    // buffer interface must use the same max size
+    static const QPair<int, int> TILE_TEXT_MAX_SIZE {2, 4};
+
+    QVector<TriangleGraphic>* graphicCpuBuffer = new QVector<TriangleGraphic>();
+    QVector<TriangleTexture>* textureCpuBuffer = new QVector<TriangleTexture>();
+    std::shared_ptr<BufferInterface> bufferInterface(
+        new BufferInterface({mazeSize, mazeSize}, mazeSize, graphicCpuBuffer, textureCpuBuffer),
+        [graphicCpuBuffer, textureCpuBuffer](BufferInterface* bufferInterface) {
+            delete bufferInterface;
+            delete graphicCpuBuffer;
+            delete textureCpuBuffer;
+        }
+    );
+    bufferInterface->initTileGraphicText(
+        Meters(P()->wallLength()),
+        Meters(P()->wallWidth()),
+        TILE_TEXT_MAX_SIZE,
+        View::getFontImageMap(),
+        P()->tileTextBorderFraction(),
+        STRING_TO_TILE_TEXT_ALIGNMENT.value(P()->tileTextAlignment()));
+    bufferInterface->initTileGraphics(1);
+    bufferInterface->setChunkSlot(0, 0);
+    return bufferInterface;
+}
+
+// Each iteration updates the next tile, so that we're not just measuring a
+// single, cached tile
+std::function<Operation(const Parameters&)> updateTile(
+        std::function<void(BufferInterface*, int, int)> update) {
+    return [update](const Parameters& parameters) -> Operation {
+        std::shared_ptr<BufferInterface> bufferInterface =
+            createBufferInterface(parameters.mazeSize);
+        int size = parameters.mazeSize;
+        int index = 0;
+        return [update, bufferInterface, size, index]() mutable {
+            update(bufferInterface.get(), index / size, index % size);
+            index = (index + 1) % (size * size);
+        };
+    };
+}
+
+Operation setTileDistances(const Parameters& parameters) {
+
+    // The tiles, as they are just before their distances are set
+    BasicMaze basicMaze = generateMaze(parameters.mazeSize);
+    QVector<QVector<Tile>> tiles;
+    for (int x = 0; x < basicMaze.size(); x += 1) {
+        QVector<Tile> column;
+        for (int y = 0; y < basicMaze.at(x).size(); y += 1) {
+            Tile tile;
+            tile.setPos(x, y);
+            tile.setMazeSize(basicMaze.size(), basicMaze.at(x).size());
+            for (Direction direction : DIRECTIONS) {
+                tile.setWall(direction, basicMaze.at(x).at(y).value(direction));
+            }
+            column.push_back(tile);
+        }
+        tiles.push_back(column);
+    }
+
+    // The distances are reset every time, so the same tiles can be reused
+    return [tiles]() mutable {
+        Maze::setTileDistances(&tiles);
+        Benchmarks::keep(tiles.at(0).at(0).getDistance());
+    };
+}
+
+// Each iteration generates a whole maze, so the iterations per second are the
+// mazes per second. The random numbers are seeded by the size, and the
+// generator's buffers are reused, just as they are when generating many mazes.
+Operation generateTomaszMaze(const Parameters& parameters) {
+    std::shared_ptr<tomasz::TomaszMazeGeneratorCore> core =
+        std::make_shared<tomasz::TomaszMazeGeneratorCore>();
+    std::shared_ptr<std::mt19937> generator =
+        std::make_shared<std::mt19937>(parameters.mazeSize);
+    std::function<double()> random = [generator]() {
+        return (*generator)() / 4294967296.0;
+    };
+    int size = parameters.mazeSize;
+    return [core, random, size]() {
+        core->generate(size, size, random);
+        Benchmarks::keep(core->getWalls(0, 0));
+    };
+}
+
+// Each iteration fills a tile's worth of random numbers for every tile of the
+// maze, which is what a randomized maze generator draws
+Operation fillRandom(const Parameters& parameters) {
+    std::shared_ptr<Random> random = std::make_shared<Random>(parameters.mazeSize);
+    std::shared_ptr<std::vector<double>> values =
+        std::make_shared<std::vector<double>>(parameters.mazeSize * parameters.mazeSize);
+    return [random, values]() {
+        random->fill(values->data(), static_cast<int>(values->size()));
+        Benchmarks::keep(values->back());
+    };
+}
+
+// A mouse algorithm that does nothing, and doesn't show declared distances
+class StubAlgorithm : public IMouseAlgorithm {
+
+public:
+    bool setTileTextWhenDistanceDeclared() const {
+        return false;
+    }
+
+    void solve(
+            int mazeWidth, int mazeHeight, bool isOfficialMaze,
+            char initialDirection, MouseInterface* mouse) {
+    }
+
+};
+
+// A MouseInterface for the parts of the mouse algorithms that are benchmarked
+// on their own. It has a maze and a maze graphic, but no mouse, so only the
+// calls that don't move the mouse or read its sensors may be made through it.
+std::shared_ptr<MouseInterface> createStubMouseInterface(
+        std::shared_ptr<Maze> maze, std::shared_ptr<IMouseAlgorithm> algorithm) {
+
+    // The whole maze is one chunk (see createBufferInterface), and so the text
+    // of every tile is limited to the same rows and columns
+    std::shared_ptr<BufferInterface> bufferInterface =
+        createBufferInterface(maze->getWidth());
+    std::shared_ptr<MazeGraphic> mazeGraphic =
+        std::make_shared<MazeGraphic>(maze.get(), bufferInterface.get());
+    std::set<char> allowableTileTextCharacters;
+    for (const QChar& character : View::getFontImageMap().keys()) {
+        allowableTileTextCharacters.insert(character.toLatin1());
+    }
+    StaticMouseAlgorithmOptions options {};
+    options.tileTextNumberOfRows = 2;
+    options.tileTextNumberOfCols = 4;
+
+    return std::shared_ptr<MouseInterface>(
+        new MouseInterface(
+            maze.get(), nullptr, mazeGraphic.get(), algorithm.get(),
+            allowableTileTextCharacters, options, Random(0)),
+        [maze, algorithm, bufferInterface, mazeGraphic](MouseInterface* mouseInterface) {
+            delete mouseInterface;
+        }
+    );
+}
+
+// The walls of each of the mazes in res/maze that FloodFill, which is fixed
+// at 16x16, can solve, indexed by ((x * 16) + y) * 4 + direction
+QVector<std::vector<bool>> loadFloodFillMazes() {
+    QVector<std::vector<bool>> mazes;
+    QDir directory(Directory::get()->getResMazeDirectory());
+    for (const QString& file : directory.entryList(QDir::Files, QDir::Name)) {
+        BasicMaze maze;
+        try {
+            maze = MazeFileUtilities::load(directory.filePath(file));
+        }
+        catch (...) {
+            continue;
+        }
+        if (maze.size() != floodFill::MAZE_SIZE_X ||
+                maze.at(0).size() != floodFill::MAZE_SIZE_Y) {
+            continue;
+        }
+        std::vector<bool> walls;
+        for (int x = 0; x < maze.size(); x += 1) {
+            for (int y = 0; y < maze.at(x).size(); y += 1) {
+                for (Direction direction : DIRECTIONS) {
+                    walls.push_back(maze.at(x).at(y).value(direction));
+                }
+            }
+        }
+        mazes.push_back(walls);
+    }
+    return mazes;
+}
+
+// Each iteration explores every maze of the corpus, flooding after each cell
+// whose walls are revealed (see FloodFill::replayFloods), so the iterations
+// per second are the corpus explorations per second
+std::function<Operation(const Parameters&)> replayFloods(bool recursive) {
+    return [recursive](const Parameters& parameters) -> Operation {
+        if (parameters.mazeSize != floodFill::MAZE_SIZE_X) {
+            return nullptr;
+        }
+        QVector<std::vector<bool>> mazes = loadFloodFillMazes();
+        if (mazes.isEmpty()) {
+            return nullptr;
+        }
+        std::shared_ptr<MouseInterface> mouseInterface = createStubMouseInterface(
+            std::make_shared<Maze>(generateMaze(parameters.mazeSize)),
+            std::make_shared<StubAlgorithm>());
+        std::shared_ptr<floodFill::FloodFill> floodFill = std::make_shared<floodFill::FloodFill>();
+        std::function<void(int)> replay = [mazes, mouseInterface, floodFill, recursive](int index) {
+            const std::vector<bool>& walls = mazes.at(index);
+            floodFill->replayFloods(
+                mouseInterface.get(),
+                [&walls](int x, int y, int direction) {
+                    return walls.at((x * floodFill::MAZE_SIZE_Y + y) * 4 + direction);
+                },
+                recursive);
+        };
+
+        // The work done by the floods doesn't depend on the timing, so it's
+        // counted once, up front, rather than in the timed operation
+        long floods = 0;
+        long visited = 0;
+        long relaxed = 0;
+        for (int i = 0; i < mazes.size(); i += 1) {
+            replay(i);
+            floods += floodFill->getFloodCount();
+            visited += floodFill->getTotalCellsVisited();
+            relaxed += floodFill->getTotalCellsRelaxed();
+        }
+        qInfo().noquote()
+            << (recursive ? "floodRecursive:" : "floodIterative:")
+            << mazes.size() << "mazes," << floods << "floods (one per cell revealed),"
+            << visited << "cells visited," << relaxed << "cells relaxed,"
+            << static_cast<double>(relaxed) / floods << "cells relaxed per flood.";
+
+        int count = mazes.size();
+        return [replay, floodFill, count]() {
+            for (int i = 0; i < count; i += 1) {
+                replay(i);
+            }
+            Benchmarks::keep(floodFill->getTotalCellsRelaxed());
+        };
+    };
+}
+
+// The cells that one step of a depth-first exploration of an open maze (one
+// with no walls but its perimeter) modifies: the target, which is explored,
+// followed by each neighbor that the step discovers. Returns the number of
+// cells, and, like FloodFill, makes each discovered neighbor point back to
+// the target, but leaves the pushing of them to the caller.
+int exploreOpenMazeCell(
+        int size, std::vector<floodFill::Cell>* cells, floodFill::Cell* target,
+        floodFill::Cell* modified[5]) {
+    static const int STEP_X[4] = {0, 1, 0, -1};
+    static const int STEP_Y[4] = {1, 0, -1, 0};
+    modified[0] = target;
+    int count = 1;
+    for (int direction = 0; direction < 4; direction += 1) {
+        int x = target->getX() + STEP_X[direction];
+        int y = target->getY() + STEP_Y[direction];
+        if (x < 0 || size <= x || y < 0 || size <= y) {
+            continue;
+        }
+        floodFill::Cell* neighbor = &cells->at(x * size + y);
+        if (neighbor->getPrev() == NULL && neighbor != &cells->at(0)) {
+            modified[count] = neighbor;
+            count += 1;
+        }
+    }
+    return count;
+}
+
+void markExploredOpenMazeCells(floodFill::Cell* modified[5], int count) {
+    modified[0]->setExplored(true);
+    for (int i = 1; i < count; i += 1) {
+        modified[i]->setPrev(modified[0]);
+    }
+}
+
+// Explores an open maze, recording each step with a floodFill::History, just
+// as FloodFill does, and then undoes the remembered steps; returns the number
+// of steps that were taken
+int exploreOpenMazeWithHistory(
+        int size, std::vector<floodFill::Cell>* cells,
+        floodFill::History* history, floodFill::CellStack::Arena* arena) {
+    arena->clear();
+    floodFill::CellStack unexplored(arena);
+    unexplored.push(&cells->at(0));
+    history->initialize(floodFill::SHORT_TERM_MEM, unexplored);
+    int steps = 0;
+    while (!unexplored.empty()) {
+        floodFill::Cell* target = unexplored.top();
+        unexplored.pop();
+        if (target->getExplored()) {
+            continue;
+        }
+        floodFill::Cell* modified[5];
+        int count = exploreOpenMazeCell(size, cells, target, modified);
+        history->moved();
+        history->startModifiedCells();
+        for (int i = 0; i < count; i += 1) {
+            history->appendModifiedCell(modified[i]);
+        }
+        markExploredOpenMazeCells(modified, count);
+        for (int i = 1; i < count; i += 1) {
+            unexplored.push(modified[i]);
+        }
+        history->stackUpdate(unexplored);
+        steps += 1;
+    }
+    history->resetModifiedCells();
+    return steps;
+}
+
+// The same exploration, but recording each step by copying the whole stack
+// and the list of modified cells, which is how History used to record steps
+int exploreOpenMazeWithCopies(int size, std::vector<floodFill::Cell>* cells) {
+    std::stack<floodFill::Cell*> unexplored;
+    unexplored.push(&cells->at(0));
+    std::queue<std::stack<floodFill::Cell*>> stacks;
+    std::list<std::list<floodFill::Cellmod>> modifiedCells;
+    int steps = 0;
+    while (!unexplored.empty()) {
+        floodFill::Cell* target = unexplored.top();
+        unexplored.pop();
+        if (target->getExplored()) {
+            continue;
+        }
+        floodFill::Cell* modified[5];
+        int count = exploreOpenMazeCell(size, cells, target, modified);
+        std::list<floodFill::Cellmod> cellList;
+        for (int i = 0; i < count; i += 1) {
+            floodFill::Cellmod cm;
+            cm.cell = modified[i];
+            cm.oldDist = modified[i]->getDistance();
+            cm.oldPrev = modified[i]->getPrev();
+            cm.oldExplored = modified[i]->getExplored();
+            cm.oldTraversed = modified[i]->getTraversed();
+            for (int j = 0; j < 4; j += 1) {
+                cm.oldWalls[j] = modified[i]->isWall(j);
+                cm.oldWallsInspected[j] = modified[i]->getWallInspected(j);
+            }
+            cellList.push_back(cm);
+        }
+        modifiedCells.push_front(cellList);
+        if (modifiedCells.size() > floodFill::SHORT_TERM_MEM) {
+            modifiedCells.pop_back();
+        }
+        markExploredOpenMazeCells(modified, count);
+        for (int i = 1; i < count; i += 1) {
+            unexplored.push(modified[i]);
+        }
+        stacks.push(unexplored);
+        if (stacks.size() > floodFill::SHORT_TERM_MEM) {
+            stacks.pop();
+        }
+        steps += 1;
+    }
+    for (const std::list<floodFill::Cellmod>& cellList : modifiedCells) {
+        for (const floodFill::Cellmod& cm : cellList) {
+            cm.cell->setPrev(cm.oldPrev);
+            cm.cell->setDistance(cm.oldDist);
+            cm.cell->setExplored(cm.oldExplored);
+            cm.cell->setTraversed(cm.oldTraversed);
+            for (int j = 0; j < 4; j += 1) {
+                cm.cell->setWall(j, cm.oldWalls[j]);
+                cm.cell->setWallInspected(j, cm.oldWallsInspected[j]);
+            }
+        }
+    }
+    return steps;
+}
+
+// Each iteration explores an open maze, in which FloodFill's unexplored stack
+// gets about as deep as it can, and then undoes the most recent steps, as
+// FloodFill does after an error. Like FloodFill's own cells, the cells declare
+// their distances through a MouseInterface, here a stub one.
+std::function<Operation(const Parameters&)> exploreOpenMaze(bool withHistory) {
+    return [withHistory](const Parameters& parameters) -> Operation {
+        int size = parameters.mazeSize;
+        std::shared_ptr<MouseInterface> mouseInterface = createStubMouseInterface(
+            std::make_shared<Maze>(generateMaze(size)),
+            std::make_shared<StubAlgorithm>());
+        std::shared_ptr<std::vector<floodFill::Cell>> cells =
+            std::make_shared<std::vector<floodFill::Cell>>(size * size);
+        for (int x = 0; x < size; x += 1) {
+            for (int y = 0; y < size; y += 1) {
+                floodFill::Cell& cell = cells->at(x * size + y);
+                cell.setX(x);
+                cell.setY(y);
+                cell.setMouseInterface(mouseInterface.get());
+            }
+        }
+        std::shared_ptr<floodFill::History> history = std::make_shared<floodFill::History>();
+        std::shared_ptr<floodFill::CellStack::Arena> arena =
+            std::make_shared<floodFill::CellStack::Arena>();
+        return [size, mouseInterface, cells, history, arena, withHistory]() {
+            for (floodFill::Cell& cell : *cells) {
+                cell.setPrev(NULL);
+                cell.setExplored(false);
+            }
+            Benchmarks::keep(withHistory ?
+                exploreOpenMazeWithHistory(size, cells.get(), history.get(), arena.get()) :
+                exploreOpenMazeWithCopies(size, cells.get()));
+        };
+    };
+}
+
+// Each iteration plans the fastest path from the origin to the center of a
+// maze whose walls are all known, with the Solver instantiated for the size
+template<class M>
+Operation planMackAlgoTwoPath(const Parameters& parameters) {
+    std::shared_ptr<Maze> maze = std::make_shared<Maze>(generateMaze(parameters.mazeSize));
+    std::shared_ptr<MouseInterface> mouseInterface = createStubMouseInterface(
+        maze, std::make_shared<mackAlgoTwo::MackAlgoTwo>());
+    std::shared_ptr<mackAlgoTwo::Solver<M>> solver = std::make_shared<mackAlgoTwo::Solver<M>>();
+    solver->discoverMaze(
+        mouseInterface.get(),
+        [maze](mackAlgoTwo::byte x, mackAlgoTwo::byte y, mackAlgoTwo::byte direction) {
+            return maze->getTile(x, y)->isWall(DIRECTIONS.at(direction));
+        });
+    if (!solver->planFromOrigin()) {
+        return nullptr;
+    }
+    return [mouseInterface, solver]() {
+        Benchmarks::keep(solver->planFromOrigin());
+    };
+}
+
+Operation planMackAlgoTwo(const Parameters& parameters) {
+    switch (parameters.mazeSize) {
+        case mackAlgoTwo::Maze16::WIDTH:
+            return planMackAlgoTwoPath<mackAlgoTwo::Maze16>(parameters);
+        case mackAlgoTwo::Maze32::WIDTH:
+            return planMackAlgoTwoPath<mackAlgoTwo::Maze32>(parameters);
+        case mackAlgoTwo::Maze64::WIDTH:
+            return planMackAlgoTwoPath<mackAlgoTwo::Maze64>(parameters);
+        default:
+            return nullptr;
+    }
+}
+
+// A generated maze with about a tenth of the remaining walls knocked down, so
+// that it has loops, and thus plenty of straightaways, turns, and diagonals
+// for a speed run to choose between
+BasicMaze generateMazeWithLoops(int size) {
+    BasicMaze maze = generateMaze(size);
+    std::mt19937 generator(size);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (int x = 0; x < size - 1; x += 1) {
+        for (int y = 0; y < size - 1; y += 1) {
+            if (uniform(generator) < 0.1) {
+                maze[x][y][Direction::EAST] = false;
+                maze[x + 1][y][Direction::WEST] = false;
+            }
+            if (uniform(generator) < 0.1) {
+                maze[x][y][Direction::NORTH] = false;
+                maze[x][y + 1][Direction::SOUTH] = false;
+            }
+        }
+    }
+    return maze;
+}
+
+// Each iteration plans the fastest run from the origin to the center of a
+// maze whose walls are all known, starting from the edge of the origin, right
+// after originMoveForwardToEdge()
+Operation planSpeedRun(const Parameters& parameters) {
+    int size = parameters.mazeSize;
+    BasicMaze maze = generateMazeWithLoops(size);
+    std::shared_ptr<planner::Planner> planner =
+        std::make_shared<planner::Planner>(size, size, planner::MotionModel());
+    for (int x = 0; x < size; x += 1) {
+        for (int y = 0; y < size; y += 1) {
+            for (int direction = 0; direction < DIRECTIONS.size(); direction += 1) {
+                planner->setWall(x, y, direction, maze.at(x).at(y).value(DIRECTIONS.at(direction)));
+            }
+        }
+    }
+    for (int x = size / 2 - 1; x <= size / 2; x += 1) {
+        for (int y = size / 2 - 1; y <= size / 2; y += 1) {
+            planner->addGoal(x, y);
+        }
+    }
+    std::vector<planner::Move> moves = planner->plan(0, 1, 0);
+    if (moves.empty()) {
+        return nullptr;
+    }
+    qInfo().noquote()
+        << QString("planner: %1x%1 maze, %2 moves, %3 s estimated run time.")
+        .arg(size)
+        .arg(moves.size())
+        .arg(planner->getRunTime(), 0, 'f', 3);
+    return [planner]() {
+        Benchmarks::keep(planner->plan(0, 1, 0).size());
+    };
+}
+
+// The traits (see IndexedHeap.h) of every heap in the heap benchmarks, which
+// order the states of searchStates() by their distances
+struct StateHeapTraits {
+    typedef int Item;
+    typedef int Index;
+    const std::vector<double>* distances;
+    int* positions;
+    bool less(int one, int two) const {
+        return (*distances)[one] < (*distances)[two];
+    }
+    int getPosition(int state) const {
+        return positions[state];
+    }
+    void setPosition(int state, int position) {
+        positions[state] = position;
+    }
+};
+
+// The queues of searchStates(), one for each kind of heap, which add a state
+// (or re-add a state whose distance decreased) in whatever way the heap can
+template<int ARITY>
+class IndexedHeapQueue {
+
+public:
+    IndexedHeapQueue(int states, const std::vector<double>* distances) :
+            m_items(states),
+            m_positions(states),
+            m_heap(m_items.data(), states, {distances, m_positions.data()}) {
+    }
+    void clear() {
+        m_heap.clear();
+    }
+    bool empty() const {
+        return m_heap.empty();
+    }
+    int pop() {
+        return m_heap.pop();
+    }
+    void add(int state, bool isNew) {
+        if (isNew) {
+            m_heap.push(state);
+        }
+        else {
+            m_heap.decrease(state);
+        }
+    }
+
+private:
+    std::vector<int> m_items;
+    std::vector<int> m_positions;
+    indexedHeap::IndexedHeap<StateHeapTraits, ARITY> m_heap;
+
+};
+
+class GrowableHeapQueue {
+
+public:
+    GrowableHeapQueue(int /* states */, const std::vector<double>* distances) :
+            m_heap({distances, nullptr}) {
+    }
+    void clear() {
+        m_heap.clear();
+    }
+    bool empty() const {
+        return m_heap.empty();
+    }
+    int pop() {
+        return m_heap.pop();
+    }
+    void add(int state, bool /* isNew */) {
+        m_heap.push(state);
+    }
+
+private:
+    GrowableHeap<StateHeapTraits> m_heap;
+
+};
+
+class LinearUpdateHeapQueue {
+
+public:
+    LinearUpdateHeapQueue(int states, const std::vector<double>* distances) :
+            m_heap(states, {distances, nullptr}) {
+    }
+    void clear() {
+        m_heap.clear();
+    }
+    bool empty() const {
+        return m_heap.empty();
+    }
+    int pop() {
+        return m_heap.pop();
+    }
+    void add(int state, bool isNew) {
+        if (isNew) {
+            m_heap.push(state);
+        }
+        else {
+            m_heap.update(state);
+        }
+    }
+
+private:
+    LinearUpdateHeap<StateHeapTraits> m_heap;
+
+};
+
+// Dijkstra's algo over states of the form (cell, heading), from the origin,
+// facing north, where moving forward costs one and turning in place costs
+// two, so that straighter paths are preferred, as in the planners. A state is
+// a cell (x * size + y) times four plus the index of its heading in
+// DIRECTIONS, and a wall is set for each state that faces it. Popped states
+// are always expanded, since a heap without decrease-key can pop a state more
+// than once, so the distances are correct with any of the queues.
+template<class Queue>
+void searchStates(
+        int size, const std::vector<bool>& walls,
+        std::vector<double>* distances, Queue* queue) {
+
+    static const int DX[] = {0, 1, 0, -1};
+    static const int DY[] = {1, 0, -1, 0};
+    static const double INFINITE_DISTANCE = std::numeric_limits<double>::infinity();
+
+    distances->assign(walls.size(), INFINITE_DISTANCE);
+    (*distances)[0] = 0.0;
+    queue->clear();
+    queue->add(0, true);
+    while (!queue->empty()) {
+        int state = queue->pop();
+        int cell = state / 4;
+        int direction = state % 4;
+        int next[3] = {-1, cell * 4 + (direction + 1) % 4, cell * 4 + (direction + 3) % 4};
+        double cost[3] = {1.0, 2.0, 2.0};
+        if (!walls.at(state)) {
+            int x = cell / size + DX[direction];
+            int y = cell % size + DY[direction];
+            next[0] = (x * size + y) * 4 + direction;
+        }
+        for (int i = 0; i < 3; i += 1) {
+            if (next[i] == -1 || (*distances)[next[i]] <= (*distances)[state] + cost[i]) {
+                continue;
+            }
+            bool isNew = (*distances)[next[i]] == INFINITE_DISTANCE;
+            (*distances)[next[i]] = (*distances)[state] + cost[i];
+            queue->add(next[i], isNew);
+        }
+    }
+}
+
+// Each iteration is a whole search with the given kind of queue, on a maze
+// with loops, so that plenty of distances are decreased. The distances are
+// checked against those of the 4-ary indexed heap, which the planners use.
+template<class Queue>
+Operation searchWithHeap(const Parameters& parameters) {
+    int size = parameters.mazeSize;
+    BasicMaze maze = generateMazeWithLoops(size);
+    std::vector<bool> walls;
+    for (int x = 0; x < size; x += 1) {
+        for (int y = 0; y < size; y += 1) {
+            for (Direction direction : DIRECTIONS) {
+                walls.push_back(maze.at(x).at(y).value(direction));
+            }
+        }
+    }
+
+    std::vector<double> expected;
+    IndexedHeapQueue<4> reference(walls.size(), &expected);
+    searchStates(size, walls, &expected, &reference);
+    std::shared_ptr<std::vector<double>> distances = std::make_shared<std::vector<double>>();
+    std::shared_ptr<Queue> queue = std::make_shared<Queue>(walls.size(), distances.get());
+    searchStates(size, walls, distances.get(), queue.get());
+    if (*distances != expected) {
+        qWarning().noquote() << "The heap's search found different distances.";
+        return nullptr;
+    }
+
+    return [size, walls, distances, queue]() {
+        searchStates(size, walls, distances.get(), queue.get());
+        Benchmarks::keep(distances->back());
+    };
+}
+
+} // namespace
+
+QVector<Benchmark> Benchmarks::get() {
+    QVector<Benchmark> benchmarks {
+        {"Mouse::update", true, mouseUpdate},
+        {"MouseBatch::step", true, mouseBatchStep},
+        {"Sensor::updateReading", true, sensorUpdateReading},
+        {"GeometryUtilities::castRay", false, castRay},
+        {"WallDistanceField::castRay", false, castRayWithWallDistanceField},
+        {"GeometryUtilities::convexHull", true, convexHull},
+        {"Polygon::triangulate", true, triangulate},
+        {"MouseGeometry::transform", true, transformMouseGeometry},
+        {"TransformationMatrix::getZoomedMapTransformationMatrix", false,
+            zoomedMapTransformationMatrix},
+    };
+    for (MazeFileType type : MAZE_FILE_TYPE_TO_STRING.keys()) {
+        benchmarks.push_back({
+            "MazeFileUtilities::loadBytes/" + MAZE_FILE_TYPE_TO_STRING.value(type),
+            false,
+            loadBytes(type)
+        });
+    }
+    benchmarks += QVector<Benchmark> {
+        {"MazeChecker::isValidMaze", false, isValidMaze},
+        {"BufferInterface::updateTileGraphicBaseColor", false, updateTile(
+            [](BufferInterface* bufferInterface, int x, int y) {
+                bufferInterface->updateTileGraphicBaseColor(x, y, Color::DARK_GRAY);
+            })},
+        {"BufferInterface::updateTileGraphicWallColor", false, updateTile(
+            [](BufferInterface* bufferInterface, int x, int y) {
+                bufferInterface->updateTileGraphicWallColor(x, y, Direction::NORTH, Color::RED, 1.0);
+            })},
+        {"BufferInterface::updateTileGraphicFog", false, updateTile(
+            [](BufferInterface* bufferInterface, int x, int y) {
+                bufferInterface->updateTileGraphicFog(x, y, 0.15);
+            })},
+        {"BufferInterface::updateTileGraphicText", false, updateTile(
+            [](BufferInterface* bufferInterface, int x, int y) {
+                bufferInterface->updateTileGraphicText(x, y, 2, 4, 1, 2, QChar('0' + (x + y) % 10));
+            })},
+        {"Maze::setTileDistances", false, setTileDistances},
+        {"TomaszMazeGeneratorCore::generate", false, generateTomaszMaze},
+        {"Random::fill", false, fillRandom},
+        {"FloodFill::floodRecursive", false, replayFloods(true)},
+        {"FloodFill::floodIterative", false, replayFloods(false)},
+        {"floodFill::History", false, exploreOpenMaze(true)},
+        {"floodFill::History/copying", false, exploreOpenMaze(false)},
+        {"mackAlgoTwo::Solver::generatePath", false, planMackAlgoTwo},
+        {"planner::Planner::plan", false, planSpeedRun},
+        {"searchStates/IndexedHeap<2>", false, searchWithHeap<IndexedHeapQueue<2>>},
+        {"searchStates/IndexedHeap<4>", false, searchWithHeap<IndexedHeapQueue<4>>},
+        {"searchStates/GrowableHeap", false, searchWithHeap<GrowableHeapQueue>},
+        {"searchStates/LinearUpdateHeap", false, searchWithHeap<LinearUpdateHeapQueue>},
+    };
+    return benchmarks;
+}
+
+} // namespace bench
@@ -0,0 +1,116 @@
+// Micro-benchmarks for the hot paths of the simulator. Each benchmark is run
+// for each maze size (and, if it depends on a mouse, each mouse file), and
+// its timing is printed as a line of JSON, so that the output of two commits
+// can be diffed:
+//
+//     bench [--filter <substring>] [--min-time <seconds>]
+//           [--size <tiles>]... [--mouse <file>]...
+//
+// If no sizes are given, 16, 32, and 64 are used; if no mouse files are
+// given, every mouse file in res/mouse is used. The mazes are generated, not
+// loaded, so that every run sees exactly the same mazes.
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+#include <QVector>
+
+#include <iostream>
+
+#include "../sim/Directory.h"
+#include "Benchmark.h"
+
+namespace {
+
+const double DEFAULT_MIN_SECONDS = 0.5;
+
+const QVector<int> DEFAULT_MAZE_SIZES {16, 32, 64};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+
+    // The project root is found just as the simulator finds it, so that the
+    // parameters and mouse files are read from res
+    QCoreApplication app(argc, argv);
+    QString path = app.applicationFilePath(); // .../mms/bin/bench
+    path = path.left(path.lastIndexOf("/")); // Strips off /bench
+    path = path.left(path.lastIndexOf("/")); // Strips off /bin
+    sim::Directory::init(path + "/");
+
+    QString filter;
+    double minSeconds = DEFAULT_MIN_SECONDS;
+    QVector<int> mazeSizes;
+    QStringList mouseFiles;
+    QStringList arguments = app.arguments();
+    for (int i = 1; i < arguments.size(); i += 1) {
+        QString argument = arguments.at(i);
+        if (i + 1 == arguments.size() || !QStringList({
+                "--filter", "--min-time", "--size", "--mouse"}).contains(argument)) {
+            qCritical().noquote() << "Unexpected argument \"" + argument + "\".";
+            return 1;
+        }
+        i += 1;
+        QString value = arguments.at(i);
+        if (argument == "--filter") {
+            filter = value;
+        }
+        else if (argument == "--min-time") {
+            minSeconds = value.toDouble();
+        }
+        else if (argument == "--size") {
+            mazeSizes.append(value.toInt());
+        }
+        else {
+            mouseFiles.append(value);
+        }
+    }
+    if (minSeconds <= 0.0) {
+        qCritical().noquote() << "The min time must be a positive number of seconds.";
+        return 1;
+    }
+    for (int size : mazeSizes) {
+        if (size <= 0) {
+            qCritical().noquote() << "Maze sizes must be positive integers.";
+            return 1;
+        }
+    }
+    if (mazeSizes.isEmpty()) {
+        mazeSizes = DEFAULT_MAZE_SIZES;
+    }
+    if (mouseFiles.isEmpty()) {
+        mouseFiles = QDir(sim::Directory::get()->getResMouseDirectory()).entryList(
+            {"*.xml"}, QDir::Files, QDir::Name);
+    }
+
+    for (const bench::Benchmark& benchmark : bench::Benchmarks::get()) {
+        if (!benchmark.name.contains(filter)) {
+            continue;
+        }
+        for (int size : mazeSizes) {
+            for (const QString& mouseFile : (benchmark.usesMouse ? mouseFiles : QStringList({""}))) {
+                bench::Operation operation = benchmark.setup({size, mouseFile});
+                if (!operation) {
+                    qWarning().noquote()
+                        << "Skipping" << benchmark.name << "for" << size << "x" << size
+                        << (mouseFile.isEmpty() ? QString("mazes.") : "mazes with \"" + mouseFile + "\".");
+                    continue;
+                }
+                bench::Result result = bench::Benchmarks::run(operation, minSeconds);
+                QJsonObject json;
+                json.insert("benchmark", benchmark.name);
+                json.insert("mazeSize", size);
+                json.insert("mouseFile", mouseFile);
+                json.insert("iterations", result.iterations);
+                json.insert("nanosecondsPerIteration", result.nanosecondsPerIteration);
+                json.insert("iterationsPerSecond", 1e9 / result.nanosecondsPerIteration);
+                std::cout << QJsonDocument(json).toJson(QJsonDocument::Compact).toStdString() << std::endl;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,45 @@
+CONFIG += qt
+CONFIG += object_parallel_to_source
+CONFIG += warn_off # TODO: Turn these on
+
+SOURCES += $$files(*.cpp, true)
+
+HEADERS += $$files(*.h, true)
+
+# Everything that the simulator is built from, except for its main()
+SOURCES += $$files(../sim/*.cpp, true)
+SOURCES -= ../sim/Main.cpp
+SOURCES += $$files(../lib/*.cpp, true)
+
+# The maze generators that are standalone enough to be benchmarked
+SOURCES += ../maze/algos/tomasz/TomaszMazeGeneratorCore.cpp
+
+# The mouse algorithms whose parts are benchmarked on their own
+SOURCES += ../mouse/IMouseAlgorithm.cpp
+SOURCES += $$files(../mouse/floodFill/*.cpp)
+SOURCES += $$files(../mouse/mackAlgoTwo/*.cpp)
+SOURCES += $$files(../mouse/motionProfile/*.cpp)
+SOURCES += $$files(../mouse/planner/*.cpp)
+
+HEADERS += $$files(../sim/*.h, true)
+HEADERS += $$files(../lib/*.h, true)
+HEADERS += ../maze/algos/tomasz/TomaszMazeGeneratorCore.h
+HEADERS += ../mouse/IMouseAlgorithm.h
+HEADERS += $$files(../mouse/floodFill/*.h)
+HEADERS += $$files(../mouse/mackAlgoTwo/*.h)
+HEADERS += $$files(../mouse/motionProfile/*.h)
+HEADERS += $$files(../mouse/planner/*.h)
+
+INCLUDEPATH += ../lib
+
+LIBS += -lGLEW
+LIBS += -lGL
+LIBS += -lglut
+LIBS += -lGLU
+LIBS += -lpthread
+
+# TODO: MACK - make this some sort of variable
+DESTDIR     = ../../bin
+MOC_DIR     = ../../build/moc/bench
+OBJECTS_DIR = ../../build/obj/bench
+RCC_DIR     = ../../build/rcc/bench
@@ -0,0 +1,244 @@
+#include "Eller.h"
+
+#include <cmath>
+
+namespace eller {
+
+EllerRowGenerator::EllerRowGenerator(int mazeWidth, int mazeHeight, bool micromouseRules,
+        const std::function<double()>& random) :
+        m_width(mazeWidth),
+        m_height(mazeHeight),
+        m_random(random),
+        m_y(mazeHeight - 1),
+        m_sets(mazeWidth),
+        m_parents(mazeWidth),
+        m_openNorth(mazeWidth, false),
+        m_openEast(mazeWidth, false),
+        m_openSouth(mazeWidth, false),
+        m_setOpenSouth(mazeWidth),
+        m_candidateCounts(mazeWidth),
+        m_candidates(mazeWidth),
+        m_setUsed(mazeWidth),
+        m_row(mazeWidth) {
+
+    m_hasStart = micromouseRules && 5 <= m_width && 5 <= m_height;
+    m_hasCenter = m_hasStart;
+
+    // The lower left corner of the center, rounded up for odd sizes, just as
+    // in the Tomasz generator, and one or two tiles in each direction
+    m_centerLeft = static_cast<int>(std::round(static_cast<double>(m_width) / 2.0) - 1);
+    m_centerBottom = static_cast<int>(std::round(static_cast<double>(m_height) / 2.0) - 1);
+    m_centerRight = m_centerLeft + (m_width % 2 == 0 ? 1 : 0);
+    m_centerTop = m_centerBottom + (m_height % 2 == 0 ? 1 : 0);
+    m_entrance = 0;
+    if (m_hasCenter) {
+        int numberOfEntrances = 2 + m_centerRight - m_centerLeft + 1;
+        m_entrance = static_cast<int>(std::floor(m_random() * numberOfEntrances));
+    }
+
+    // Every tile of the top row starts out in a set of its own
+    for (int x = 0; x < m_width; x += 1) {
+        m_sets[x] = x;
+    }
+}
+
+bool EllerRowGenerator::hasNextRow() const {
+    return 0 <= m_y;
+}
+
+int EllerRowGenerator::nextRow() {
+
+    int y = m_y;
+    m_y -= 1;
+
+    // The center isn't opened to the row above it, so its top row starts out
+    // in sets of its own, which are then joined into one
+    if (m_hasCenter && y == m_centerTop) {
+        for (int x = m_centerLeft + 1; x <= m_centerRight; x += 1) {
+            m_sets[x] = m_sets[m_centerLeft];
+        }
+    }
+
+    // Join tiles within the row, and then open some of them to the next row
+    for (int x = 0; x < m_width; x += 1) {
+        m_parents[x] = x;
+    }
+    for (int x = 0; x + 1 < m_width; x += 1) {
+        m_openEast[x] = openEast(x, y);
+    }
+    m_openEast[m_width - 1] = false;
+    for (int x = 0; x < m_width; x += 1) {
+        m_sets[x] = find(m_sets[x]);
+    }
+    if (0 < y) {
+        openSouth(y);
+    }
+
+    for (int x = 0; x < m_width; x += 1) {
+        bool north = !m_openNorth.at(x);
+        bool east = !m_openEast.at(x);
+        bool south = y == 0 || !m_openSouth.at(x);
+        bool west = x == 0 || !m_openEast.at(x - 1);
+        m_row[x] = (west << 3) | (south << 2) | (east << 1) | (north << 0);
+    }
+
+    // The tiles that are open to the next row keep their sets, and the rest
+    // get sets of their own, none of which are in use
+    if (0 < y) {
+        m_setUsed.assign(m_width, false);
+        for (int x = 0; x < m_width; x += 1) {
+            if (m_openSouth.at(x)) {
+                m_setUsed[m_sets.at(x)] = true;
+            }
+        }
+        int unused = 0;
+        for (int x = 0; x < m_width; x += 1) {
+            if (!m_openSouth.at(x)) {
+                while (m_setUsed.at(unused)) {
+                    unused += 1;
+                }
+                m_sets[x] = unused;
+                m_setUsed[unused] = true;
+            }
+        }
+        m_openNorth = m_openSouth;
+    }
+
+    return y;
+}
+
+const std::vector<unsigned char>& EllerRowGenerator::getRow() const {
+    return m_row;
+}
+
+int EllerRowGenerator::find(int set) {
+    while (m_parents.at(set) != set) {
+        m_parents[set] = m_parents.at(m_parents.at(set));
+        set = m_parents.at(set);
+    }
+    return set;
+}
+
+bool EllerRowGenerator::isCenter(int x, int y) const {
+    return m_hasCenter &&
+        m_centerLeft <= x && x <= m_centerRight &&
+        m_centerBottom <= y && y <= m_centerTop;
+}
+
+bool EllerRowGenerator::openEast(int x, int y) {
+
+    // The center has no walls inside of it, and none to the outside, other
+    // than its entrance. The center's tiles are already in the same set.
+    bool westIsCenter = isCenter(x, y);
+    bool eastIsCenter = isCenter(x + 1, y);
+    if (westIsCenter && eastIsCenter) {
+        return true;
+    }
+    bool isEntrance = y == m_centerBottom && (
+        (eastIsCenter && m_entrance == 0) ||
+        (westIsCenter && m_entrance == 1));
+    if ((westIsCenter || eastIsCenter) && !isEntrance) {
+        return false;
+    }
+
+    // Tiles in different sets may be joined without making a loop. In the
+    // last row, they must be, so that every tile is reachable. Above the
+    // start, the start's set is joined to the tile to its east, so that the
+    // two are still joined (from above) when the wall between them is kept.
+    // Above the center, the tiles that can't be opened to the center are
+    // joined to the tiles next to them, so that their sets can be continued.
+    int west = find(m_sets.at(x));
+    int east = find(m_sets.at(x + 1));
+    if (west == east) {
+        return false;
+    }
+    bool join =
+        isEntrance ||
+        y == 0 ||
+        (m_hasStart && y == 1 && x == 0) ||
+        (m_hasCenter && y == m_centerTop + 1 && m_centerLeft <= x + 1 && x <= m_centerRight) ||
+        m_random() < m_joinChance;
+    if (join) {
+        m_parents[east] = west;
+    }
+    return join;
+}
+
+void EllerRowGenerator::openSouth(int y) {
+
+    m_setOpenSouth.assign(m_width, false);
+    m_candidateCounts.assign(m_width, 0);
+    for (int x = 0; x < m_width; x += 1) {
+
+        // The tiles whose walls are fixed by the rules, i.e., those above
+        // the center, those in it, and those above the start
+        bool fixed = true;
+        bool open = false;
+        if (m_hasCenter && m_centerLeft <= x && x <= m_centerRight &&
+                m_centerBottom <= y && y <= m_centerTop + 1) {
+            open = y == m_centerBottom ? m_entrance == 2 + x - m_centerLeft :
+                y <= m_centerTop;
+        }
+        else if (m_hasStart && y == 1 && x <= 1) {
+            open = true;
+        }
+        else {
+            fixed = false;
+            open = m_random() < m_carveChance;
+        }
+        m_openSouth[x] = open;
+
+        int set = m_sets.at(x);
+        if (open) {
+            m_setOpenSouth[set] = true;
+        }
+        else if (!fixed) {
+            m_candidateCounts[set] += 1;
+            if (m_random() * m_candidateCounts.at(set) < 1.0) {
+                m_candidates[set] = x;
+            }
+        }
+    }
+
+    // Every set must be continued into the next row, or else its tiles would
+    // be cut off from the rest of the maze. The rules above always leave each
+    // set at least one tile that may be opened.
+    for (int x = 0; x < m_width; x += 1) {
+        int set = m_sets.at(x);
+        if (!m_setOpenSouth.at(set) && 0 < m_candidateCounts.at(set)) {
+            m_openSouth[m_candidates.at(set)] = true;
+            m_setOpenSouth[set] = true;
+        }
+    }
+}
+
+Eller::Eller(bool micromouseRules) :
+        m_micromouseRules(micromouseRules) {
+}
+
+void Eller::generate(int mazeWidth, int mazeHeight, MazeInterface* maze) {
+    static const char DIRECTION_CHARS[] = {'n', 'e', 's', 'w'};
+    EllerRowGenerator rows(mazeWidth, mazeHeight, m_micromouseRules, [maze]() {
+        return maze->getRandom();
+    });
+    while (rows.hasNextRow()) {
+        int y = rows.nextRow();
+        for (int x = 0; x < mazeWidth; x += 1) {
+            for (int direction = 0; direction < 4; direction += 1) {
+                maze->setWall(x, y, DIRECTION_CHARS[direction], (rows.getRow().at(x) >> direction) & 1);
+            }
+        }
+    }
+}
+
+void Eller::write(int mazeWidth, int mazeHeight, const std::function<double()>& random,
+        MazeRowWriter* writer) {
+    EllerRowGenerator rows(mazeWidth, mazeHeight, m_micromouseRules, random);
+    while (rows.hasNextRow()) {
+        int y = rows.nextRow();
+        writer->writeRow(y, rows.getRow());
+    }
+    writer->finish();
+}
+
+} // namespace eller
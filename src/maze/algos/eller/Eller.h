@@ -0,0 +1,110 @@
+#pragma once
+
+#include "../IMazeAlgorithm.h"
+#include "../MazeRowWriter.h"
+
+#include <functional>
+#include <vector>
+
+namespace eller {
+
+// Generates a perfect maze one row at a time, from the top (north) row down,
+// with Eller's algorithm. Only the current row is ever kept, along with which
+// of its tiles are connected by the rows above it, so the memory used is
+// proportional to the width of the maze, no matter how tall it is.
+//
+// With the Micromouse rules, the center of the maze (the same tiles as the
+// Tomasz generator uses) is a room with a single entrance, and the starting
+// tile, in the lower left corner, only opens to the north. The rules are only
+// applied to mazes that are at least 5x5, since the center and the start
+// would otherwise overlap.
+class EllerRowGenerator {
+
+public:
+
+    // The random numbers must be in [0, 1)
+    EllerRowGenerator(int mazeWidth, int mazeHeight, bool micromouseRules,
+        const std::function<double()>& random);
+
+    bool hasNextRow() const;
+
+    // Generates the next row, and returns its y
+    int nextRow();
+
+    // The walls of the last row generated, in the layout of MazeRowWriter
+    const std::vector<unsigned char>& getRow() const;
+
+private:
+
+    // The chance that two neighboring tiles that aren't yet connected are
+    // joined, and that a tile is opened to the row below it
+    double m_joinChance = 0.5;
+    double m_carveChance = 0.4;
+
+    int m_width;
+    int m_height;
+    std::function<double()> m_random;
+
+    // The next row to be generated
+    int m_y;
+
+    bool m_hasStart;
+    bool m_hasCenter;
+    int m_centerLeft;
+    int m_centerRight;
+    int m_centerBottom;
+    int m_centerTop;
+
+    // 0 for the west wall, 1 for the east wall, and then each of the south
+    // walls, all of the bottom row of the center
+    int m_entrance;
+
+    // The set of each tile of the current row, which are always less than
+    // the width, and the union-find parents of the sets
+    std::vector<int> m_sets;
+    std::vector<int> m_parents;
+
+    // Which tiles of the current row are open to the north and to the
+    // east, and which are open to the south, i.e., to the next row
+    std::vector<bool> m_openNorth;
+    std::vector<bool> m_openEast;
+    std::vector<bool> m_openSouth;
+
+    // For each set, whether it's open to the next row, the number of its
+    // tiles that could be opened to make it so, and one of them, at random
+    std::vector<bool> m_setOpenSouth;
+    std::vector<int> m_candidateCounts;
+    std::vector<int> m_candidates;
+
+    std::vector<bool> m_setUsed;
+    std::vector<unsigned char> m_row;
+
+    int find(int set);
+    bool isCenter(int x, int y) const;
+
+    // Whether the wall east of the tile is open, joining the tiles' sets if so
+    bool openEast(int x, int y);
+
+    // Opens the tiles to the next row, at least one per set
+    void openSouth(int y);
+
+};
+
+// The maze algorithm, which sends the rows to the maze interface as soon as
+// they're generated, or to a writer, without the maze interface at all
+class Eller : public IMazeAlgorithm {
+
+public:
+    Eller(bool micromouseRules = true);
+
+    void generate(int mazeWidth, int mazeHeight, MazeInterface* maze);
+
+    void write(int mazeWidth, int mazeHeight, const std::function<double()>& random,
+        MazeRowWriter* writer);
+
+private:
+    bool m_micromouseRules;
+
+};
+
+} // namespace eller
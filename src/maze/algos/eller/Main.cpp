@@ -0,0 +1,54 @@
+// Streams a maze to stdout as it's generated, just as the simulator expects
+// of a maze algorithm's Main:
+//
+//     eller <width> <height> <seed> [map|num|binary]
+//
+// The maze is written as a .map file by default. Since only a single row is
+// ever held in memory, the maze can be arbitrarily tall.
+
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "../../../sim/Random.h"
+#include "Eller.h"
+
+int main(int argc, char* argv[]) {
+
+    if (argc < 4 || 5 < argc) {
+        std::cerr << "Usage: " << argv[0] << " <width> <height> <seed> [map|num|binary]" << std::endl;
+        return 1;
+    }
+    int width = std::atoi(argv[1]);
+    int height = std::atoi(argv[2]);
+    if (width <= 0 || height <= 0) {
+        std::cerr << "The width and height must be positive integers." << std::endl;
+        return 1;
+    }
+
+    // The same stream of the seed as the simulator generates mazes from
+    sim::Random random = sim::Random(std::strtoull(argv[3], nullptr, 10))
+        .getStream(sim::Random::MAZE_GENERATION);
+
+    std::string format = argc == 5 ? argv[4] : "map";
+    std::unique_ptr<MazeRowWriter> writer;
+    if (format == "map") {
+        writer.reset(new MapRowWriter(&std::cout, width, height));
+    }
+    else if (format == "num") {
+        writer.reset(new NumRowWriter(&std::cout, width, height));
+    }
+    else if (format == "binary") {
+        writer.reset(new BinaryRowWriter(&std::cout, width, height));
+    }
+    else {
+        std::cerr << "Unknown format \"" << format << "\"." << std::endl;
+        return 1;
+    }
+
+    eller::Eller().write(width, height, [&random]() {
+        return random.getDouble();
+    }, writer.get());
+    return 0;
+}
@@ -0,0 +1,354 @@
+#include "TomaszMazeGeneratorCore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace tomasz {
+
+const unsigned char TomaszMazeGeneratorCore::ALL_WALLS;
+const unsigned char TomaszMazeGeneratorCore::EXPLORED;
+const unsigned char TomaszMazeGeneratorCore::CENTER;
+
+void TomaszMazeGeneratorCore::generate(
+        int mazeWidth, int mazeHeight, const std::function<double()>& random) {
+
+    m_width = mazeWidth;
+    m_height = mazeHeight;
+    m_direction = UNDEFINED;
+    m_random = &random;
+
+    // None of these reallocate unless the maze is bigger than any before it
+    int numberOfCells = m_width * m_height;
+    m_cells.assign(numberOfCells, ALL_WALLS);
+    m_distances.resize(numberOfCells);
+    m_distanceStamps.assign(numberOfCells, 0);
+    m_search = 0;
+    m_stack.resize(numberOfCells);
+    m_queue.resize(numberOfCells);
+
+    makeCenter();
+
+    // Put the first cell on the stack, and then continue to DFS until we've
+    // explored every cell
+    m_cells[0] |= EXPLORED;
+    m_stack[0] = 0;
+    int stackSize = 1;
+    while (0 < stackSize) {
+
+        const int current = m_stack[stackSize - 1];
+        const int xPos = current / m_height;
+        const int yPos = current % m_height;
+        const unsigned char choices = getUnexploredMoves(current);
+
+        // If the current cell has no more paths forward, backtrack, and if we
+        // just reached the end of a path, break a wall toward the most
+        // disjoint cell with some probability, for a more open maze
+        if (choices == 0) {
+            stackSize -= 1;
+            if (m_direction != UNDEFINED && random() <= tomDeadEndBreakChance) {
+                updateDistances(current, true);
+                breakGradientWall(current);
+            }
+            m_direction = UNDEFINED;
+            continue;
+        }
+
+        // The chance that the algorithm will continue in the same direction
+        // is proportional to the distance from the center. Note that the
+        // original implementation took the (integer) abs of the offsets from
+        // the center, truncating them, and so we do too.
+        const double xCenterDistance =
+            (std::abs(static_cast<int>(xPos - m_width / 2.0)) * 2.0) / (m_width - 1);
+        const double yCenterDistance =
+            (std::abs(static_cast<int>(yPos - m_height / 2.0)) * 2.0) / (m_height - 1);
+        const double moveConst = tomStraightFactor * std::max(xCenterDistance, yCenterDistance);
+
+        // Break down the wall toward the next cell, and push it onto the stack
+        m_direction = getDirectionToMove(moveConst, choices);
+        setWall(current, m_direction, false);
+        int next = getNeighbor(current, m_direction);
+        m_cells[next] |= EXPLORED;
+        m_stack[stackSize] = next;
+        stackSize += 1;
+    }
+
+    breakGradientWalls();
+    updateDistances(0, false);
+    pathIntoCenter();
+
+    m_random = nullptr;
+}
+
+int TomaszMazeGeneratorCore::getWidth() const {
+    return m_width;
+}
+
+int TomaszMazeGeneratorCore::getHeight() const {
+    return m_height;
+}
+
+unsigned char TomaszMazeGeneratorCore::getWalls(int x, int y) const {
+    return m_cells[getCell(x, y)] & ALL_WALLS;
+}
+
+bool TomaszMazeGeneratorCore::isWall(int x, int y, Direction direction) const {
+    return (getWalls(x, y) >> direction) & 1;
+}
+
+int TomaszMazeGeneratorCore::getCell(int x, int y) const {
+    return x * m_height + y;
+}
+
+int TomaszMazeGeneratorCore::getNeighbor(int cell, Direction direction) const {
+    switch (direction) {
+        case NORTH:
+            return cell % m_height + 1 < m_height ? cell + 1 : -1;
+        case EAST:
+            return cell + m_height < m_width * m_height ? cell + m_height : -1;
+        case SOUTH:
+            return 0 < cell % m_height ? cell - 1 : -1;
+        case WEST:
+            return m_height <= cell ? cell - m_height : -1;
+        default:
+            return -1;
+    }
+}
+
+void TomaszMazeGeneratorCore::setWall(int cell, Direction direction, bool value) {
+    int neighbor = getNeighbor(cell, direction);
+    Direction opposite = static_cast<Direction>((direction + 2) % 4);
+    if (value) {
+        m_cells[cell] |= 1 << direction;
+        m_cells[neighbor] |= 1 << opposite;
+    }
+    else {
+        m_cells[cell] &= ~(1 << direction);
+        m_cells[neighbor] &= ~(1 << opposite);
+    }
+}
+
+int TomaszMazeGeneratorCore::getDistance(int cell) const {
+    return m_distanceStamps[cell] == m_search ? m_distances[cell] : -1;
+}
+
+void TomaszMazeGeneratorCore::setDistance(int cell, int distance) {
+    m_distances[cell] = distance;
+    m_distanceStamps[cell] = m_search;
+}
+
+unsigned char TomaszMazeGeneratorCore::getUnexploredMoves(int cell) const {
+    unsigned char moves = 0;
+    for (int direction = NORTH; direction <= WEST; direction += 1) {
+        int neighbor = getNeighbor(cell, static_cast<Direction>(direction));
+        if (neighbor != -1 && (m_cells[neighbor] & (EXPLORED | CENTER)) == 0) {
+            moves |= 1 << direction;
+        }
+    }
+    return moves;
+}
+
+bool TomaszMazeGeneratorCore::isValidExploredTile(int cell) const {
+    return cell > 0 && (m_cells[cell] & (EXPLORED | CENTER)) == EXPLORED;
+}
+
+void TomaszMazeGeneratorCore::makeCenter() {
+
+    // These center variables will always be the lower left corner of
+    // the center.  If a side is odd, the division will yeild X.5,
+    // this rounded will result in middle.  Middle square of 3 is 2.
+    // 3 / 2 = 1.5 -> 2         4 / 2 = 2 -> 2
+    int xCenter = static_cast<int>(std::round(static_cast<double>(m_width) / 2.0) - 1);
+    int yCenter = static_cast<int>(std::round(static_cast<double>(m_height) / 2.0) - 1);
+    int center = getCell(xCenter, yCenter);
+
+    m_cells[center] |= CENTER; // This is always the middle
+
+    if ((m_width % 2 == 0) && (m_height % 2 == 0)) {
+        int upperRight = getCell(xCenter + 1, yCenter + 1);
+        setWall(upperRight, SOUTH, false);
+        setWall(upperRight, WEST, false);
+        m_cells[upperRight] |= CENTER;
+    }
+
+    if (m_width % 2 == 0) {
+        setWall(center, EAST, false);
+        m_cells[getNeighbor(center, EAST)] |= CENTER;
+    }
+
+    if (m_height % 2 == 0) {
+        setWall(center, NORTH, false);
+        m_cells[getNeighbor(center, NORTH)] |= CENTER;
+    }
+}
+
+Direction TomaszMazeGeneratorCore::getDirectionToMove(float moveConst, unsigned char choices) {
+
+    // The directions are drawn just as the original implementation drew them,
+    // i.e., uniformly, and then redrawn until they're valid, so that the same
+    // random numbers yield the same maze
+    const std::function<double()>& random = *m_random;
+    int possible = 0;
+    for (int direction = NORTH; direction <= WEST; direction += 1) {
+        possible += (choices >> direction) & 1;
+    }
+
+    // If the previous move exists, and repeating it will yield a valid move,
+    // and it's not the only valid move, then maybe repeat it
+    Direction directionToMove;
+    if (m_direction != UNDEFINED && ((choices >> m_direction) & 1) && possible != 1) {
+        if (random() <= moveConst) {
+            return m_direction;
+        }
+        do {
+            directionToMove = static_cast<Direction>(static_cast<int>(std::floor(random() * 4)));
+        } while (((choices >> directionToMove) & 1) == 0 || directionToMove == m_direction);
+    }
+    else {
+        do {
+            directionToMove = static_cast<Direction>(static_cast<int>(std::floor(random() * 4)));
+        } while (((choices >> directionToMove) & 1) == 0);
+    }
+    return directionToMove;
+}
+
+void TomaszMazeGeneratorCore::updateDistances(int cell, bool onlyNeighbors) {
+
+    // Note: In a normal recursive backtracker maze generation algorithm, the
+    // distance from start is just the size of the stack. Since walls are
+    // broken in certain scenarios, that's no longer reliable, and so the
+    // distances are computed by a breadth first search. Since a cell's
+    // distance is final once it's been queued, we can stop as soon as all of
+    // the neighbors have been queued, if that's all that's needed.
+    m_search += 1;
+    setDistance(cell, 0);
+    m_queue[0] = cell;
+    int head = 0;
+    int tail = 1;
+
+    int neighbors[4];
+    int remaining = 0;
+    for (int direction = NORTH; direction <= WEST; direction += 1) {
+        neighbors[direction] = getNeighbor(cell, static_cast<Direction>(direction));
+        if (neighbors[direction] != -1) {
+            remaining += 1;
+        }
+    }
+    if (onlyNeighbors && remaining == 0) {
+        return;
+    }
+
+    while (head < tail) {
+        int current = m_queue[head];
+        head += 1;
+        int newDistance = getDistance(current) + 1;
+        for (int direction = NORTH; direction <= WEST; direction += 1) {
+            if ((m_cells[current] >> direction) & 1) {
+                continue;
+            }
+            int next = getNeighbor(current, static_cast<Direction>(direction));
+            if (getDistance(next) != -1) {
+                continue;
+            }
+            setDistance(next, newDistance);
+            m_queue[tail] = next;
+            tail += 1;
+            if (onlyNeighbors && std::find(neighbors, neighbors + 4, next) != neighbors + 4) {
+                remaining -= 1;
+                if (remaining == 0) {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+void TomaszMazeGeneratorCore::breakGradientWall(int cell) {
+
+    int currentCellDist = getDistance(cell);
+    int biggestDifference = 0;
+    Direction cellToBreak = UNDEFINED;
+    for (int direction = NORTH; direction <= WEST; direction += 1) {
+        int neighbor = getNeighbor(cell, static_cast<Direction>(direction));
+        if (neighbor != -1 && isValidExploredTile(neighbor) &&
+                std::abs(getDistance(neighbor) - currentCellDist) > biggestDifference) {
+            biggestDifference = std::abs(getDistance(neighbor) - currentCellDist);
+            cellToBreak = static_cast<Direction>(direction);
+        }
+    }
+
+    if (biggestDifference > tomDeadEndBreakThreshold) {
+        setWall(cell, cellToBreak, false);
+    }
+}
+
+void TomaszMazeGeneratorCore::breakGradientWalls() {
+
+    for (int i = 0; i < tomGradientWallBreaks; i += 1) {
+
+        // Compute the distances from every cell (other than the start and the
+        // center), and find the biggest gradient across any of its walls
+        int greatestGradient = 0;
+        int cellOfGreatest = 0;
+        for (int cell = 0; cell < m_width * m_height; cell += 1) {
+            if (cell == 0 || (m_cells[cell] & CENTER)) {
+                continue;
+            }
+            // The cell's own distance is zero
+            updateDistances(cell, true);
+            for (int direction = NORTH; direction <= WEST; direction += 1) {
+                int neighbor = getNeighbor(cell, static_cast<Direction>(direction));
+                if (neighbor != -1 && isValidExploredTile(neighbor) &&
+                        std::abs(getDistance(neighbor)) > greatestGradient) {
+                    greatestGradient = std::abs(getDistance(neighbor));
+                    cellOfGreatest = cell;
+                }
+            }
+        }
+
+        // This will figure out the direction of the greatest gradient by itself
+        updateDistances(cellOfGreatest, true);
+        breakGradientWall(cellOfGreatest);
+    }
+}
+
+void TomaszMazeGeneratorCore::pathIntoCenter() {
+
+    int xCenter = static_cast<int>(std::round(static_cast<double>(m_width) / 2.0) - 1);
+    int yCenter = static_cast<int>(std::round(static_cast<double>(m_height) / 2.0) - 1);
+
+    // The center cells, other than the lower left one, in the same order as
+    // the original implementation looked at them
+    int candidates[3];
+    int numberOfCandidates = 0;
+    if ((m_width % 2 == 0) && (m_height % 2 == 0)) {
+        candidates[numberOfCandidates] = getCell(xCenter + 1, yCenter + 1);
+        numberOfCandidates += 1;
+    }
+    if (m_width % 2 == 0) {
+        candidates[numberOfCandidates] = getCell(xCenter + 1, yCenter);
+        numberOfCandidates += 1;
+    }
+    if (m_height % 2 == 0) {
+        candidates[numberOfCandidates] = getCell(xCenter, yCenter + 1);
+        numberOfCandidates += 1;
+    }
+
+    int greatestGradient = 0;
+    int cellOfGreatest = getCell(xCenter, yCenter);
+    for (int i = 0; i < numberOfCandidates; i += 1) {
+        int currentCellDist = getDistance(candidates[i]);
+        for (int direction = NORTH; direction <= WEST; direction += 1) {
+            int neighbor = getNeighbor(candidates[i], static_cast<Direction>(direction));
+            if (neighbor != -1 && isValidExploredTile(neighbor) &&
+                    std::abs(getDistance(neighbor) - currentCellDist) > greatestGradient) {
+                greatestGradient = std::abs(getDistance(neighbor) - currentCellDist);
+                cellOfGreatest = candidates[i];
+            }
+        }
+    }
+
+    breakGradientWall(cellOfGreatest);
+}
+
+} // namespace tomasz
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+namespace tomasz {
+
+enum Direction { NORTH, EAST, SOUTH, WEST, UNDEFINED };
+
+// The maze generation itself, without any maze interface, so that it can be
+// run (and benchmarked) on its own, as many times as needed.
+//
+// Every cell is a single byte: four wall bits, in the order of the Direction
+// enum, plus an explored bit and a center bit. The cells, the depth first
+// search stack, and the breadth first search queue are all flat arrays that
+// are only ever reallocated when the maze gets bigger, so generating many
+// mazes of the same size doesn't allocate at all.
+//
+// Given the same sequence of random numbers, this generates exactly the same
+// maze as the original, map-based implementation did.
+class TomaszMazeGeneratorCore {
+
+public:
+
+    // The random numbers must be in [0, 1)
+    void generate(int mazeWidth, int mazeHeight, const std::function<double()>& random);
+
+    int getWidth() const;
+    int getHeight() const;
+
+    // The four wall bits of a cell of the last maze that was generated
+    unsigned char getWalls(int x, int y) const;
+    bool isWall(int x, int y, Direction direction) const;
+
+private:
+
+    // Tomasz Maze Generator Parameters
+    // Number between 0-1 which determines how straight the maze becomes closer to edges
+    double tomStraightFactor = 0.85;
+    // Number between 0-1 which determines if the algorithm will break down a wall at a dead end
+    double tomDeadEndBreakChance = 0.75;
+    // The minimum distance between cells to break down a dead end wall. > 5
+    int tomDeadEndBreakThreshold = 8;
+    // Number of walls to break down in finalized maze
+    int tomGradientWallBreaks = 3;
+
+    static const unsigned char ALL_WALLS = 0x0F;
+    static const unsigned char EXPLORED = 0x10;
+    static const unsigned char CENTER = 0x20;
+
+    int m_width;
+    int m_height;
+
+    // The current direction of the path being generated
+    Direction m_direction;
+
+    // Only set during generate()
+    const std::function<double()>* m_random;
+
+    // The cells, column by column, i.e., the cell at x, y is at x * height + y
+    std::vector<unsigned char> m_cells;
+
+    // The distances of the cells from the start of the last breadth first
+    // search. Rather than resetting every distance before each search, a
+    // distance only counts if its stamp is the number of the current search.
+    std::vector<int> m_distances;
+    std::vector<unsigned int> m_distanceStamps;
+    unsigned int m_search;
+
+    // Each cell is pushed onto the stack, and the queue, at most once per
+    // search, so neither needs more room than the number of cells
+    std::vector<int> m_stack;
+    std::vector<int> m_queue;
+
+    int getCell(int x, int y) const;
+
+    // The cell next to the given cell in the given direction, or -1 if it's
+    // outside of the maze
+    int getNeighbor(int cell, Direction direction) const;
+
+    // Sets a wall of a cell, and the same wall of the cell on the other side
+    void setWall(int cell, Direction direction, bool value);
+
+    int getDistance(int cell) const;
+    void setDistance(int cell, int distance);
+
+    // The (bits of the) directions toward cells that are in the maze,
+    // unexplored, and not in the center
+    unsigned char getUnexploredMoves(int cell) const;
+
+    // Whether the cell is in the maze, explored, not in the center, and not
+    // the start
+    bool isValidExploredTile(int cell) const;
+
+    // Hollows out the center, and sets the center bits
+    void makeCenter();
+
+    // Determines which way the algorithm should proceed. This takes into account
+    // the configuration values and determines whether or not the algorithm should turn.
+    Direction getDirectionToMove(float moveConst, unsigned char choices);
+
+    // Run a breadth first search through the maze from the given cell, and
+    // update the distances of the cells. If only the distances of the cell's
+    // neighbors are needed, the search stops as soon as they're all known.
+    void updateDistances(int cell, bool onlyNeighbors);
+
+    // Breaks the wall of a cell toward the neighbor with the biggest
+    // difference in distance, if it's big enough
+    void breakGradientWall(int cell);
+
+    // Breaks a number of walls which are across the biggest gradient
+    void breakGradientWalls();
+
+    // Finds the longest distance from beginning that is touching the center
+    // of tiles, and breaks that wall
+    void pathIntoCenter();
+
+};
+
+} // namespace tomasz
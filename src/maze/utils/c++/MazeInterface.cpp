@@ -1,13 +1,14 @@
 #include "MazeInterface.h"
 
-MazeInterface::MazeInterface() {
+MazeInterface::MazeInterface(sim::Random random) :
+        m_random(random) {
 }
 
 void MazeInterface::quit() {
 }
 
 double MazeInterface::getRandom() {
-    return 0.5;
+    return m_random.getDouble();
 }
 
 void MazeInterface::setWall(int x, int y, char direction, bool wallExists) {
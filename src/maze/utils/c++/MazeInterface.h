@@ -1,9 +1,11 @@
 #pragma once
 
+#include "../../../sim/Random.h"
+
 class MazeInterface {
 
 public:
-    MazeInterface();
+    MazeInterface(sim::Random random);
 
     // Misc functions
     double getRandom();
@@ -14,4 +16,8 @@ public:
 
 private:
 
+    // The maze generation stream of the simulation's random numbers, so that
+    // the same seed always generates the same maze
+    sim::Random m_random;
+
 };
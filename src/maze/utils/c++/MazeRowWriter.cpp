@@ -0,0 +1,93 @@
+#include "MazeRowWriter.h"
+
+#include <cstdint>
+
+MazeRowWriter::MazeRowWriter(std::ostream* stream, int mazeWidth, int mazeHeight) :
+        m_stream(stream),
+        m_mazeWidth(mazeWidth),
+        m_mazeHeight(mazeHeight) {
+}
+
+MazeRowWriter::~MazeRowWriter() {
+}
+
+void MazeRowWriter::finish() {
+    m_stream->flush();
+}
+
+MapRowWriter::MapRowWriter(std::ostream* stream, int mazeWidth, int mazeHeight) :
+        MazeRowWriter(stream, mazeWidth, mazeHeight),
+        m_line(4 * mazeWidth + 2, ' ') {
+    m_line.back() = '\n';
+}
+
+void MapRowWriter::writeRow(int y, const std::vector<unsigned char>& walls) {
+
+    // Each row is the line of posts and walls above it, followed by the line
+    // of tiles. The line above the top row is drawn from its north walls, and
+    // the rest from the south walls of the row above, which is kept around.
+    writeHorizontalLine(y == m_mazeHeight - 1 ? walls : m_lastRow, y == m_mazeHeight - 1 ? 0 : 2);
+    writeVerticalLine(walls);
+    m_lastRow = walls;
+}
+
+void MapRowWriter::finish() {
+    writeHorizontalLine(m_lastRow, 2);
+    MazeRowWriter::finish();
+}
+
+void MapRowWriter::writeHorizontalLine(const std::vector<unsigned char>& walls, int bit) {
+    for (int x = 0; x < m_mazeWidth; x += 1) {
+        char wall = (walls.at(x) >> bit) & 1 ? '-' : ' ';
+        m_line[4 * x] = '+';
+        m_line[4 * x + 1] = wall;
+        m_line[4 * x + 2] = wall;
+        m_line[4 * x + 3] = wall;
+    }
+    m_line[4 * m_mazeWidth] = '+';
+    m_stream->write(m_line.data(), m_line.size());
+}
+
+void MapRowWriter::writeVerticalLine(const std::vector<unsigned char>& walls) {
+    for (int x = 0; x < m_mazeWidth; x += 1) {
+        m_line[4 * x] = (walls.at(x) >> 3) & 1 ? '|' : ' ';
+        m_line[4 * x + 1] = ' ';
+        m_line[4 * x + 2] = ' ';
+        m_line[4 * x + 3] = ' ';
+    }
+    m_line[4 * m_mazeWidth] = (walls.at(m_mazeWidth - 1) >> 1) & 1 ? '|' : ' ';
+    m_stream->write(m_line.data(), m_line.size());
+}
+
+NumRowWriter::NumRowWriter(std::ostream* stream, int mazeWidth, int mazeHeight) :
+        MazeRowWriter(stream, mazeWidth, mazeHeight) {
+}
+
+void NumRowWriter::writeRow(int y, const std::vector<unsigned char>& walls) {
+    for (int x = 0; x < m_mazeWidth; x += 1) {
+        *m_stream << x << ' ' << y;
+        for (int bit = 0; bit < 4; bit += 1) {
+            *m_stream << ((walls.at(x) >> bit) & 1 ? " 1" : " 0");
+        }
+        *m_stream << '\n';
+    }
+}
+
+BinaryRowWriter::BinaryRowWriter(std::ostream* stream, int mazeWidth, int mazeHeight) :
+        MazeRowWriter(stream, mazeWidth, mazeHeight),
+        m_bytes((mazeWidth + 1) / 2) {
+    for (uint32_t value : {static_cast<uint32_t>(mazeWidth), static_cast<uint32_t>(mazeHeight)}) {
+        for (int shift = 24; shift >= 0; shift -= 8) {
+            m_stream->put(static_cast<char>(value >> shift));
+        }
+    }
+}
+
+void BinaryRowWriter::writeRow(int /* y */, const std::vector<unsigned char>& walls) {
+    for (int i = 0; i < static_cast<int>(m_bytes.size()); i += 1) {
+        unsigned char low = walls.at(2 * i) & 0x0F;
+        unsigned char high = 2 * i + 1 < m_mazeWidth ? walls.at(2 * i + 1) & 0x0F : 0;
+        m_bytes[i] = static_cast<char>(low | (high << 4));
+    }
+    m_stream->write(m_bytes.data(), m_bytes.size());
+}
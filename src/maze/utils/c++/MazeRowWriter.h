@@ -0,0 +1,72 @@
+#pragma once
+
+#include <ostream>
+#include <vector>
+
+// Writes a maze to a stream one row at a time, from the top (north) row down,
+// so that the maze never has to be held in memory as a whole. Each row is one
+// byte per tile, from west to east, whose low four bits are the walls of the
+// tile, 'W S E N' from the most significant bit down, just as in .MAZ files.
+class MazeRowWriter {
+
+public:
+    MazeRowWriter(std::ostream* stream, int mazeWidth, int mazeHeight);
+    virtual ~MazeRowWriter();
+
+    // The rows must be written in order, starting with y = mazeHeight - 1
+    virtual void writeRow(int y, const std::vector<unsigned char>& walls) = 0;
+
+    // Must be called after the last (y = 0) row has been written
+    virtual void finish();
+
+protected:
+    std::ostream* m_stream;
+    int m_mazeWidth;
+    int m_mazeHeight;
+
+};
+
+// The same text as MazeFileUtilities writes for .map files
+class MapRowWriter : public MazeRowWriter {
+
+public:
+    MapRowWriter(std::ostream* stream, int mazeWidth, int mazeHeight);
+    void writeRow(int y, const std::vector<unsigned char>& walls);
+    void finish();
+
+private:
+
+    // The bottom line of the maze is drawn from the last row's south walls
+    std::vector<unsigned char> m_lastRow;
+    std::vector<char> m_line;
+
+    void writeHorizontalLine(const std::vector<unsigned char>& walls, int bit);
+    void writeVerticalLine(const std::vector<unsigned char>& walls);
+
+};
+
+// The same lines as MazeFileUtilities writes for .num files, i.e.,
+// "x y n e s w", but in the order in which the rows are generated. Each line
+// gives the position of its tile, so the order doesn't matter.
+class NumRowWriter : public MazeRowWriter {
+
+public:
+    NumRowWriter(std::ostream* stream, int mazeWidth, int mazeHeight);
+    void writeRow(int y, const std::vector<unsigned char>& walls);
+
+};
+
+// The compact binary layout: the width and then the height, as big endian
+// 32 bit unsigned ints (as in .MZ2 files), followed by the rows, from the top
+// down, with two tiles per byte. The tile on the west is in the low nibble,
+// and a row with an odd number of tiles is padded with a zero nibble.
+class BinaryRowWriter : public MazeRowWriter {
+
+public:
+    BinaryRowWriter(std::ostream* stream, int mazeWidth, int mazeHeight);
+    void writeRow(int y, const std::vector<unsigned char>& walls);
+
+private:
+    std::vector<char> m_bytes;
+
+};
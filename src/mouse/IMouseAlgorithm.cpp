@@ -1,5 +1,8 @@
 #include "IMouseAlgorithm.h"
 
+IMouseAlgorithm::~IMouseAlgorithm() {
+}
+
 std::string IMouseAlgorithm::mouseFile() const {
     return "default.xml";
 }
@@ -6,6 +6,9 @@ class IMouseAlgorithm {
 
 public:
 
+    // Algorithms are deleted through this interface (see src/test)
+    virtual ~IMouseAlgorithm();
+
     // Static options for both interfaces
     virtual std::string mouseFile() const;
     virtual std::string interfaceType() const;
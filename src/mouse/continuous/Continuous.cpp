@@ -1,5 +1,4 @@
 #include "Continuous.h"
-#include "CurveProfile.h"
 #include <iostream>
 #ifdef _WIN32
 #   include <Windows.h>
@@ -19,6 +18,16 @@ using namespace std;
 
 namespace continuous {
 
+	const Continuous::CurveTurn Continuous::DEFAULT_CURVE_TURN = {
+		{90, .325, .025, 0, 0, 0},
+		62
+	};
+
+	Continuous::Continuous(const CurveTurn& curveTurn) :
+		curveProfile(motionProfile::MotionProfile::generate(curveTurn.profile)),
+		curveTurnSettleIterations(curveTurn.settleIterations) {
+	}
+
 	std::string Continuous::mouseFile() const {
 		return "megaMouse.xml";
 	}
@@ -33,6 +42,20 @@ namespace continuous {
 	void Continuous::solve(int mazeWidth, int mazeHeight, bool isOfficialMaze, char initialDirection, sim::MouseInterface* mouse) {
 
 		m_mouse = mouse;
+
+		//resolve the wheels and sensors once, so the control loops never look them up by name
+		leftWheel = m_mouse->getWheelHandle("left-lower");
+		rightWheel = m_mouse->getWheelHandle("right-lower");
+		wheels = { leftWheel, rightWheel };
+		sensors = {
+			m_mouse->getSensorHandle("left-side"),
+			m_mouse->getSensorHandle("right-side"),
+			m_mouse->getSensorHandle("left-front"),
+			m_mouse->getSensorHandle("right-front"),
+			m_mouse->getSensorHandle("left-middle"),
+			m_mouse->getSensorHandle("right-middle")
+		};
+
 		//read initial sensor values to determine first cell move
 		walls_global[0] = wallLeft();
 		walls_global[1] = wallFront();
@@ -354,8 +377,7 @@ namespace continuous {
 				// Calculate PWM based on Error
 
 				// Update Motor PWM values
-				m_mouse->setWheelSpeed("left-lower", -(leftBaseSpeed + totalError));//TODO variable speed
-				m_mouse->setWheelSpeed("right-lower", rightBaseSpeed - totalError);
+				setSpeed(-(leftBaseSpeed + totalError), rightBaseSpeed - totalError);//TODO variable speed
 			}
 		}
 
@@ -470,8 +492,8 @@ namespace continuous {
 			}
 		}
 		angle -= targetDegrees;
-		leftTicks = -m_mouse->readWheelEncoder("left-lower") + forwardOffset;
-		rightTicks = m_mouse->readWheelEncoder("right-lower") + forwardOffset;
+		leftTicks = -m_mouse->readWheelEncoder(leftWheel) + forwardOffset;
+		rightTicks = m_mouse->readWheelEncoder(rightWheel) + forwardOffset;
 		if (accelerate) {
 
 			if (leftBaseSpeed == 0) {
@@ -638,8 +660,7 @@ namespace continuous {
 		oldErrorP = errorP;
 
 		// Update Motor PWM values
-		m_mouse->setWheelSpeed("left-lower", -(leftBaseSpeed + totalError));//TODO variable speed
-		m_mouse->setWheelSpeed("right-lower", rightBaseSpeed - totalError);
+		setSpeed(-(leftBaseSpeed + totalError), rightBaseSpeed - totalError);//TODO variable speed
 	}
 
 	//Curve Turn
@@ -871,15 +892,13 @@ namespace continuous {
 			double wallValue = .958;
 			if ((leftFront + rightFront) / 2 >= wallValue) {
 				while ((leftFront + rightFront) / 2 >= wallValue) {
-					m_mouse->setWheelSpeed("left-lower", 400);
-					m_mouse->setWheelSpeed("right-lower", -400);
+					setSpeed(400, -400);
 					readSensors();
 				}
 			}
 			else {
 				while ((leftFront + rightFront) / 2 < wallValue) {
-					m_mouse->setWheelSpeed("left-lower", -400);
-					m_mouse->setWheelSpeed("right-lower", 400);
+					setSpeed(-400, 400);
 					readSensors();
 				}
 			}
@@ -900,15 +919,13 @@ namespace continuous {
 			double wallValue = .958;
 			if ((leftFront + rightFront) / 2 >= wallValue) {
 				while ((leftFront + rightFront) / 2 >= wallValue) {
-					m_mouse->setWheelSpeed("left-lower", 400);
-					m_mouse->setWheelSpeed("right-lower", -400);
+					setSpeed(400, -400);
 					readSensors();
 				}
 			}
 			else {
 				while ((leftFront + rightFront) / 2 < wallValue) {
-					m_mouse->setWheelSpeed("left-lower", -400);
-					m_mouse->setWheelSpeed("right-lower", 400);
+					setSpeed(-400, 400);
 					readSensors();
 				}
 			}
@@ -1025,15 +1042,15 @@ namespace continuous {
 	//}
 
 	bool Continuous::wallRight() {
-		return m_mouse->readSensor("right-side") > 0.5;
+		return m_mouse->readSensor(sensors[RIGHT_SIDE]) > 0.5;
 	}
 
 	bool Continuous::wallLeft() {
-		return m_mouse->readSensor("left-side") > 0.5;
+		return m_mouse->readSensor(sensors[LEFT_SIDE]) > 0.5;
 	}
 
 	bool Continuous::wallFront() {
-		return m_mouse->readSensor("right-front") > 0.4;
+		return m_mouse->readSensor(sensors[RIGHT_FRONT]) > 0.4;
 	}
 
 	void Continuous::curveTurnRight() {
@@ -1086,10 +1103,10 @@ namespace continuous {
 		}
 		else {
 			if (moveType == TURN_RIGHT) {
-				targetAngle = offsetAngle - curve[i];
+				targetAngle = offsetAngle - curveProfile.getPosition(i);
 			}
 			else {
-				targetAngle = offsetAngle + curve[i];
+				targetAngle = offsetAngle + curveProfile.getPosition(i);
 			}
 		}
 		angle = m_mouse->currentRotationDegrees();
@@ -1114,13 +1131,12 @@ namespace continuous {
 
 		//m_mouse->info(std::string("L: ") + std::to_string(leftSpeed));
 		//m_mouse->info(std::string("R: ") + std::to_string(rightSpeed));
-		m_mouse->setWheelSpeed("left-lower", leftSpeed);
-		m_mouse->setWheelSpeed("right-lower", rightSpeed);
+		setSpeed(leftSpeed, rightSpeed);
 		if (moveType == TURN_RIGHT) {
-			continueTurn = i < curveTime - 1 && angle > offsetAngle - 90;
+			continueTurn = i < curveProfile.getDuration() + curveTurnSettleIterations && angle > offsetAngle - 90;
 		}
 		else {
-			continueTurn = i < curveTime - 1 && angle < offsetAngle + 90;
+			continueTurn = i < curveProfile.getDuration() + curveTurnSettleIterations && angle < offsetAngle + 90;
 		}
 		if (continueTurn) {
 			i++;
@@ -1145,8 +1161,8 @@ namespace continuous {
 	}
 
 	void Continuous::setSpeed(double left, double right) {
-		m_mouse->setWheelSpeed("left-lower", left);
-		m_mouse->setWheelSpeed("right-lower", right);
+		double rpms[2] = { left, right };
+		m_mouse->setWheelSpeeds(wheels, rpms);
 	}
 
 	void Continuous::delay(int ms) {
@@ -1155,12 +1171,14 @@ namespace continuous {
 
 	void Continuous::readSensors() {
 		//if (!haveSensorReading) {
-		leftSensor = m_mouse->readSensor("left-side");
-		rightSensor = m_mouse->readSensor("right-side");
-		leftFront = m_mouse->readSensor("left-front");
-		rightFront = m_mouse->readSensor("right-front");
-		rightMiddleValue = m_mouse->readSensor("right-middle");
-		leftMiddleValue = m_mouse->readSensor("left-middle");
+		double readings[SENSOR_COUNT];
+		m_mouse->readSensors(sensors, readings);
+		leftSensor = readings[LEFT_SIDE];
+		rightSensor = readings[RIGHT_SIDE];
+		leftFront = readings[LEFT_FRONT];
+		rightFront = readings[RIGHT_FRONT];
+		rightMiddleValue = readings[RIGHT_MIDDLE];
+		leftMiddleValue = readings[LEFT_MIDDLE];
 
 		//TODO read the rest of them
 		//haveSensorReading = true;
@@ -1,12 +1,35 @@
 #pragma once
 
+#include <vector>
+
 #include "../IMouseAlgorithm.h"
+#include "../motionProfile/MotionProfile.h"
 
 namespace continuous {
 
 class Continuous : public IMouseAlgorithm {
 
 public:
+
+    // The curve turn, in degrees and iterations of the turn loop
+    struct CurveTurn {
+
+        // The turn itself, which is 90 degrees, from rest to rest
+        motionProfile::MotionProfile::Parameters profile;
+
+        // The iterations that the turn may continue after the profile ends,
+        // while the angle settles at 90 degrees
+        int settleIterations;
+    };
+
+    // The curve turn that the old pasted table of angles described: a
+    // trapezoid that reaches 90 degrees after about 290 iterations. The table
+    // then held 90 for its last 62 entries, giving the PID time to settle
+    // before the turn ends, so the turn still lasts about as long as before.
+    static const CurveTurn DEFAULT_CURVE_TURN;
+
+    Continuous(const CurveTurn& curveTurn = DEFAULT_CURVE_TURN);
+
     std::string mouseFile() const;
     std::string interfaceType() const;
     void solve(int mazeWidth, int mazeHeight, bool isOfficialMaze, char initialDirection, sim::MouseInterface* mouse);
@@ -43,6 +66,10 @@ private:
 												//Max speed for acceleration
 	const int maxSpeed = 1500;
 
+	//Curve turn profile, generated from the curve turn given at construction
+	motionProfile::MotionProfile curveProfile;
+	int curveTurnSettleIterations;
+
 	bool currentMoveDone = false;
 	bool firstMove = true;
 	bool accelerate = true;
@@ -77,6 +104,21 @@ private:
 		TURN_AROUND = 4
 	} moveType;
 
+	//Wheel and sensor handles, resolved once at the start of solve()
+	int leftWheel;
+	int rightWheel;
+	std::vector<int> wheels; // Left, right
+	enum {
+		LEFT_SIDE,
+		RIGHT_SIDE,
+		LEFT_FRONT,
+		RIGHT_FRONT,
+		LEFT_MIDDLE,
+		RIGHT_MIDDLE,
+		SENSOR_COUNT
+	};
+	std::vector<int> sensors; // Indexed by the enum above
+
 	int rightTicks = 0;
 	int leftTicks = 0;
 	double leftSensor;
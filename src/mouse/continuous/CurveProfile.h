@@ -1,357 +0,0 @@
-#pragma once
-#include "../IMouseAlgorithm.h"
-
-const int curveTime = 351;
-float curve[curveTime] = {
-	0,
-	0.025,
-	0.075,
-	0.15,
-	0.25,
-	0.375,
-	0.525,
-	0.7,
-	0.9,
-	1.125,
-	1.375,
-	1.65,
-	1.95,
-	2.275,
-	2.6,
-	2.925,
-	3.25,
-	3.575,
-	3.9,
-	4.225,
-	4.55,
-	4.875,
-	5.2,
-	5.525,
-	5.85,
-	6.175,
-	6.5,
-	6.825,
-	7.15,
-	7.475,
-	7.8,
-	8.125,
-	8.45,
-	8.775,
-	9.1,
-	9.425,
-	9.75,
-	10.075,
-	10.4,
-	10.725,
-	11.05,
-	11.375,
-	11.7,
-	12.025,
-	12.35,
-	12.675,
-	13,
-	13.325,
-	13.65,
-	13.975,
-	14.3,
-	14.625,
-	14.95,
-	15.275,
-	15.6,
-	15.925,
-	16.25,
-	16.575,
-	16.9,
-	17.225,
-	17.55,
-	17.875,
-	18.2,
-	18.525,
-	18.85,
-	19.175,
-	19.5,
-	19.825,
-	20.15,
-	20.475,
-	20.8,
-	21.125,
-	21.45,
-	21.775,
-	22.1,
-	22.425,
-	22.75,
-	23.075,
-	23.4,
-	23.725,
-	24.05,
-	24.375,
-	24.7,
-	25.025,
-	25.35,
-	25.675,
-	26,
-	26.325,
-	26.65,
-	26.975,
-	27.3,
-	27.625,
-	27.95,
-	28.275,
-	28.6,
-	28.925,
-	29.25,
-	29.575,
-	29.9,
-	30.225,
-	30.55,
-	30.875,
-	31.2,
-	31.525,
-	31.85,
-	32.175,
-	32.5,
-	32.825,
-	33.15,
-	33.475,
-	33.8,
-	34.125,
-	34.45,
-	34.775,
-	35.1,
-	35.425,
-	35.75,
-	36.075,
-	36.4,
-	36.725,
-	37.05,
-	37.375,
-	37.7,
-	38.025,
-	38.35,
-	38.675,
-	39,
-	39.325,
-	39.65,
-	39.975,
-	40.3,
-	40.625,
-	40.95,
-	41.275,
-	41.6,
-	41.925,
-	42.25,
-	42.575,
-	42.9,
-	43.225,
-	43.55,
-	43.875,
-	44.2,
-	44.525,
-	44.85,
-	45.175,
-	45.5,
-	45.825,
-	46.15,
-	46.475,
-	46.8,
-	47.125,
-	47.45,
-	47.775,
-	48.1,
-	48.425,
-	48.75,
-	49.075,
-	49.4,
-	49.725,
-	50.05,
-	50.375,
-	50.7,
-	51.025,
-	51.35,
-	51.675,
-	52,
-	52.325,
-	52.65,
-	52.975,
-	53.3,
-	53.625,
-	53.95,
-	54.275,
-	54.6,
-	54.925,
-	55.25,
-	55.575,
-	55.9,
-	56.225,
-	56.55,
-	56.875,
-	57.2,
-	57.525,
-	57.85,
-	58.175,
-	58.5,
-	58.825,
-	59.15,
-	59.475,
-	59.8,
-	60.125,
-	60.45,
-	60.775,
-	61.1,
-	61.425,
-	61.75,
-	62.075,
-	62.4,
-	62.725,
-	63.05,
-	63.375,
-	63.7,
-	64.025,
-	64.35,
-	64.675,
-	65,
-	65.325,
-	65.65,
-	65.975,
-	66.3,
-	66.625,
-	66.95,
-	67.275,
-	67.6,
-	67.925,
-	68.25,
-	68.575,
-	68.9,
-	69.225,
-	69.55,
-	69.875,
-	70.2,
-	70.525,
-	70.85,
-	71.175,
-	71.5,
-	71.825,
-	72.15,
-	72.475,
-	72.8,
-	73.125,
-	73.45,
-	73.775,
-	74.1,
-	74.425,
-	74.75,
-	75.075,
-	75.4,
-	75.725,
-	76.05,
-	76.375,
-	76.7,
-	77.025,
-	77.35,
-	77.675,
-	78,
-	78.325,
-	78.65,
-	78.975,
-	79.3,
-	79.625,
-	79.95,
-	80.275,
-	80.6,
-	80.925,
-	81.25,
-	81.575,
-	81.9,
-	82.225,
-	82.55,
-	82.875,
-	83.2,
-	83.525,
-	83.85,
-	84.175,
-	84.5,
-	84.825,
-	85.15,
-	85.475,
-	85.8,
-	86.125,
-	86.45,
-	86.775,
-	87.1,
-	87.425,
-	87.75,
-	88.075,
-	88.375,
-	88.65,
-	88.9,
-	89.125,
-	89.325,
-	89.5,
-	89.65,
-	89.775,
-	89.875,
-	89.95,
-	90,
-	90,
-	90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90,
-		90
-};
\ No newline at end of file
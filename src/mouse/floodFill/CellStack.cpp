@@ -0,0 +1,31 @@
+#include "CellStack.h"
+
+namespace floodFill {
+
+CellStack::CellStack() : m_arena(NULL), m_top(-1) {
+}
+
+CellStack::CellStack(Arena* arena) : m_arena(arena), m_top(-1) {
+}
+
+bool CellStack::empty() const {
+    return m_top == -1;
+}
+
+Cell* CellStack::top() const {
+    return (*m_arena)[m_top].cell;
+}
+
+void CellStack::push(Cell* cell) {
+    Node node;
+    node.cell = cell;
+    node.next = m_top;
+    m_arena->push_back(node);
+    m_top = m_arena->size() - 1;
+}
+
+void CellStack::pop() {
+    m_top = (*m_arena)[m_top].next;
+}
+
+} // namespace floodFill
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <vector>
+
+#include "Cell.h"
+
+namespace floodFill {
+
+/*
+ * A persistent stack of cells. Pushing and popping never modify the nodes that
+ * are already in the stack, so copying a stack is O(1), copies share all of
+ * their common nodes, and pushing onto a copy leaves the original untouched.
+ * This lets the History object checkpoint the unexplored stack at every step
+ * without copying it. The nodes live in an arena that all of the stacks share,
+ * and are only ever freed when the whole arena is cleared.
+ */
+class CellStack {
+
+public:
+
+    struct Node {
+        Cell* cell; // The cell at this position in the stack
+        int next; // The index of the node below this one, or -1 if none
+    };
+    typedef std::vector<Node> Arena;
+
+    CellStack();
+    CellStack(Arena* arena); // An empty stack whose nodes live in the arena
+
+    bool empty() const;
+    Cell* top() const;
+    void push(Cell* cell);
+    void pop();
+
+private:
+    Arena* m_arena; // The storage of the nodes of this stack
+    int m_top; // The index of the top node in the arena, or -1 if empty
+
+};
+
+} // namespace floodFill
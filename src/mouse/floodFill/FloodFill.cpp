@@ -1,6 +1,8 @@
 #include "FloodFill.h"
 
+#include <chrono>
 #include <iostream>
+#include <list>
 #include <stack>
 #include <queue>
 #include <stdlib.h>
@@ -39,13 +41,7 @@ void FloodFill::solve(
     }
 
     // Initialize the x and y positions of the cells
-    for (int x = 0; x < MAZE_SIZE_X; x += 1) {
-        for (int y = 0; y < MAZE_SIZE_Y; y += 1) {
-            m_cells[x][y].setX(x);
-            m_cells[x][y].setY(y);
-            m_cells[x][y].setMouseInterface(m_mouse);
-        }
-    }
+    initializeCells();
 
     // If we're comparing algos, run both of them
     if (ALGO_COMPARE) {
@@ -61,6 +57,70 @@ void FloodFill::solve(
     //extensiveSolve();
 }
 
+void FloodFill::replayFloods(
+        sim::MouseInterface* mouse,
+        const std::function<bool(int, int, int)>& isWall,
+        bool recursive) {
+
+    m_mouse = mouse;
+    initializeCells();
+    initialize();
+
+    // Each cell is pushed at most once, when it's first reached
+    static const int STEP_X[4] = {0, 1, 0, -1};
+    static const int STEP_Y[4] = {1, 0, -1, 0};
+    Cell* stack[MAZE_SIZE_X*MAZE_SIZE_Y];
+    bool reached[MAZE_SIZE_X][MAZE_SIZE_Y] = {};
+    int size = 0;
+    stack[size++] = &m_cells[0][0];
+    reached[0][0] = true;
+
+    while (size > 0) {
+
+        Cell* cell = stack[--size];
+        for (int direction = NORTH; direction <= WEST; direction += 1) {
+            int x = cell->getX() + STEP_X[direction];
+            int y = cell->getY() + STEP_Y[direction];
+            if (x < 0 || MAZE_SIZE_X <= x || y < 0 || MAZE_SIZE_Y <= y) {
+                continue;
+            }
+            bool wall = isWall(cell->getX(), cell->getY(), direction);
+            cell->setWall(direction, wall);
+            cell->setWallInspected(direction, true);
+            m_cells[x][y].setWall((direction+2)%4, wall);
+            m_cells[x][y].setWallInspected((direction+2)%4, true);
+            if (!wall && !reached[x][y]) {
+                stack[size++] = &m_cells[x][y];
+                reached[x][y] = true;
+            }
+        }
+
+        m_floodCellsVisited = 0;
+        m_floodCellsRelaxed = 0;
+        if (recursive) {
+            floodRecursive(cell->getX(), cell->getY());
+        }
+        else {
+            floodIterative(cell->getX(), cell->getY());
+        }
+        m_floodCount += 1;
+        m_totalCellsVisited += m_floodCellsVisited;
+        m_totalCellsRelaxed += m_floodCellsRelaxed;
+    }
+}
+
+int FloodFill::getFloodCount() const {
+    return m_floodCount;
+}
+
+long FloodFill::getTotalCellsVisited() const {
+    return m_totalCellsVisited;
+}
+
+long FloodFill::getTotalCellsRelaxed() const {
+    return m_totalCellsRelaxed;
+}
+
 void FloodFill::justFloodFill() {
 
     initialize();
@@ -91,7 +151,9 @@ void FloodFill::simpleSolve() {
 
         int s_steps = m_steps;
         if (ALGO_COMPARE) {
-            std::cout << "Simple explore in " << m_steps << " steps" << std::endl;
+            std::cout << "Simple explore in " << m_steps << " steps, with " << m_floodCount
+                      << " floods that visited " << m_totalCellsVisited << " and relaxed "
+                      << m_totalCellsRelaxed << " cells" << std::endl;
         }
 
         // Solve the maze as quickly as possible,
@@ -123,7 +185,9 @@ void FloodFill::extensiveSolve() {
 
         int s_steps = m_steps;
         if (ALGO_COMPARE) {
-            std::cout << "Extensive explore in " << m_steps << " steps" << std::endl;
+            std::cout << "Extensive explore in " << m_steps << " steps, with " << m_floodCount
+                      << " floods that visited " << m_totalCellsVisited << " and relaxed "
+                      << m_totalCellsRelaxed << " cells" << std::endl;
         }
 
         // Once we know everything about the maze, solve the maze as quickly as possible,
@@ -174,6 +238,17 @@ void FloodFill::resetColors() {
     m_mouse->clearAllTileColor();
 }
 
+void FloodFill::initializeCells() {
+    for (int x = 0; x < MAZE_SIZE_X; x += 1) {
+        for (int y = 0; y < MAZE_SIZE_Y; y += 1) {
+            m_cells[x][y].setX(x);
+            m_cells[x][y].setY(y);
+            m_cells[x][y].setMouseInterface(m_mouse);
+            m_floodQueued[x][y] = false;
+        }
+    }
+}
+
 void FloodFill::initialize() {
 
     // Note: Doesn't work for odd sized mazes
@@ -221,7 +296,15 @@ void FloodFill::initialize() {
     m_explored = false; // Initialize the exploredness of the maze
     m_centerReached = false; // At the start, we haven't yet made it to the center
     m_checkpointReached = true; // We begin at the origin, the first checkpoint
-    m_history.initialize(SHORT_TERM_MEM, &m_cells[0][0]); // Initialize the History object
+    m_floodCount = 0; // No floods have happened yet
+    m_floodCellsVisited = 0;
+    m_floodCellsRelaxed = 0;
+    m_totalCellsVisited = 0;
+    m_totalCellsRelaxed = 0;
+    m_stackArena.clear(); // Free the nodes of the previous explore's stacks
+    CellStack originStack(&m_stackArena);
+    originStack.push(&m_cells[0][0]);
+    m_history.initialize(SHORT_TERM_MEM, originStack); // Initialize the History object
 }
 
 void FloodFill::victory() {
@@ -361,6 +444,82 @@ void FloodFill::checkDeadEnd(Cell* cell) {
 }
 
 void FloodFill::flood(int x, int y) {
+
+    m_floodCellsVisited = 0;
+    m_floodCellsRelaxed = 0;
+
+    if (FLOOD_COMPARE) {
+        compareFloods(x, y);
+    }
+    else {
+        floodIterative(x, y);
+    }
+
+    m_floodCount += 1;
+    m_totalCellsVisited += m_floodCellsVisited;
+    m_totalCellsRelaxed += m_floodCellsRelaxed;
+}
+
+void FloodFill::floodIterative(int x, int y) {
+
+    // This computes the same distance values as floodRecursive, but rather
+    // than recursing into every open neighbor of every cell that changes
+    // (which revisits the same cells many times over, and can run deep
+    // enough to exhaust the stack), each cell is kept in the worklist at most
+    // once. The worklist is a fixed size ring buffer, so nothing is allocated.
+    int capacity = MAZE_SIZE_X*MAZE_SIZE_Y;
+    int head = 0;
+    int size = 0;
+
+    m_floodQueue[0] = &m_cells[x][y];
+    m_floodQueued[x][y] = true;
+    size += 1;
+
+    while (size > 0) {
+
+        Cell* cell = m_floodQueue[head];
+        head = (head + 1) % capacity;
+        size -= 1;
+        m_floodQueued[cell->getX()][cell->getY()] = false;
+
+        // *DO NOT* flood the cells in the goal region (see floodRecursive)
+        if (inGoal(cell->getX(), cell->getY())) {
+            continue;
+        }
+
+        m_floodCellsVisited += 1;
+
+        // Find the smallest distance value of the reachable neighbors
+        int minDistance = MAZE_SIZE_X*MAZE_SIZE_Y;
+        for (int direction = NORTH; direction <= WEST; direction += 1) {
+            if (!cell->isWall(direction)) {
+                int distance = getNeighboringCell(cell, direction)->getDistance();
+                if (distance < minDistance) {
+                    minDistance = distance;
+                }
+            }
+        }
+
+        // If the distance value isn't the min plus one, fix it and then
+        // revisit each reachable neighbor, since their values may depend on it
+        if (cell->getDistance() != minDistance + 1) {
+            cell->setDistance(minDistance + 1);
+            m_floodCellsRelaxed += 1;
+            for (int direction = NORTH; direction <= WEST; direction += 1) {
+                if (!cell->isWall(direction)) {
+                    Cell* neighbor = getNeighboringCell(cell, direction);
+                    if (!m_floodQueued[neighbor->getX()][neighbor->getY()]) {
+                        m_floodQueue[(head + size) % capacity] = neighbor;
+                        m_floodQueued[neighbor->getX()][neighbor->getY()] = true;
+                        size += 1;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void FloodFill::floodRecursive(int x, int y) {
     
     // *DO NOT* flood the cells in the goal region of the maze - there is no
     // information that we can gain about the distance values in the goal,
@@ -368,6 +527,8 @@ void FloodFill::flood(int x, int y) {
     // can't and shouldn't change from 0)
     if (!inGoal(x, y)) {
 
+        m_floodCellsVisited += 1;
+
         // Initialize distance values for surrounding cells
         int northDistance = MAZE_SIZE_X*MAZE_SIZE_Y;
         int eastDistance = MAZE_SIZE_X*MAZE_SIZE_Y;
@@ -393,23 +554,76 @@ void FloodFill::flood(int x, int y) {
 
             // Set the value to the min plus one
             m_cells[x][y].setDistance(min(northDistance, eastDistance, southDistance, westDistance) + 1);
+            m_floodCellsRelaxed += 1;
 
             if (!m_cells[x][y].isWall(NORTH)) {
-                flood(x, y + 1);
+                floodRecursive(x, y + 1);
             }
             if (!m_cells[x][y].isWall(EAST)) {
-                flood(x + 1, y);
+                floodRecursive(x + 1, y);
             }
             if (!m_cells[x][y].isWall(SOUTH)) {
-                flood(x, y - 1);
+                floodRecursive(x, y - 1);
             }
             if (!m_cells[x][y].isWall(WEST)) {
-                flood(x - 1, y);
+                floodRecursive(x - 1, y);
             }
         }
     }
 }
 
+void FloodFill::compareFloods(int x, int y) {
+
+    // Save the distance values, so that both floods start from the same state
+    int before[MAZE_SIZE_X][MAZE_SIZE_Y];
+    int after[MAZE_SIZE_X][MAZE_SIZE_Y];
+    for (int i = 0; i < MAZE_SIZE_X; i += 1) {
+        for (int j = 0; j < MAZE_SIZE_Y; j += 1) {
+            before[i][j] = m_cells[i][j].getDistance();
+        }
+    }
+
+    // Run the recursive flood, and save its results
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    floodRecursive(x, y);
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    long recursiveNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    int recursiveVisited = m_floodCellsVisited;
+    int recursiveRelaxed = m_floodCellsRelaxed;
+    for (int i = 0; i < MAZE_SIZE_X; i += 1) {
+        for (int j = 0; j < MAZE_SIZE_Y; j += 1) {
+            after[i][j] = m_cells[i][j].getDistance();
+            m_cells[i][j].setDistance(before[i][j]);
+        }
+    }
+
+    // Run the iterative flood from the same starting state
+    m_floodCellsVisited = 0;
+    m_floodCellsRelaxed = 0;
+    start = std::chrono::steady_clock::now();
+    floodIterative(x, y);
+    end = std::chrono::steady_clock::now();
+    long iterativeNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    // Ensure that both floods produced the same distance values
+    bool same = true;
+    for (int i = 0; i < MAZE_SIZE_X; i += 1) {
+        for (int j = 0; j < MAZE_SIZE_Y; j += 1) {
+            if (m_cells[i][j].getDistance() != after[i][j]) {
+                same = false;
+            }
+        }
+    }
+
+    std::cout << "Flood " << m_floodCount << " from (" << x << ", " << y << "):"
+              << " recursive visited " << recursiveVisited
+              << " relaxed " << recursiveRelaxed
+              << " in " << recursiveNanoseconds << "ns,"
+              << " iterative visited " << m_floodCellsVisited
+              << " relaxed " << m_floodCellsRelaxed
+              << " in " << iterativeNanoseconds << "ns"
+              << (same ? "" : " - DISTANCES DIFFER") << std::endl;
+}
 
 void FloodFill::moveTowardsGoal() {
     
@@ -669,6 +883,20 @@ bool FloodFill::spaceRight() {
     }
 }
 
+Cell* FloodFill::getNeighboringCell(Cell* cell, int direction) {
+    switch (direction) {
+        case NORTH:
+            return &m_cells[cell->getX()][cell->getY()+1];
+        case EAST:
+            return &m_cells[cell->getX()+1][cell->getY()];
+        case SOUTH:
+            return &m_cells[cell->getX()][cell->getY()-1];
+        case WEST:
+            return &m_cells[cell->getX()-1][cell->getY()];
+    }
+    return NULL;
+}
+
 void FloodFill::explore() {
 
    /*
@@ -707,7 +935,7 @@ void FloodFill::explore() {
     */
 
     // Push unexplored nodes onto a stack
-    std::stack<Cell*> unexplored;
+    CellStack unexplored(&m_stackArena);
 
     // The initial square is at (0, 0)
     unexplored.push(&m_cells[0][0]);
@@ -1003,13 +1231,13 @@ void FloodFill::moveOneCell(Cell* target) {
     }
 }
 
-void FloodFill::doUpdatesForCurrentCell(std::stack<Cell*>* unexplored) {
+void FloodFill::doUpdatesForCurrentCell(CellStack* unexplored) {
 
-    // List of cellmod objects for all cell modifications performed at this step
-    std::list<Cellmod> modifiedCells;
+    // Begin the list of all cell modifications performed at this step
+    m_history.startModifiedCells();
 
     // We need to keep track of the old values for the modified cell before we update it.
-    appendModifiedCell(&modifiedCells, &m_cells[m_x][m_y]);
+    m_history.appendModifiedCell(&m_cells[m_x][m_y]);
 
     // Once we're in the correct Cells, we can now examine the contents of the
     // target and update our walls and distances
@@ -1030,7 +1258,7 @@ void FloodFill::doUpdatesForCurrentCell(std::stack<Cell*>* unexplored) {
     if (!m_mouse->wallLeft() && getLeftCell()->getPrev() == NULL) {
 
         // We need to keep track of the old values for the modified cell before we update it.
-        appendModifiedCell(&modifiedCells, getLeftCell());
+        m_history.appendModifiedCell(getLeftCell());
 
         unexploredNeighbors.push_back(getLeftCell());
         getLeftCell()->setPrev(&m_cells[m_x][m_y]);
@@ -1038,7 +1266,7 @@ void FloodFill::doUpdatesForCurrentCell(std::stack<Cell*>* unexplored) {
     if (!m_mouse->wallRight() && getRightCell()->getPrev() == NULL) {
 
         // We need to keep track of the old values for the modified cell before we update it.
-        appendModifiedCell(&modifiedCells, getRightCell());
+        m_history.appendModifiedCell(getRightCell());
 
         unexploredNeighbors.push_back(getRightCell());
         getRightCell()->setPrev(&m_cells[m_x][m_y]);
@@ -1046,7 +1274,7 @@ void FloodFill::doUpdatesForCurrentCell(std::stack<Cell*>* unexplored) {
     if (!m_mouse->wallFront() && getFrontCell()->getPrev() == NULL) {
 
         // We need to keep track of the old values for the modified cell before we update it.
-        appendModifiedCell(&modifiedCells, getFrontCell());
+        m_history.appendModifiedCell(getFrontCell());
 
         unexploredNeighbors.push_back(getFrontCell());
         getFrontCell()->setPrev(&m_cells[m_x][m_y]);
@@ -1097,9 +1325,8 @@ void FloodFill::doUpdatesForCurrentCell(std::stack<Cell*>* unexplored) {
         }
     }
             
-    // Update the History target stack and modified cells
+    // Update the History target stack
     m_history.stackUpdate(*unexplored);
-    m_history.modifiedCellsUpdate(modifiedCells);
 }
 
 bool FloodFill::isOneCellAway(Cell* target) {
@@ -1499,21 +1726,6 @@ bool FloodFill::proceedToCheckpoint(std::stack<Cell*> path) {
     return false;
 }
 
-void FloodFill::appendModifiedCell(std::list<Cellmod>* modList, Cell* modCell) {
-
-    Cellmod cm;
-    cm.cell = modCell;
-    cm.oldDist = modCell->getDistance();
-    cm.oldPrev = modCell->getPrev();
-    cm.oldExplored = modCell->getExplored(); // Note: I don't think this is necessary
-    cm.oldTraversed = modCell->getTraversed(); // Note: I don't think this is necessary
-    for (int i = 0; i < 4; i += 1) {
-        cm.oldWalls[i] = modCell->isWall(i);
-        cm.oldWallsInspected[i] = modCell->getWallInspected(i);
-    }
-    modList->push_back(cm);
-}
-
 bool FloodFill::checkRequestVictory() {
 
     // If a request has been made, perform appropriately. Since the maze has already
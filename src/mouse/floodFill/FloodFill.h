@@ -1,10 +1,12 @@
 #pragma once
 
+#include <functional>
 #include <list>
 
 #include "../IMouseAlgorithm.h"
 #include "Cell.h"
 #include "Cellmod.h"
+#include "CellStack.h"
 #include "History.h"
 #include "SimpleCellmod.h"
 
@@ -15,6 +17,7 @@ static const int MAZE_SIZE_X = 16; // Length of X axis of maze
 static const int MAZE_SIZE_Y = 16; // Length of Y axis of maze
 static const int SHORT_TERM_MEM = 8; // Steps that are forgetten by the mouse after an error
 static const bool ALGO_COMPARE = false; // Whether or not we're comparing the solving algorithms
+static const bool FLOOD_COMPARE = false; // Whether or not we're comparing the recursive and iterative floods
 enum {NORTH = 0, EAST = 1, SOUTH = 2, WEST = 3};
 
 class FloodFill : public IMouseAlgorithm {
@@ -25,6 +28,20 @@ public:
         int mazeWidth, int mazeHeight, bool isOfficialMaze,
         char initialDirection, sim::MouseInterface* mouse);
 
+    // Reveals the walls of the maze, given by isWall(x, y, direction), one
+    // cell at a time, in the order that a depth-first exploration from the
+    // origin reaches them, and floods after each cell, with either flood.
+    // This is how the benchmarks (see src/bench) time the floods on their own.
+    void replayFloods(
+        sim::MouseInterface* mouse,
+        const std::function<bool(int, int, int)>& isWall,
+        bool recursive);
+
+    // The flood counters, since the most recent initialization
+    int getFloodCount() const;
+    long getTotalCellsVisited() const;
+    long getTotalCellsRelaxed() const;
+
 private:
     sim::MouseInterface* m_mouse; // A pointer to the mouse interface
     Cell m_cells[MAZE_SIZE_X][MAZE_SIZE_Y]; // Grid a cells to store maze information
@@ -35,8 +52,24 @@ private:
     bool m_centerReached; // Whether or not the mouse has reached the center at least once
     bool m_explored; // Whether or not the explore method was has completed
     History m_history; // History object used for undos
+    CellStack::Arena m_stackArena; // Storage shared by the unexplored stack and its checkpoints
     bool m_checkpointReached; // Whether or not we've made it back to the checkpoint
 
+    // Worklist used by flood, with one slot per cell, since each cell is in
+    // the worklist at most once at any given time. Each cell's flag is cleared
+    // as it leaves the worklist, so the flags are all false between floods.
+    Cell* m_floodQueue[MAZE_SIZE_X*MAZE_SIZE_Y];
+    bool m_floodQueued[MAZE_SIZE_X][MAZE_SIZE_Y];
+
+    // Counters for the floods, each of which follows a wall discovery. A cell
+    // is "visited" when its neighbors are inspected, and "relaxed" when its
+    // distance value actually changes as a result.
+    int m_floodCount; // Number of floods since initialization
+    int m_floodCellsVisited; // Cells visited by the most recent flood
+    int m_floodCellsRelaxed; // Cells relaxed by the most recent flood
+    long m_totalCellsVisited; // Cells visited by all floods since initialization
+    long m_totalCellsRelaxed; // Cells relaxed by all floods since initialization
+
     void justFloodFill(); // Vanilla Floodfill algo
     void simpleSolve(); // Solves using basic floodfill (not perfect)
     void extensiveSolve(); // Solves using explore (guaranteed perfect)
@@ -45,6 +78,7 @@ private:
     void printWalls(); // Prints the wall values of the cells in the maze
     void resetColors(); // Resets the colors to the maze through the MouseInterface
 
+    void initializeCells(); // Sets the positions and mouse interface of the Cells
     void initialize(); // Initialize all mutable fields, including the Cells' walls
                        // and distances, as well as the mouse-related fields. This 
                        // should only be called when the mouse is actually in the
@@ -55,6 +89,9 @@ private:
     void walls(); // Updates the walls surrounding the robot
     void checkDeadEnd(Cell* cell); // Deduces fourth wall value, if possible
     void flood(int x, int y); // Floods the maze corresponding to new walls
+    void floodIterative(int x, int y); // Worklist flood, touching only cells whose distance changes
+    void floodRecursive(int x, int y); // The original recursive flood, kept for comparison
+    void compareFloods(int x, int y); // Times both floods from the same state and checks they agree
     void moveTowardsGoal(); // Moves the mouse one step towards the goal (lower distance value)
     bool inGoal(int x, int y); // Returns true if the cell at (x, y) is in the center
 
@@ -70,6 +107,7 @@ private:
     bool spaceFront(); // Returns true if there's a cell in front of the mouse
     bool spaceLeft(); // Returns true if there's a cell to the left of the mouse
     bool spaceRight(); // Returns true if there's a cell to the right of the mouse
+    Cell* getNeighboringCell(Cell* cell, int direction); // Returns the cell adjacent to cell in direction
     int min(int one, int two, int three, int four); // Returns the min of four ints
     char directionToChar(int direction); // Converts 0123 to nesw
 
@@ -104,7 +142,7 @@ private:
 
     // Updates all values for the Cell that the mouse is currently in. Additionally
     // updates the history and the current stack of unexplored Cells
-    void doUpdatesForCurrentCell(std::stack<Cell*>* unexplored);
+    void doUpdatesForCurrentCell(CellStack* unexplored);
 
     // Returns whether or not the location is one cell away
     bool isOneCellAway(Cell* target);
@@ -116,9 +154,6 @@ private:
 
     // -------------------- Explore Request Utilities ----------------------- //
 
-    // Appends a newly modified cell to the modified cells list for each step in the algo
-    void appendModifiedCell(std::list<Cellmod>* modList, Cell* cell);
-
     // Moves to the checkpoint and updates cell values along the way. Returns true if either
     // a reset or undo request was made during the movement, false otherwise
     bool proceedToCheckpoint(std::stack<Cell*> path);
@@ -4,32 +4,23 @@
 
 namespace floodFill {
 
-void History::initialize(int stm, Cell* origin) {
+void History::initialize(int stm, const CellStack& originStack) {
 
     // Set the short term memory
     m_stm = stm;
 
     // Erase any left-over data
     m_size = 0;
-    while (!m_stacks.empty()) {
-        m_stacks.pop();
-    }
-    while (!m_stackReferenceCounts.empty()) {
-        m_stackReferenceCounts.pop_front();
-    }
-    while (!m_modifiedCells.empty()) {
-        m_modifiedCells.pop_front();
-    }
+    m_stacks.clear();
+    m_modifiedCells.clear();
+    m_steps.clear();
 
     // Push the stack [(0,0)] since (0,0) or is *always* our first target
-    std::stack<Cell*> temp;
-    temp.push(origin);
-    m_stacks.push(temp);
-    m_stackReferenceCounts.push_back(1);
+    m_stacks.push_back(std::make_pair(originStack, 1));
 
     // Set the checkpoint values
-    m_checkpointCell = origin;
-    m_checkpointStack = temp;
+    m_checkpointCell = originStack.top();
+    m_checkpointStack = originStack;
 }
 
 Cell* History::getCheckpointCell() {
@@ -63,7 +54,7 @@ std::stack<Cell*> History::getCheckpointPath() {
     return path;
 }
 
-std::stack<Cell*> History::getCheckpointStack() {
+CellStack History::getCheckpointStack() {
 
     return m_checkpointStack;
 }
@@ -72,38 +63,30 @@ void History::moved() {
 
     m_size++;
 
-    // Assertion - Neither m_stacks nor m_stackReferenceCounts should ever be empty
-    if (m_stackReferenceCounts.empty() || m_stacks.empty()) {
+    // Assertion - m_stacks should never be empty
+    if (m_stacks.empty()) {
         std::cout << "Error - History object has zero stack references" << std::endl;
         exit(0);
     }
 
     // Increment our stack reference counts
-    int srefCount = m_stackReferenceCounts.back();
-    m_stackReferenceCounts.pop_back();
-    m_stackReferenceCounts.push_back(srefCount+1);
+    m_stacks.back().second += 1;
 
-    // Every move we push an empty list onto the list of lists of modified cells
-    std::list<Cellmod> empty;
-    m_modifiedCells.push_front(empty);
+    // Every move we begin a new, empty step of modified cells
+    m_steps.push_back(m_modifiedCells.size());
 
     // If the size of the path is larger than our short term memory (which it needn't
     // be) then reduce the reference counts and pop the appropriate number of things
     // off of the stacks.
     if (m_size > m_stm) {
-
         m_size -= 1;
-
-        int srefCount2 = m_stackReferenceCounts.front();
-        m_stackReferenceCounts.pop_front();
-        m_stackReferenceCounts.push_front(srefCount2-1);
+        m_stacks.front().second -= 1;
     }
-    if (m_stackReferenceCounts.front() == 0) {
-        m_stackReferenceCounts.pop_front();
-        m_stacks.pop();
-        m_checkpointStack = m_stacks.front();
-        if (m_stacks.front().top()->getPrev() != NULL) {
-            m_checkpointCell = m_stacks.front().top()->getPrev();
+    if (m_stacks.front().second == 0) {
+        m_stacks.pop_front();
+        m_checkpointStack = m_stacks.front().first;
+        if (m_checkpointStack.top()->getPrev() != NULL) {
+            m_checkpointCell = m_checkpointStack.top()->getPrev();
         }
         else {
             std::cout << "Error - checkpoint has NULL prev Cell" << std::endl;
@@ -112,15 +95,25 @@ void History::moved() {
     }
 
     // Also make sure to only keep the correct number of modified cells
-    if (m_modifiedCells.size() > m_stm) {
-        m_modifiedCells.pop_back();
+    if (m_steps.size() > m_stm) {
+        m_steps.pop_front();
+
+        // Drop the forgotten steps once they make up half of the log, so that
+        // the log stays small while each modification is moved at most once
+        int forgotten = m_steps.front();
+        if (2 * forgotten >= m_modifiedCells.size()) {
+            m_modifiedCells.erase(m_modifiedCells.begin(), m_modifiedCells.begin() + forgotten);
+            for (int i = 0; i < m_steps.size(); i += 1) {
+                m_steps.at(i) -= forgotten;
+            }
+        }
     }
 }
 
-void History::stackUpdate(std::stack<Cell*> newStack) {
+void History::stackUpdate(const CellStack& newStack) {
 
-    // Assertion - Neither m_stacks nor m_stackReferenceCounts should ever be empty
-    if (m_stackReferenceCounts.empty() || m_stacks.empty()) {
+    // Assertion - m_stacks should never be empty
+    if (m_stacks.empty()) {
         std::cout << "Error - History object has zero stack references" << std::endl;
         exit(0);
     }
@@ -128,65 +121,64 @@ void History::stackUpdate(std::stack<Cell*> newStack) {
     // When we perform the stack update, it's always after a cell has been pushed
     // to the path queue. However, in pushing the new Cell, we incremented the
     // reference count for that particular stack. Thus we need to decrement it
-    // and then push the proper stack on m_stacks, as well as a reference count
-    // of 1 for the new stack on the stack reference count queue
-    m_stacks.push(newStack);
-
-    int temp = m_stackReferenceCounts.back();
-    m_stackReferenceCounts.pop_back();
-    m_stackReferenceCounts.push_back(temp-1);
-    m_stackReferenceCounts.push_back(1);
+    // and then push the proper stack on m_stacks, with a reference count of 1
+    m_stacks.back().second -= 1;
+    m_stacks.push_back(std::make_pair(newStack, 1));
 }
 
-void History::modifiedCellsUpdate(std::list<Cellmod> cells) {
+void History::startModifiedCells() {
 
-    // The only situation when this list will be empty is immediately after
+    // The only situation when there are no steps is immediately after
     // returning to the origin after undo is called. This is because the checkpoint
     // stack will contain the origin, and thus won't move from the origin to get to
     // the target (the origin) but WILL perform the appropriate updates.
-    if (m_modifiedCells.size() > 0) {
-        m_modifiedCells.pop_front();
+    if (m_steps.empty()) {
+        m_steps.push_back(m_modifiedCells.size());
+    }
+    else {
+        m_modifiedCells.erase(m_modifiedCells.begin() + m_steps.back(), m_modifiedCells.end());
     }
-    m_modifiedCells.push_front(cells);
 }
 
-void History::resetModifiedCells() {
-
-    std::list<std::list<Cellmod>> temp = m_modifiedCells;
-
-    // Iterate through all modified cells, starting with most recent and going
-    // to least recent. During iterations, we simply restore the old values
-    while (!temp.empty()) {
+void History::appendModifiedCell(Cell* cell) {
+
+    Cellmod cm;
+    cm.cell = cell;
+    cm.oldDist = cell->getDistance();
+    cm.oldPrev = cell->getPrev();
+    cm.oldExplored = cell->getExplored(); // Note: I don't think this is necessary
+    cm.oldTraversed = cell->getTraversed(); // Note: I don't think this is necessary
+    for (int i = 0; i < 4; i += 1) {
+        cm.oldWalls[i] = cell->isWall(i);
+        cm.oldWallsInspected[i] = cell->getWallInspected(i);
+    }
+    m_modifiedCells.push_back(cm);
+}
 
-        std::list<Cellmod> cellList = temp.front();
-        temp.pop_front();
+void History::resetModifiedCells() {
 
-        for (std::list<Cellmod>::iterator it = cellList.begin(); it != cellList.end() ; ++it) {
-            (*it).cell->setPrev((*it).oldPrev);
-            (*it).cell->setDistance((*it).oldDist);
-            (*it).cell->setExplored((*it).oldExplored);
-            (*it).cell->setTraversed((*it).oldTraversed);
-            for (int i = 0; i < 4; i += 1) {
-                (*it).cell->setWall(i, (*it).oldWalls[i]);
-                (*it).cell->setWallInspected(i, (*it).oldWallsInspected[i]);
-            }
+    // Iterate through all remembered modifications, starting with the most
+    // recent and going to the least recent, simply restoring the old values
+    int oldest = m_steps.empty() ? m_modifiedCells.size() : m_steps.front();
+    for (int i = m_modifiedCells.size() - 1; i >= oldest; i -= 1) {
+        const Cellmod& cm = m_modifiedCells.at(i);
+        cm.cell->setPrev(cm.oldPrev);
+        cm.cell->setDistance(cm.oldDist);
+        cm.cell->setExplored(cm.oldExplored);
+        cm.cell->setTraversed(cm.oldTraversed);
+        for (int j = 0; j < 4; j += 1) {
+            cm.cell->setWall(j, cm.oldWalls[j]);
+            cm.cell->setWallInspected(j, cm.oldWallsInspected[j]);
         }
     }
 
     // After we get a new checkpoint, we empty everything
     m_size = 0;
-    while (!m_stacks.empty()) {
-        m_stacks.pop();
-    }
-    while (!m_stackReferenceCounts.empty()) {
-        m_stackReferenceCounts.pop_front();
-    }
-    while (!m_modifiedCells.empty()) {
-        m_modifiedCells.pop_front();
-    }
+    m_stacks.clear();
+    m_modifiedCells.clear();
+    m_steps.clear();
 
-    m_stacks.push(m_checkpointStack);
-    m_stackReferenceCounts.push_back(1);
+    m_stacks.push_back(std::make_pair(m_checkpointStack, 1));
 }
 
 } // namespace floodFill
@@ -1,12 +1,13 @@
 #pragma once
 
-#include <list>
-#include <queue>
+#include <deque>
 #include <stack>
 #include <utility>
+#include <vector>
 
 #include "Cell.h"
 #include "Cellmod.h"
+#include "CellStack.h"
 
 namespace floodFill {
 
@@ -14,18 +15,23 @@ class History {
 
 public:
 
-    // Set the history object for the origin
-    void initialize(int stm, Cell* origin);
+    // Set the history object for the origin, given the stack [origin]
+    void initialize(int stm, const CellStack& originStack);
 
     // Checkpoint accessors
     Cell* getCheckpointCell(); // Returns a pointer the checkpoint cell
-    std::stack<Cell*> getCheckpointStack(); // Returns the stack that was present at the most recent checkpoint
+    CellStack getCheckpointStack(); // Returns the stack that was present at the most recent checkpoint
     std::stack<Cell*> getCheckpointPath(); // Returns the path to the checkpoint cell
 
     // Called by Floodfill to update the history object
     void moved();
-    void stackUpdate(std::stack<Cell*> newStack);
-    void modifiedCellsUpdate(std::list<Cellmod> cells);
+    void stackUpdate(const CellStack& newStack);
+
+    // Called by Floodfill before modifying a cell, so that the modification can
+    // be undone; startModifiedCells() discards any cells already recorded for
+    // the current step, and must be called before the first appendModifiedCell()
+    void startModifiedCells();
+    void appendModifiedCell(Cell* cell);
 
     // Resets the modifications to each of the cells stored in short term mem
     void resetModifiedCells();
@@ -40,16 +46,20 @@ private:
 
     // Checkpoint objects
     Cell* m_checkpointCell;
-    std::stack<Cell*> m_checkpointStack;
+    CellStack m_checkpointStack;
 
-    // Queue of stacks for explore
-    std::queue<std::stack<Cell*>> m_stacks;
+    // Queue of stacks for explore, oldest first, each paired with the number
+    // of steps that reference it. Since the stacks are persistent, each entry
+    // costs O(1) regardless of the depth of the stack.
+    std::deque<std::pair<CellStack, int>> m_stacks;
 
-    // Queue of ints counting the references for each stack in m_stacks
-    std::list<int> m_stackReferenceCounts;
+    // Log of the cell modification objects for every step, oldest first. The
+    // log is only appended to, except that forgotten steps are dropped from
+    // the front once they make up at least half of it.
+    std::vector<Cellmod> m_modifiedCells;
 
-    // List of List of cell modification objects for each step.
-    std::list<std::list<Cellmod>> m_modifiedCells;
+    // The offsets into m_modifiedCells at which each remembered step begins
+    std::deque<int> m_steps;
 };
 
 } // namespace floodFill
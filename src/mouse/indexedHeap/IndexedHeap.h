@@ -0,0 +1,187 @@
+#pragma once
+
+#include <assert.h>
+
+namespace indexedHeap {
+
+// A d-ary min-heap that tracks the position of each of its items, so that an
+// item whose key has decreased can be moved up in O(log n), rather than being
+// searched for or pushed a second time. The heap never allocates, so that it
+// can be used by the embedded algorithms as well: the caller provides storage
+// for the items, along with a traits object of the form
+//
+//     struct Traits {
+//         typedef ... Item; // Cheap to copy and compare, e.g., a cell index or pointer
+//         typedef ... Index; // An integer type that can hold the capacity
+//         bool less(Item one, Item two) const; // Whether one's key is smaller
+//         Index getPosition(Item item) const;
+//         void setPosition(Item item, Index position);
+//     };
+//
+// The keys and positions live wherever the traits put them (usually with the
+// rest of the per-cell data), and positions needn't be initialized, since the
+// heap checks that an item is actually at its position before trusting it.
+// To decrease a key, update it where the traits can see it, then call
+// decrease(). Four children per node tends to be fastest for our searches,
+// since sifting down dominates and the children share a cache line.
+template<class Traits, int ARITY = 4>
+class IndexedHeap {
+
+public:
+
+    typedef typename Traits::Item Item;
+    typedef typename Traits::Index Index;
+
+    IndexedHeap(Item* storage, Index capacity, const Traits& traits = Traits());
+
+    Index size() const;
+    bool empty() const;
+    bool contains(Item item) const;
+
+    // Returns, or removes and returns, the item with the smallest key
+    Item top() const;
+    Item pop();
+
+    // Adds an item that isn't already in the heap
+    void push(Item item);
+
+    // Restores the heap order after the key of an item in the heap decreased
+    void decrease(Item item);
+
+    // Either pushes the item, or restores the order after its key decreased
+    void pushOrDecrease(Item item);
+
+    void clear();
+
+private:
+
+    Item* m_items;
+    Index m_capacity;
+    Index m_size;
+    Traits m_traits;
+
+    // Moves the item from the hole at position towards the root or the
+    // leaves, shifting the items that it passes into the hole as it goes
+    void siftUp(unsigned long position, Item item);
+    void siftDown(unsigned long position, Item item);
+
+    // Stores the item at the position, and tells the traits where it is
+    void place(unsigned long position, Item item);
+};
+
+template<class Traits, int ARITY>
+IndexedHeap<Traits, ARITY>::IndexedHeap(Item* storage, Index capacity, const Traits& traits) :
+        m_items(storage),
+        m_capacity(capacity),
+        m_size(0),
+        m_traits(traits) {
+}
+
+template<class Traits, int ARITY>
+typename IndexedHeap<Traits, ARITY>::Index IndexedHeap<Traits, ARITY>::size() const {
+    return m_size;
+}
+
+template<class Traits, int ARITY>
+bool IndexedHeap<Traits, ARITY>::empty() const {
+    return m_size == 0;
+}
+
+template<class Traits, int ARITY>
+bool IndexedHeap<Traits, ARITY>::contains(Item item) const {
+    // A stale (or negative) position is either out of range, or the position
+    // of some other item; the cast makes negative positions out of range
+    unsigned long position = static_cast<unsigned long>(m_traits.getPosition(item));
+    return position < static_cast<unsigned long>(m_size) && m_items[position] == item;
+}
+
+template<class Traits, int ARITY>
+typename IndexedHeap<Traits, ARITY>::Item IndexedHeap<Traits, ARITY>::top() const {
+    assert(0 < m_size);
+    return m_items[0];
+}
+
+template<class Traits, int ARITY>
+typename IndexedHeap<Traits, ARITY>::Item IndexedHeap<Traits, ARITY>::pop() {
+    assert(0 < m_size);
+    Item item = m_items[0];
+    m_size -= 1;
+    if (0 < m_size) {
+        siftDown(0, m_items[m_size]);
+    }
+    return item;
+}
+
+template<class Traits, int ARITY>
+void IndexedHeap<Traits, ARITY>::push(Item item) {
+    assert(m_size < m_capacity);
+    assert(!contains(item));
+    m_size += 1;
+    siftUp(m_size - 1, item);
+}
+
+template<class Traits, int ARITY>
+void IndexedHeap<Traits, ARITY>::decrease(Item item) {
+    assert(contains(item));
+    siftUp(m_traits.getPosition(item), item);
+}
+
+template<class Traits, int ARITY>
+void IndexedHeap<Traits, ARITY>::pushOrDecrease(Item item) {
+    if (contains(item)) {
+        decrease(item);
+    }
+    else {
+        push(item);
+    }
+}
+
+template<class Traits, int ARITY>
+void IndexedHeap<Traits, ARITY>::clear() {
+    m_size = 0;
+}
+
+template<class Traits, int ARITY>
+void IndexedHeap<Traits, ARITY>::siftUp(unsigned long position, Item item) {
+    while (0 < position) {
+        unsigned long parent = (position - 1) / ARITY;
+        if (!m_traits.less(item, m_items[parent])) {
+            break;
+        }
+        place(position, m_items[parent]);
+        position = parent;
+    }
+    place(position, item);
+}
+
+template<class Traits, int ARITY>
+void IndexedHeap<Traits, ARITY>::siftDown(unsigned long position, Item item) {
+    unsigned long size = static_cast<unsigned long>(m_size);
+    while (true) {
+        unsigned long first = position * ARITY + 1;
+        if (size <= first) {
+            break;
+        }
+        unsigned long last = (first + ARITY < size ? first + ARITY : size);
+        unsigned long min = first;
+        for (unsigned long child = first + 1; child < last; child += 1) {
+            if (m_traits.less(m_items[child], m_items[min])) {
+                min = child;
+            }
+        }
+        if (!m_traits.less(m_items[min], item)) {
+            break;
+        }
+        place(position, m_items[min]);
+        position = min;
+    }
+    place(position, item);
+}
+
+template<class Traits, int ARITY>
+void IndexedHeap<Traits, ARITY>::place(unsigned long position, Item item) {
+    m_items[position] = item;
+    m_traits.setPosition(item, static_cast<Index>(position));
+}
+
+} // namespace indexedHeap
@@ -10,7 +10,8 @@ Cell::Cell() :
         m_parent(0),
         m_sourceDirection(0),
         m_distance(0),
-        m_examined(false) {
+        m_examined(false),
+        m_heapPosition(-1) {
 
     for (int i = 0; i < 4; i += 1) {
         m_walls[i] = false;
@@ -93,7 +94,7 @@ float Cell::getDistance() const {
 
 void Cell::setDistance(float distance) {
     m_distance = distance;
-    m_mouse->setTileText(m_x, m_y, std::to_string(distance));
+    m_mouse->setTileText(m_x, m_y, QString::number(distance));
 }
 
 bool Cell::getExamined() const {
@@ -104,4 +105,12 @@ void Cell::setExamined(bool examined) {
     m_examined = examined;
 }
 
+int Cell::getHeapPosition() const {
+    return m_heapPosition;
+}
+
+void Cell::setHeapPosition(int heapPosition) {
+    m_heapPosition = heapPosition;
+}
+
 } // namespace mackAlgo
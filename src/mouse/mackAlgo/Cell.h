@@ -41,6 +41,9 @@ public:
     bool getExamined() const;
     void setExamined(bool examined);
 
+    int getHeapPosition() const;
+    void setHeapPosition(int heapPosition);
+
 private:
     sim::MouseInterface* m_mouse;
     int m_x;
@@ -55,6 +58,7 @@ private:
     int m_straightAwayLength;
     float m_distance;
     bool m_examined;
+    int m_heapPosition;
 
 };
 
@@ -1,40 +1,33 @@
 #pragma once
 
-namespace mackAlgo {
-
-class Cell;
-
-class CellHeap {
-
-static const int DEFAULT_CAPACITY = 16;
+#include "../indexedHeap/IndexedHeap.h"
 
-public:
-    CellHeap();
-    CellHeap(const CellHeap& other);
-    void operator=(const CellHeap& other);
-    ~CellHeap();
+#include "Cell.h"
 
-    int size() const;
-    int capacity() const;
-    Cell* get(int index) const;
+namespace mackAlgo {
 
-    Cell* pop();
-    void push(Cell* cell);
+// The traits (see IndexedHeap.h) of the heap used by Dijkstra's algo, which
+// orders cells by their distance and keeps their positions in the cells
+struct CellHeapTraits {
+    typedef Cell* Item;
+    typedef int Index;
+    bool less(Cell* one, Cell* two) const;
+    int getPosition(Cell* cell) const;
+    void setPosition(Cell* cell, int position);
+};
 
-private:
-    int m_size;
-    int m_capacity;
-    Cell** m_data;
+typedef indexedHeap::IndexedHeap<CellHeapTraits> CellHeap;
 
-    void increaseCapacity();
+inline bool CellHeapTraits::less(Cell* one, Cell* two) const {
+    return one->getDistance() < two->getDistance();
+}
 
-    int getParentIndex(int index); 
-    int getLeftChildIndex(int index); 
-    int getRightChildIndex(int index); 
+inline int CellHeapTraits::getPosition(Cell* cell) const {
+    return cell->getHeapPosition();
+}
 
-    void swap(int indexOne, int indexTwo);
-    void heapifyUp(int index);
-    void heapifyDown(int index);
-};
+inline void CellHeapTraits::setPosition(Cell* cell, int position) {
+    cell->setHeapPosition(position);
+}
 
 } // namespace mackAlgo
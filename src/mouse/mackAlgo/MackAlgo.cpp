@@ -106,7 +106,7 @@ bool MackAlgo::move() {
     source->setDistance(0);
     initializeDestinationDistance();
 
-    CellHeap heap;
+    CellHeap heap(m_heapItems, MAZE_WIDTH * MAZE_HEIGHT);
     heap.push(source);
     while (heap.size() > 0) {
 
@@ -143,7 +143,7 @@ bool MackAlgo::move() {
                 }
                 if (neighbor->getSequenceNumber() != current->getSequenceNumber() || !neighbor->getExamined()) {
                     if (inspectNeighbor(current, neighbor, direction)) {
-                        heap.push(neighbor);
+                        heap.pushOrDecrease(neighbor);
                     }
                 }
             }
@@ -224,7 +224,8 @@ float MackAlgo::getStraightAwayCost(int length) {
 
 bool MackAlgo::inspectNeighbor(Cell* current, Cell* neighbor, int direction) {
 
-    bool pushToHeap = false;
+    // Whether or not the neighbor was discovered, or its distance decreased
+    bool updated = false;
 
     // Determine the cost if routed through the currect node
     float costToNeighbor = current->getDistance();
@@ -239,9 +240,9 @@ bool MackAlgo::inspectNeighbor(Cell* current, Cell* neighbor, int direction) {
     if (neighbor->getSequenceNumber() != current->getSequenceNumber() || costToNeighbor < neighbor->getDistance()) {
         if (neighbor->getSequenceNumber() != current->getSequenceNumber()) {
             neighbor->setSequenceNumber(current->getSequenceNumber());
-            pushToHeap = true;
             neighbor->setExamined(false);
         }
+        updated = true;
         neighbor->setParent(current);
         neighbor->setDistance(costToNeighbor);
         neighbor->setSourceDirection(direction);
@@ -253,7 +254,7 @@ bool MackAlgo::inspectNeighbor(Cell* current, Cell* neighbor, int direction) {
         }
     }
 
-    return pushToHeap;
+    return updated;
 }
 
 void MackAlgo::initializeDestinationDistance() {
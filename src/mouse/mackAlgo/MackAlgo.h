@@ -34,6 +34,7 @@ public:
 private:
     sim::MouseInterface* m_mouse;
     Cell m_maze[MAZE_WIDTH][MAZE_HEIGHT];
+    Cell* m_heapItems[MAZE_WIDTH * MAZE_HEIGHT];
     int m_x;
     int m_y;
     int m_d;
@@ -4,5 +4,22 @@ namespace mackAlgoTwo {
 
 typedef unsigned char byte;
 typedef unsigned int twobyte;
+typedef unsigned long fourbyte;
+
+// The narrowest of the above types that can hold every value in [0, N)
+template<unsigned long N, bool FITS_BYTE = N <= 256, bool FITS_TWOBYTE = N <= 65536>
+struct Narrowest {
+    typedef fourbyte type;
+};
+
+template<unsigned long N>
+struct Narrowest<N, false, true> {
+    typedef twobyte type;
+};
+
+template<unsigned long N>
+struct Narrowest<N, true, true> {
+    typedef byte type;
+};
 
 } // namespace mackAlgoTwo
@@ -1,35 +1,62 @@
 #pragma once
 
+#include "../indexedHeap/IndexedHeap.h"
+
 #include "Byte.h"
 
 namespace mackAlgoTwo {
 
-class Heap {
+// The traits (see IndexedHeap.h) of the heap used by Solver<M>, which orders
+// cells by their distance in M. The heap can hold half of the cells in the
+// maze, and each position in the heap fits in the narrowest possible type.
+// Like the rest of the per-cell data, the items and positions are statically
+// allocated; for 16x16 mazes, the positions cost one byte per cell.
+template<class M>
+class HeapTraits {
 
 public:
 
-    static byte size();
-    static void push(byte cell);
-    static void update(byte cell);
-    static byte pop();
-    static void clear();
+    typedef typename M::Cell Item;
+    static const twobyte CAPACITY = M::CELLS / 2 - 1;
+    typedef typename Narrowest<CAPACITY + 1>::type Index;
 
-private:
+    bool less(Item one, Item two) const;
+    Index getPosition(Item item) const;
+    void setPosition(Item item, Index position);
 
-    static const byte CAPACITY = 127;
-    static const byte SENTINEL = 255;
+    // The storage for the items in the heap
+    static Item m_items[CAPACITY];
 
-    static byte m_size;
-    static byte m_data[CAPACITY];
+private:
+
+    static Index m_positions[M::CELLS];
+};
 
-    static byte getParentIndex(byte index); 
-    static byte getLeftChildIndex(byte index); 
-    static byte getRightChildIndex(byte index); 
-    static byte getMinChildIndex(byte index);
+// The heap itself, which is bound to the static storage above
+template<class M>
+class Heap : public indexedHeap::IndexedHeap<HeapTraits<M>> {
 
-    static void heapifyUp(byte index);
-    static void heapifyDown(byte index);
-    static void swap(byte indexOne, byte indexTwo);
+public:
+    Heap();
 };
 
+template<class M>
+bool HeapTraits<M>::less(Item one, Item two) const {
+    return M::getDistance(one) < M::getDistance(two);
+}
+
+template<class M>
+typename HeapTraits<M>::Index HeapTraits<M>::getPosition(Item item) const {
+    return m_positions[item];
+}
+
+template<class M>
+void HeapTraits<M>::setPosition(Item item, Index position) {
+    m_positions[item] = position;
+}
+
+template<class M>
+Heap<M>::Heap() : indexedHeap::IndexedHeap<HeapTraits<M>>(HeapTraits<M>::m_items, HeapTraits<M>::CAPACITY) {
+}
+
 } // namespace mackAlgoTwo
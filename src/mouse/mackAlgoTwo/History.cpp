@@ -1,24 +1,36 @@
 #include "History.h"
 
 #include "Assert.h"
+#include "Maze.h"
+#include "Options.h"
 
 namespace mackAlgoTwo {
 
-byte History::m_size = 0;
-byte History::m_tail = 0;
-bool History::m_infoAdded = false;
-twobyte History::m_data[] = {0};
+template<class M>
+byte History<M>::m_size = 0;
 
-byte History::size() {
+template<class M>
+byte History<M>::m_tail = 0;
+
+template<class M>
+bool History<M>::m_infoAdded = false;
+
+template<class M>
+typename History<M>::Entry History<M>::m_data[CAPACITY] = {0};
+
+template<class M>
+byte History<M>::size() {
     return m_size;
 }
 
-void History::add(byte cell, byte data) {
-    m_data[m_tail] = cell << 8 | data;
+template<class M>
+void History<M>::add(Cell cell, byte data) {
+    m_data[m_tail] = static_cast<Entry>(cell) << 8 | data;
     m_infoAdded = true;
 }
 
-void History::move() {
+template<class M>
+void History<M>::move() {
     if (!m_infoAdded) {
         m_data[m_tail] = 0;
     }
@@ -29,21 +41,30 @@ void History::move() {
     }
 }
 
-twobyte History::pop() {
+template<class M>
+typename History<M>::Entry History<M>::pop() {
     ASSERT_LT(0, m_size);
     m_tail = (m_tail - 1 + CAPACITY) % CAPACITY;
-    twobyte cellAndData = m_data[m_tail];
+    Entry cellAndData = m_data[m_tail];
     m_data[m_tail] = 0;
     m_size -= 1;
     return cellAndData;
 }
 
-byte History::cell(twobyte cellAndData) {
+template<class M>
+typename History<M>::Cell History<M>::cell(Entry cellAndData) {
     return cellAndData >> 8;
 }
 
-byte History::data(twobyte cellAndData) {
+template<class M>
+byte History<M>::data(Entry cellAndData) {
     return cellAndData & 255;
 }
 
+template class History<Maze16>;
+#if (LARGE_MAZES)
+template class History<Maze32>;
+template class History<Maze64>;
+#endif
+
 } // namespace mackAlgoTwo
@@ -4,6 +4,7 @@
 
 namespace mackAlgoTwo {
 
+template<class M>
 class History {
 
     // The History class is a circular stack that remembers the previous
@@ -18,12 +19,17 @@ class History {
 
 public:
 
+    typedef typename M::Cell Cell;
+
+    // The narrowest type that can hold both the cell and the data byte
+    typedef typename Narrowest<static_cast<unsigned long>(M::CELLS) << 8>::type Entry;
+
     static byte size();
-    static void add(byte cell, byte data);
+    static void add(Cell cell, byte data);
     static void move();
-    static twobyte pop();
-    static byte cell(twobyte cellAndData);
-    static byte data(twobyte cellAndData);
+    static Entry pop();
+    static Cell cell(Entry cellAndData);
+    static byte data(Entry cellAndData);
 
 private:
 
@@ -43,9 +49,9 @@ private:
     // some data the next time that move() is called.
     static bool m_infoAdded;
 
-    // One byte for the x and y position of the cell, and one byte for whether
-    // or not we learned of any walls, and what wall values we actually learned
-    // (which is technically not needed):
+    // The index of the cell, and one byte for whether or not we learned of any
+    // walls, and what wall values we actually learned (which is technically
+    // not needed). For mazes of up to 16x16 cells, this looks like:
     //
     //                 |---------|---------|---------|---------|
     //            info |    x    |    y    | learned |  walls  |
@@ -55,7 +61,7 @@ private:
     //            bits | 7 6 5 4 | 3 2 1 0 | 7 6 5 4 | 3 2 1 0 |
     //                 |---------|---------|---------|---------|
     //
-    static twobyte m_data[CAPACITY];
+    static Entry m_data[CAPACITY];
 
 };
 
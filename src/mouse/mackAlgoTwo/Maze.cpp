@@ -1,96 +1,133 @@
 #include "Maze.h"
 
+#include "Options.h"
+
 namespace mackAlgoTwo {
 
-byte Maze::m_data[] = {0};
-Info Maze::m_info[] = {0};
+template<byte W, byte H>
+byte Maze<W, H>::m_data[CELLS] = {0};
+
+template<byte W, byte H>
+Info Maze<W, H>::m_info[CELLS] = {0};
 
-byte Maze::getX(byte cell) {
+template<byte W, byte H>
+byte Maze<W, H>::getX(Cell cell) {
     return cell / HEIGHT;
 }
 
-byte Maze::getY(byte cell) {
+template<byte W, byte H>
+byte Maze<W, H>::getY(Cell cell) {
     return cell % HEIGHT;
 }
 
-byte Maze::getCell(byte x, byte y) {
+template<byte W, byte H>
+typename Maze<W, H>::Cell Maze<W, H>::getCell(byte x, byte y) {
     return x * HEIGHT + y;
 }
 
-bool Maze::isKnown(byte x, byte y, byte direction) {
+template<byte W, byte H>
+bool Maze<W, H>::isKnown(byte x, byte y, byte direction) {
     return isKnown(getCell(x, y), direction);
 }
 
-bool Maze::isWall(byte x, byte y, byte direction) {
+template<byte W, byte H>
+bool Maze<W, H>::isWall(byte x, byte y, byte direction) {
     return isWall(getCell(x, y), direction);
 }
 
-void Maze::setWall(byte x, byte y, byte direction, bool isWall) {
+template<byte W, byte H>
+void Maze<W, H>::setWall(byte x, byte y, byte direction, bool isWall) {
     setWall(getCell(x, y), direction, isWall);
 }
 
-void Maze::unsetWall(byte x, byte y, byte direction) {
+template<byte W, byte H>
+void Maze<W, H>::unsetWall(byte x, byte y, byte direction) {
     unsetWall(getCell(x, y), direction);
 }
 
-bool Maze::isKnown(byte cell, byte direction) {
+template<byte W, byte H>
+bool Maze<W, H>::isKnown(Cell cell, byte direction) {
     return (m_data[cell] >> direction + 4) & 1;
 }
 
-bool Maze::isWall(byte cell, byte direction) {
+template<byte W, byte H>
+bool Maze<W, H>::isWall(Cell cell, byte direction) {
     return (m_data[cell] >> direction) & 1;
 }
 
-void Maze::setWall(byte cell, byte direction, bool isWall) {
+template<byte W, byte H>
+void Maze<W, H>::setWall(Cell cell, byte direction, bool isWall) {
     m_data[cell] |= 1 << direction + 4;
     m_data[cell] =
         (m_data[cell] & ~(1 << direction)) | (isWall ? 1 << direction : 0);
 }
 
-void Maze::unsetWall(byte cell, byte direction) {
+template<byte W, byte H>
+void Maze<W, H>::unsetWall(Cell cell, byte direction) {
     m_data[cell] &= ~(1 << direction + 4);
     m_data[cell] &= ~(1 << direction);
 }
 
-twobyte Maze::getDistance(byte cell) {
+template<byte W, byte H>
+twobyte Maze<W, H>::getDistance(Cell cell) {
     return m_info[cell].distance;
 }
 
-void Maze::setDistance(byte cell, twobyte distance) {
+template<byte W, byte H>
+void Maze<W, H>::setDistance(Cell cell, twobyte distance) {
     m_info[cell].distance = distance;
 }
 
-bool Maze::getDiscovered(byte cell) {
+template<byte W, byte H>
+bool Maze<W, H>::getDiscovered(Cell cell) {
     return m_info[cell].misc & 1;
 }
 
-void Maze::setDiscovered(byte cell, bool discovered) {
+template<byte W, byte H>
+void Maze<W, H>::setDiscovered(Cell cell, bool discovered) {
     m_info[cell].misc = (m_info[cell].misc & ~1) | (discovered ? 1 : 0);
 }
 
-bool Maze::hasNext(byte cell) {
+template<byte W, byte H>
+bool Maze<W, H>::hasNext(Cell cell) {
     return m_info[cell].misc & 2;
 }
 
-void Maze::clearNext(byte cell) {
+template<byte W, byte H>
+void Maze<W, H>::clearNext(Cell cell) {
     m_info[cell].misc &= ~2;
 }
 
-byte Maze::getNextDirection(byte cell) {
+template<byte W, byte H>
+byte Maze<W, H>::getNextDirection(Cell cell) {
     return m_info[cell].misc >> 2 & 3;
 }
 
-void Maze::setNextDirection(byte cell, byte nextDirection) {
+template<byte W, byte H>
+void Maze<W, H>::setNextDirection(Cell cell, byte nextDirection) {
     m_info[cell].misc |= 2;
     m_info[cell].misc = (m_info[cell].misc & ~12) | (nextDirection << 2);
 }
 
-byte Maze::getStraightAwayLength(byte cell) {
+template<byte W, byte H>
+byte Maze<W, H>::getStraightAwayLength(Cell cell) {
     return m_info[cell].misc >> 4 & 15;
 }
 
-void Maze::setStraightAwayLength(byte cell, byte straightAwayLength) {
+template<byte W, byte H>
+void Maze<W, H>::setStraightAwayLength(Cell cell, byte straightAwayLength) {
+    // Straightaways longer than fifteen cells, which are only possible in
+    // mazes larger than 16x16, don't fit in four bits, so we saturate them
+    if (15 < straightAwayLength) {
+        straightAwayLength = 15;
+    }
     m_info[cell].misc = (m_info[cell].misc & 15) | (straightAwayLength << 4);
 }
 
+template struct Maze<16, 16>;
+#if (LARGE_MAZES)
+template struct Maze<32, 32>;
+template struct Maze<64, 64>;
+#endif
+
 } // namespace mackAlgoTwo
@@ -11,16 +11,23 @@ struct Info {
     // bit 0 is whether or not the cell has been discovered
     // bit 1 is whether or not the cell has a "next" cell
     // bits 2 - 3 are the direction of the "next" cell
-    // bits 4 - 7 are the straightaway length
+    // bits 4 - 7 are the straightaway length (saturating at 15)
     byte misc;
 };
 
+template<byte W, byte H>
 struct Maze {
 
-    // The width and height of the maze, as understood
-    // by the algorithm, both of which must be in [1, 16]
-    static const byte WIDTH  = 16;
-    static const byte HEIGHT = 16;
+    // The width and height of the maze, as understood by the algorithm,
+    // which are fixed at compile time so that the arrays below can be
+    // statically allocated (see MackAlgoTwo::solve for the supported sizes)
+    static const byte WIDTH  = W;
+    static const byte HEIGHT = H;
+    static const twobyte CELLS = W * H;
+
+    // The narrowest type that can index every cell in the maze, which is just
+    // a byte for mazes of up to 16x16 cells
+    typedef typename Narrowest<CELLS>::type Cell;
 
     // The x and y positions of the lower left and upper right center cells
     static const byte CLLX = (WIDTH  - 1) / 2;
@@ -37,42 +44,48 @@ struct Maze {
     //         |---------|---------|
     //    bits | 7 6 5 4 | 3 2 1 0 |
     //
-    // Furthermore, each cell can be indexed by just eight bits: at most
-    // four bits for the x position, and at most four bits for the y position
-    //      
-    static byte m_data[WIDTH * HEIGHT];
+    // Furthermore, for mazes of up to 16x16 cells, each cell can be indexed
+    // by just eight bits: at most four bits for the x position, and at most
+    // four bits for the y position
+    //
+    static byte m_data[CELLS];
 
     // Helper methods for converting between xy coordinates
     // and the maze index of the cell in the data array
-    static byte getX(byte cell);
-    static byte getY(byte cell);
-    static byte getCell(byte x, byte y);
+    static byte getX(Cell cell);
+    static byte getY(Cell cell);
+    static Cell getCell(byte x, byte y);
 
     // Helper methods for querying and updating maze data
     static bool isKnown(byte x, byte y, byte direction);
     static bool isWall(byte x, byte y, byte direction);
     static void setWall(byte x, byte y, byte direction, bool isWall);
     static void unsetWall(byte x, byte y, byte direction);
-    static bool isKnown(byte cell, byte direction);
-    static bool isWall(byte cell, byte direction);
-    static void setWall(byte cell, byte direction, bool isWall);
-    static void unsetWall(byte cell, byte direction);
+    static bool isKnown(Cell cell, byte direction);
+    static bool isWall(Cell cell, byte direction);
+    static void setWall(Cell cell, byte direction, bool isWall);
+    static void unsetWall(Cell cell, byte direction);
 
     // Information used only by Dijkstra's algo to determine the fastest path
-    static Info m_info[WIDTH * HEIGHT];
+    static Info m_info[CELLS];
 
     // Helper methods for accessing and modifying m_info
-    static twobyte getDistance(byte cell);
-    static void setDistance(byte cell, twobyte distance);
-    static bool getDiscovered(byte cell);
-    static void setDiscovered(byte cell, bool discovered);
-    static bool hasNext(byte cell);
-    static void clearNext(byte cell);
-    static byte getNextDirection(byte cell);
-    static void setNextDirection(byte cell, byte nextDirection);
-    static byte getStraightAwayLength(byte cell);
-    static void setStraightAwayLength(byte cell, byte straightAwayLength);
+    static twobyte getDistance(Cell cell);
+    static void setDistance(Cell cell, twobyte distance);
+    static bool getDiscovered(Cell cell);
+    static void setDiscovered(Cell cell, bool discovered);
+    static bool hasNext(Cell cell);
+    static void clearNext(Cell cell);
+    static byte getNextDirection(Cell cell);
+    static void setNextDirection(Cell cell, byte nextDirection);
+    static byte getStraightAwayLength(Cell cell);
+    static void setStraightAwayLength(Cell cell, byte straightAwayLength);
 
 };
 
+// The maze sizes for which the algorithm is compiled
+typedef Maze<16, 16> Maze16;
+typedef Maze<32, 32> Maze32;
+typedef Maze<64, 64> Maze64;
+
 } // namespace mackAlgoTwo
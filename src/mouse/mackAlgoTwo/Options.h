@@ -3,3 +3,8 @@
 // 0 - Arduino
 // 1 - Simulator
 #define SIMULATOR 1
+
+// Whether or not the algorithm is compiled for 32x32 and 64x64 mazes, in
+// addition to 16x16 mazes; 1 for the simulator, since the robot doesn't
+// have enough memory for the larger mazes anyways
+#define LARGE_MAZES SIMULATOR
@@ -0,0 +1,808 @@
+#include "Solver.h"
+
+#include "Assert.h"
+#include "Mode.h"
+#include "Options.h"
+
+#if (!SIMULATOR) 
+extern char movesBuffer[256];
+extern bool walls_global[3];
+extern volatile bool movesReady;
+extern volatile bool movesDoneAndWallsSet;
+extern volatile bool buttonPressed;
+#endif
+
+namespace mackAlgoTwo {
+
+#if (SIMULATOR)
+
+template<class M>
+void Solver<M>::solve(char initialDirection, sim::MouseInterface* mouse) {
+
+    // Initialize the MouseInterface pointer
+    m_mouse = mouse;
+
+#else
+
+template<class M>
+void Solver<M>::solve() {
+
+#endif
+
+    // Initialize the (perimeter of the) maze
+    for (byte x = 0; x < M::WIDTH; x += 1) {
+        for (byte y = 0; y < M::HEIGHT; y += 1) {
+            if (x == 0) { 
+                setCellWall(M::getCell(x, y), Direction::WEST, true);
+            }
+            if (y == 0) {
+                setCellWall(M::getCell(x, y), Direction::SOUTH, true);
+            }
+            if (x == M::WIDTH - 1) {
+                setCellWall(M::getCell(x, y), Direction::EAST, true);
+            }
+            if (y == M::HEIGHT - 1) {
+                setCellWall(M::getCell(x, y), Direction::NORTH, true);
+            }
+        }
+    }
+
+    // Initialize the mouse
+    m_x = 0;
+    m_y = 0;
+    switch (initialDirection) {
+        case 'n':
+            m_initialDirection = Direction::NORTH;
+            break;
+        case 'e':
+            m_initialDirection = Direction::EAST;
+            break;
+        default:
+#if (SIMULATOR)
+            m_mouse->warn("Can't start facing south or west. I'm giving up...");
+#endif
+            return;
+    }
+    m_d = m_initialDirection;
+    m_mode = Mode::CENTER;
+
+    // Perform a series of strategical steps ad infinitum
+    while (true) {
+
+#if (SIMULATOR)
+        // Clear all tile color, and color the center
+        m_mouse->clearAllTileColor();
+        m_mouse->setTileColor(0, 0, 'G');
+        colorCenter('G');
+#else
+        while (!movesDoneAndWallsSet) {
+            // Wait for the walls to be ready
+        }
+#endif
+
+        // If requested, reset the mouse state and undo cell wall info
+        if (resetButtonPressed()) {
+            reset();
+        }
+
+        // Perform a movement that will take us closer to the destination 
+        step();
+
+        // If the maze is unsolvable, give up
+        if (m_mode == Mode::GIVEUP) {
+#if (SIMULATOR)
+            m_mouse->warn("Unsolvable maze detected. I'm giving up...");
+#endif
+            break;
+        }
+    }
+}
+
+#if (SIMULATOR)
+
+template<class M>
+void Solver<M>::discoverMaze(
+        sim::MouseInterface* mouse,
+        const std::function<bool(byte, byte, byte)>& isWall) {
+    m_mouse = mouse;
+    for (byte x = 0; x < M::WIDTH; x += 1) {
+        for (byte y = 0; y < M::HEIGHT; y += 1) {
+            for (byte direction = 0; direction < 4; direction += 1) {
+                setCellWall(M::getCell(x, y), direction, isWall(x, y, direction), false);
+            }
+        }
+    }
+    m_x = 0;
+    m_y = 0;
+    m_d = Direction::NORTH;
+    m_initialDirection = Direction::NORTH;
+    m_mode = Mode::CENTER;
+}
+
+template<class M>
+bool Solver<M>::planFromOrigin() {
+    Cell origin = M::getCell(0, 0);
+    return generatePath(origin) == origin;
+}
+
+#endif
+
+template<class M>
+bool Solver<M>::shouldColorVisitedCells() const {
+#if (SIMULATOR)
+    // 1 to enable, 0 to disable
+    if (m_mouse->inputButtonPressed(1)) {
+        if (m_mouse->inputButtonPressed(0)) {
+            m_mouse->acknowledgeInputButtonPressed(1);
+            m_mouse->acknowledgeInputButtonPressed(0);
+            return false;
+        }
+        return true;
+    }
+    if (m_mouse->inputButtonPressed(0)) {
+        m_mouse->acknowledgeInputButtonPressed(0);
+    }
+#endif
+    return false;
+}
+
+template<class M>
+byte Solver<M>::colorVisitedCellsDelayMs() const {
+    return 10;
+}
+
+template<class M>
+bool Solver<M>::resetButtonPressed() {
+#if (SIMULATOR)
+    return m_mouse->inputButtonPressed(2);
+#else
+    return buttonPressed;
+#endif
+}
+
+template<class M>
+void Solver<M>::acknowledgeResetButtonPressed() {
+#if (SIMULATOR)
+    m_mouse->acknowledgeInputButtonPressed(2);
+#else
+    buttonPressed = false;
+#endif
+}
+
+template<class M>
+twobyte Solver<M>::getTurnCost() {
+    return (FAST_STRAIGHT_AWAYS ? 256 : 2);
+}
+
+template<class M>
+twobyte Solver<M>::getStraightAwayCost(byte length) {
+    return (FAST_STRAIGHT_AWAYS ? 256 / length : 3);
+}
+
+template<class M>
+void Solver<M>::reset() {
+
+#if (SIMULATOR)
+    // First, reset the position in the simulator
+    m_mouse->resetPosition();
+#endif
+
+    // Then acknowledge that the button was pressed (and potentially sleep)
+    acknowledgeResetButtonPressed();
+
+#if (!SIMULATOR)
+    delay(300);
+    while (!resetButtonPressed()) {
+        // Wait until the button is pressed again to
+        // signify that we're ready to start moving again
+    }
+    acknowledgeResetButtonPressed();
+    delay(300);
+#endif
+
+    // Reset some state
+    m_x = 0;
+    m_y = 0;
+    m_d = m_initialDirection;
+    m_mode = Mode::CENTER;
+    M::setStraightAwayLength(M::getCell(0, 0), 0);
+
+    // Roll back some cell wall data
+    while (0 < History<M>::size()) {
+        typename History<M>::Entry cellAndData = History<M>::pop();
+        Cell cell = History<M>::cell(cellAndData);
+        byte data = History<M>::data(cellAndData);
+        for (byte direction = 0; direction < 4; direction += 1) {
+            if (data >> direction + 4 & 1) {
+                unsetCellWall(cell, direction, true);
+            }
+        }
+    }
+}
+
+template<class M>
+void Solver<M>::step() {
+
+    // Read the walls if unknown
+    readWalls();
+
+#if (!SIMULATOR)
+    movesDoneAndWallsSet = false;
+#endif
+
+    // Get the current cell
+    Cell current = M::getCell(m_x, m_y);
+
+    // Generate a path from the current cell to the destination
+    Cell start = generatePath(current);
+
+    // Invalid path, maze not solvable
+    if (start != current) {
+        m_mode = Mode::GIVEUP;
+        return;
+    }
+
+    // Draw the path from the current position to the destination
+    drawPath(start);
+
+#if (!SIMULATOR)
+    m_moveBufferIndex = 0;
+#endif
+
+    // Move along the path as far as possible
+    followPath(start);
+
+#if (!SIMULATOR)
+    movesBuffer[m_moveBufferIndex] = '\0';
+    movesReady = true;
+#endif
+
+    // Update the mode if we've reached the destination
+    if (m_mode == Mode::CENTER && inCenter(m_x, m_y)) {
+#if (!SIMULATOR)
+        readWalls();
+        moveForward();
+#endif
+        m_mode = Mode::ORIGIN;
+    }
+    if (m_mode == Mode::ORIGIN && inOrigin(m_x, m_y)) {
+        m_mode = Mode::CENTER;
+    }
+}
+
+template<class M>
+typename Solver<M>::Cell Solver<M>::generatePath(Cell start) {
+
+    // Reset the sequence bit of all cells
+    for (byte x = 0; x < M::WIDTH; x += 1) {
+        for (byte y = 0; y < M::HEIGHT; y += 1) {
+            M::setDiscovered(M::getCell(x, y), false);
+        }
+    }
+
+    // Initialize the starting cell
+    M::setDiscovered(start, true);
+    setCellDistance(start, 0);
+
+    // This is nuanced - when we are determining whether or not a movement
+    // continues the straightaway path, we inspect the previous cells "next"
+    // pointer, which really points *that* cell's previous cell. In the case of
+    // the starting cell, we assume that the previous cell is directly behind
+    // us, so that the straightaway distance is properly calculated.
+    M::setNextDirection(start, getOppositeDirection(m_d));
+    M::clearNext(start);
+
+    // Reset the destination cell distances
+    resetDestinationCellDistances();
+
+    // Dijkstra's algo
+    ASSERT_EQ(m_heap.size(), 0);
+    m_heap.push(start);
+    while (0 < m_heap.size()) {
+        Cell cell = m_heap.pop();
+        for (byte direction = 0; direction < 4; direction += 1) {
+            if (!M::isWall(cell, direction)) {
+                checkNeighbor(cell, direction);
+            }
+        }
+        if (shouldColorVisitedCells()) {
+#if (SIMULATOR)
+            m_mouse->delay(colorVisitedCellsDelayMs());
+            m_mouse->setTileColor(M::getX(cell), M::getY(cell), 'Y');
+#endif
+        }
+        if (cell == getClosestDestinationCell()) {
+            m_heap.clear();
+            break;
+        }
+    }
+
+    // Reverse the linked list from the destination to the start (which we
+    // built during our execution of Dijkstra's algo) into a linked list from
+    // the start to the destination (which we use to instruct the robot's
+    // movements).
+    return reverseLinkedList(getClosestDestinationCell());
+}
+
+template<class M>
+void Solver<M>::drawPath(Cell start) {
+#if (SIMULATOR)
+    // This is probably a little two cutesy for it's own good. Oh well...
+    Cell current = start;
+    for (byte i = 0; i < 2; i += 1) {
+        while (M::hasNext(current)) {
+            Cell next = getNeighboringCell(current, M::getNextDirection(current));
+            // Draw the "known" moves
+            if (i == 0) {
+                if (!M::isKnown(current, M::getNextDirection(current))) {
+                    break;
+                }
+                m_mouse->setTileColor(M::getX(next), M::getY(next), 'V');
+            }
+            // Draw the "intended" moves
+            else {
+                m_mouse->setTileColor(M::getX(next), M::getY(next), 'B');
+            }
+            current = next;
+        }
+    }
+#endif
+}
+
+template<class M>
+void Solver<M>::followPath(Cell start) {
+
+    // Move forward as long as we know we won't collide with a wall
+    Cell current = start;
+    while (M::hasNext(current) && M::isKnown(current, M::getNextDirection(current))) {
+
+        // Move to the next cell and advance our pointers
+        Cell next = getNeighboringCell(current, M::getNextDirection(current));
+        moveOneCell(next);
+        current = next;
+
+        // Inform the History class that the mouse has moved a cell
+        History<M>::move();
+
+        // If the reset button was pressed, we should stop moving
+        if (resetButtonPressed()) {
+            break;
+        }
+    }
+}
+
+template<class M>
+typename Solver<M>::Cell Solver<M>::getFirstUnknown(Cell start) {
+    Cell current = start;
+    while (M::hasNext(current) &&
+           M::isKnown(current, M::getNextDirection(current))) {
+        current = getNeighboringCell(current, M::getNextDirection(current));
+    }
+    return current;
+}
+
+template<class M>
+void Solver<M>::checkNeighbor(Cell cell, byte direction) {
+
+    // Retrieve the neighboring cell, and the direction that would take us from
+    // the neighboring cell to the current cell (which is the opposite of the
+    // direction that takes us from the current cell to the neighboring cell)
+    Cell neighbor = getNeighboringCell(cell, direction);
+    byte directionFromNeighbor = getOppositeDirection(direction);
+
+    // Determine the cost if routed through the current cell
+    twobyte costToNeighbor = M::getDistance(cell) + (
+        M::getNextDirection(cell) == directionFromNeighbor ?
+        getStraightAwayCost(M::getStraightAwayLength(cell) + 1) :
+        getTurnCost()
+    );
+
+    // Make updates to the neighbor cell if necessary
+    if (!M::getDiscovered(neighbor) ||
+        costToNeighbor < M::getDistance(neighbor)) {
+
+        // Update the distance, next direction, and straight away length
+        setCellDistance(neighbor, costToNeighbor);
+        M::setNextDirection(neighbor, directionFromNeighbor);
+        M::setStraightAwayLength(neighbor, (
+            M::getNextDirection(cell) == directionFromNeighbor ?
+            M::getStraightAwayLength(cell) + 1 : 1
+        ));
+
+        // Either discover (and push) the cell, or just update it
+        if (!M::getDiscovered(neighbor)) {
+            M::setDiscovered(neighbor, true);
+            m_heap.push(neighbor);
+        }
+        else {
+            m_heap.decrease(neighbor);
+        }
+    }
+}
+
+template<class M>
+typename Solver<M>::Cell Solver<M>::reverseLinkedList(Cell cell) {
+    Cell closest = cell;
+    byte direction = M::getNextDirection(closest);
+    Cell current = getNeighboringCell(closest, direction);
+    M::clearNext(closest);
+    while (M::hasNext(current)) {
+        byte temp = M::getNextDirection(current);
+        M::setNextDirection(current, getOppositeDirection(direction));
+        direction = temp;
+        closest = current;
+        current = getNeighboringCell(current, direction);
+    }
+    M::setNextDirection(current, getOppositeDirection(direction));
+    return current;
+}
+
+template<class M>
+bool Solver<M>::inCenter(byte x, byte y) {
+    for (byte xx = M::CLLX; xx <= M::CURX; xx += 1) {
+        for (byte yy = M::CLLY; yy <= M::CURY; yy += 1) {
+            if (x == xx && y == yy) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+template<class M>
+bool Solver<M>::inOrigin(byte x, byte y) {
+    return x == 0 && y == 0;
+}
+
+template<class M>
+void Solver<M>::colorCenter(char color) {
+#if (SIMULATOR)
+    for (byte x = M::CLLX; x <= M::CURX; x += 1) {
+        for (byte y = M::CLLY; y <= M::CURY; y += 1) {
+            m_mouse->setTileColor(x, y, color);
+        }
+    }
+#endif
+}
+
+template<class M>
+void Solver<M>::resetDestinationCellDistances() {
+    // The largest possible distance, which is 65535 on the robot
+    static twobyte maxDistance = static_cast<twobyte>(-1);
+    if (m_mode == Mode::CENTER) {
+        for (byte x = M::CLLX; x <= M::CURX; x += 1) {
+            for (byte y = M::CLLY; y <= M::CURY; y += 1) {
+                setCellDistance(M::getCell(x, y), maxDistance);
+            }
+        }
+    }
+    else {
+        setCellDistance(M::getCell(0, 0), maxDistance);
+    }
+}
+
+template<class M>
+typename Solver<M>::Cell Solver<M>::getClosestDestinationCell() {
+    Cell closest = M::getCell(M::CLLX, M::CLLY);
+    if (m_mode == Mode::CENTER) {
+        for (byte x = M::CLLX; x <= M::CURX; x += 1) {
+            for (byte y = M::CLLY; y <= M::CURY; y += 1) {
+                Cell other = M::getCell(x, y);
+                if (M::getDistance(other) < M::getDistance(closest)) {
+                    closest = other;
+                }
+            }
+        }
+    }
+    else {
+        closest = M::getCell(0, 0);
+    }
+    return closest;
+}
+
+template<class M>
+byte Solver<M>::getOppositeDirection(byte direction) {
+    switch (direction) {
+        case Direction::NORTH:
+            return Direction::SOUTH;
+        case Direction::EAST:
+            return Direction::WEST;
+        case Direction::SOUTH:
+            return Direction::NORTH;
+        case Direction::WEST:
+            return Direction::EAST;
+        default:
+            ASSERT_TR(false);
+    }
+}
+
+template<class M>
+bool Solver<M>::hasNeighboringCell(Cell cell, byte direction) {
+
+    byte x = M::getX(cell);
+    byte y = M::getY(cell);
+
+    switch (direction) {
+        case Direction::NORTH:
+            return y < M::HEIGHT - 1;
+        case Direction::EAST:
+            return x < M::WIDTH - 1;
+        case Direction::SOUTH:
+            return 0 < y;
+        case Direction::WEST:
+            return 0 < x;
+    }
+}
+
+template<class M>
+typename Solver<M>::Cell Solver<M>::getNeighboringCell(Cell cell, byte direction) {
+
+    ASSERT_TR(hasNeighboringCell(cell, direction));
+
+    byte x = M::getX(cell);
+    byte y = M::getY(cell);
+
+    switch (direction) {
+        case Direction::NORTH:
+            return M::getCell(x, y + 1);
+        case Direction::EAST:
+            return M::getCell(x + 1, y);
+        case Direction::SOUTH:
+            return M::getCell(x, y - 1);
+        case Direction::WEST:
+            return M::getCell(x - 1, y);
+    }
+}
+
+template<class M>
+bool Solver<M>::isOneCellAway(Cell target) {
+
+    byte x = M::getX(target);
+    byte y = M::getY(target);
+    
+    if ((m_x == x) && (m_y + 1 == y) && !M::isWall(m_x, m_y, Direction::NORTH)) {
+        return true;
+    }
+    else if ((m_x == x) && (m_y - 1 == y) && !M::isWall(m_x, m_y, Direction::SOUTH)) {
+        return true;
+    }
+    else if ((m_x + 1 == x) && (m_y == y) && !M::isWall(m_x, m_y, Direction::EAST)) {
+        return true;
+    }
+    else if ((m_x - 1 == x) && (m_y == y) && !M::isWall(m_x, m_y, Direction::WEST)) {
+        return true;
+    }
+    
+    return false;
+}
+
+template<class M>
+void Solver<M>::moveOneCell(Cell target) {
+
+    ASSERT_TR(isOneCellAway(target));
+
+    byte x = M::getX(target);
+    byte y = M::getY(target);
+    
+    byte moveDirection = Direction::NORTH;
+    if (x > m_x) {
+        moveDirection = Direction::EAST;
+    }
+    else if (y < m_y) {
+        moveDirection = Direction::SOUTH;
+    }
+    else if (x < m_x) {
+        moveDirection = Direction::WEST;
+    }
+
+    if (moveDirection == m_d) {
+        moveForward();
+    }
+    else if (moveDirection == (m_d + 1) % 4) {
+        rightAndForward();
+    }
+    else if (moveDirection == (m_d + 2) % 4) {
+        aroundAndForward();
+    }
+    else if (moveDirection == (m_d + 3) % 4) {
+        leftAndForward();
+    }
+}
+
+template<class M>
+void Solver<M>::readWalls() {
+
+    // Record the cell and wall data for the History
+    Cell cell = M::getCell(m_x, m_y);
+    byte data = 0;
+
+    // For each of [left, front, right]
+    for (int i = -1; i <= 1; i += 1) {
+        byte direction = (m_d + i + 4) % 4;
+
+        // If the wall is not already known
+        if (!M::isKnown(m_x, m_y, direction)) {
+
+            // Read and update the wall value
+            bool isWall = readWall(direction);
+            setCellWall(M::getCell(m_x, m_y), direction, isWall);
+
+            // Set the "learned" bit, as well as "walls" bit
+            data |= 1 << direction + 4;
+            if (isWall) {
+                data |= 1 << direction;
+            }
+        }
+    }
+
+    // Actually add the learned cell walls to the History
+    History<M>::add(cell, data);
+}
+
+template<class M>
+bool Solver<M>::readWall(byte direction) {
+    switch ((direction - m_d + 4) % 4) {
+#if (SIMULATOR)
+        case 0:
+            return m_mouse->wallFront();
+        case 1:
+            return m_mouse->wallRight();
+        case 3:
+            return m_mouse->wallLeft();
+#else
+        case 0:
+            return walls_global[1];
+        case 1:
+            return walls_global[2];
+        case 3:
+            return walls_global[0];
+#endif
+    }
+    // We should never get here
+    ASSERT_TR(false);
+}
+
+template<class M>
+void Solver<M>::turnLeftUpdateState() {
+    m_d = (m_d + 3) % 4;
+}
+
+template<class M>
+void Solver<M>::turnRightUpdateState() {
+    m_d = (m_d + 1) % 4;
+}
+
+template<class M>
+void Solver<M>::turnAroundUpdateState() {
+    m_d = (m_d + 2) % 4;
+}
+
+template<class M>
+void Solver<M>::moveForwardUpdateState() {
+    m_x += (m_d == Direction::EAST  ? 1 : (m_d == Direction::WEST  ? -1 : 0));
+    m_y += (m_d == Direction::NORTH ? 1 : (m_d == Direction::SOUTH ? -1 : 0));
+}
+
+template<class M>
+void Solver<M>::turnLeft() {
+    turnLeftUpdateState();
+#if (SIMULATOR)
+    m_mouse->turnLeft();
+#else
+    // UNIMPLEMENTED
+#endif
+}
+
+template<class M>
+void Solver<M>::turnRight() {
+    turnRightUpdateState();
+#if (SIMULATOR)
+    m_mouse->turnRight();
+#else
+    // UNIMPLEMENTED
+#endif
+}
+
+template<class M>
+void Solver<M>::turnAround() {
+    turnAroundUpdateState();
+#if (SIMULATOR)
+    m_mouse->turnAroundLeft();
+#else
+    // UNIMPLEMENTED
+#endif
+}
+
+template<class M>
+void Solver<M>::moveForward() {
+#if (SIMULATOR)
+    m_mouse->moveForward();
+#else
+    movesBuffer[m_moveBufferIndex] = 'f';
+    m_moveBufferIndex += 1;
+#endif
+    moveForwardUpdateState();
+}
+
+template<class M>
+void Solver<M>::leftAndForward() {
+#if (SIMULATOR)
+    turnLeft();
+    moveForward();
+#else
+    movesBuffer[m_moveBufferIndex] = 'l';
+    m_moveBufferIndex += 1;
+    turnLeftUpdateState();
+    moveForwardUpdateState();
+#endif
+}
+
+template<class M>
+void Solver<M>::rightAndForward() {
+#if (SIMULATOR)
+    turnRight();
+    moveForward();
+#else
+    movesBuffer[m_moveBufferIndex] = 'r';
+    m_moveBufferIndex += 1;
+    turnRightUpdateState();
+    moveForwardUpdateState();
+#endif
+}
+
+template<class M>
+void Solver<M>::aroundAndForward() {
+#if (SIMULATOR)
+    turnAround();
+    moveForward();
+#else
+    movesBuffer[m_moveBufferIndex] = 'a';
+    m_moveBufferIndex += 1;
+    movesBuffer[m_moveBufferIndex] = 'f';
+    m_moveBufferIndex += 1;
+    turnAroundUpdateState();
+    moveForwardUpdateState();
+#endif
+}
+
+template<class M>
+void Solver<M>::setCellDistance(Cell cell, twobyte distance) {
+    M::setDistance(cell, distance);
+#if (SIMULATOR)
+    m_mouse->setTileText(M::getX(cell), M::getY(cell), QString::number(distance));
+#endif
+}
+
+template<class M>
+void Solver<M>::setCellWall(Cell cell, byte direction, bool isWall, bool bothSides) {
+    M::setWall(cell, direction, isWall);
+    static char directionChars[] = {'n', 'e', 's', 'w'};
+#if (SIMULATOR)
+    m_mouse->declareWall(M::getX(cell), M::getY(cell), directionChars[direction], isWall);
+#endif
+    if (bothSides && hasNeighboringCell(cell, direction)) {
+        Cell neighboringCell = getNeighboringCell(cell, direction);
+        setCellWall(neighboringCell, getOppositeDirection(direction), isWall, false);
+    }
+}
+
+template<class M>
+void Solver<M>::unsetCellWall(Cell cell, byte direction, bool bothSides) {
+    M::unsetWall(cell, direction);
+    static char directionChars[] = {'n', 'e', 's', 'w'};
+#if (SIMULATOR)
+    m_mouse->undeclareWall(M::getX(cell), M::getY(cell), directionChars[direction]);
+#endif
+    if (bothSides && hasNeighboringCell(cell, direction)) {
+        Cell neighboringCell = getNeighboringCell(cell, direction);
+        unsetCellWall(neighboringCell, getOppositeDirection(direction), false);
+    }
+}
+
+template class Solver<Maze16>;
+#if (LARGE_MAZES)
+template class Solver<Maze32>;
+template class Solver<Maze64>;
+#endif
+
+} // namespace mackAlgoTwo
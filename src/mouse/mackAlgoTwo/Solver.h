@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Options.h"
+
+#if (SIMULATOR)
+#include <functional>
+
+#include "../IMouseAlgorithm.h"
+#endif
+
+#include "Byte.h"
+#include "Direction.h"
+#include "Heap.h"
+#include "History.h"
+#include "Maze.h"
+
+namespace mackAlgoTwo {
+
+// The algorithm itself, for a maze of type M (see Maze.h); MackAlgoTwo
+// chooses the instantiation that matches the size of the actual maze
+template<class M>
+class Solver {
+
+public:
+#if (SIMULATOR)
+    void solve(char initialDirection, sim::MouseInterface* mouse);
+
+    // For the benchmarks (see src/bench), which time the path planning on its
+    // own: discovers every wall of the maze at once, as given by isWall(x, y,
+    // direction), and puts the mouse in the origin, facing north
+    void discoverMaze(
+        sim::MouseInterface* mouse,
+        const std::function<bool(byte, byte, byte)>& isWall);
+
+    // Plans the fastest path from the origin to the center, and returns
+    // whether or not there is one
+    bool planFromOrigin();
+#else
+    void solve();
+#endif
+
+private:
+
+    typedef typename M::Cell Cell;
+
+    static const bool FAST_STRAIGHT_AWAYS = true;
+
+#if (SIMULATOR)
+    sim::MouseInterface* m_mouse;
+#else
+    byte m_moveBufferIndex;
+#endif
+    byte m_x; // X position of the mouse
+    byte m_y; // Y position of the mouse
+    byte m_d; // Direction of the mouse
+    byte m_mode; // Modus operandi of the mouse
+    byte m_initialDirection; // As the name states
+    Heap<M> m_heap; // Used by Dijkstra's algo in generatePath
+
+    bool shouldColorVisitedCells() const;
+    byte colorVisitedCellsDelayMs() const;
+
+    bool resetButtonPressed();
+    void acknowledgeResetButtonPressed();
+
+    twobyte getTurnCost();
+    twobyte getStraightAwayCost(byte length);
+
+    void reset();
+    void step();
+
+    Cell generatePath(Cell start);
+    void drawPath(Cell start);
+    void followPath(Cell start);
+    Cell getFirstUnknown(Cell start);
+
+    void checkNeighbor(Cell cell, byte direction);
+    Cell reverseLinkedList(Cell cell);
+
+    bool inCenter(byte x, byte y);
+    bool inOrigin(byte x, byte y);
+
+    void colorCenter(char color);
+    void resetDestinationCellDistances();
+    Cell getClosestDestinationCell();
+
+    byte getOppositeDirection(byte direction);
+    bool hasNeighboringCell(Cell cell, byte direction);
+    Cell getNeighboringCell(Cell cell, byte direction);
+
+    bool isOneCellAway(Cell target);
+    void moveOneCell(Cell target);
+
+    void readWalls();
+    bool readWall(byte direction);
+
+    void turnLeftUpdateState();
+    void turnRightUpdateState();
+    void turnAroundUpdateState();
+    void moveForwardUpdateState();
+
+    void turnLeft();
+    void turnRight();
+    void turnAround();
+
+    void moveForward();
+    void leftAndForward();
+    void rightAndForward();
+    void aroundAndForward();
+
+    void setCellDistance(Cell cell, twobyte distance);
+    void setCellWall(Cell cell, byte direction, bool isWall, bool bothSides = true);
+    void unsetCellWall(Cell cell, byte direction, bool bothSides = true);
+
+};
+
+} // namespace mackAlgoTwo
@@ -0,0 +1,250 @@
+#include "MotionProfile.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace motionProfile {
+
+MotionProfile MotionProfile::generate(const Parameters& parameters) {
+    if (0.0 < parameters.jerk) {
+        return sCurve(
+            parameters.distance, parameters.maxSpeed, parameters.acceleration, parameters.jerk);
+    }
+    return trapezoidal(
+        parameters.distance, parameters.maxSpeed, parameters.acceleration,
+        parameters.startSpeed, parameters.endSpeed);
+}
+
+MotionProfile MotionProfile::trapezoidal(
+        double distance, double maxSpeed, double acceleration,
+        double startSpeed, double endSpeed) {
+
+    double accelerationTime = 0.0;
+    double cruiseTime = 0.0;
+    double decelerationTime = 0.0;
+    if (!getTrapezoidalPhases(distance, maxSpeed, acceleration, startSpeed, &endSpeed,
+            &accelerationTime, &cruiseTime, &decelerationTime)) {
+        // We can't slow down in time, so just slow down the whole way
+        decelerationTime = (
+            startSpeed - std::sqrt(startSpeed * startSpeed - 2 * acceleration * distance)
+        ) / acceleration;
+    }
+
+    std::vector<Segment> segments;
+    segments.push_back(makeSegment(accelerationTime, 0.0, acceleration));
+    segments.push_back(makeSegment(cruiseTime, 0.0, 0.0));
+    segments.push_back(makeSegment(decelerationTime, 0.0, -acceleration));
+    return MotionProfile(distance, startSpeed, segments);
+}
+
+MotionProfile MotionProfile::sCurve(
+        double distance, double maxSpeed, double acceleration, double jerk) {
+
+    double jerkTime = 0.0;
+    double accelerationTime = 0.0;
+    double cruiseTime = 0.0;
+    double peakAcceleration = 0.0;
+    getSCurvePhases(distance, maxSpeed, acceleration, jerk,
+        &jerkTime, &accelerationTime, &cruiseTime, &peakAcceleration);
+
+    std::vector<Segment> segments;
+    segments.push_back(makeSegment(jerkTime, jerk, 0.0));
+    segments.push_back(makeSegment(accelerationTime, 0.0, peakAcceleration));
+    segments.push_back(makeSegment(jerkTime, -jerk, peakAcceleration));
+    segments.push_back(makeSegment(cruiseTime, 0.0, 0.0));
+    segments.push_back(makeSegment(jerkTime, -jerk, 0.0));
+    segments.push_back(makeSegment(accelerationTime, 0.0, -peakAcceleration));
+    segments.push_back(makeSegment(jerkTime, jerk, -peakAcceleration));
+    return MotionProfile(distance, 0.0, segments);
+}
+
+double MotionProfile::getTrapezoidalDuration(
+        double distance, double maxSpeed, double acceleration,
+        double startSpeed, double endSpeed) {
+    double accelerationTime = 0.0;
+    double cruiseTime = 0.0;
+    double decelerationTime = 0.0;
+    if (!getTrapezoidalPhases(distance, maxSpeed, acceleration, startSpeed, &endSpeed,
+            &accelerationTime, &cruiseTime, &decelerationTime)) {
+        return -1.0;
+    }
+    return accelerationTime + cruiseTime + decelerationTime;
+}
+
+double MotionProfile::getSCurveDuration(
+        double distance, double maxSpeed, double acceleration, double jerk) {
+    double jerkTime = 0.0;
+    double accelerationTime = 0.0;
+    double cruiseTime = 0.0;
+    double peakAcceleration = 0.0;
+    getSCurvePhases(distance, maxSpeed, acceleration, jerk,
+        &jerkTime, &accelerationTime, &cruiseTime, &peakAcceleration);
+    return 4 * jerkTime + 2 * accelerationTime + cruiseTime;
+}
+
+double MotionProfile::getDistance() const {
+    return m_distance;
+}
+
+double MotionProfile::getDuration() const {
+    return m_duration;
+}
+
+double MotionProfile::getPosition(double time) const {
+    const Segment& segment = getSegment(time);
+    double t = std::min(std::max(time, 0.0), m_duration) - segment.start;
+    return (
+        segment.position +
+        segment.speed * t +
+        segment.acceleration * t * t / 2.0 +
+        segment.jerk * t * t * t / 6.0
+    );
+}
+
+double MotionProfile::getSpeed(double time) const {
+    const Segment& segment = getSegment(time);
+    double t = std::min(std::max(time, 0.0), m_duration) - segment.start;
+    return segment.speed + segment.acceleration * t + segment.jerk * t * t / 2.0;
+}
+
+double MotionProfile::getAcceleration(double time) const {
+    const Segment& segment = getSegment(time);
+    double t = std::min(std::max(time, 0.0), m_duration) - segment.start;
+    return segment.acceleration + segment.jerk * t;
+}
+
+double MotionProfile::getTime(double position) const {
+    if (m_distance <= 0.0) {
+        return 0.0;
+    }
+    double index = std::min(std::max(position / m_distance, 0.0), 1.0) * TIME_TABLE_SIZE;
+    int lower = std::min(static_cast<int>(index), TIME_TABLE_SIZE - 1);
+    double fraction = index - lower;
+    return m_times.at(lower) * (1.0 - fraction) + m_times.at(lower + 1) * fraction;
+}
+
+MotionProfile::MotionProfile(double distance, double startSpeed, const std::vector<Segment>& segments) :
+        m_distance(distance),
+        m_duration(0.0),
+        m_segments(segments) {
+
+    // Integrate the state from the start of each segment to the next
+    double position = 0.0;
+    double speed = startSpeed;
+    for (Segment& segment : m_segments) {
+        double t = segment.duration;
+        segment.start = m_duration;
+        segment.position = position;
+        segment.speed = speed;
+        position += speed * t + segment.acceleration * t * t / 2.0 + segment.jerk * t * t * t / 6.0;
+        speed += segment.acceleration * t + segment.jerk * t * t / 2.0;
+        m_duration += t;
+    }
+
+    // Build the time table by bisection, which works since the position
+    // never decreases
+    m_times.resize(TIME_TABLE_SIZE + 1);
+    double lower = 0.0;
+    for (int i = 0; i <= TIME_TABLE_SIZE; i += 1) {
+        double target = m_distance * i / TIME_TABLE_SIZE;
+        double upper = m_duration;
+        for (int j = 0; j < 48; j += 1) {
+            double middle = (lower + upper) / 2.0;
+            if (getPosition(middle) < target) {
+                lower = middle;
+            }
+            else {
+                upper = middle;
+            }
+        }
+        m_times.at(i) = upper;
+    }
+}
+
+MotionProfile::Segment MotionProfile::makeSegment(double duration, double jerk, double acceleration) {
+    Segment segment;
+    segment.start = 0.0;
+    segment.duration = std::max(duration, 0.0);
+    segment.jerk = jerk;
+    segment.position = 0.0;
+    segment.speed = 0.0;
+    segment.acceleration = acceleration;
+    return segment;
+}
+
+const MotionProfile::Segment& MotionProfile::getSegment(double time) const {
+    // There are at most seven segments, so a linear search is plenty fast
+    for (int i = 0; i < static_cast<int>(m_segments.size()) - 1; i += 1) {
+        if (time < m_segments.at(i).start + m_segments.at(i).duration) {
+            return m_segments.at(i);
+        }
+    }
+    return m_segments.back();
+}
+
+bool MotionProfile::getTrapezoidalPhases(
+        double distance, double maxSpeed, double acceleration,
+        double startSpeed, double* endSpeed,
+        double* accelerationTime, double* cruiseTime, double* decelerationTime) {
+
+    // If we can't slow down in time, the profile is impossible, but if we
+    // can't speed up in time, we just end up going a little slower
+    if (2 * acceleration * distance < startSpeed * startSpeed - *endSpeed * *endSpeed) {
+        return false;
+    }
+    *endSpeed = std::min(*endSpeed, std::sqrt(startSpeed * startSpeed + 2 * acceleration * distance));
+
+    // The start and end speeds are never limited by the max speed
+    maxSpeed = std::max(maxSpeed, std::max(startSpeed, *endSpeed));
+
+    // Accelerate for as long as possible, and then decelerate...
+    double peakSpeed = std::sqrt(
+        (2 * acceleration * distance + startSpeed * startSpeed + *endSpeed * *endSpeed) / 2.0);
+    if (peakSpeed <= maxSpeed) {
+        *accelerationTime = (peakSpeed - startSpeed) / acceleration;
+        *cruiseTime = 0.0;
+        *decelerationTime = (peakSpeed - *endSpeed) / acceleration;
+        return true;
+    }
+
+    // ...unless we reach the max speed first, in which case we cruise
+    double accelerationDistance = (maxSpeed * maxSpeed - startSpeed * startSpeed) / (2 * acceleration);
+    double decelerationDistance = (maxSpeed * maxSpeed - *endSpeed * *endSpeed) / (2 * acceleration);
+    *accelerationTime = (maxSpeed - startSpeed) / acceleration;
+    *cruiseTime = (distance - accelerationDistance - decelerationDistance) / maxSpeed;
+    *decelerationTime = (maxSpeed - *endSpeed) / acceleration;
+    return true;
+}
+
+void MotionProfile::getSCurvePhases(
+        double distance, double maxSpeed, double acceleration, double jerk,
+        double* jerkTime, double* accelerationTime, double* cruiseTime, double* peakAcceleration) {
+
+    // Determine the peak speed, which is the max speed if there's enough
+    // distance to reach it, where the time spent speeding up from zero to
+    // some speed v is v / a + a / j if the max acceleration is reached, and
+    // 2 * sqrt(v / j) otherwise, and the distance covered is v * time / 2
+    double peakSpeed = maxSpeed;
+    double speedUpTime = (
+        maxSpeed * jerk < acceleration * acceleration ?
+        2 * std::sqrt(maxSpeed / jerk) :
+        maxSpeed / acceleration + acceleration / jerk
+    );
+    *cruiseTime = (distance - peakSpeed * speedUpTime) / peakSpeed;
+    if (*cruiseTime < 0.0) {
+        *cruiseTime = 0.0;
+        peakSpeed = acceleration / 2.0 * (
+            std::sqrt(std::pow(acceleration / jerk, 2) + 4 * distance / acceleration) - acceleration / jerk
+        );
+        if (peakSpeed * jerk < acceleration * acceleration) {
+            peakSpeed = std::pow(distance * std::sqrt(jerk) / 2.0, 2.0 / 3.0);
+        }
+    }
+
+    // Then determine whether or not the max acceleration is reached
+    *peakAcceleration = std::min(acceleration, std::sqrt(peakSpeed * jerk));
+    *jerkTime = *peakAcceleration / jerk;
+    *accelerationTime = peakSpeed / *peakAcceleration - *jerkTime;
+}
+
+} // namespace motionProfile
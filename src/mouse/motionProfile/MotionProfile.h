@@ -0,0 +1,121 @@
+#pragma once
+
+#include <vector>
+
+namespace motionProfile {
+
+class MotionProfile {
+
+    // A MotionProfile describes how to travel some distance as quickly as
+    // possible, subject to limits on speed, acceleration, and (optionally)
+    // jerk. The units are up to the caller - meters and seconds, degrees and
+    // control loop iterations, etc. - so long as they're consistent.
+    //
+    // A trapezoidal profile (zero jerk limit) accelerates at the maximum
+    // rate, cruises, and then decelerates at the maximum rate. An S-curve
+    // profile (positive jerk limit) additionally ramps the acceleration up
+    // and down, which is gentler on the wheels. Either way, the profile is a
+    // handful of segments of constant jerk, so sampling by time only needs
+    // to find the right segment; sampling by distance uses a lookup table of
+    // times, built once by the constructor.
+
+public:
+
+    // Everything that a profile is generated from, so that a profile can be
+    // tuned (or read from a file) as a single value. A jerk limit of zero
+    // gives a trapezoidal profile; a positive one gives an S-curve profile,
+    // whose start and end speeds must be zero.
+    struct Parameters {
+        double distance;
+        double maxSpeed;
+        double acceleration;
+        double jerk;
+        double startSpeed;
+        double endSpeed;
+    };
+
+    // A trapezoidal or S-curve profile, depending on the jerk limit
+    static MotionProfile generate(const Parameters& parameters);
+
+    // A trapezoidal profile, which may start and end at nonzero speeds
+    static MotionProfile trapezoidal(
+        double distance, double maxSpeed, double acceleration,
+        double startSpeed = 0.0, double endSpeed = 0.0);
+
+    // A jerk-limited S-curve profile, which starts and ends at rest
+    static MotionProfile sCurve(
+        double distance, double maxSpeed, double acceleration, double jerk);
+
+    // The duration of a trapezoidal profile, without building one; returns a
+    // negative number if there isn't enough distance to slow down to
+    // endSpeed, and uses the fastest achievable end speed if there isn't
+    // enough distance to speed up to endSpeed
+    static double getTrapezoidalDuration(
+        double distance, double maxSpeed, double acceleration,
+        double startSpeed, double endSpeed);
+
+    // The duration of a rest-to-rest S-curve profile, without building one
+    static double getSCurveDuration(
+        double distance, double maxSpeed, double acceleration, double jerk);
+
+    double getDistance() const;
+    double getDuration() const;
+
+    // Sample the profile at some time since the start, clamped to the
+    // duration of the profile
+    double getPosition(double time) const;
+    double getSpeed(double time) const;
+    double getAcceleration(double time) const;
+
+    // The time at which the profile reaches some position, clamped to the
+    // distance of the profile
+    double getTime(double position) const;
+
+private:
+
+    // The number of entries in the table used by getTime()
+    static const int TIME_TABLE_SIZE = 256;
+
+    // A part of the profile during which the jerk is constant, along with the
+    // state at the start of that part
+    struct Segment {
+        double start;
+        double duration;
+        double jerk;
+        double position;
+        double speed;
+        double acceleration;
+    };
+
+    double m_distance;
+    double m_duration;
+    std::vector<Segment> m_segments;
+
+    // The times at which the profile reaches evenly spaced positions
+    std::vector<double> m_times;
+
+    // Fills in the start time and state of each segment, given only their
+    // durations, jerks, and initial accelerations
+    MotionProfile(double distance, double startSpeed, const std::vector<Segment>& segments);
+
+    // A segment of the given duration, jerk, and initial acceleration
+    static Segment makeSegment(double duration, double jerk, double acceleration);
+
+    // The segment that contains some (clamped) time
+    const Segment& getSegment(double time) const;
+
+    // The phase durations of a trapezoidal profile, and the achievable end speed
+    static bool getTrapezoidalPhases(
+        double distance, double maxSpeed, double acceleration,
+        double startSpeed, double* endSpeed,
+        double* accelerationTime, double* cruiseTime, double* decelerationTime);
+
+    // The durations of the constant jerk and constant acceleration phases of
+    // the speed up (and slow down) of an S-curve, and the cruising time
+    static void getSCurvePhases(
+        double distance, double maxSpeed, double acceleration, double jerk,
+        double* jerkTime, double* accelerationTime, double* cruiseTime, double* peakAcceleration);
+
+};
+
+} // namespace motionProfile
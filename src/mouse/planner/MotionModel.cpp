@@ -0,0 +1,55 @@
+#include "MotionModel.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../motionProfile/MotionProfile.h"
+
+namespace planner {
+
+MotionModel::MotionModel() :
+        tileLength(0.18),
+        acceleration(4.0),
+        maxSpeed(2.5),
+        maxDiagonalSpeed(1.8),
+        curveSpeed(0.8),
+        diagonalTurnSpeed(1.0),
+        turnAroundSpeed(12.0) {
+}
+
+double MotionModel::getStraightTime(
+        double distance, double startSpeed, double endSpeed, double topSpeed) const {
+    return motionProfile::MotionProfile::getTrapezoidalDuration(
+        distance, topSpeed, acceleration, startSpeed, endSpeed);
+}
+
+double MotionModel::getFinishTime(double distance, double startSpeed, double topSpeed) const {
+    topSpeed = std::max(topSpeed, startSpeed);
+    double endSpeed = std::min(topSpeed, std::sqrt(startSpeed * startSpeed + 2 * acceleration * distance));
+    double accelerationDistance = (endSpeed * endSpeed - startSpeed * startSpeed) / (2 * acceleration);
+    return (endSpeed - startSpeed) / acceleration + (distance - accelerationDistance) / endSpeed;
+}
+
+double MotionModel::getCurveTime() const {
+    // A quarter circle whose radius is half of a tile
+    return M_PI / 4.0 * tileLength / curveSpeed;
+}
+
+double MotionModel::getDiagonalTurnTime() const {
+    // An eighth of a circle whose radius is half of a tile
+    return M_PI / 8.0 * tileLength / diagonalTurnSpeed;
+}
+
+double MotionModel::getTurnAroundTime() const {
+    return M_PI / turnAroundSpeed;
+}
+
+double MotionModel::getTurnAroundExitSpeed() const {
+    // Don't go any faster than the slowest turn, since the turn around might
+    // be immediately followed by any other turn
+    return std::min(
+        std::min(curveSpeed, diagonalTurnSpeed),
+        std::sqrt(acceleration * tileLength));
+}
+
+} // namespace planner
@@ -0,0 +1,51 @@
+#pragma once
+
+namespace planner {
+
+// A description of how fast the mouse can move, which the Planner uses to
+// estimate how long each candidate movement takes. All distances are in
+// meters, all speeds in meters per second, and all accelerations in meters
+// per second squared. The defaults describe a typical classic-size mouse.
+struct MotionModel {
+
+    MotionModel();
+
+    // The distance between the centers of adjacent tiles
+    double tileLength;
+
+    // The magnitude of both the acceleration and the deceleration
+    double acceleration;
+
+    // The top speed along orthogonal and diagonal straightaways
+    double maxSpeed;
+    double maxDiagonalSpeed;
+
+    // The speed through 90 degree curve turns, and through the 45 degree
+    // turns at the entrance and exit of diagonals
+    double curveSpeed;
+    double diagonalTurnSpeed;
+
+    // The angular speed, in radians per second, of an in-place turn around
+    double turnAroundSpeed;
+
+    // The time it takes to travel the given distance, starting at startSpeed
+    // and ending at endSpeed (or as close to it as the acceleration allows),
+    // without exceeding topSpeed; returns a negative number if there isn't
+    // enough distance to slow down to endSpeed
+    double getStraightTime(double distance, double startSpeed, double endSpeed, double topSpeed) const;
+
+    // The time it takes to travel the given distance, starting at startSpeed,
+    // when there's no need to slow down at the end
+    double getFinishTime(double distance, double startSpeed, double topSpeed) const;
+
+    // The time it takes to perform each of the turns
+    double getCurveTime() const;
+    double getDiagonalTurnTime() const;
+    double getTurnAroundTime() const;
+
+    // The speed of the mouse as it leaves the cell after a turn around
+    double getTurnAroundExitSpeed() const;
+
+};
+
+} // namespace planner
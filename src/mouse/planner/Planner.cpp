@@ -0,0 +1,334 @@
+#include "Planner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace planner {
+
+Planner::Planner(int width, int height, const MotionModel& model) :
+        m_width(width),
+        m_height(height),
+        m_model(model),
+        m_walls(width * height, 0),
+        m_goals(width * height, false),
+        m_times(width * height * 4 * SPEED_COUNT + 1),
+        m_steps(width * height * 4 * SPEED_COUNT + 1),
+        m_finalized(width * height * 4 * SPEED_COUNT + 1),
+        m_terminal(width * height * 4 * SPEED_COUNT),
+        m_queueStates(width * height * 4 * SPEED_COUNT + 1),
+        m_positions(width * height * 4 * SPEED_COUNT + 1),
+        m_queue(m_queueStates.data(), m_queueStates.size(), {m_times.data(), m_positions.data()}),
+        m_runTime(-1.0) {
+
+    // Initialize the perimeter of the maze
+    for (int x = 0; x < m_width; x += 1) {
+        setWall(x, 0, SOUTH, true);
+        setWall(x, m_height - 1, NORTH, true);
+    }
+    for (int y = 0; y < m_height; y += 1) {
+        setWall(0, y, WEST, true);
+        setWall(m_width - 1, y, EAST, true);
+    }
+}
+
+void Planner::setWall(int x, int y, int direction, bool isWall) {
+    static int dx[] = {0, 1, 0, -1};
+    static int dy[] = {1, 0, -1, 0};
+    int cells[2][3] = {
+        {x, y, direction},
+        {x + dx[direction], y + dy[direction], (direction + 2) % 4},
+    };
+    for (int i = 0; i < 2; i += 1) {
+        if (inMaze(cells[i][0], cells[i][1])) {
+            unsigned char& walls = m_walls.at(cells[i][0] * m_height + cells[i][1]);
+            walls = (walls & ~(1 << cells[i][2])) | (isWall ? 1 << cells[i][2] : 0);
+        }
+    }
+}
+
+void Planner::clearWalls() {
+    std::fill(m_walls.begin(), m_walls.end(), 0);
+    for (int x = 0; x < m_width; x += 1) {
+        setWall(x, 0, SOUTH, true);
+        setWall(x, m_height - 1, NORTH, true);
+    }
+    for (int y = 0; y < m_height; y += 1) {
+        setWall(0, y, WEST, true);
+        setWall(m_width - 1, y, EAST, true);
+    }
+}
+
+void Planner::addGoal(int x, int y) {
+    m_goals.at(x * m_height + y) = true;
+}
+
+void Planner::clearGoals() {
+    std::fill(m_goals.begin(), m_goals.end(), false);
+}
+
+std::vector<Move> Planner::plan(int x, int y, int direction) {
+
+    m_runTime = -1.0;
+    if (!inMaze(x, y)) {
+        return {};
+    }
+    if (isGoal(x, y)) {
+        m_runTime = 0.0;
+        return {};
+    }
+
+    // Reset the search data
+    std::fill(m_times.begin(), m_times.end(), std::numeric_limits<double>::infinity());
+    std::fill(m_finalized.begin(), m_finalized.end(), false);
+    m_queue.clear();
+
+    // Dijkstra's algo, using an indexed heap with decrease-key
+    int start = getState(x, y, direction, STOPPED);
+    m_times.at(start) = 0.0;
+    m_steps.at(start).previous = -1;
+    m_queue.push(start);
+    while (!m_queue.empty()) {
+
+        int state = m_queue.pop();
+        m_finalized.at(state) = true;
+
+        // The first time that we reach the terminal state is the fastest
+        if (state == m_terminal) {
+            m_runTime = m_times.at(m_terminal);
+            return getMoves();
+        }
+
+        // Decode the state, and never expand goal cells, since the run is
+        // already over by the time the mouse enters one
+        int speed = state % SPEED_COUNT;
+        int d = (state / SPEED_COUNT) % 4;
+        int cell = state / SPEED_COUNT / 4;
+        if (isGoal(cell / m_height, cell % m_height)) {
+            relax(state, m_terminal, 0.0, 0, Move::FORWARD, 0);
+            continue;
+        }
+        expand(state, cell / m_height, cell % m_height, d, speed);
+    }
+
+    // No path to the goal exists
+    return {};
+}
+
+double Planner::getRunTime() const {
+    return m_runTime;
+}
+
+void Planner::execute(const std::vector<Move>& moves, sim::MouseInterface* mouse) {
+    for (const Move& move : moves) {
+        switch (move.type) {
+            case Move::FORWARD:
+                mouse->moveForwardToEdge(move.count);
+                break;
+            case Move::CURVE_LEFT:
+                mouse->turnLeftToEdge();
+                break;
+            case Move::CURVE_RIGHT:
+                mouse->turnRightToEdge();
+                break;
+            case Move::TURN_AROUND:
+                mouse->turnAroundLeftToEdge();
+                break;
+            case Move::DIAGONAL_LEFT_LEFT:
+                mouse->diagonalLeftLeft(move.count);
+                break;
+            case Move::DIAGONAL_LEFT_RIGHT:
+                mouse->diagonalLeftRight(move.count);
+                break;
+            case Move::DIAGONAL_RIGHT_LEFT:
+                mouse->diagonalRightLeft(move.count);
+                break;
+            case Move::DIAGONAL_RIGHT_RIGHT:
+                mouse->diagonalRightRight(move.count);
+                break;
+        }
+    }
+}
+
+bool Planner::inMaze(int x, int y) const {
+    return 0 <= x && x < m_width && 0 <= y && y < m_height;
+}
+
+bool Planner::isWall(int x, int y, int direction) const {
+    return (m_walls.at(x * m_height + y) >> direction) & 1;
+}
+
+bool Planner::isGoal(int x, int y) const {
+    return m_goals.at(x * m_height + y);
+}
+
+int Planner::getState(int x, int y, int direction, int speed) const {
+    return ((x * m_height + y) * 4 + direction) * SPEED_COUNT + speed;
+}
+
+double Planner::getSpeed(int speed) const {
+    switch (speed) {
+        case CURVE:
+            return m_model.curveSpeed;
+        case DIAGONAL:
+            return m_model.diagonalTurnSpeed;
+        case AROUND:
+            return m_model.getTurnAroundExitSpeed();
+    }
+    return 0.0;
+}
+
+void Planner::relax(int from, int to, double time, int straightaway, Move::Type type, int count) {
+    // Impossible movements have negative times
+    if (time < 0.0 || m_finalized.at(to)) {
+        return;
+    }
+    double total = m_times.at(from) + time;
+    if (total < m_times.at(to)) {
+        m_times.at(to) = total;
+        m_steps.at(to).previous = from;
+        m_steps.at(to).straightaway = straightaway;
+        m_steps.at(to).turn.type = type;
+        m_steps.at(to).turn.count = count;
+        m_queue.pushOrDecrease(to);
+    }
+}
+
+void Planner::expand(int state, int x, int y, int direction, int speed) {
+
+    static int dx[] = {0, 1, 0, -1};
+    static int dy[] = {1, 0, -1, 0};
+
+    double tile = m_model.tileLength;
+    double halfDiagonal = tile * std::sqrt(2.0) / 2.0;
+    double startSpeed = getSpeed(speed);
+    int left = (direction + 3) % 4;
+    int right = (direction + 1) % 4;
+    int back = (direction + 2) % 4;
+
+    // Try every straightaway length, and every turn at the end of each
+    for (int n = 0; true; n += 1) {
+
+        int cx = x + n * dx[direction];
+        int cy = y + n * dy[direction];
+        double distance = n * tile;
+
+        // Run straight into the goal
+        if (0 < n && isGoal(cx, cy)) {
+            relax(state, m_terminal, m_model.getFinishTime(distance, startSpeed, m_model.maxSpeed),
+                n, Move::FORWARD, 0);
+            break;
+        }
+
+        // 90 degree curve turns, out of the side of the cell
+        double curveTime = m_model.getStraightTime(
+            distance, startSpeed, m_model.curveSpeed, m_model.maxSpeed);
+        if (0.0 <= curveTime) {
+            if (!isWall(cx, cy, left)) {
+                relax(state, getState(cx + dx[left], cy + dy[left], left, CURVE),
+                    curveTime + m_model.getCurveTime(), n, Move::CURVE_LEFT, 0);
+            }
+            if (!isWall(cx, cy, right)) {
+                relax(state, getState(cx + dx[right], cy + dy[right], right, CURVE),
+                    curveTime + m_model.getCurveTime(), n, Move::CURVE_RIGHT, 0);
+            }
+        }
+
+        // Turn around in the center of the cell, and leave the way we came
+        double aroundTime = m_model.getStraightTime(
+            distance + tile / 2.0, startSpeed, 0.0, m_model.maxSpeed);
+        if (0.0 <= aroundTime && !isWall(cx, cy, back)) {
+            relax(state, getState(cx + dx[back], cy + dy[back], back, AROUND),
+                aroundTime + m_model.getTurnAroundTime() + m_model.getStraightTime(
+                    tile / 2.0, 0.0, m_model.getTurnAroundExitSpeed(), m_model.maxSpeed),
+                n, Move::TURN_AROUND, 0);
+        }
+
+        // Diagonals, which zigzag through the edges on one side and the front
+        // of the cells; an odd number of segments leaves the mouse facing the
+        // side that it first turned towards, and an even number leaves it
+        // facing its original direction
+        double diagonalTime = m_model.getStraightTime(
+            distance, startSpeed, m_model.diagonalTurnSpeed, m_model.maxSpeed);
+        for (int i = 0; 0.0 <= diagonalTime && i < 2; i += 1) {
+            bool startLeft = (i == 0);
+            int side = (startLeft ? left : right);
+            int hx = cx;
+            int hy = cy;
+            for (int k = 1; true; k += 1) {
+                int crossing = (k % 2 == 1 ? side : direction);
+                if (isWall(hx, hy, crossing)) {
+                    break;
+                }
+                hx += dx[crossing];
+                hy += dy[crossing];
+                double time = diagonalTime + 2 * m_model.getDiagonalTurnTime() +
+                    m_model.getStraightTime(k * halfDiagonal, m_model.diagonalTurnSpeed,
+                        m_model.diagonalTurnSpeed, m_model.maxDiagonalSpeed);
+                Move::Type type = (
+                    startLeft ?
+                    (k % 2 == 1 ? Move::DIAGONAL_LEFT_LEFT : Move::DIAGONAL_LEFT_RIGHT) :
+                    (k % 2 == 1 ? Move::DIAGONAL_RIGHT_RIGHT : Move::DIAGONAL_RIGHT_LEFT)
+                );
+                relax(state, getState(hx, hy, crossing, DIAGONAL), time, n, type, k);
+                if (isGoal(hx, hy)) {
+                    break;
+                }
+            }
+        }
+
+        // Continue the straightaway into the next cell, if possible
+        if (isWall(cx, cy, direction)) {
+            break;
+        }
+    }
+}
+
+std::vector<Move> Planner::getMoves() const {
+
+    // Walk back from the terminal state to the start state
+    std::vector<Move> moves;
+    int state = m_terminal;
+    while (m_steps.at(state).previous != -1) {
+        const Step& step = m_steps.at(state);
+        if (!(step.turn.type == Move::FORWARD && step.turn.count == 0)) {
+            moves.push_back(step.turn);
+        }
+        if (0 < step.straightaway) {
+            Move forward;
+            forward.type = Move::FORWARD;
+            forward.count = step.straightaway;
+            moves.push_back(forward);
+        }
+        state = step.previous;
+    }
+    std::reverse(moves.begin(), moves.end());
+
+    // Merge adjacent straightaways, which can happen when a straightaway
+    // runs into the goal right after a turn
+    std::vector<Move> compressed;
+    for (const Move& move : moves) {
+        if (move.type == Move::FORWARD && !compressed.empty() &&
+                compressed.back().type == Move::FORWARD) {
+            compressed.back().count += move.count;
+        }
+        else {
+            compressed.push_back(move);
+        }
+    }
+    return compressed;
+}
+
+bool Planner::QueueTraits::less(int one, int two) const {
+    return times[one] < times[two];
+}
+
+int Planner::QueueTraits::getPosition(int state) const {
+    return positions[state];
+}
+
+void Planner::QueueTraits::setPosition(int state, int position) {
+    positions[state] = position;
+}
+
+} // namespace planner
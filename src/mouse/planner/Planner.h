@@ -0,0 +1,141 @@
+#pragma once
+
+#include <vector>
+
+#include "../../sim/MouseInterface.h"
+#include "../indexedHeap/IndexedHeap.h"
+#include "MotionModel.h"
+
+namespace planner {
+
+// A single tile-edge movement, which maps directly onto one of the special
+// discrete interface methods (see Planner::execute)
+struct Move {
+
+    enum Type {
+        FORWARD,
+        CURVE_LEFT,
+        CURVE_RIGHT,
+        TURN_AROUND,
+        DIAGONAL_LEFT_LEFT,
+        DIAGONAL_LEFT_RIGHT,
+        DIAGONAL_RIGHT_LEFT,
+        DIAGONAL_RIGHT_RIGHT,
+    };
+
+    Type type;
+
+    // The number of tiles for FORWARD, the number of half-tile diagonal
+    // segments for the DIAGONAL types, and unused otherwise
+    int count;
+
+};
+
+class Planner {
+
+    // The Planner finds the path to the goal that takes the least amount of
+    // time to run, as opposed to the one that visits the fewest cells. It runs
+    // Dijkstra's algo over states of the form (cell, heading, speed), where
+    // each state describes the mouse sitting on the edge of a cell, about to
+    // enter it. Each edge of the search is a straightaway of zero or more
+    // cells followed by a 90 degree curve turn, a turn around, or an entire
+    // diagonal (including its 45 degree entrance and exit turns), and its
+    // cost is the time that the MotionModel says that it takes. Since every
+    // kind of turn is performed at one fixed speed, the speed part of the
+    // state is just the kind of turn that was most recently performed.
+
+public:
+
+    Planner(int width, int height, const MotionModel& model);
+
+    // Walls that have not been set are assumed to not exist, so callers that
+    // want a guaranteed-safe run should set unknown walls to true
+    void setWall(int x, int y, int direction, bool isWall);
+    void clearWalls();
+
+    // The run ends as soon as the mouse enters any goal cell
+    void addGoal(int x, int y);
+    void clearGoals();
+
+    // Plans a run for a mouse at rest on the edge of (x, y), facing the given
+    // direction, about to enter the cell. For a mouse in the origin, this is
+    // the position right after a call to originMoveForwardToEdge(). Returns an
+    // empty vector if there is no path, or if (x, y) is already a goal.
+    std::vector<Move> plan(int x, int y, int direction);
+
+    // The estimated run time, in seconds, of the most recent plan, or a
+    // negative number if no path was found
+    double getRunTime() const;
+
+    // Performs the moves using the special discrete interface methods
+    static void execute(const std::vector<Move>& moves, sim::MouseInterface* mouse);
+
+private:
+
+    enum {NORTH = 0, EAST = 1, SOUTH = 2, WEST = 3};
+
+    // The kind of turn most recently performed, which determines the speed
+    enum {STOPPED = 0, CURVE = 1, DIAGONAL = 2, AROUND = 3, SPEED_COUNT = 4};
+
+    // How the search arrived at a particular state: a straightaway of some
+    // number of cells from the previous state, followed by a single turn
+    struct Step {
+        int previous;
+        int straightaway;
+        Move turn;
+    };
+
+    int m_width;
+    int m_height;
+    MotionModel m_model;
+
+    // Four bits per cell, one for each wall, and whether or not each cell is
+    // a goal
+    std::vector<unsigned char> m_walls;
+    std::vector<bool> m_goals;
+
+    // Per-state search data, which is kept between calls to avoid allocation;
+    // the extra state at the end is the terminal state, for finished runs
+    std::vector<double> m_times;
+    std::vector<Step> m_steps;
+    std::vector<bool> m_finalized;
+    int m_terminal;
+
+    // The traits (see IndexedHeap.h) of the queue of states, which orders
+    // states by their time so far and keeps their positions in m_positions
+    struct QueueTraits {
+        typedef int Item;
+        typedef int Index;
+        const double* times;
+        int* positions;
+        bool less(int one, int two) const;
+        int getPosition(int state) const;
+        void setPosition(int state, int position);
+    };
+
+    // The queue of states, each of which appears at most once, so that
+    // improving a state's time is a decrease-key instead of another push
+    std::vector<int> m_queueStates;
+    std::vector<int> m_positions;
+    indexedHeap::IndexedHeap<QueueTraits> m_queue;
+
+    double m_runTime;
+
+    bool inMaze(int x, int y) const;
+    bool isWall(int x, int y, int direction) const;
+    bool isGoal(int x, int y) const;
+    int getState(int x, int y, int direction, int speed) const;
+    double getSpeed(int speed) const;
+
+    // Records a step to a state if it's faster than the best so far
+    void relax(int from, int to, double time, int straightaway, Move::Type type, int count);
+
+    // Adds all of the steps out of a single state to the queue
+    void expand(int state, int x, int y, int direction, int speed);
+
+    // Walks the steps back from the terminal state, and compresses the moves
+    std::vector<Move> getMoves() const;
+
+};
+
+} // namespace planner
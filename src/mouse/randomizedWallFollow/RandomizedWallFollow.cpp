@@ -1,7 +1,5 @@
 #include "RandomizedWallFollow.h"
 
-#include <cstdlib>
-
 namespace randomizedWallFollow {
 
 bool RandomizedWallFollow::declareWallOnRead() const {
@@ -16,7 +14,7 @@ void RandomizedWallFollow::solve(
         int mazeWidth, int mazeHeight, bool isOfficialMaze,
         char initialDirection, sim::MouseInterface* mouse) {
     while (true){
-        if (rand() % 2 == 0){
+        if (mouse->getRandom() < 0.5){
             rightWallFollowStep(mouse);
         }
         else{
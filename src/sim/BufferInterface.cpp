@@ -1,16 +1,20 @@
 #include "BufferInterface.h"
 
+#include "Assert.h"
 #include "RGB.h"
 
 namespace sim {
 
 BufferInterface::BufferInterface(
         QPair<int, int> mazeSize,
+        int chunkSize,
         QVector<TriangleGraphic>* graphicCpuBuffer,
         QVector<TriangleTexture>* textureCpuBuffer) :
-        m_mazeSize(mazeSize),
+        m_chunks(mazeSize.first, mazeSize.second, chunkSize),
+        m_tileGraphicsChanged(false),
         m_graphicCpuBuffer(graphicCpuBuffer),
         m_textureCpuBuffer(textureCpuBuffer) {
+    m_chunkSlots.fill(-1, m_chunks.getNumberOfChunks());
 }
 
 void BufferInterface::initTileGraphicText(
@@ -35,18 +39,17 @@ QPair<int, int> BufferInterface::getTileGraphicTextMaxSize() {
     return m_tileGraphicTextCache.getTileGraphicTextMaxSize();
 }
 
-void BufferInterface::insertIntoGraphicCpuBuffer(const Polygon& polygon, Color color, double alpha) {
-    QVector<TriangleGraphic> tgs = polygonToTriangleGraphics(polygon, color, alpha);
-    for (int i = 0; i < tgs.size(); i += 1) {
-        m_graphicCpuBuffer->push_back(tgs.at(i));
-    }
-}
+void BufferInterface::initTileGraphics(int numberOfSlots) {
 
-void BufferInterface::insertIntoTextureCpuBuffer() {
-    // Here we just insert dummy TriangleTexture objects. All of the actual
-    // values of the objects will be set on calls to the update method.
-    // However, we do intentionally insert the appropriate 'v' values, since
-    // these will never change.
+    SIM_ASSERT_TR(m_graphicCpuBuffer->isEmpty());
+    SIM_ASSERT_TR(m_textureCpuBuffer->isEmpty());
+    SIM_ASSERT_LE(numberOfSlots, m_chunks.getNumberOfChunks());
+    int numberOfTiles = numberOfSlots * m_chunks.getTilesPerChunk();
+    m_graphicCpuBuffer->resize(numberOfTiles * trianglesPerTile());
+
+    // All of the actual values of the texture triangles will be set on calls
+    // to the update method. However, we do intentionally set the appropriate
+    // 'v' values here, since these will never change.
     TriangleTexture t1 {
         // x    y    u    v
         {0.0, 0.0, 0.0, 0.0},
@@ -58,12 +61,80 @@ void BufferInterface::insertIntoTextureCpuBuffer() {
         {0.0, 0.0, 0.0, 1.0},
         {0.0, 0.0, 0.0, 0.0},
     };
-    m_textureCpuBuffer->push_back(t1);
-    m_textureCpuBuffer->push_back(t2);
+    m_textureCpuBuffer->resize(numberOfTiles * triangleTexturesPerTile());
+    for (int i = 0; i < m_textureCpuBuffer->size(); i += 2) {
+        (*m_textureCpuBuffer)[i] = t1;
+        (*m_textureCpuBuffer)[i + 1] = t2;
+    }
+    markTileGraphicsChanged();
+}
+
+const MazeChunks& BufferInterface::getChunks() const {
+    return m_chunks;
+}
+
+int BufferInterface::getChunkSlot(int chunk) const {
+    return m_chunkSlots.at(chunk);
+}
+
+void BufferInterface::setChunkSlot(int chunk, int slot) {
+    // A chunk is drawn right after it's given a slot, before the buffers are
+    // next uploaded, so the rectangles that are drawn needn't each be noted
+    m_chunkSlots[chunk] = slot;
+    markTileGraphicsChanged();
+}
+
+QPair<int, int> BufferInterface::getChunkTriangleGraphics(int chunk) {
+    int count = m_chunks.getTilesPerChunk() * trianglesPerTile();
+    return {m_chunkSlots.at(chunk) * count, count};
+}
+
+QPair<int, int> BufferInterface::getChunkTriangleTextures(int chunk) {
+    int count = m_chunks.getTilesPerChunk() * triangleTexturesPerTile();
+    return {m_chunkSlots.at(chunk) * count, count};
+}
+
+bool BufferInterface::takeTileGraphicsChanged() {
+    return m_tileGraphicsChanged.exchange(false);
+}
+
+bool BufferInterface::getTileGraphicsChanged() const {
+    return m_tileGraphicsChanged.load(std::memory_order_relaxed);
+}
+
+void BufferInterface::markTileGraphicsChanged() {
+    // Tiles may be updated from many threads at once, so only write the flag
+    // if it isn't already set
+    if (!m_tileGraphicsChanged.load(std::memory_order_relaxed)) {
+        m_tileGraphicsChanged.store(true, std::memory_order_relaxed);
+    }
+}
+
+void BufferInterface::drawTileGraphicBase(
+        int x, int y, const QPair<Cartesian, Cartesian>& rectangle, Color color) {
+    setRectangle(getTileGraphicBaseStartingIndex(x, y), rectangle, color, 1.0);
+}
+
+void BufferInterface::drawTileGraphicWall(int x, int y, Direction direction,
+        const QPair<Cartesian, Cartesian>& rectangle, Color color, double alpha) {
+    setRectangle(getTileGraphicWallStartingIndex(x, y, direction), rectangle, color, alpha);
+}
+
+void BufferInterface::drawTileGraphicCorner(int x, int y, int cornerNumber,
+        const QPair<Cartesian, Cartesian>& rectangle, Color color) {
+    setRectangle(getTileGraphicCornerStartingIndex(x, y, cornerNumber), rectangle, color, 1.0);
+}
+
+void BufferInterface::drawTileGraphicFog(int x, int y,
+        const QPair<Cartesian, Cartesian>& rectangle, Color color, double alpha) {
+    setRectangle(getTileGraphicFogStartingIndex(x, y), rectangle, color, alpha);
 }
 
 void BufferInterface::updateTileGraphicBaseColor(int x, int y, Color color) {
     int index = getTileGraphicBaseStartingIndex(x, y);
+    if (index < 0) {
+        return;
+    }
     RGB rgb = COLOR_TO_RGB.value(color);
     for (int i = 0; i < 2; i += 1) {
         TriangleGraphic* triangleGraphic = &(*m_graphicCpuBuffer)[index + i];
@@ -71,10 +142,14 @@ void BufferInterface::updateTileGraphicBaseColor(int x, int y, Color color) {
         triangleGraphic->p2.rgb = rgb;
         triangleGraphic->p3.rgb = rgb;
     }
+    markTileGraphicsChanged();
 }
 
 void BufferInterface::updateTileGraphicWallColor(int x, int y, Direction direction, Color color, double alpha) {
     int index = getTileGraphicWallStartingIndex(x, y, direction);
+    if (index < 0) {
+        return;
+    }
     RGB rgb = COLOR_TO_RGB.value(color);
     for (int i = 0; i < 2; i += 1) {
         TriangleGraphic* triangleGraphic = &(*m_graphicCpuBuffer)[index + i];
@@ -85,16 +160,21 @@ void BufferInterface::updateTileGraphicWallColor(int x, int y, Direction directi
         triangleGraphic->p2.a = alpha;
         triangleGraphic->p3.a = alpha;
     }
+    markTileGraphicsChanged();
 }
 
 void BufferInterface::updateTileGraphicFog(int x, int y, double alpha) {
     int index = getTileGraphicFogStartingIndex(x, y);
+    if (index < 0) {
+        return;
+    }
     for (int i = 0; i < 2; i += 1) {
         TriangleGraphic* triangleGraphic = &(*m_graphicCpuBuffer)[index + i];
         triangleGraphic->p1.a = alpha;
         triangleGraphic->p2.a = alpha;
         triangleGraphic->p3.a = alpha;
     }
+    markTileGraphicsChanged();
 }
 
 void BufferInterface::updateTileGraphicText(int x, int y, int numRows, int numCols, int row, int col, QChar c) {
@@ -107,13 +187,17 @@ void BufferInterface::updateTileGraphicText(int x, int y, int numRows, int numCo
     //    | /         |    | /       /         |
     //   [LL]---------+   [p1]     [p1]------[p3]
 
+    int triangleTextureIndex = getTileGraphicTextStartingIndex(x, y, row, col);
+    if (triangleTextureIndex < 0) {
+        return;
+    }
+
     QPair<double, double> fontImageCharacterPosition =
         m_tileGraphicTextCache.getFontImageCharacterPosition(c);
 
     QPair<Cartesian, Cartesian> LL_UR =
         m_tileGraphicTextCache.getTileGraphicTextPosition(x, y, numRows, numCols, row, col);
 
-    int triangleTextureIndex = getTileGraphicTextStartingIndex(x, y, row, col);
     TriangleTexture* t1 = &(*m_textureCpuBuffer)[triangleTextureIndex];
     TriangleTexture* t2 = &(*m_textureCpuBuffer)[triangleTextureIndex + 1];
 
@@ -136,12 +220,28 @@ void BufferInterface::updateTileGraphicText(int x, int y, int numRows, int numCo
     t2->p3.x = LL_UR.second.getX().getMeters();
     t2->p3.y = LL_UR.first.getY().getMeters();
     t2->p3.u = fontImageCharacterPosition.second;
+    markTileGraphicsChanged();
 }
 
 void BufferInterface::drawMousePolygon(const Polygon& polygon, Color color, double sensorAlpha) {
     m_graphicCpuBuffer->append(polygonToTriangleGraphics(polygon, color, sensorAlpha));
 }
 
+void BufferInterface::drawMouseGeometry(
+        const MouseGeometry& geometry, const MouseGeometry::Vertices& vertices,
+        int part, Color color, double alpha) {
+    RGB colorValues = COLOR_TO_RGB.value(color);
+    geometry.forEachTriangle(part, vertices,
+        [&](double x1, double y1, double x2, double y2, double x3, double y3) {
+            m_graphicCpuBuffer->push_back({
+                {x1, y1, colorValues, alpha},
+                {x2, y2, colorValues, alpha},
+                {x3, y3, colorValues, alpha}
+            });
+        }
+    );
+}
+
 QVector<TriangleGraphic> BufferInterface::polygonToTriangleGraphics(const Polygon& polygon, Color color, double alpha) {
     QVector<Triangle> triangles = polygon.getTriangles();
     QVector<TriangleGraphic> triangleGraphics;
@@ -156,6 +256,38 @@ QVector<TriangleGraphic> BufferInterface::polygonToTriangleGraphics(const Polygo
     return triangleGraphics;
 }
 
+void BufferInterface::setRectangle(
+        int index, const QPair<Cartesian, Cartesian>& rectangle, Color color, double alpha) {
+
+    //   [UL]-------[UR]
+    //    |         / |
+    //    |  t1   /   |
+    //    |     /     |
+    //    |   /   t2  |
+    //    | /         |
+    //   [LL]-------[LR]
+
+    if (index < 0) {
+        return;
+    }
+    RGB rgb = COLOR_TO_RGB.value(color);
+    double left = rectangle.first.getX().getMeters();
+    double bottom = rectangle.first.getY().getMeters();
+    double right = rectangle.second.getX().getMeters();
+    double top = rectangle.second.getY().getMeters();
+    TriangleGraphic* triangleGraphics = m_graphicCpuBuffer->data() + index;
+    triangleGraphics[0] = {
+        {left, bottom, rgb, alpha},
+        {left, top, rgb, alpha},
+        {right, top, rgb, alpha},
+    };
+    triangleGraphics[1] = {
+        {left, bottom, rgb, alpha},
+        {right, top, rgb, alpha},
+        {right, bottom, rgb, alpha},
+    };
+}
+
 int BufferInterface::trianglesPerTile() {
     // This value must be predetermined, and was done so as follows:
     // Base polygon:      2 (2 triangles x 1 polygon  per tile)
@@ -167,26 +299,48 @@ int BufferInterface::trianglesPerTile() {
     return 20;
 }
 
+int BufferInterface::getTileSlotIndex(int x, int y) {
+    int slot = m_chunkSlots.at(m_chunks.getChunk(x, y));
+    if (slot < 0) {
+        return -1;
+    }
+    return slot * m_chunks.getTilesPerChunk() + m_chunks.getIndexInChunk(x, y);
+}
+
 int BufferInterface::getTileGraphicBaseStartingIndex(int x, int y) {
-    return  0 + trianglesPerTile() * (m_mazeSize.second * x + y);
+    int tileIndex = getTileSlotIndex(x, y);
+    return (tileIndex < 0 ? -1 :  0 + trianglesPerTile() * tileIndex);
 }
 
 int BufferInterface::getTileGraphicWallStartingIndex(int x, int y, Direction direction) {
-    return  2 + trianglesPerTile() * (m_mazeSize.second * x + y) + (2 * DIRECTIONS.indexOf(direction));
+    int tileIndex = getTileSlotIndex(x, y);
+    return (tileIndex < 0 ? -1 :  2 + trianglesPerTile() * tileIndex + (2 * DIRECTIONS.indexOf(direction)));
 }
 
 int BufferInterface::getTileGraphicCornerStartingIndex(int x, int y, int cornerNumber) {
-    return 10 + trianglesPerTile() * (m_mazeSize.second * x + y) + (2 * cornerNumber);
+    int tileIndex = getTileSlotIndex(x, y);
+    return (tileIndex < 0 ? -1 : 10 + trianglesPerTile() * tileIndex + (2 * cornerNumber));
 }
 
 int BufferInterface::getTileGraphicFogStartingIndex(int x, int y) {
-    return 18 + trianglesPerTile() * (m_mazeSize.second * x + y);
+    int tileIndex = getTileSlotIndex(x, y);
+    return (tileIndex < 0 ? -1 : 18 + trianglesPerTile() * tileIndex);
+}
+
+int BufferInterface::triangleTexturesPerTile() {
+    // Two triangles for each possible character
+    QPair<int, int> maxRowsAndCols = getTileGraphicTextMaxSize();
+    return 2 * maxRowsAndCols.first * maxRowsAndCols.second;
 }
 
 int BufferInterface::getTileGraphicTextStartingIndex(int x, int y, int row, int col) {
     static QPair<int, int> maxRowsAndCols = getTileGraphicTextMaxSize();
-    static int triangleTexturesPerTile = 2 * maxRowsAndCols.first * maxRowsAndCols.second;
-    return triangleTexturesPerTile * (m_mazeSize.second * x + y) + 2 * (row * maxRowsAndCols.second + col);
+    static int texturesPerTile = triangleTexturesPerTile();
+    int tileIndex = getTileSlotIndex(x, y);
+    if (tileIndex < 0) {
+        return -1;
+    }
+    return texturesPerTile * tileIndex + 2 * (row * maxRowsAndCols.second + col);
 }
 
 } // namespace sim
@@ -5,8 +5,12 @@
 #include <QPair>
 #include <QVector>
 
+#include <atomic>
+
 #include "Color.h"
 #include "Direction.h"
+#include "MazeChunks.h"
+#include "MouseGeometry.h"
 #include "Polygon.h"
 #include "TileGraphicTextCache.h"
 #include "TileTextAlignment.h"
@@ -20,6 +24,7 @@ class BufferInterface {
 public:
     BufferInterface(
         QPair<int, int> mazeSize,
+        int chunkSize,
         QVector<TriangleGraphic>* graphicCpuBuffer,
         QVector<TriangleTexture>* textureCpuBuffer);
 
@@ -36,9 +41,44 @@ public:
     // Returns the maximum number of rows and columns of text in a tile graphic
     QPair<int, int> getTileGraphicTextMaxSize();
 
-    // Fills the graphic cpu buffer and texture cpu buffer
-    void insertIntoGraphicCpuBuffer(const Polygon& polygon, Color color, double alpha);
-    void insertIntoTextureCpuBuffer();
+    // The tiles' parts of the buffers are split into slots, each of which can
+    // hold one chunk of the maze (see MazeChunks.h). This allocates the given
+    // number of slots in both the graphic cpu buffer and the texture cpu
+    // buffer, which must both be empty. The slots are then assigned to
+    // chunks with setChunkSlot(), and within a slot, every part of every tile
+    // has a fixed place, so the tiles may be drawn in any order.
+    void initTileGraphics(int numberOfSlots);
+
+    const MazeChunks& getChunks() const;
+
+    // The slot of a chunk, or -1 if the chunk doesn't have one. The drawing
+    // and update methods below do nothing for tiles in chunks without slots.
+    int getChunkSlot(int chunk) const;
+    void setChunkSlot(int chunk, int slot);
+
+    // The first triangle, and the number of triangles, of a chunk's slot in
+    // the graphic cpu buffer and texture cpu buffer, respectively
+    QPair<int, int> getChunkTriangleGraphics(int chunk);
+    QPair<int, int> getChunkTriangleTextures(int chunk);
+
+    // Whether or not the tiles' parts of the buffers have been written to
+    // since the last time this was called
+    bool takeTileGraphicsChanged();
+
+    // The same, but without clearing the flag, so that the View can check
+    // whether or not there's anything new to draw
+    bool getTileGraphicsChanged() const;
+
+    // Fill in the parts of a tile, each of which is a rectangle given by its
+    // lower left and upper right points. These only write to the tile's own
+    // place in the buffer, so they may be called concurrently for different tiles.
+    void drawTileGraphicBase(int x, int y, const QPair<Cartesian, Cartesian>& rectangle, Color color);
+    void drawTileGraphicWall(int x, int y, Direction direction,
+        const QPair<Cartesian, Cartesian>& rectangle, Color color, double alpha);
+    void drawTileGraphicCorner(int x, int y, int cornerNumber,
+        const QPair<Cartesian, Cartesian>& rectangle, Color color);
+    void drawTileGraphicFog(int x, int y,
+        const QPair<Cartesian, Cartesian>& rectangle, Color color, double alpha);
 
     // These methods are inexpensive, and may be called many times
     void updateTileGraphicBaseColor(int x, int y, Color color);
@@ -49,10 +89,18 @@ public:
     // Appends a mouse polygon to the graphic cpu buffer
     void drawMousePolygon(const Polygon& polygon, Color color, double sensorAlpha);
 
+    // Appends a part of the (already transformed) mouse geometry to the
+    // graphic cpu buffer, without building a polygon for it
+    void drawMouseGeometry(
+        const MouseGeometry& geometry, const MouseGeometry::Vertices& vertices,
+        int part, Color color, double alpha);
+
 private:
 
-    // The width and height of the maze
-    QPair<int, int> m_mazeSize;
+    // The chunks of the maze, and the slot of each
+    MazeChunks m_chunks;
+    QVector<int> m_chunkSlots;
+    std::atomic<bool> m_tileGraphicsChanged;
 
     // CPU-side buffers
     QVector<TriangleGraphic>* m_graphicCpuBuffer;
@@ -64,14 +112,26 @@ private:
     // Converts a polygon to a vector of triangle graphics or triangle textures
     QVector<TriangleGraphic> polygonToTriangleGraphics(const Polygon& polygon, Color color, double alpha);
 
-    // Retrieve the indices into the graphic cpu buffer for each specific type of Tile triangle
+    void markTileGraphicsChanged();
+
+    // Writes the two triangles of a rectangle to the graphic cpu buffer
+    void setRectangle(int index, const QPair<Cartesian, Cartesian>& rectangle, Color color, double alpha);
+
+    // The place of a tile among the tiles of all of the slots, or -1 if the
+    // tile's chunk doesn't have a slot
+    int getTileSlotIndex(int x, int y);
+
+    // Retrieve the indices into the graphic cpu buffer for each specific type
+    // of Tile triangle, all of which are negative if the tile has no slot
     int trianglesPerTile();
     int getTileGraphicBaseStartingIndex(int x, int y);
     int getTileGraphicWallStartingIndex(int x, int y, Direction direction);
     int getTileGraphicCornerStartingIndex(int x, int y, int cornerNumber);
     int getTileGraphicFogStartingIndex(int x, int y);
 
-    // Retrieve the indices into the texture cpu buffer
+    // Retrieve the indices into the texture cpu buffer, which are likewise
+    // negative if the tile has no slot
+    int triangleTexturesPerTile();
     int getTileGraphicTextStartingIndex(int x, int y, int row, int col);
 
 };
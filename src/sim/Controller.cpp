@@ -13,7 +13,9 @@ namespace sim {
 static const QString& OPENING_DIRECTION_STRING = "OPENING";
 static const QString& WALL_DIRECTION_STRING = "WALL";
 
-Controller::Controller(Model* model, View* view) {
+Controller::Controller(Model* model, View* view) :
+        m_mouseAlgorithm(nullptr),
+        m_mouseInterface(nullptr) {
 
     // TODO: MACK
     m_options.mouseFile = "default.xml";
@@ -69,7 +71,8 @@ Controller::Controller(Model* model, View* view) {
         view->getMazeGraphic(),
         m_mouseAlgorithm,
         view->getAllowableTileTextCharacters(),
-        m_options
+        m_options,
+        model->getRandom().getStream(Random::MOUSE_ALGORITHM)
     );
     */
 }
@@ -165,16 +168,21 @@ void Controller::initAndValidateMouse(
         const QString& initialDirection,
         Model* model) {
 
-    // Initialize the mouse with the file provided
+    // Initialize each of the mice with the file provided
     Direction direction = getInitialDirection(initialDirection, model);
-    bool success = model->getMouse()->initialize(mouseFile, direction);
-    if (!success) {
-        qCritical()
-            << "Unable to successfully initialize the mouse in the algorithm \""
-            << mouseAlgorithm << "\" from \"" << mouseFile << "\".";
-        SimUtilities::quit();
+    for (int i = 0; i < model->getNumberOfMice(); i += 1) {
+        bool success = model->getMouse(i)->initialize(
+            mouseFile, direction, (i == 0 ? nullptr : model->getMouse()->getWallDistanceField()));
+        if (!success) {
+            qCritical()
+                << "Unable to successfully initialize the mouse in the algorithm \""
+                << mouseAlgorithm << "\" from \"" << mouseFile << "\".";
+            SimUtilities::quit();
+        }
     }
 
+    // The mice are all the same, so validating the first is enough
+
     // Validate the mouse
     if (STRING_TO_INTERFACE_TYPE.value(interfaceType) == InterfaceType::DISCRETE) {
         if (!MouseChecker::isDiscreteInterfaceCompatible(*model->getMouse())) {
@@ -48,6 +48,10 @@ QString Directory::getRunDirectory() {
     return m_root + "run/";
 }
 
+QString Directory::getCacheDirectory() {
+    return m_root + "cache/";
+}
+
 Directory::Directory(const QString& root) :
     m_root(root) {
 }
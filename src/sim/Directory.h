@@ -39,6 +39,9 @@ public:
     // mms/run
     QString getRunDirectory();
 
+    // mms/cache
+    QString getCacheDirectory();
+
 private:
 
     // A private constructor is used to ensure
@@ -3,6 +3,8 @@
 #include <QCoreApplication>
 #include <QProcess>
 #include <QDebug>
+#include <QPair>
+#include <QVector>
 
 //#include <QtGlobal> // qInstallMessageHandler
 #include <QFile>
@@ -15,6 +17,8 @@
 #include "Directory.h"
 #include "Logging.h"
 #include "Param.h"
+#include "Recorder.h"
+#include "RunArchive.h"
 #include "SimUtilities.h"
 #include "State.h"
 #include "Time.h"
@@ -25,6 +29,7 @@ namespace sim {
 Model* Driver::m_model;
 View* Driver::m_view;
 Controller* Driver::m_controller;
+Replayer* Driver::m_replayer;
 
 // TODO: MACK - put this is logging
 void myMessageHandler(
@@ -95,6 +100,11 @@ void Driver::drive(int argc, char* argv[]) {
         Time::get()->startTimestamp()
     );
 
+    // Then, lock the run before anything is written to its directory, so
+    // that no other simulator archives it; if another simulator already has
+    // a run with this id, we're given a unique one
+    runId = RunArchive::init(runId);
+
     // Then, initiliaze logging (before initializing Param or State)
     Logging::init(runId);
 
@@ -104,14 +114,20 @@ void Driver::drive(int argc, char* argv[]) {
     // 3) Initialize the Param object
     S()->setRunId(runId);
 
-    // Remove any excessive archived runs
-    SimUtilities::removeExcessArchivedRuns();
+    // Initialize the recorder, which writes to the run directory
+    Recorder::init(runId);
+
+    // Archive the previous runs, and remove the oldest ones, in the background
+    RunArchive::get()->start();
 
     // Generate the glut functions in a static context
     GlutFunctions functions = {
         []() {
             m_view->refresh();
         },
+        [](int value) {
+            m_view->tick(value);
+        },
         [](int width, int height) {
             m_view->updateWindowSize(width, height);
         },
@@ -126,10 +142,23 @@ void Driver::drive(int argc, char* argv[]) {
         }
     };
 
+    // Time each phase of the rest of startup, so that we can tell which one
+    // is to blame when startup is slow (e.g., for large mazes)
+    QVector<QPair<QString, double>> startupPhases;
+    double phaseStart = SimUtilities::getHighResTimestamp();
+    auto endPhase = [&startupPhases, &phaseStart](const QString& name) {
+        double now = SimUtilities::getHighResTimestamp();
+        startupPhases.push_back({name, now - phaseStart});
+        phaseStart = now;
+    };
+
     // Initialize the model, view, and controller
     m_model = new Model();
+    endPhase("model (maze and mice)");
     m_view = new View(m_model, argc, argv, functions);
+    endPhase("view");
     m_controller = new Controller(m_model, m_view);
+    endPhase("controller");
 
     // Initialize mouse algorithm values in the model and view
     m_model->getWorld()->setOptions(
@@ -142,10 +171,41 @@ void Driver::drive(int argc, char* argv[]) {
 
     // Initialize the tile text, now that the options have been set
     m_view->initTileGraphicText();
+    endPhase("tile text");
 
     // Lastly, we need to populate the graphics buffers with maze information,
     // but only after we've initialized the tile graphic text
     m_view->getMazeGraphic()->draw();
+    endPhase("maze graphic buffers");
+
+    double startupSeconds = 0.0;
+    for (const QPair<QString, double>& phase : startupPhases) {
+        qInfo().noquote()
+            << "Startup phase \"" + phase.first + "\" took"
+            << SimUtilities::formatSeconds(phase.second) << "seconds.";
+        startupSeconds += phase.second;
+    }
+    qInfo().noquote()
+        << "Startup took" << SimUtilities::formatSeconds(startupSeconds) << "seconds in total.";
+
+    // If we're replaying a previous run, the replay takes the place of both
+    // the physics loop and the solving loop
+    if (P()->useReplayRun()) {
+        m_replayer = new Replayer(
+            P()->replayRun(),
+            m_model,
+            m_view->getMazeGraphic(),
+            m_controller->getMouseAlgorithm(),
+            m_controller->getOptions(),
+            m_view->getAllowableTileTextCharacters());
+        m_view->setReplayer(m_replayer);
+        std::thread replayThread([]() {
+            m_replayer->play();
+        });
+        replayThread.detach();
+        glutMainLoop();
+        return;
+    }
 
     // Start the physics loop
     std::thread physicsThread([]() {
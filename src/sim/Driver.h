@@ -3,6 +3,7 @@
 #include "Model.h"
 #include "View.h"
 #include "Controller.h"
+#include "Replayer.h"
 
 namespace sim {
 
@@ -16,6 +17,7 @@ private:
     static Model* m_model;
     static View* m_view;
     static Controller* m_controller;
+    static Replayer* m_replayer;
 
 };
 
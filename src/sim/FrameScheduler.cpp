@@ -0,0 +1,53 @@
+#include "FrameScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace sim {
+
+const double FrameScheduler::IDLE_DELAY = 1.0;
+
+FrameScheduler::FrameScheduler(int frameRate, int idleFrameRate) :
+        m_period(1.0 / frameRate),
+        m_idlePeriod(1.0 / idleFrameRate),
+        m_nextTick(0.0),
+        m_lastChange(0.0),
+        m_idle(false) {
+}
+
+bool FrameScheduler::tick(double now, bool changed, bool paused) {
+
+    if (changed) {
+        m_lastChange = now;
+    }
+    m_idle = paused || IDLE_DELAY < now - m_lastChange;
+    double period = m_idle ? m_idlePeriod : m_period;
+
+    // The first tick starts the grid, and if we've fallen more than a whole
+    // period behind it, the ticks that we've missed are skipped
+    if (m_nextTick == 0.0) {
+        m_nextTick = now;
+    }
+    m_nextTick += period;
+    if (m_nextTick <= now) {
+        m_nextTick += (std::floor((now - m_nextTick) / period) + 1) * period;
+    }
+
+    return changed;
+}
+
+bool FrameScheduler::wake(double now) {
+    m_lastChange = now;
+    if (!m_idle) {
+        return false;
+    }
+    m_idle = false;
+    m_nextTick = now + m_period;
+    return true;
+}
+
+int FrameScheduler::getMillisecondsUntilNextTick(double now) const {
+    return std::max(0, static_cast<int>(std::ceil((m_nextTick - now) * 1000.0)));
+}
+
+} // namespace sim
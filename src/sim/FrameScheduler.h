@@ -0,0 +1,47 @@
+#pragma once
+
+namespace sim {
+
+// Decides when the View draws. Rather than drawing as often as it can, and
+// sleeping in between, the View checks for changes on a timer, and only draws
+// a frame when something it shows has changed.
+//
+// The checks are done on a fixed grid of times, frameRate times per second,
+// so a frame that takes too long (or whose swap waits for vsync) just causes
+// the ticks that it overlapped to be skipped, rather than drawn back to back
+// to catch up. While paused, or once nothing has changed for a while, the
+// checks drop to idleFrameRate times per second, so that an idle window uses
+// next to no CPU; the first change goes back to the full rate.
+class FrameScheduler {
+
+public:
+    FrameScheduler(int frameRate, int idleFrameRate);
+
+    // Called at every tick, with the current time, whether or not anything
+    // that's drawn has changed since the last frame, and whether or not the
+    // simulation is paused; returns whether or not to draw a frame
+    bool tick(double now, bool changed, bool paused);
+
+    // Called for changes that aren't seen by tick(), e.g., key presses, which
+    // are drawn right away; returns whether or not the ticks were idle, in
+    // which case the next tick is moved up to a period from now
+    bool wake(double now);
+
+    // The number of milliseconds from now until the next tick
+    int getMillisecondsUntilNextTick(double now) const;
+
+private:
+
+    // The number of seconds without any change before the ticks slow down
+    static const double IDLE_DELAY;
+
+    double m_period;
+    double m_idlePeriod;
+    // The time of the next tick, or 0.0 before the first tick
+    double m_nextTick;
+    double m_lastChange;
+    bool m_idle;
+
+};
+
+} // namespace sim
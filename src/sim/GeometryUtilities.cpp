@@ -1,11 +1,11 @@
 #include "GeometryUtilities.h"
 
 #include <algorithm>
-#include <functional>
 #include <QPair>
 
 #include "Assert.h"
 #include "CPMath.h"
+#include "units/Heading.h"
 #include "units/Polar.h"
 
 namespace sim {
@@ -15,19 +15,15 @@ Cartesian GeometryUtilities::translateVertex(const Cartesian& vertex, const Coor
 }
 
 Cartesian GeometryUtilities::rotateVertexAroundPoint(const Cartesian& vertex, const Angle& angle, const Coordinate& point) {
-    Cartesian relativeVertex(
-        vertex.getX() - point.getX(),
-        vertex.getY() - point.getY()
+    // Rotate the offset from the point directly, rather than converting it to
+    // polar coordinates and back, which costs an atan2 and a sqrt
+    units::Length x(vertex.getX().getMeters() - point.getX().getMeters());
+    units::Length y(vertex.getY().getMeters() - point.getY().getMeters());
+    units::Heading(angle).rotate(&x, &y);
+    return Cartesian(
+        Meters(x.getValue() + point.getX().getMeters()),
+        Meters(y.getValue() + point.getY().getMeters())
     );
-    Polar rotatedRelativeVertex(
-        relativeVertex.getRho(),
-        relativeVertex.getTheta() + angle
-    );
-    Cartesian rotatedVertex(
-        rotatedRelativeVertex.getX() + point.getX(),
-        rotatedRelativeVertex.getY() + point.getY()
-    );
-    return rotatedVertex;
 }
 
 Polygon GeometryUtilities::createCirclePolygon(const Cartesian& position, const Distance& radius, int numberOfEdges) {
@@ -52,6 +48,14 @@ MetersSquared GeometryUtilities::crossProduct(const Cartesian& Z, const Cartesia
 }
 
 Polygon GeometryUtilities::convexHull(const QVector<Polygon>& polygons) {
+    QVector<Cartesian> points;
+    for (const Polygon& polygon : polygons) {
+        points += polygon.getVertices();
+    }
+    return convexHull(points);
+}
+
+Polygon GeometryUtilities::convexHull(QVector<Cartesian> points) {
 
     // TODO: Explain/Clean this functionality
 
@@ -60,14 +64,6 @@ Polygon GeometryUtilities::convexHull(const QVector<Polygon>& polygons) {
     // Returns a list of points on the convex hull in counter-clockwise order.
     // Note: the last point in the returned list is the same as the first one.
 
-    // First, get a list of all of the points
-    QVector<Cartesian> points;
-    for (Polygon polygon : polygons) {
-        for (Cartesian point : polygon.getVertices()) {
-            points.push_back(point);
-        }
-    }
-
     int n = points.size();
     int k = 0;
     QVector<Cartesian> hull(2*n);
@@ -104,16 +100,26 @@ Cartesian GeometryUtilities::castRay(
     // first object with which a ray collides. It relies on the fact that we
     // know where the walls are ahead of time.
 
+    // This runs for every ray of every sensor on every update, so the ray is
+    // traced with the header-only units, which compile down to plain doubles
+    using units::Length;
+    const Length startX(start.getX().getMeters());
+    const Length startY(start.getY().getMeters());
+    const Length endX(end.getX().getMeters());
+    const Length endY(end.getY().getMeters());
+    const Length halfWall(halfWallWidth.getMeters());
+    const Length tile(tileLength.getMeters());
+
     // First, determine the difference between the points. This allows us to
     // determine the direction of the ray, and thus the logical starting and
     // ending tiles (different from the actual starting and ending tiles).
-    Meters dx = end.getX() - start.getX();
-    Meters dy = end.getY() - start.getY();
+    Length dx = endX - startX;
+    Length dy = endY - startY;
 
     // Determine the direction of the ray
     QPair<int, int> direction = {
-        (0 < dx.getMeters() ? 1 : -1),
-        (0 < dy.getMeters() ? 1 : -1)
+        (0 < dx.getValue() ? 1 : -1),
+        (0 < dy.getValue() ? 1 : -1)
     };
 
     //  Logical Tiles
@@ -167,18 +173,16 @@ Cartesian GeometryUtilities::castRay(
     // west rays, and IJKL and MNOP, respectively.
 
     // We want to shift the walls in the opposite direction of the ray
-    Cartesian logicalShift = Cartesian(
-        halfWallWidth * direction.first  * -1,
-        halfWallWidth * direction.second * -1
-    );
+    Length shiftX = halfWall * (direction.first  * -1);
+    Length shiftY = halfWall * (direction.second * -1);
 
     // The current x and y positions that are tracked in the loop
-    Meters cx = start.getX();
-    Meters cy = start.getY();
+    Length cx = startX;
+    Length cy = startY;
 
     // Determine the logical starting tile
-    int sx = static_cast<int>(std::floor((start - logicalShift).getX() / tileLength));
-    int sy = static_cast<int>(std::floor((start - logicalShift).getY() / tileLength)); 
+    int sx = static_cast<int>(std::floor((startX - shiftX) / tile));
+    int sy = static_cast<int>(std::floor((startY - shiftY) / tile));
 
     // The initial integer tile offset from the starting tile
     int px = (direction.first  == 1 ? 1 : 0);
@@ -193,31 +197,17 @@ Cartesian GeometryUtilities::castRay(
     int iy = direction.second;
 
     // The x and y values of the next potential collision
-    Meters nx = tileLength * (sx + ox) + logicalShift.getX();
-    Meters ny = tileLength * (sy + oy) + logicalShift.getY();
+    Length nx = tile * (sx + ox) + shiftX;
+    Length ny = tile * (sy + oy) + shiftY;
 
     // The direction of wall to inspect for a potential collision
     Direction wx = (direction.first  == 1 ? Direction::EAST  : Direction::WEST );
     Direction wy = (direction.second == 1 ? Direction::NORTH : Direction::SOUTH);
 
-    // The x and y conditions on which to continue looping
-    static std::function<bool(const Meters&, const Meters&)> east = [](const Meters& nx, const Meters& ex) {
-        return nx < ex;
-    };
-    static std::function<bool(const Meters&, const Meters&)> west = [](const Meters& nx, const Meters& ex) {
-        return ex < nx;
-    };
-    static std::function<bool(const Meters&, const Meters&)> north = [](const Meters& ny, const Meters& ey) {
-        return ny < ey;
-    };
-    static std::function<bool(const Meters&, const Meters&)> south = [](const Meters& ny, const Meters& ey) {
-        return ey < ny;
-    };
-    std::function<bool(const Meters&, const Meters&)>* bx = (direction.first  == 1 ? &east  : &west );
-    std::function<bool(const Meters&, const Meters&)>* by = (direction.second == 1 ? &north : &south);
-
-    // Loop until we've exhausted the entirety of the ray
-    while ((*bx)(nx, end.getX()) || (*by)(ny, end.getY())) {
+    // Loop until we've exhausted the entirety of the ray, i.e., while the
+    // next potential collision in either direction is before the end
+    while ((direction.first  == 1 ? nx < endX : endX < nx) ||
+           (direction.second == 1 ? ny < endY : endY < ny)) {
 
         // x collision will happen first
         if (std::abs((nx - cx) / dx) < std::abs((ny - cy) / dy)) {
@@ -225,12 +215,12 @@ Cartesian GeometryUtilities::castRay(
             cx = nx;
             int x = sx + ox - px;
             int y = sy + oy - py;
-            if (isOnTileEdge(cy, halfWallWidth, tileLength) ||
+            if (isOnTileEdge(cy, halfWall, tile) ||
                     (maze.withinMaze(x, y) && maze.getTile(x, y)->isWall(wx))) {
-                return Cartesian(cx, cy);
+                return Cartesian(Meters(cx.getValue()), Meters(cy.getValue()));
             }
             ox += ix;
-            nx = tileLength * (sx + ox) + logicalShift.getX();
+            nx = tile * (sx + ox) + shiftX;
         }
 
         // y collision will happen first
@@ -239,12 +229,12 @@ Cartesian GeometryUtilities::castRay(
             cy = ny;
             int x = sx + ox - px;
             int y = sy + oy - py;
-            if (isOnTileEdge(cx, halfWallWidth, tileLength) ||
+            if (isOnTileEdge(cx, halfWall, tile) ||
                     (maze.withinMaze(x, y) && maze.getTile(x, y)->isWall(wy))) {
-                return Cartesian(cx, cy);
+                return Cartesian(Meters(cx.getValue()), Meters(cy.getValue()));
             }
             oy += iy;
-            ny = tileLength * (sy + oy) + logicalShift.getY();
+            ny = tile * (sy + oy) + shiftY;
         }
     }
 
@@ -253,9 +243,10 @@ Cartesian GeometryUtilities::castRay(
 
 bool GeometryUtilities::isOnTileEdge(
         const Meters& position, const Meters& halfWallWidth, const Meters& tileLength) {
-    Meters tileLengthMinusHalfWallWidth = tileLength - halfWallWidth;
-    Meters mod = Meters(std::fmod(position.getMeters(), tileLength.getMeters()));
-    return (mod < halfWallWidth || tileLengthMinusHalfWallWidth < mod);
+    return isOnTileEdge(
+        units::Length(position.getMeters()),
+        units::Length(halfWallWidth.getMeters()),
+        units::Length(tileLength.getMeters()));
 }
 
 } // namespace sim
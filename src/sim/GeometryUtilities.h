@@ -1,11 +1,14 @@
 #pragma once
 
+#include <cmath>
+
 #include "Maze.h"
 #include "Polygon.h"
 #include "units/Angle.h"
 #include "units/Cartesian.h"
 #include "units/Distance.h"
 #include "units/MetersSquared.h"
+#include "units/Quantity.h"
 
 namespace sim {
 
@@ -31,6 +34,9 @@ public:
     // Returns the convex hull of all of the points of all of the polygons
     static Polygon convexHull(const QVector<Polygon>& polygons);
 
+    // Returns the convex hull of the points
+    static Polygon convexHull(QVector<Cartesian> points);
+
     // Attempts to cast a ray from start to end and returns the first point of
     // intersection with walls or corners, as given by maze, or end if none
     static Cartesian castRay(
@@ -40,6 +46,14 @@ public:
     // Returns true if position is located on the edge of a tile, based on halfWallWidth and tileLength
     static bool isOnTileEdge(
         const Meters& position, const Meters& halfWallWidth, const Meters& tileLength);
+    static bool isOnTileEdge(
+        units::Length position, units::Length halfWallWidth, units::Length tileLength);
 };
 
+inline bool GeometryUtilities::isOnTileEdge(
+        units::Length position, units::Length halfWallWidth, units::Length tileLength) {
+    units::Length mod(std::fmod(position.getValue(), tileLength.getValue()));
+    return (mod < halfWallWidth || tileLength - halfWallWidth < mod);
+}
+
 } // namespace sim
@@ -4,6 +4,7 @@ namespace sim {
 
 struct GlutFunctions {
     void (*refresh)(void);
+    void (*frameTimer)(int value);
     void (*windowResize)(int width, int height);
     void (*keyPress)(unsigned char key, int x, int y);
     void (*specialKeyPress)(int key, int x, int y);
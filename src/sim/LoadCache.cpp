@@ -0,0 +1,103 @@
+#include "LoadCache.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "Directory.h"
+
+namespace sim {
+
+const quint32 LoadCache::MAGIC = 0x6d6d7363; // "mmsc"
+const quint32 LoadCache::VERSION = 1;
+
+bool LoadCache::load(const QString& sourcePath, std::function<bool(QDataStream&)> read) {
+
+    QFile file(getCachePath(sourcePath));
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+        return false;
+    }
+
+    // The mapping is unmapped when the file is destroyed, which is after
+    // we're done reading from it
+    uchar* data = file.map(0, file.size());
+    if (data == nullptr) {
+        return false;
+    }
+    QByteArray bytes = QByteArray::fromRawData(reinterpret_cast<const char*>(data), file.size());
+    QDataStream stream(bytes);
+    stream.setVersion(QDataStream::Qt_5_0);
+
+    quint32 magic;
+    quint32 version;
+    QByteArray key;
+    stream >> magic >> version >> key;
+    if (stream.status() != QDataStream::Ok || magic != MAGIC || version != VERSION) {
+        return false;
+    }
+    if (key.isEmpty() || key != getKey(sourcePath)) {
+        return false;
+    }
+    return read(stream) && stream.status() == QDataStream::Ok;
+}
+
+void LoadCache::save(const QString& sourcePath, std::function<void(QDataStream&)> write) {
+
+    QByteArray key = getKey(sourcePath);
+    if (key.isEmpty() || !QDir().mkpath(Directory::get()->getCacheDirectory())) {
+        return;
+    }
+
+    // Many simulators may be starting at once, so the blob is written to a
+    // temporary file that's atomically renamed into place
+    QSaveFile file(getCachePath(sourcePath));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << MAGIC << VERSION << key;
+    write(stream);
+    if (stream.status() == QDataStream::Ok) {
+        file.commit();
+    }
+}
+
+QString LoadCache::getCachePath(const QString& sourcePath) {
+    QString absolutePath = QFileInfo(sourcePath).absoluteFilePath();
+    return Directory::get()->getCacheDirectory()
+        + QFileInfo(sourcePath).fileName() + "-"
+        + QCryptographicHash::hash(absolutePath.toUtf8(), QCryptographicHash::Sha1).toHex().left(16)
+        + ".cache";
+}
+
+QByteArray LoadCache::getKey(const QString& sourcePath) {
+
+    QFile file(sourcePath);
+    if (QCoreApplication::instance() == nullptr || !file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    QFileInfo sourceInfo(file);
+
+    // The executable is part of the key, since the defaults and valid ranges
+    // of the values (and the layout of the blob) can change from build to build
+    QFileInfo executableInfo(QCoreApplication::applicationFilePath());
+
+    QByteArray key;
+    QDataStream stream(&key, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream
+        << sourceInfo.absoluteFilePath()
+        << sourceInfo.size()
+        << sourceInfo.lastModified().toMSecsSinceEpoch()
+        << QCryptographicHash::hash(file.readAll(), QCryptographicHash::Sha1)
+        << executableInfo.size()
+        << executableInfo.lastModified().toMSecsSinceEpoch();
+    return key;
+}
+
+} // namespace sim
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <QDataStream>
+#include <QString>
+
+#include <functional>
+
+namespace sim {
+
+// A cache of the fully validated contents of input files (e.g., the
+// parameters file and the mouse files), so that we don't have to parse and
+// validate the XML every single time the simulator starts.
+//
+// Each source file gets its own binary blob in the cache directory. A blob is
+// only used if it was written by this very executable, for a file at the same
+// path, with the same size, modification time, and content hash; otherwise
+// it's ignored, and overwritten once the file has been parsed again. The blob
+// is memory-mapped, rather than read, when it's loaded.
+class LoadCache {
+
+public:
+
+    // The LoadCache class is not constructible
+    LoadCache() = delete;
+
+    // Calls read with a stream of the cached contents of the source file,
+    // if there are any, and returns whether or not read succeeded
+    static bool load(const QString& sourcePath, std::function<bool(QDataStream&)> read);
+
+    // Caches whatever write writes as the contents of the source file;
+    // failing to do so is harmless, and so it's silently ignored
+    static void save(const QString& sourcePath, std::function<void(QDataStream&)> write);
+
+private:
+
+    // Identify blobs, and the layout of their headers
+    static const quint32 MAGIC;
+    static const quint32 VERSION;
+
+    // The path of the blob for the source file
+    static QString getCachePath(const QString& sourcePath);
+
+    // Everything that the blob is keyed by, serialized, or an empty array if
+    // the source file (or the executable) can't be identified
+    static QByteArray getKey(const QString& sourcePath);
+
+};
+
+} // namespace sim
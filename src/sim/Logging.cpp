@@ -1,6 +1,8 @@
 #include "Logging.h"
 
-#include <QTextStream>
+#include <QDir>
+
+#include <iostream>
 
 #include "Assert.h"
 #include "Directory.h"
@@ -11,6 +13,8 @@ namespace sim {
 
 Logging* Logging::INSTANCE = nullptr;
 
+const QString Logging::LOG_FILE_NAME = "log.txt";
+
 void Logging::init(const QString& runId) {
     SIM_ASSERT_TR(nullptr == INSTANCE);
     INSTANCE = new Logging(runId);
@@ -18,6 +22,14 @@ void Logging::init(const QString& runId) {
 
 Logging::Logging(const QString& runId) {
 
+    // The log is written to the run's directory, and so it's archived along
+    // with the rest of the run
+    QString runDirectory = Directory::get()->getRunDirectory() + runId + "/";
+    m_logFile.setFileName(runDirectory + LOG_FILE_NAME);
+    if (QDir().mkpath(runDirectory)) {
+        m_logFile.open(QIODevice::WriteOnly | QIODevice::Append);
+    }
+
     // TODO: See http://doc.qt.io/qt-5/qloggingcategory.html#setFilterRules
     // TODO: http://doc.qt.io/qt-5/qtglobal.html#qSetMessagePattern
     qInstallMessageHandler(handler);
@@ -97,12 +109,13 @@ void Logging::handler(
         msg
     );
 
+    // Messages come from many threads
+    std::lock_guard<std::mutex> lock(INSTANCE->m_mutex);
     std::cout << formatted.toStdString() << std::endl;
-
-    QFile outFile("/home/mack/Desktop/test-log.txt");
-    outFile.open(QIODevice::WriteOnly | QIODevice::Append);
-    QTextStream ts(&outFile);
-    ts << formatted << endl << flush;
+    if (INSTANCE->m_logFile.isOpen()) {
+        INSTANCE->m_logFile.write((formatted + "\n").toUtf8());
+        INSTANCE->m_logFile.flush();
+    }
 }
 
 } // namespace sim
@@ -3,6 +3,8 @@
 #include <QFile>
 #include <QString>
 
+#include <mutex>
+
 namespace sim {
 
 class Logging {
@@ -12,6 +14,9 @@ public:
     // Should only be called once, at start time
     static void init(const QString& runId);
 
+    // The name of the log file, relative to the directory of the run
+    static const QString LOG_FILE_NAME;
+
 private:
 
     // A private constructor is used to ensure
@@ -20,8 +25,9 @@ private:
 
     static Logging* INSTANCE;
 
-    // The file that we'll log to
+    // The file that we'll log to, and the lock that guards it
     QFile m_logFile;
+    std::mutex m_mutex;
 
     // Gets called for every log statement
     // TODO: MACK Just use a lambda
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+
+namespace sim {
+
+// A 4x4 matrix of floats, in row-major order (and so it's given to OpenGL
+// transposed). Unlike a QVector<float>, it's a plain, fixed size value, so
+// making, multiplying, copying, and comparing matrices never allocates.
+class Matrix4 {
+
+public:
+    Matrix4() : m_values{{
+            1.0f, 0.0f, 0.0f, 0.0f,
+            0.0f, 1.0f, 0.0f, 0.0f,
+            0.0f, 0.0f, 1.0f, 0.0f,
+            0.0f, 0.0f, 0.0f, 1.0f}} {
+    }
+
+    static Matrix4 translation(double x, double y) {
+        Matrix4 matrix;
+        matrix.m_values[3] = static_cast<float>(x);
+        matrix.m_values[7] = static_cast<float>(y);
+        return matrix;
+    }
+
+    static Matrix4 scaling(double x, double y) {
+        Matrix4 matrix;
+        matrix.m_values[0] = static_cast<float>(x);
+        matrix.m_values[5] = static_cast<float>(y);
+        return matrix;
+    }
+
+    // A clockwise rotation, by the given number of radians, about the z axis
+    static Matrix4 rotation(double radians) {
+        Matrix4 matrix;
+        matrix.m_values[0] = static_cast<float>(std::cos(radians));
+        matrix.m_values[1] = static_cast<float>(std::sin(radians));
+        matrix.m_values[4] = static_cast<float>(-std::sin(radians));
+        matrix.m_values[5] = static_cast<float>(std::cos(radians));
+        return matrix;
+    }
+
+    // Each row of the product is a sum of the other matrix's rows, scaled by
+    // the elements of this matrix's row; the inner loop is four floats wide,
+    // which the compiler turns into a single vector multiply and add
+    Matrix4 operator*(const Matrix4& other) const {
+        Matrix4 product;
+        for (int i = 0; i < 4; i += 1) {
+            float row[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            for (int k = 0; k < 4; k += 1) {
+                float value = m_values[4 * i + k];
+                for (int j = 0; j < 4; j += 1) {
+                    row[j] += value * other.m_values[4 * k + j];
+                }
+            }
+            for (int j = 0; j < 4; j += 1) {
+                product.m_values[4 * i + j] = row[j];
+            }
+        }
+        return product;
+    }
+
+    float at(int row, int col) const {
+        return m_values[4 * row + col];
+    }
+
+    const float* data() const {
+        return m_values.data();
+    }
+
+private:
+    std::array<float, 16> m_values;
+
+};
+
+} // namespace sim
@@ -13,14 +13,38 @@
 #include "MazeChecker.h"
 #include "MazeFileType.h"
 #include "MazeFileUtilities.h"
+#include "MazeTransform.h"
 #include "Param.h"
 #include "SimUtilities.h"
 #include "Tile.h"
 
 namespace sim {
 
-Maze::Maze() {
-    
+Maze::Maze(Random random) : Maze(loadBasicMaze(&random)) {
+}
+
+Maze::Maze(const BasicMaze& basicMaze) {
+
+    // Check to see if it's a valid maze
+    m_isValidMaze = MazeChecker::isValidMaze(basicMaze).first;
+    if (!m_isValidMaze) {
+        qWarning()
+            << "The maze failed validation. The mouse algorithm will not"
+            << " execute.";
+    }
+
+    // Then, store whether or not the maze is an official maze
+    m_isOfficialMaze = m_isValidMaze && MazeChecker::isOfficialMaze(basicMaze).first;
+    if (m_isValidMaze && !m_isOfficialMaze) {
+        qWarning() << "The maze did not pass the \"is official maze\" tests.";
+    }
+
+    // Load the maze given by the maze generation algorithm
+    m_maze = initializeFromBasicMaze(basicMaze);
+}
+
+BasicMaze Maze::loadBasicMaze(Random* random) {
+
     BasicMaze basicMaze;
 
     if (P()->useMazeFile()) {
@@ -78,6 +102,7 @@ Maze::Maze() {
             args << selectedMazeAlgoDir.absolutePath() + QString("/Main.py");
             args << QString::number(P()->generatedMazeWidth());
             args << QString::number(P()->generatedMazeHeight());
+            args << QString::number(random->getUint32());
             for (int i = 0; i < args.size(); i += 1) {
                 qInfo() << args.at(i);
             }
@@ -96,47 +121,33 @@ Maze::Maze() {
         basicMaze = MazeFileUtilities::loadBytes(bytes);
     }
 
-    // Check to see if it's a valid maze
-    m_isValidMaze = MazeChecker::isValidMaze(basicMaze).first;
-    if (!m_isValidMaze) {
-        qWarning()
-            << "The maze failed validation. The mouse algorithm will not"
-            << " execute.";
-    }
-
     // Optionally save the maze
     if (!P()->useMazeFile() && P()->saveGeneratedMaze()) {
         MazeFileType type = STRING_TO_MAZE_FILE_TYPE.value(P()->generatedMazeType());
         QString mazeFilePath = Directory::get()->getResMazeDirectory() +
             P()->generatedMazeFile() + MAZE_FILE_TYPE_TO_SUFFIX.value(type);
-        // TODO: MACK
-        bool success = false; // MazeFileUtilities::save(basicMaze, mazeFilePath, type);
-        if (success) {
+        try {
+            MazeFileUtilities::save(basicMaze, mazeFilePath, type);
             qInfo() << "Maze saved to \"" << mazeFilePath << "\".";
         }
-        else {
+        catch (...) {
             qWarning() << "Unable to save maze to \"" << mazeFilePath << "\".";
         }
     }
 
-    // Mirror and rotate the maze
-    if (P()->mazeMirrored()) {
-        basicMaze = mirrorAcrossVertical(basicMaze);
+    // Mirror and rotate the maze, in a single pass
+    MazeTransform transform(P()->mazeMirrored(), P()->mazeRotations());
+    if (transform.isMirrored()) {
         qInfo() << "Mirroring the maze across the vertical.";
     }
-    for (int i = 0; i < P()->mazeRotations(); i += 1) {
-        basicMaze = rotateCounterClockwise(basicMaze);
-        qInfo() << "Rotating the maze counter-clockwise (" << i + 1 << ").";
+    if (transform.getRotations() != 0) {
+        qInfo() << "Rotating the maze counter-clockwise (" << transform.getRotations() << ").";
     }
-
-    // Then, store whether or not the maze is an official maze
-    m_isOfficialMaze = m_isValidMaze && MazeChecker::isOfficialMaze(basicMaze).first;
-    if (m_isValidMaze && !m_isOfficialMaze) {
-        qWarning() << "The maze did not pass the \"is official maze\" tests.";
+    if (transform.isMirrored() || transform.getRotations() != 0) {
+        basicMaze = transform.apply(basicMaze);
     }
 
-    // Load the maze given by the maze generation algorithm
-    m_maze = initializeFromBasicMaze(basicMaze);
+    return basicMaze;
 }
 
 int Maze::getWidth() const {
@@ -175,83 +186,46 @@ bool Maze::isCenterTile(int x, int y) const {
 
 QVector<QVector<Tile>> Maze::initializeFromBasicMaze(const BasicMaze& basicMaze) {
     // TODO: MACK - assert valid here
+    // The tiles only hold their walls and positions; their geometry is
+    // derived from those whenever it's needed
     QVector<QVector<Tile>> maze;
+    maze.reserve(basicMaze.size());
     for (int x = 0; x < basicMaze.size(); x += 1) {
         QVector<Tile> column;
+        column.reserve(basicMaze.at(x).size());
         for (int y = 0; y < basicMaze.at(x).size(); y += 1) {
             Tile tile;
             tile.setPos(x, y);
+            tile.setMazeSize(basicMaze.size(), basicMaze.at(x).size());
             for (Direction direction : DIRECTIONS) {
                 tile.setWall(direction, basicMaze.at(x).at(y).value(direction));
             }
-            tile.initPolygons(basicMaze.size(), basicMaze.at(x).size());
             column.push_back(tile);
         }
         maze.push_back(column);
     }
-    maze = setTileDistances(maze);
+    setTileDistances(&maze);
     return maze;
 }
 
-BasicMaze Maze::mirrorAcrossVertical(const BasicMaze& basicMaze) {
-    static QMap<Direction, Direction> verticalOpposites {
-        {Direction::NORTH, Direction::NORTH},
-        {Direction::EAST, Direction::WEST},
-        {Direction::SOUTH, Direction::SOUTH},
-        {Direction::WEST, Direction::EAST},
-    };
-    // TODO: MACK - test this
-    BasicMaze mirrored;
-    for (int x = 0; x < basicMaze.size(); x += 1) {
-        QVector<BasicTile> column;
-        for (int y = 0; y < basicMaze.at(x).size(); y += 1) {
-            BasicTile tile;
-            for (Direction direction : DIRECTIONS) {
-                tile.insert(
-                    direction,
-                    basicMaze
-                        .at(basicMaze.size() - 1 - x)
-                        .at(y)
-                        .value(verticalOpposites.value(direction))
-                );
-            }
-            column.push_back(tile);
-        }
-        mirrored.push_back(column);
-    }
-    return mirrored; 
-}
-
-BasicMaze Maze::rotateCounterClockwise(const BasicMaze& basicMaze) {
-    BasicMaze rotated;
-    for (int x = 0; x < basicMaze.size(); x += 1) {
-        QVector<BasicTile> row;
-        for (int y = basicMaze.at(x).size() - 1; y >= 0; y -= 1) {
-            BasicTile tile;
-            int rotatedTileX = basicMaze.at(x).size() - 1 - y;
-            tile.insert(Direction::NORTH, basicMaze.at(x).at(y).value(Direction::EAST));
-            tile.insert(Direction::EAST, basicMaze.at(x).at(y).value(Direction::SOUTH));
-            tile.insert(Direction::SOUTH, basicMaze.at(x).at(y).value(Direction::WEST));
-            tile.insert(Direction::WEST, basicMaze.at(x).at(y).value(Direction::NORTH));
-            if (rotated.size() <= rotatedTileX) {
-                rotated.push_back({tile});
-            }
-            else {
-                rotated[rotatedTileX].push_back(tile);
-            }
-        }
-    }
-    return rotated;
-}
-
-QVector<QVector<Tile>> Maze::setTileDistances(QVector<QVector<Tile>> maze) {
+void Maze::setTileDistances(QVector<QVector<Tile>>* tiles) {
 
     // TODO: MACK - dedup some of this with hasNoInaccessibleLocations
 
+    // The tiles are modified in place, rather than copied in and out
+    QVector<QVector<Tile>>& maze = *tiles;
+
     // The maze is guarenteed to be nonempty and rectangular
     int width = maze.size();
     int height = maze.at(0).size();
 
+    // Forget any previous distances, so that only reachable tiles get one
+    for (int x = 0; x < width; x += 1) {
+        for (int y = 0; y < height; y += 1) {
+            maze[x][y].setDistance(-1);
+        }
+    }
+
     // Helper lambda for retrieving and adjacent tile if one exists, nullptr if not
     // TODO: MACK - this should be in maze utilities too
     auto getNeighbor = [&maze, &width, &height](int x, int y, Direction direction) {
@@ -304,8 +278,6 @@ QVector<QVector<Tile>> Maze::setTileDistances(QVector<QVector<Tile>> maze) {
             }
         }
     }
-
-    return maze;
 }
 
 } // namespace sim
@@ -3,6 +3,7 @@
 #include <QVector>
 
 #include "BasicMaze.h"
+#include "Random.h"
 #include "Tile.h"
 
 namespace sim {
@@ -10,7 +11,13 @@ namespace sim {
 class Maze {
 
 public:
-    Maze();
+    // Loads or generates the maze specified by the parameters; a generated
+    // maze is seeded from the given stream
+    Maze(Random random);
+
+    // Constructs the maze from a basic maze that has already been loaded
+    Maze(const BasicMaze& basicMaze);
+
     int getWidth() const;
     int getHeight() const;
     bool withinMaze(int x, int y) const;
@@ -20,6 +27,10 @@ public:
     bool isOfficialMaze() const;
     bool isCenterTile(int x, int y) const;
 
+    // (Re)set the distance values for the tiles in maze that are reachable
+    // from the center, in place; unreachable tiles get a distance of -1
+    static void setTileDistances(QVector<QVector<Tile>>* maze);
+
 private:
     // Vector to hold all of the tiles
     QVector<QVector<Tile>> m_maze;
@@ -29,15 +40,12 @@ private:
     bool m_isValidMaze;
     bool m_isOfficialMaze;
 
+    // Loads or generates, validates, and transforms the basic maze specified
+    // by the parameters
+    static BasicMaze loadBasicMaze(Random* random);
+
     // Initializes all of the tiles of the basic maze
     static QVector<QVector<Tile>> initializeFromBasicMaze(const BasicMaze& basicMaze);
-
-    // Basic maze geometric transformations
-    static BasicMaze mirrorAcrossVertical(const BasicMaze& basicMaze);
-    static BasicMaze rotateCounterClockwise(const BasicMaze& basicMaze);
-
-    // (Re)set the distance values for the tiles in maze that are reachable from the center
-    static QVector<QVector<Tile>> setTileDistances(QVector<QVector<Tile>> maze);
 };
 
 } // namespace sim
@@ -0,0 +1,76 @@
+#include "MazeChunks.h"
+
+#include <algorithm>
+
+#include "Assert.h"
+
+namespace sim {
+
+MazeChunks::MazeChunks(int mazeWidth, int mazeHeight, int chunkSize) :
+        m_mazeWidth(mazeWidth),
+        m_mazeHeight(mazeHeight),
+        m_chunkSize(chunkSize),
+        m_chunksWide((mazeWidth + chunkSize - 1) / chunkSize),
+        m_chunksHigh((mazeHeight + chunkSize - 1) / chunkSize) {
+    SIM_ASSERT_LT(0, chunkSize);
+}
+
+int MazeChunks::getChunkSize() const {
+    return m_chunkSize;
+}
+
+int MazeChunks::getTilesPerChunk() const {
+    return m_chunkSize * m_chunkSize;
+}
+
+int MazeChunks::getChunksWide() const {
+    return m_chunksWide;
+}
+
+int MazeChunks::getChunksHigh() const {
+    return m_chunksHigh;
+}
+
+int MazeChunks::getNumberOfChunks() const {
+    return m_chunksWide * m_chunksHigh;
+}
+
+int MazeChunks::getChunk(int x, int y) const {
+    return (x / m_chunkSize) * m_chunksHigh + (y / m_chunkSize);
+}
+
+int MazeChunks::getIndexInChunk(int x, int y) const {
+    // The height of the chunk, which is only less than the chunk size for
+    // chunks in the top row
+    int bottom = y - y % m_chunkSize;
+    int height = std::min(m_chunkSize, m_mazeHeight - bottom);
+    return (x % m_chunkSize) * height + (y - bottom);
+}
+
+void MazeChunks::getTileBounds(int chunk, int* left, int* bottom, int* right, int* top) const {
+    SIM_ASSERT_LE(0, chunk);
+    SIM_ASSERT_LT(chunk, getNumberOfChunks());
+    *left = (chunk / m_chunksHigh) * m_chunkSize;
+    *bottom = (chunk % m_chunksHigh) * m_chunkSize;
+    *right = std::min(*left + m_chunkSize, m_mazeWidth);
+    *top = std::min(*bottom + m_chunkSize, m_mazeHeight);
+}
+
+QVector<int> MazeChunks::getChunksIntersecting(int left, int bottom, int right, int top) const {
+    QVector<int> chunks;
+    if (right < 0 || top < 0 || m_mazeWidth <= left || m_mazeHeight <= bottom) {
+        return chunks;
+    }
+    int firstColumn = std::max(0, left) / m_chunkSize;
+    int lastColumn = std::min(m_mazeWidth - 1, right) / m_chunkSize;
+    int firstRow = std::max(0, bottom) / m_chunkSize;
+    int lastRow = std::min(m_mazeHeight - 1, top) / m_chunkSize;
+    for (int column = firstColumn; column <= lastColumn; column += 1) {
+        for (int row = firstRow; row <= lastRow; row += 1) {
+            chunks.append(column * m_chunksHigh + row);
+        }
+    }
+    return chunks;
+}
+
+} // namespace sim
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <QVector>
+
+namespace sim {
+
+// Splits a maze into square chunks of tiles, so that the graphics of a huge
+// maze can be stored, drawn, and culled a chunk at a time rather than a tile
+// at a time. The chunks along the top and right edges of the maze may be
+// smaller than the rest.
+//
+// Like the tiles of a maze, chunks are numbered column by column, starting in
+// the lower left, and so are the tiles within each chunk.
+class MazeChunks {
+
+public:
+    MazeChunks(int mazeWidth, int mazeHeight, int chunkSize);
+
+    // The number of tiles along each side of a (full) chunk, and in all
+    int getChunkSize() const;
+    int getTilesPerChunk() const;
+
+    int getChunksWide() const;
+    int getChunksHigh() const;
+    int getNumberOfChunks() const;
+
+    // The chunk that contains a tile, and the tile's place within it
+    int getChunk(int x, int y) const;
+    int getIndexInChunk(int x, int y) const;
+
+    // The tiles of the chunk are those in [left, right) x [bottom, top)
+    void getTileBounds(int chunk, int* left, int* bottom, int* right, int* top) const;
+
+    // The chunks that contain any of the tiles in [left, right] x [bottom,
+    // top], which need not be within the maze
+    QVector<int> getChunksIntersecting(int left, int bottom, int right, int top) const;
+
+private:
+    int m_mazeWidth;
+    int m_mazeHeight;
+    int m_chunkSize;
+    int m_chunksWide;
+    int m_chunksHigh;
+
+};
+
+} // namespace sim
@@ -53,22 +53,26 @@ void MazeFileUtilities::save(
     const QString& path,
     MazeFileType type) {
 
-    // TODO: MACK - should throw exception
-    QByteArray bytes;
+    QByteArray bytes = saveBytes(maze, type);
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+            file.write(bytes) != bytes.size()) {
+        throw std::exception();
+    }
+}
+
+QByteArray MazeFileUtilities::saveBytes(const BasicMaze& maze, MazeFileType type) {
     switch (type) {
         case MazeFileType::MAP:
-            bytes = serializeMapType(maze);
+            return serializeMapType(maze);
         case MazeFileType::MAZ:
-            bytes = serializeMazType(maze);
+            return serializeMazType(maze);
         case MazeFileType::MZ2:
-            bytes = serializeMz2Type(maze);
+            return serializeMz2Type(maze);
         case MazeFileType::NUM:
-            bytes = serializeNumType(maze);
-        default:
-            // TODO: MACK
-            SimUtilities::quit();
+            return serializeNumType(maze);
     }
-    // TODO: MACK - write to file
+    throw std::exception();
 }
 
 BasicMaze MazeFileUtilities::deserializeMapType(const QByteArray& bytes) {
@@ -385,16 +389,19 @@ BasicMaze MazeFileUtilities::deserializeNumType(const QByteArray& bytes) {
 
 QByteArray MazeFileUtilities::serializeMapType(const BasicMaze& maze) {
 
-    /*
     // The characters to use in the file
     char post = '+';
     char space = ' ';
     char vertical = '|';
     char horizontal = '-';
 
+    if (maze.isEmpty()) {
+        throw std::exception();
+    }
+
     // A blank line, and a list of all lines to be written
-    QString blankLine(4 * maze.size() + 1, space);
-    QVector<QString> upsideDownLines {blankLine};
+    QByteArray blankLine(4 * maze.size() + 1, space);
+    QVector<QByteArray> upsideDownLines {blankLine};
 
     // For all tiles in the maze
     for (int i = 0; i < maze.size(); i += 1) {
@@ -411,242 +418,167 @@ QByteArray MazeFileUtilities::serializeMapType(const BasicMaze& maze) {
             int right = 4 * (i + 1);
             int up = 2 * (j + 1);
             int down = 2 * j;
-            upsideDownLines.at(down).at(left) = post;
-            upsideDownLines.at(down).at(right) = post;
-            upsideDownLines.at(up).at(left) = post;
-            upsideDownLines.at(up).at(right) = post;
+            upsideDownLines[down][left] = post;
+            upsideDownLines[down][right] = post;
+            upsideDownLines[up][left] = post;
+            upsideDownLines[up][right] = post;
 
             // Insert walls if they exist
-            if (maze.at(i).at(j).at(Direction::NORTH)) {
+            const BasicTile& tile = maze.at(i).at(j);
+            if (tile.value(Direction::NORTH)) {
                 for (int k = 0; k < 3; k += 1) {
-                    upsideDownLines.at(up).at(left + 1 + k) = horizontal;
+                    upsideDownLines[up][left + 1 + k] = horizontal;
                 }
             }
-            if (maze.at(i).at(j).at(Direction::SOUTH)) {
+            if (tile.value(Direction::SOUTH)) {
                 for (int k = 0; k < 3; k += 1) {
-                    upsideDownLines.at(down).at(left + 1 + k) = horizontal;
+                    upsideDownLines[down][left + 1 + k] = horizontal;
                 }
             }
-            if (maze.at(i).at(j).at(Direction::EAST)) {
-                upsideDownLines.at(down + 1).at(right) = vertical;
+            if (tile.value(Direction::EAST)) {
+                upsideDownLines[down + 1][right] = vertical;
             }
-            if (maze.at(i).at(j).at(Direction::WEST)) {
-                upsideDownLines.at(down + 1).at(left) = vertical;
+            if (tile.value(Direction::WEST)) {
+                upsideDownLines[down + 1][left] = vertical;
             }
         }
     }
 
     // Flip the lines so that they're right side up
-    QVector<QString> rightSideUpLines;
+    QByteArray bytes;
     for (int i = upsideDownLines.size() - 1; i >= 0; i -= 1) {
-        rightSideUpLines.push_back(upsideDownLines.at(i));
-    }
-
-    // Create the stream
-    std::ofstream file(mazeFilePath.toStdString(), std::ios::trunc);
-
-    // Make sure the file is open
-    if (!file.is_open()) {
-        return false;
-    }
-
-    // Write to the file
-    for (QString line : rightSideUpLines) {
-        file << line << '\n'; // std::endl flushes the buffer everytime its called
+        bytes.append(upsideDownLines.at(i));
+        bytes.append('\n');
     }
 
-    // Make sure to close the file
-    file.close();
-
-    // Return success
-    return true;
-    */
-    throw std::exception();
+    return bytes;
 }
 
 QByteArray MazeFileUtilities::serializeMazType(const BasicMaze& maze) {
 
-    /*
-    if (maze.size() != 16) {
-        return false; // We only support 16x16 mazes
-    }
-
-    if (maze.at(0).size() != 16) {
-        // Lets assume the maze is at least rectangular. I don't know if it cannot be
-
-        return false; // We only support 16x16 mazes
-    }
-
-    // Create the stream
-    std::ofstream file(mazeFilePath.toStdString(), std::ios::trunc | std::ios::binary);
-    file.imbue(std::locale::classic());
-
-    // Make sure the file is open
-    if (!file.is_open()) {
-        return false;
+    // We only support 16x16 mazes; let's assume the maze is rectangular
+    if (maze.size() != 16 || maze.at(0).size() != 16) {
+        throw std::exception();
     }
 
     // We hardcode values becuase we specifically checked that the maze
     // was 16x16 above.
-    for (auto x = 0; x < 16; x++) {
-        for (auto y = 0; y < 16; y++) {
-            BasicTile tile = maze.at(x).at(y);
+    QByteArray bytes;
+    for (int x = 0; x < 16; x += 1) {
+        for (int y = 0; y < 16; y += 1) {
+            const BasicTile& tile = maze.at(x).at(y);
             //Each byte reprsents the walls like this: 'X X X X W S E N'
-            int representation = (tile[Direction::WEST]  << 3) +
-                                 (tile[Direction::SOUTH] << 2) +
-                                 (tile[Direction::EAST]  << 1) +
-                                 (tile[Direction::NORTH] << 0);
-
-            file.put(representation);
+            int representation = (tile.value(Direction::WEST)  << 3) +
+                                 (tile.value(Direction::SOUTH) << 2) +
+                                 (tile.value(Direction::EAST)  << 1) +
+                                 (tile.value(Direction::NORTH) << 0);
+            bytes.append(static_cast<char>(representation));
         }
     }
 
-    // Make sure to close the file
-    file.close();
-
-    // Return success
-    return true;
-    */
-    throw std::exception();
+    return bytes;
 }
 
 QByteArray MazeFileUtilities::serializeMz2Type(const BasicMaze& maze) {
 
-    /*
-    // Create the stream
-    std::ofstream file(mazeFilePath.toStdString(), std::ios::trunc | std::ios::binary);
-    file.imbue(std::locale::classic());
-
-    // Make sure the file is open
-    if (!file.is_open()) {
-        return false;
+    // Empty mazes aren't allowed
+    if (maze.isEmpty() || maze.at(0).isEmpty()) {
+        throw std::exception();
     }
 
-    file.put(0);  // Hardcoded name is: 'Auto Generated Maze' (length: 19)
-    file.put(19); // I am assuming that the length is encoded in 16 bits.
-                  // The spec is unclear
-    
-    file << "Auto Generated Maze";
+    QByteArray bytes;
 
-    uint32_t width = maze.size();
-    uint32_t height = 0;
+    bytes.append(static_cast<char>(0));  // Hardcoded name is: 'Auto Generated Maze' (length: 19)
+    bytes.append(static_cast<char>(19)); // I am assuming that the length is encoded in 16 bits.
+                                         // The spec is unclear
+    bytes.append("Auto Generated Maze");
 
-    if (maze.size() > 0) {
-        height = maze.at(0).size();
-        if (height == 0)
-            return false; // I don't think this should be allowed?
-    }
-    else
-        return false; // I don't think this should be allowed?
+    uint32_t width = maze.size();
+    uint32_t height = maze.at(0).size();
 
-    file.put(width >> 24); // width
-    file.put(width >> 16);
-    file.put(width >> 8);
-    file.put(width);
+    bytes.append(static_cast<char>(width >> 24)); // width
+    bytes.append(static_cast<char>(width >> 16));
+    bytes.append(static_cast<char>(width >> 8));
+    bytes.append(static_cast<char>(width));
 
-    file.put(height >> 24); // height
-    file.put(height >> 16);
-    file.put(height >> 8);
-    file.put(height);
+    bytes.append(static_cast<char>(height >> 24)); // height
+    bytes.append(static_cast<char>(height >> 16));
+    bytes.append(static_cast<char>(height >> 8));
+    bytes.append(static_cast<char>(height));
 
     int numberOfBits = 0;
     int numberOfBytes = 0;
     unsigned char toWrite = 0;
 
-    for (auto y = 0; y < height - 1; y++) {
-        for (auto x = 0; x < width; x++) {
-            BasicTile tile = maze.at(x).at(height - 1 - y);
-
+    for (uint32_t y = 0; y < height - 1; y += 1) {
+        for (uint32_t x = 0; x < width; x += 1) {
             toWrite >>= 1;
-            if (tile[Direction::SOUTH] == true) {
+            if (maze.at(x).at(height - 1 - y).value(Direction::SOUTH)) {
                 toWrite |= 1 << 7; // Set the MSB bit as one
             }
             numberOfBits = (numberOfBits + 1) % 8;
 
             if (numberOfBits == 0) {
-                file.put(toWrite); // Write the byte when it is full
+                bytes.append(static_cast<char>(toWrite)); // Write the byte when it is full
                 numberOfBytes = (numberOfBytes + 1) % 8; // Add one to the number of bytes
             }
         }
     }
 
     if (numberOfBits != 0) {
-        file.put(toWrite >> (8 - numberOfBits));
-        numberOfBits = 0; // Write the last byte out 
+        bytes.append(static_cast<char>(toWrite >> (8 - numberOfBits)));
+        numberOfBits = 0; // Write the last byte out
     }
-    
+
     if (numberOfBytes != 0) {
-        for (auto i = 0; i < (7 - numberOfBytes); i++) {
-            file.put(0); // Padding so the number of bytes is a muliple of 8
+        for (int i = 0; i < (7 - numberOfBytes); i += 1) {
+            bytes.append(static_cast<char>(0)); // Padding so the number of bytes is a muliple of 8
         }
         numberOfBytes = 0;
     }
 
-    for (auto x = 0; x < width - 1; x++) {
-        for (auto y = 0; y < height; y++) {
-            BasicTile tile = maze.at(x).at(height - 1 - y);
-
+    for (uint32_t x = 0; x < width - 1; x += 1) {
+        for (uint32_t y = 0; y < height; y += 1) {
             toWrite >>= 1;
-            if (tile[Direction::EAST] == true) {
+            if (maze.at(x).at(height - 1 - y).value(Direction::EAST)) {
                 toWrite |= 1 << 7; // Set the MSB bit as one
             }
             numberOfBits = (numberOfBits + 1) % 8;
 
             if (numberOfBits == 0) {
-                file.put(toWrite); // Write the byte when it is full
+                bytes.append(static_cast<char>(toWrite)); // Write the byte when it is full
                 numberOfBytes = (numberOfBytes + 1) % 8; // Add one to the number of bytes
             }
         }
     }
 
     if (numberOfBits != 0) {
-        file.put(toWrite >> (8 - numberOfBits));
+        bytes.append(static_cast<char>(toWrite >> (8 - numberOfBits)));
     }
 
     if (numberOfBytes != 0) {
-        for (auto i = 0; i < (7 - numberOfBytes); i++) {
-            file.put(0); // Padding so the number of bytes is a muliple of 8
+        for (int i = 0; i < (7 - numberOfBytes); i += 1) {
+            bytes.append(static_cast<char>(0)); // Padding so the number of bytes is a muliple of 8
         }
     }
 
-    // Make sure to close the file
-    file.close();
-
-    // Return success
-    return true;
-    */
-    throw std::exception();
+    return bytes;
 }
 
 QByteArray MazeFileUtilities::serializeNumType(const BasicMaze& maze) {
 
-    /*
-    // Create the stream
-    std::ofstream file(mazeFilePath.toStdString(), std::ios::trunc);
-
-    // Make sure the file is open
-    if (!file.is_open()) {
-        return false;
-    }
-
-    // Write to the file
+    QByteArray bytes;
     for (int x = 0; x < maze.size(); x += 1) {
         for (int y = 0; y < maze.at(x).size(); y += 1) {
-            file << x << " " << y;
+            bytes.append(QByteArray::number(x) + " " + QByteArray::number(y));
             for (Direction direction : DIRECTIONS) {
-                file << " " << (maze.at(x).at(y).at(direction) ? 1 : 0);
+                bytes.append(maze.at(x).at(y).value(direction) ? " 1" : " 0");
             }
-            file << "\n"; // std::endl flushes the buffer everytime its called
+            bytes.append('\n');
         }
     }
 
-    // Make sure to close the file
-    file.close();
-
-    // Return success
-    return true;
-    */
-    throw std::exception();
+    return bytes;
 }
 
 } //namespace sim
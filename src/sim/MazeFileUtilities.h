@@ -17,10 +17,13 @@ public:
     static BasicMaze load(const QString& path);
     static BasicMaze loadBytes(const QByteArray& bytes);
 
+    // Both of these throw std::exception if the maze can't be represented
+    // in the given format (or, for save, if the file can't be written)
     static void save(
         const BasicMaze& maze,
         const QString& path,
         MazeFileType type);
+    static QByteArray saveBytes(const BasicMaze& maze, MazeFileType type);
 
 private:
 
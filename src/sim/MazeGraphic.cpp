@@ -1,101 +1,289 @@
 #include "MazeGraphic.h"
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 #include "Assert.h"
+#include "Param.h"
+#include "RGB.h"
 
 namespace sim {
 
-MazeGraphic::MazeGraphic(const Maze* maze, BufferInterface* bufferInterface) {
-    for (int x = 0; x < maze->getWidth(); x += 1) {
-        QVector<TileGraphic> column;
-        for (int y = 0; y < maze->getHeight(); y += 1) {
-            column.push_back(TileGraphic(maze->getTile(x, y), bufferInterface));
+MazeGraphic::MazeGraphic(const Maze* maze, BufferInterface* bufferInterface) :
+        m_maze(maze),
+        m_bufferInterface(bufferInterface),
+        m_chunks(bufferInterface->getChunks()),
+        m_numberOfStreams(0) {
+    for (int chunk = 0; chunk < m_chunks.getNumberOfChunks(); chunk += 1) {
+        int left, bottom, right, top;
+        m_chunks.getTileBounds(chunk, &left, &bottom, &right, &top);
+        QVector<TileGraphic> tileGraphics;
+        tileGraphics.reserve((right - left) * (top - bottom));
+        for (int x = left; x < right; x += 1) {
+            for (int y = bottom; y < top; y += 1) {
+                tileGraphics.push_back(TileGraphic(maze->getTile(x, y), bufferInterface));
+            }
         }
-        m_tileGraphics.push_back(column);
+        m_tileGraphics.push_back(tileGraphics);
     }
-    SIM_ASSERT_EQ(getWidth(), maze->getWidth());
-    SIM_ASSERT_EQ(getHeight(), maze->getHeight());
+    m_lastStreamed.fill(0, m_chunks.getNumberOfChunks());
+    m_overviewOutdated.fill(true, m_chunks.getNumberOfChunks());
 }
 
 void MazeGraphic::setTileColor(int x, int y, Color color) {
     SIM_ASSERT_TR(withinMaze(x, y));
-    m_tileGraphics[x][y].setColor(color);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    getTileGraphic(x, y).setColor(color);
+    m_overviewOutdated[m_chunks.getChunk(x, y)] = true;
 }
 
 void MazeGraphic::declareWall(int x, int y, Direction direction, bool isWall) {
     SIM_ASSERT_TR(withinMaze(x, y));
-    m_tileGraphics[x][y].declareWall(direction, isWall);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    getTileGraphic(x, y).declareWall(direction, isWall);
+    m_overviewOutdated[m_chunks.getChunk(x, y)] = true;
 }
 
 void MazeGraphic::undeclareWall(int x, int y, Direction direction) {
     SIM_ASSERT_TR(withinMaze(x, y));
-    m_tileGraphics[x][y].undeclareWall(direction);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    getTileGraphic(x, y).undeclareWall(direction);
+    m_overviewOutdated[m_chunks.getChunk(x, y)] = true;
 }
 
 void MazeGraphic::setTileFogginess(int x, int y, bool foggy) {
     SIM_ASSERT_TR(withinMaze(x, y));
-    m_tileGraphics[x][y].setFogginess(foggy);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    getTileGraphic(x, y).setFogginess(foggy);
+    m_overviewOutdated[m_chunks.getChunk(x, y)] = true;
 }
 
 void MazeGraphic::setTileText(int x, int y, const QVector<QString>& rowsOfText) {
+    // The overview doesn't show text, so it's still up to date
     SIM_ASSERT_TR(withinMaze(x, y));
-    m_tileGraphics[x][y].setText(rowsOfText);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    getTileGraphic(x, y).setText(rowsOfText);
 }
 
-void MazeGraphic::draw() const {
+void MazeGraphic::draw() {
 
     // Make sure that this function is only called once
     SIM_ASSERT_RUNS_JUST_ONCE();
 
-    // Fill the GRAPHIC_CPU_BUFFER
-    for (int x = 0; x < m_tileGraphics.size(); x += 1) {
-        for (int y = 0; y < m_tileGraphics.at(x).size(); y += 1) {
-            m_tileGraphics.at(x).at(y).draw();
-        }
+    // Allocate the tiles' part of the buffers up front. If every chunk fits,
+    // which is the case for all but huge mazes, then every chunk gets a slot
+    // of its own for good, and the chunks are split among threads and drawn
+    // now. Otherwise, the chunks are drawn as they're streamed in.
+    int numberOfChunks = m_chunks.getNumberOfChunks();
+    int numberOfSlots = std::min(numberOfChunks, P()->maxResidentMazeChunks());
+    m_bufferInterface->initTileGraphics(numberOfSlots);
+    m_slotChunks.fill(-1, numberOfSlots);
+    if (numberOfSlots < numberOfChunks) {
+        return;
+    }
+    for (int chunk = 0; chunk < numberOfChunks; chunk += 1) {
+        m_slotChunks[chunk] = chunk;
+        m_bufferInterface->setChunkSlot(chunk, chunk);
+    }
+    int numberOfThreads = std::max(1, std::min(
+        static_cast<int>(std::thread::hardware_concurrency()), numberOfChunks));
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i += 1) {
+        int firstChunk = numberOfChunks * i / numberOfThreads;
+        int lastChunk = numberOfChunks * (i + 1) / numberOfThreads;
+        threads.push_back(std::thread([this, firstChunk, lastChunk]() {
+            for (int chunk = firstChunk; chunk < lastChunk; chunk += 1) {
+                drawChunk(chunk);
+            }
+        }));
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
     }
 }
 
-void MazeGraphic::updateColor() const {
-    for (int x = 0; x < getWidth(); x += 1) {
-        for (int y = 0; y < getHeight(); y += 1) {
-            m_tileGraphics.at(x).at(y).updateColor();
-        }
+bool MazeGraphic::stream(const QVector<int>& chunks) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_slotChunks.size() < chunks.size()) {
+        return false;
     }
-}
 
-void MazeGraphic::updateWalls() const {
-    for (int x = 0; x < getWidth(); x += 1) {
-        for (int y = 0; y < getHeight(); y += 1) {
-            m_tileGraphics.at(x).at(y).updateWalls();
-        }
+    // Mark all of the chunks as used first, so that none of them are evicted
+    // to make room for the others
+    m_numberOfStreams += 1;
+    for (int chunk : chunks) {
+        m_lastStreamed[chunk] = m_numberOfStreams;
     }
-}
 
-void MazeGraphic::updateFog() const {
-    for (int x = 0; x < getWidth(); x += 1) {
-        for (int y = 0; y < getHeight(); y += 1) {
-            m_tileGraphics.at(x).at(y).updateFog();
+    for (int chunk : chunks) {
+        if (m_bufferInterface->getChunkSlot(chunk) != -1) {
+            continue;
+        }
+        int slot = 0;
+        for (int i = 0; i < m_slotChunks.size(); i += 1) {
+            if (m_slotChunks.at(i) == -1) {
+                slot = i;
+                break;
+            }
+            if (m_lastStreamed.at(m_slotChunks.at(i)) < m_lastStreamed.at(m_slotChunks.at(slot))) {
+                slot = i;
+            }
+        }
+        if (m_slotChunks.at(slot) != -1) {
+            m_bufferInterface->setChunkSlot(m_slotChunks.at(slot), -1);
         }
+        m_slotChunks[slot] = chunk;
+        m_bufferInterface->setChunkSlot(chunk, slot);
+        drawChunk(chunk);
     }
+    return true;
 }
 
-void MazeGraphic::updateText() const {
-    for (int x = 0; x < getWidth(); x += 1) {
-        for (int y = 0; y < getHeight(); y += 1) {
-            m_tileGraphics.at(x).at(y).updateText();
+QVector<int> MazeGraphic::updateOverview() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_overview.isEmpty()) {
+        m_overview.fill(0, 4 * getOverviewWidth() * getOverviewHeight());
+    }
+    QVector<int> chunks;
+    for (int chunk = 0; chunk < m_chunks.getNumberOfChunks(); chunk += 1) {
+        if (m_overviewOutdated.at(chunk)) {
+            drawOverviewChunk(chunk);
+            m_overviewOutdated[chunk] = false;
+            chunks.append(chunk);
         }
     }
+    return chunks;
+}
+
+const QVector<unsigned char>& MazeGraphic::getOverview() const {
+    return m_overview;
+}
+
+int MazeGraphic::getOverviewWidth() const {
+    return 2 * getWidth() + 1;
+}
+
+int MazeGraphic::getOverviewHeight() const {
+    return 2 * getHeight() + 1;
+}
+
+void MazeGraphic::updateColor() {
+    updateTiles(&TileGraphic::updateColor);
+}
+
+void MazeGraphic::updateWalls() {
+    updateTiles(&TileGraphic::updateWalls);
+}
+
+void MazeGraphic::updateFog() {
+    updateTiles(&TileGraphic::updateFog);
+}
+
+void MazeGraphic::updateText() {
+    updateTiles(&TileGraphic::updateText);
 }
 
 int MazeGraphic::getWidth() const {
-    return m_tileGraphics.size();
+    return m_maze->getWidth();
 }
 
 int MazeGraphic::getHeight() const {
-    return (m_tileGraphics.size() > 0 ? m_tileGraphics.at(0).size() : 0);
+    return m_maze->getHeight();
 }
 
 bool MazeGraphic::withinMaze(int x, int y) const {
     return 0 <= x && x < getWidth() && 0 <= y && y < getHeight();
 }
 
+TileGraphic& MazeGraphic::getTileGraphic(int x, int y) {
+    return m_tileGraphics[m_chunks.getChunk(x, y)][m_chunks.getIndexInChunk(x, y)];
+}
+
+void MazeGraphic::drawChunk(int chunk) const {
+    for (const TileGraphic& tileGraphic : m_tileGraphics.at(chunk)) {
+        tileGraphic.draw();
+    }
+}
+
+void MazeGraphic::drawOverviewChunk(int chunk) {
+
+    // Each tile owns its own texel, along with those of its north wall, its
+    // east wall, and the post between them. The tiles on the south and west
+    // edges of the maze also own the walls and posts along those edges.
+    //
+    //     P N P
+    //     W T E
+    //     P S P
+    //
+    RGB cornerColor = COLOR_TO_RGB.value(STRING_TO_COLOR.value(P()->tileCornerColor()));
+    RGB fogColor = COLOR_TO_RGB.value(STRING_TO_COLOR.value(P()->tileFogColor()));
+    int overviewWidth = getOverviewWidth();
+    unsigned char* overview = m_overview.data();
+
+    auto blend = [](RGB below, RGB above, double alpha) {
+        return RGB {
+            below.r + (above.r - below.r) * alpha,
+            below.g + (above.g - below.g) * alpha,
+            below.b + (above.b - below.b) * alpha,
+        };
+    };
+
+    int left, bottom, right, top;
+    m_chunks.getTileBounds(chunk, &left, &bottom, &right, &top);
+    for (int x = left; x < right; x += 1) {
+        for (int y = bottom; y < top; y += 1) {
+
+            const TileGraphic& tileGraphic = getTileGraphic(x, y);
+            RGB tileColor = COLOR_TO_RGB.value(tileGraphic.getBaseColor());
+            double fogAlpha = tileGraphic.getFogAlpha();
+
+            auto setTexel = [&](int u, int v, RGB color) {
+                color = blend(color, fogColor, fogAlpha);
+                unsigned char* texel = overview + 4 * (v * overviewWidth + u);
+                texel[0] = static_cast<unsigned char>(255.0 * color.r);
+                texel[1] = static_cast<unsigned char>(255.0 * color.g);
+                texel[2] = static_cast<unsigned char>(255.0 * color.b);
+                texel[3] = 255;
+            };
+            auto wallColor = [&](Direction direction) -> RGB {
+                QPair<Color, float> colorAndAlpha = tileGraphic.deduceWallColorAndAlpha(direction);
+                return blend(tileColor, COLOR_TO_RGB.value(colorAndAlpha.first), colorAndAlpha.second);
+            };
+
+            int u = 2 * x + 1;
+            int v = 2 * y + 1;
+            setTexel(u, v, tileColor);
+            setTexel(u, v + 1, wallColor(Direction::NORTH));
+            setTexel(u + 1, v, wallColor(Direction::EAST));
+            setTexel(u + 1, v + 1, cornerColor);
+            if (x == 0) {
+                setTexel(u - 1, v, wallColor(Direction::WEST));
+                setTexel(u - 1, v + 1, cornerColor);
+            }
+            if (y == 0) {
+                setTexel(u, v - 1, wallColor(Direction::SOUTH));
+                setTexel(u + 1, v - 1, cornerColor);
+            }
+            if (x == 0 && y == 0) {
+                setTexel(u - 1, v - 1, cornerColor);
+            }
+        }
+    }
+}
+
+void MazeGraphic::updateTiles(void (TileGraphic::*update)() const) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (int chunk : m_slotChunks) {
+        if (chunk == -1) {
+            continue;
+        }
+        for (const TileGraphic& tileGraphic : m_tileGraphics.at(chunk)) {
+            (tileGraphic.*update)();
+        }
+    }
+    m_overviewOutdated.fill(true);
+}
+
 } // namespace sim
@@ -2,13 +2,22 @@
 
 #include <QVector>
 
+#include <mutex>
+
 #include "BufferInterface.h"
 #include "Color.h"
 #include "Maze.h"
+#include "MazeChunks.h"
 #include "TileGraphic.h"
 
 namespace sim {
 
+// The graphics of the tiles of the maze, which are stored a chunk at a time
+// (see MazeChunks.h). The buffers only have room for so many chunks; if the
+// maze has more than that, the chunks that are on screen are streamed into
+// the buffers as they're needed, in place of those that have gone unused the
+// longest. From far away, huge mazes are instead drawn as the overview, a
+// small image of the whole maze that's kept up to date a chunk at a time.
 class MazeGraphic {
 
 public:
@@ -20,19 +29,62 @@ public:
     void setTileFogginess(int x, int y, bool foggy);
     void setTileText(int x, int y, const QVector<QString>& rowsOfText);
 
-    void draw() const;
-    void updateColor() const;
-    void updateWalls() const;
-    void updateFog() const;
-    void updateText() const;
+    // Allocates the tiles' parts of the buffers, and draws every chunk into
+    // them if there's room for all of them at once
+    void draw();
+
+    // Makes sure that each of the chunks is drawn in the buffers, and returns
+    // true, unless there isn't room for all of them at once
+    bool stream(const QVector<int>& chunks);
+
+    // The overview has a texel for each tile, each wall, and each post, and so
+    // is (2 * width + 1) by (2 * height + 1) texels, in RGBA, from the bottom
+    // row up. This redraws the chunks of the overview that have changed since
+    // it was last called, and returns them; the first call draws them all.
+    QVector<int> updateOverview();
+    const QVector<unsigned char>& getOverview() const;
+    int getOverviewWidth() const;
+    int getOverviewHeight() const;
+
+    void updateColor();
+    void updateWalls();
+    void updateFog();
+    void updateText();
 
 private:
+    const Maze* m_maze;
+    BufferInterface* m_bufferInterface;
+    MazeChunks m_chunks;
+
+    // The tile graphics of each chunk, in the same order as the tiles
     QVector<QVector<TileGraphic>> m_tileGraphics;
 
+    // The tiles are changed by the algorithm, but streamed and drawn into the
+    // overview by the view, on another thread
+    std::mutex m_mutex;
+
+    // The chunk in each slot of the buffers (or -1), and for each chunk, the
+    // number of the last call to stream() that asked for it
+    QVector<int> m_slotChunks;
+    QVector<int> m_lastStreamed;
+    int m_numberOfStreams;
+
+    QVector<unsigned char> m_overview;
+    QVector<bool> m_overviewOutdated;
+
     int getWidth() const;
     int getHeight() const;
     bool withinMaze(int x, int y) const;
 
+    TileGraphic& getTileGraphic(int x, int y);
+
+    void drawChunk(int chunk) const;
+    void drawOverviewChunk(int chunk);
+
+    // Calls the update method of every tile in a chunk that has a slot, and
+    // marks the whole overview as outdated
+    void updateTiles(void (TileGraphic::*update)() const);
+
 };
 
 } // namespace sim
@@ -0,0 +1,107 @@
+#include "MazeTransform.h"
+
+namespace sim {
+
+MazeTransform::MazeTransform() : MazeTransform(false, 0) {
+}
+
+MazeTransform::MazeTransform(bool mirrored, int rotations) :
+        m_mirrored(mirrored),
+        m_rotations((rotations % 4 + 4) % 4),
+        m_swapsAxes(m_rotations % 2 == 1) {
+
+    // Undo the rotations first, one clockwise quarter turn at a time, and then
+    // the mirroring; mirroring is its own inverse
+    m_xx = 1;
+    m_xy = 0;
+    m_yx = 0;
+    m_yy = 1;
+    for (int i = 0; i < m_rotations; i += 1) {
+        int xx = m_yx;
+        int xy = m_yy;
+        m_yx = -m_xx;
+        m_yy = -m_xy;
+        m_xx = xx;
+        m_xy = xy;
+    }
+    if (m_mirrored) {
+        m_xx = -m_xx;
+        m_xy = -m_xy;
+    }
+
+    // Directions are unit vectors, and so map through the same matrix
+    static const int dx[] = {0, 1, 0, -1};
+    static const int dy[] = {1, 0, -1, 0};
+    for (int i = 0; i < 4; i += 1) {
+        int x = m_xx * dx[i] + m_xy * dy[i];
+        int y = m_yx * dx[i] + m_yy * dy[i];
+        for (int j = 0; j < 4; j += 1) {
+            if (dx[j] == x && dy[j] == y) {
+                m_originalDirections[i] = j;
+            }
+        }
+    }
+}
+
+QVector<MazeTransform> MazeTransform::all() {
+    QVector<MazeTransform> transforms;
+    for (bool mirrored : {false, true}) {
+        for (int rotations = 0; rotations < 4; rotations += 1) {
+            transforms.append(MazeTransform(mirrored, rotations));
+        }
+    }
+    return transforms;
+}
+
+bool MazeTransform::isMirrored() const {
+    return m_mirrored;
+}
+
+int MazeTransform::getRotations() const {
+    return m_rotations;
+}
+
+MazeTransform MazeTransform::after(const MazeTransform& other) const {
+    // A mirroring followed by a rotation is the reverse rotation followed by
+    // the same mirroring, so this mirroring can be moved before the other
+    // transform's rotations by negating them
+    return MazeTransform(
+        m_mirrored != other.m_mirrored,
+        m_rotations + (m_mirrored ? -other.m_rotations : other.m_rotations));
+}
+
+QString MazeTransform::getName() const {
+    return "r" + QString::number(90 * m_rotations) + (m_mirrored ? "m" : "");
+}
+
+Direction MazeTransform::getOriginalDirection(Direction direction) const {
+    return DIRECTIONS.at(m_originalDirections[static_cast<int>(direction)]);
+}
+
+BasicMaze MazeTransform::apply(const BasicMaze& basicMaze) const {
+    int width = basicMaze.size();
+    int height = (0 < width ? basicMaze.at(0).size() : 0);
+    int transformedWidth = getWidth(width, height);
+    int transformedHeight = getHeight(width, height);
+    BasicMaze transformed;
+    transformed.reserve(transformedWidth);
+    for (int x = 0; x < transformedWidth; x += 1) {
+        QVector<BasicTile> column;
+        column.reserve(transformedHeight);
+        for (int y = 0; y < transformedHeight; y += 1) {
+            int originalX = x;
+            int originalY = y;
+            getOriginalPosition(width, height, &originalX, &originalY);
+            const BasicTile& original = basicMaze.at(originalX).at(originalY);
+            BasicTile tile;
+            for (Direction direction : DIRECTIONS) {
+                tile.insert(direction, original.value(getOriginalDirection(direction)));
+            }
+            column.append(tile);
+        }
+        transformed.append(column);
+    }
+    return transformed;
+}
+
+} // namespace sim
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+#include "BasicMaze.h"
+
+namespace sim {
+
+// One of the eight symmetries of a rectangular maze (the dihedral group of the
+// square): an optional mirroring across the vertical, followed by some number
+// of counter-clockwise quarter turns.
+//
+// Rather than building a transformed copy of a maze, a transform maps
+// positions and directions in the transformed maze back to the original one,
+// so that the original can be read through it as if it had been transformed.
+// Positions map through a 2x2 integer matrix about the center of the maze,
+// and directions through a fixed permutation, both computed at construction.
+//
+// Directions may also be given as ints, in the order of the Direction enum.
+class MazeTransform {
+
+public:
+
+    // The identity
+    MazeTransform();
+
+    // The mirroring (if any) is applied before the rotations, which may be
+    // any number, positive or negative
+    MazeTransform(bool mirrored, int rotations);
+
+    // The eight distinct transforms, starting with the identity
+    static QVector<MazeTransform> all();
+
+    bool isMirrored() const;
+    int getRotations() const;
+
+    // The transform that is equivalent to first applying other, and then
+    // applying this transform
+    MazeTransform after(const MazeTransform& other) const;
+
+    // A short, unique name, e.g., "r0", "r90", or "r270m"
+    QString getName() const;
+
+    // The width and height of the transformed maze
+    int getWidth(int width, int height) const {
+        return m_swapsAxes ? height : width;
+    }
+    int getHeight(int width, int height) const {
+        return m_swapsAxes ? width : height;
+    }
+
+    // The position in the original maze, of the given width and height, of a
+    // position in the transformed maze
+    void getOriginalPosition(int width, int height, int* x, int* y) const {
+        int doubledX = 2 * *x - (getWidth(width, height) - 1);
+        int doubledY = 2 * *y - (getHeight(width, height) - 1);
+        *x = (m_xx * doubledX + m_xy * doubledY + width - 1) / 2;
+        *y = (m_yx * doubledX + m_yy * doubledY + height - 1) / 2;
+    }
+
+    // The direction in the original maze of a direction in the transformed
+    // maze
+    int getOriginalDirection(int direction) const {
+        return m_originalDirections[direction];
+    }
+    Direction getOriginalDirection(Direction direction) const;
+
+    // Materializes the transformed maze in a single pass over the original
+    BasicMaze apply(const BasicMaze& basicMaze) const;
+
+private:
+
+    bool m_mirrored;
+    int m_rotations;
+    bool m_swapsAxes;
+
+    // From (doubled, centered) transformed coordinates to original ones
+    int m_xx;
+    int m_xy;
+    int m_yx;
+    int m_yy;
+
+    int m_originalDirections[4];
+
+};
+
+} // namespace sim
@@ -1,23 +1,43 @@
 #include "Model.h"
 
+#include "Assert.h"
+#include "Param.h"
+
 namespace sim {
 
-Model::Model() {
-    m_maze = new Maze(); 
-    m_mouse = new Mouse(m_maze); 
-    m_world = new World(m_maze, m_mouse);
+Model::Model() :
+        m_random(static_cast<uint32_t>(P()->randomSeed())) {
+    m_maze = new Maze(m_random.getStream(Random::MAZE_GENERATION));
+    for (int i = 0; i < P()->numberOfMice(); i += 1) {
+        m_mice.push_back(new Mouse(m_maze));
+    }
+    m_world = new World(m_maze, m_mice);
 }
 
 Maze* Model::getMaze() {
     return m_maze;
 }
 
-Mouse* Model::getMouse() {
-    return m_mouse;
+const Random& Model::getRandom() {
+    return m_random;
 }
 
 World* Model::getWorld() {
     return m_world;
 }
 
+Mouse* Model::getMouse() {
+    return getMouse(0);
+}
+
+Mouse* Model::getMouse(int index) {
+    SIM_ASSERT_LE(0, index);
+    SIM_ASSERT_LT(index, m_mice.size());
+    return m_mice.at(index);
+}
+
+int Model::getNumberOfMice() {
+    return m_mice.size();
+}
+
 } // namespace sim
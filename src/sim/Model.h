@@ -1,7 +1,10 @@
 #pragma once
 
+#include <QVector>
+
 #include "Maze.h"
 #include "Mouse.h"
+#include "Random.h"
 #include "World.h"
 
 namespace sim {
@@ -11,12 +14,23 @@ class Model {
 public:
     Model();
     Maze* getMaze();
-    Mouse* getMouse();
+
+    // The root of the simulation's random numbers, seeded by the random seed
+    // parameter; each consumer is given a stream of its own, derived from it
+    const Random& getRandom();
+
     World* getWorld();
 
+    // All of the mice share the maze (and the world); the first mouse is the
+    // one that the zoomed map follows, the header describes, and so on
+    Mouse* getMouse();
+    Mouse* getMouse(int index);
+    int getNumberOfMice();
+
 private:
+    Random m_random;
     Maze* m_maze;
-    Mouse* m_mouse;
+    QVector<Mouse*> m_mice;
     World* m_world;
 
 };
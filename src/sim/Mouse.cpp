@@ -1,12 +1,13 @@
 #include "Mouse.h"
 
-#include <QMapIterator>
 #include <QPair>
 #include <QVector>
 
+#include <algorithm>
+
 #include "units/Meters.h"
 #include "units/MetersPerSecond.h"
-#include "units/Polar.h"
+#include "units/Heading.h"
 
 #include "Assert.h"
 #include "CPMath.h"
@@ -25,7 +26,8 @@ Mouse::Mouse(const Maze* maze) :
 
 bool Mouse::initialize(
         const QString& mouseFile,
-        Direction initialDirection) {
+        Direction initialDirection,
+        std::shared_ptr<const WallDistanceField> wallDistanceField) {
 
     // We begin with the assumption that the initialization will succeed
     bool success = true;
@@ -45,47 +47,82 @@ bool Mouse::initialize(
         return false;
     }
 
-    // Initialize the body, wheels, and sensors, such that they have the
-    // correct initial translation and rotation
-    m_initialBodyPolygon = parser.getBody(m_initialTranslation, m_initialRotation, &success);
-    m_wheels = parser.getWheels(m_initialTranslation, m_initialRotation, &success);
-    m_sensors = parser.getSensors(m_initialTranslation, m_initialRotation, *m_maze, &success);
+    // Initialize the wheels and sensors, such that they have the correct
+    // initial translation and rotation
+    QMap<QString, Wheel> wheels =
+        parser.getWheels(m_initialTranslation, m_initialRotation);
+    QMap<QString, Sensor> sensors =
+        parser.getSensors(m_initialTranslation, m_initialRotation, *m_maze);
 
     // Initialize the wheel effects and speed adjustment factors
-    m_wheelEffects = getWheelEffects(m_initialTranslation, m_initialRotation, m_wheels);
-    m_wheelSpeedAdjustmentFactors = getWheelSpeedAdjustmentFactors(m_wheels, m_wheelEffects);
+    QMap<QString, WheelEffect> wheelEffects =
+        getWheelEffects(m_initialTranslation, m_initialRotation, wheels);
+    QMap<QString, QPair<double, double>> wheelSpeedAdjustmentFactors =
+        getWheelSpeedAdjustmentFactors(wheels, wheelEffects);
 
     // Initialize the curve turn factors, based on previously determined info
     m_curveTurnFactorCalculator = CurveTurnFactorCalculator(
-        m_wheels,
-        m_wheelEffects,
-        m_wheelSpeedAdjustmentFactors);
-
-    // Initialize the collision polygon; this is technically not correct since
-    // we should be using union, not convexHull, but it's a good approximation
-    QVector<Polygon> polygons;
-    polygons.push_back(m_initialBodyPolygon);
-    for (const Wheel& wheel : m_wheels) {
-        polygons.push_back(wheel.getInitialPolygon());
+        wheels,
+        wheelEffects,
+        wheelSpeedAdjustmentFactors);
+
+    // Flatten the wheels and sensors (and everything keyed by their names)
+    // into vectors, so that the per-tick updates and the index-based methods
+    // never have to look anything up by name
+    for (const auto& pair : ContainerUtilities::items(wheels)) {
+        m_wheelIndices.insert(pair.first, m_wheels.size());
+        m_wheelNames.push_back(pair.first);
+        m_wheels.push_back(pair.second);
+        m_wheelEffects.push_back(wheelEffects.value(pair.first));
+        m_wheelSpeedAdjustmentFactors.push_back(wheelSpeedAdjustmentFactors.value(pair.first));
     }
-    for (const Sensor& sensor : m_sensors) {
-        polygons.push_back(sensor.getInitialPolygon());
+    for (const auto& pair : ContainerUtilities::items(sensors)) {
+        m_sensorIndices.insert(pair.first, m_sensors.size());
+        m_sensorNames.push_back(pair.first);
+        m_sensors.push_back(pair.second);
     }
-    m_initialCollisionPolygon = GeometryUtilities::convexHull(polygons);
 
-    // Initialize the center of mass polygon
-    m_initialCenterOfMassPolygon = GeometryUtilities::createCirclePolygon(m_initialTranslation, Meters(.005), 8);
+    // Optionally precompute how far the sensors' rays can go before they
+    // could possibly hit anything; the field only needs to cover the ranges
+    m_wallDistanceField = wallDistanceField;
+    if (m_wallDistanceField == nullptr && 0 < P()->sensorDistanceFieldHeadings() && !m_sensors.isEmpty()) {
+        Meters maxRange(0);
+        for (const Sensor& sensor : m_sensors) {
+            maxRange = std::max(maxRange, sensor.getRange());
+        }
+        m_wallDistanceField = std::make_shared<WallDistanceField>(
+            *m_maze,
+            P()->sensorDistanceFieldCellsPerTile(),
+            P()->sensorDistanceFieldHeadings(),
+            maxRange);
+    }
 
-    // Force triangulation of the drawable polygons, thus ensuring
-    // that we only triangulate once, at the beginning of execution
-    m_initialBodyPolygon.getTriangles();
-    m_initialCollisionPolygon.getTriangles();
-    m_initialCenterOfMassPolygon.getTriangles();
-    for (const Wheel& wheel : m_wheels) {
-        wheel.getInitialPolygon().getTriangles();
+    // Compile the rigid parts into a single array of vertices, triangulating
+    // each of them once, at the beginning of execution; the result is cached
+    // along with the mouse's definitions, so that later runs that start the
+    // mouse in the same pose can skip the hull and the triangulations
+    if (!parser.getGeometry(m_initialTranslation, m_initialRotation, &m_geometry)) {
+        QVector<Polygon> wheelPolygons;
+        for (const Wheel& wheel : m_wheels) {
+            wheelPolygons.push_back(wheel.getInitialPolygon());
+        }
+        QVector<Polygon> sensorPolygons;
+        for (const Sensor& sensor : m_sensors) {
+            sensorPolygons.push_back(sensor.getInitialPolygon());
+        }
+        m_geometry = MouseGeometry(
+            m_initialTranslation,
+            m_initialRotation,
+            parser.getBody(m_initialTranslation, m_initialRotation),
+            GeometryUtilities::createCirclePolygon(m_initialTranslation, Meters(.005), 8),
+            wheelPolygons,
+            sensorPolygons);
+        parser.cacheGeometry(m_initialTranslation, m_initialRotation, m_geometry);
     }
+
+    // Force triangulation of the sensor views, which aren't rigid, but whose
+    // initial triangles are still worth having up front
     for (const Sensor& sensor : m_sensors) {
-        sensor.getInitialPolygon().getTriangles();
         sensor.getInitialViewPolygon().getTriangles();
     }
 
@@ -151,24 +188,27 @@ void Mouse::teleport(const Coordinate& translation, const Angle& rotation) {
 
 Polygon Mouse::getCurrentBodyPolygon(
         const Coordinate& currentTranslation, const Angle& currentRotation) const {
-    return getCurrentPolygon(m_initialBodyPolygon, currentTranslation, currentRotation);
+    return m_geometry.getPolygon(m_geometry.getBodyPart(), currentTranslation, currentRotation);
 }
 
 Polygon Mouse::getCurrentCollisionPolygon(
         const Coordinate& currentTranslation, const Angle& currentRotation) const {
-    return getCurrentPolygon(m_initialCollisionPolygon, currentTranslation, currentRotation);
+    return m_geometry.getPolygon(m_geometry.getCollisionPart(), currentTranslation, currentRotation);
 }
 
 Polygon Mouse::getCurrentCenterOfMassPolygon(
         const Coordinate& currentTranslation, const Angle& currentRotation) const {
-    return getCurrentPolygon(m_initialCenterOfMassPolygon, currentTranslation, currentRotation);
+    return m_geometry.getPolygon(m_geometry.getCenterOfMassPart(), currentTranslation, currentRotation);
 }
 
 QVector<Polygon> Mouse::getCurrentWheelPolygons(
         const Coordinate& currentTranslation, const Angle& currentRotation) const {
+    // A single transform of all of the vertices, rather than one per wheel
+    MouseGeometry::Vertices vertices;
+    m_geometry.transform(currentTranslation, currentRotation, &vertices);
     QVector<Polygon> polygons;
-    for (const Wheel& wheel : m_wheels) {
-        polygons.push_back(getCurrentPolygon(wheel.getInitialPolygon(), currentTranslation, currentRotation));
+    for (int i = 0; i < m_wheels.size(); i += 1) {
+        polygons.push_back(m_geometry.getPolygon(m_geometry.getWheelPart(i), vertices));
     }
     return polygons;
 }
@@ -184,9 +224,11 @@ QVector<Polygon> Mouse::getCurrentWheelSpeedIndicatorPolygons(
 
 QVector<Polygon> Mouse::getCurrentSensorPolygons(
         const Coordinate& currentTranslation, const Angle& currentRotation) const {
+    MouseGeometry::Vertices vertices;
+    m_geometry.transform(currentTranslation, currentRotation, &vertices);
     QVector<Polygon> polygons;
-    for (const Sensor& sensor : m_sensors) {
-        polygons.push_back(getCurrentPolygon(sensor.getInitialPolygon(), currentTranslation, currentRotation));
+    for (int i = 0; i < m_sensors.size(); i += 1) {
+        polygons.push_back(m_geometry.getPolygon(m_geometry.getSensorPart(i), vertices));
     }
     return polygons;
 }
@@ -204,91 +246,107 @@ QVector<Polygon> Mouse::getCurrentSensorViewPolygons(
             sensor.getCurrentViewPolygon(
                 translationAndRotation.first,
                 translationAndRotation.second,
-                *m_maze));
+                *m_maze,
+                m_wallDistanceField.get()));
     }
     return polygons;
 }
 
+std::shared_ptr<const WallDistanceField> Mouse::getWallDistanceField() const {
+    return m_wallDistanceField;
+}
+
+const MouseGeometry& Mouse::getGeometry() const {
+    return m_geometry;
+}
+
 void Mouse::update(const Duration& elapsed) {
 
     // NOTE: This is a *very* performance critical function
 
     m_updateMutex.lock();
 
-    MetersPerSecond sumDx(0);
-    MetersPerSecond sumDy(0);
-    RadiansPerSecond sumDr(0);
-
-    // TODO: MACK - check the performance of this - can/should I use ContainerUtilities::items here?
-    QMapIterator<QString, Wheel> wheelIterator(m_wheels);
-    while (wheelIterator.hasNext()) {
-        auto pair = wheelIterator.next();
-
-        // We can't do pair.second.updateRotation() since that breaks const
-        m_wheels[pair.key()].updateRotation(pair.value().getAngularVelocity() * elapsed);
+    // Sum the effects of the wheels in the mouse's frame of reference, and
+    // only then rotate them into the maze's, so that the sine and cosine of
+    // the rotation are computed once rather than once per wheel. MouseBatch
+    // performs the very same arithmetic on many mice at once.
+    units::Speed forward;
+    units::Speed sideways;
+    units::AngularVelocity turn;
+    for (int i = 0; i < m_wheels.size(); i += 1) {
+        Wheel& wheel = m_wheels[i];
+        wheel.updateRotation(wheel.getAngularVelocity() * elapsed);
 
         // Get the effects on the rate of change of translation, both forward
         // and sideways, and rotation of the mouse due to this particular wheel
         std::tuple<MetersPerSecond, MetersPerSecond, RadiansPerSecond> effects =
-            m_wheelEffects.value(pair.key()).getEffects(pair.value().getAngularVelocity());
-
-        // The effect of the forward component
-        sumDx += std::get<0>(effects) * getCurrentRotation().getCos();
-        sumDy += std::get<0>(effects) * getCurrentRotation().getSin();
-
-        // The effect of the sideways component
-        sumDx += std::get<1>(effects) * getCurrentRotation().getSin();
-        sumDy += std::get<1>(effects) * getCurrentRotation().getCos() * -1;
-
-        // The effect of the rotation component
-        sumDr += std::get<2>(effects);
+            m_wheelEffects.at(i).getEffects(wheel.getAngularVelocity());
+        forward += units::Speed(std::get<0>(effects).getMetersPerSecond());
+        sideways += units::Speed(std::get<1>(effects).getMetersPerSecond());
+        turn += units::AngularVelocity(std::get<2>(effects).getRadiansPerSecond());
     }
 
-    MetersPerSecond aveDx = sumDx / static_cast<double>(m_wheels.size());
-    MetersPerSecond aveDy = sumDy / static_cast<double>(m_wheels.size());
-    RadiansPerSecond aveDr = sumDr / static_cast<double>(m_wheels.size());
+    double wheelCount = static_cast<double>(m_wheels.size());
+    units::Speed aveForward = forward / wheelCount;
+    units::Speed aveSideways = sideways / wheelCount;
+    units::AngularVelocity aveTurn = turn / wheelCount;
 
-    m_currentGyro = aveDr;
-    m_currentRotation += Radians(aveDr * elapsed);
-    m_currentTranslation += Cartesian(aveDx * elapsed, aveDy * elapsed);
+    units::Heading rotation(m_currentRotation);
+    units::Speed aveDx = aveForward * rotation.getCos() + aveSideways * rotation.getSin();
+    units::Speed aveDy = aveForward * rotation.getSin() - aveSideways * rotation.getCos();
+    units::Time seconds(elapsed.getSeconds());
 
-    // TODO: MACK - check the performance of this - can/should I use ContainerUtilities::items here?
-    QMapIterator<QString, Sensor> sensorIterator(m_sensors);
-    while (sensorIterator.hasNext()) {
-        auto pair = sensorIterator.next();
+    m_currentGyro = RadiansPerSecond(aveTurn.getValue());
+    m_currentRotation = Radians((rotation.getAngle() + aveTurn * seconds).getValue());
+    m_currentTranslation = Cartesian(
+        Meters((units::Length(m_currentTranslation.getX().getMeters()) + aveDx * seconds).getValue()),
+        Meters((units::Length(m_currentTranslation.getY().getMeters()) + aveDy * seconds).getValue()));
 
-        QPair<Cartesian, Radians> translationAndRotation =
-            getCurrentSensorPositionAndDirection(
-                pair.value(),
-                m_currentTranslation,
-                m_currentRotation);
-        // We can't do pair.value().updateReading() since that breaks const
-        m_sensors[pair.key()].updateReading(
-            translationAndRotation.first,
-            translationAndRotation.second,
-            *m_maze);
-    }
+    updateSensorReadings();
 
     m_updateMutex.unlock();
 }
 
+void Mouse::updateSensorReadings() {
+
+    // The sensors move rigidly with the mouse, so they're all placed with the
+    // same rotation, whose sine and cosine are computed just once
+    units::Heading rotationDelta(units::Angle(
+        m_currentRotation.getRadiansNotBounded() - m_initialRotation.getRadiansNotBounded()));
+    units::Length initialX(m_initialTranslation.getX().getMeters());
+    units::Length initialY(m_initialTranslation.getY().getMeters());
+    units::Length currentX(m_currentTranslation.getX().getMeters());
+    units::Length currentY(m_currentTranslation.getY().getMeters());
+
+    for (Sensor& sensor : m_sensors) {
+        units::Length dx = units::Length(sensor.getInitialPosition().getX().getMeters()) - initialX;
+        units::Length dy = units::Length(sensor.getInitialPosition().getY().getMeters()) - initialY;
+        rotationDelta.rotate(&dx, &dy);
+        sensor.updateReading(
+            Cartesian(Meters((currentX + dx).getValue()), Meters((currentY + dy).getValue())),
+            Radians(sensor.getInitialDirection().getRadiansNotBounded() + rotationDelta.getAngle().getValue()),
+            *m_maze,
+            m_wallDistanceField.get());
+    }
+}
+
 bool Mouse::hasWheel(const QString& name) const {
-    return m_wheels.contains(name);
+    return m_wheelIndices.contains(name);
 }
 
 RadiansPerSecond Mouse::getWheelMaxSpeed(const QString& name) const {
-    SIM_ASSERT_TR(m_wheels.contains(name));
-    return m_wheels.value(name).getMaxAngularVelocityMagnitude();
+    SIM_ASSERT_TR(hasWheel(name));
+    return getWheelMaxSpeed(m_wheelIndices.value(name));
 }
 
 void Mouse::setWheelSpeeds(const QMap<QString, RadiansPerSecond>& wheelSpeeds) {
     m_updateMutex.lock();
     for (const auto& pair : ContainerUtilities::items(wheelSpeeds)) {
-        SIM_ASSERT_TR(m_wheels.contains(pair.first));
+        SIM_ASSERT_TR(hasWheel(pair.first));
         SIM_ASSERT_LE(
             std::abs(pair.second.getRevolutionsPerMinute()),
             getWheelMaxSpeed(pair.first).getRevolutionsPerMinute());
-        m_wheels[pair.first].setAngularVelocity(pair.second);
+        m_wheels[m_wheelIndices.value(pair.first)].setAngularVelocity(pair.second);
     }
     m_updateMutex.unlock();
 }
@@ -309,52 +367,117 @@ void Mouse::setWheelSpeedsForCurveRight(double fractionOfMaxSpeed, const Meters&
 
 void Mouse::stopAllWheels() {
     QMap<QString, RadiansPerSecond> wheelSpeeds;
-    for (const auto& pair : ContainerUtilities::items(m_wheels)) {
-        wheelSpeeds.insert(pair.first, RadiansPerSecond(0));
+    for (const QString& name : m_wheelNames) {
+        wheelSpeeds.insert(name, RadiansPerSecond(0));
     }
     setWheelSpeeds(wheelSpeeds);
 }
 
 EncoderType Mouse::getWheelEncoderType(const QString& name) const {
     SIM_ASSERT_TR(hasWheel(name));
-    return m_wheels.value(name).getEncoderType();
+    return getWheelEncoderType(m_wheelIndices.value(name));
 }
 
 double Mouse::getWheelEncoderTicksPerRevolution(const QString& name) const {
     SIM_ASSERT_TR(hasWheel(name));
-    return m_wheels.value(name).getEncoderTicksPerRevolution();
+    return m_wheels.at(m_wheelIndices.value(name)).getEncoderTicksPerRevolution();
 }
 
 int Mouse::readWheelAbsoluteEncoder(const QString& name) const {
     SIM_ASSERT_TR(hasWheel(name));
-    m_updateMutex.lock();
-    int encoderReading = m_wheels.value(name).readAbsoluteEncoder();
-    m_updateMutex.unlock();
-    return encoderReading;
+    return readWheelAbsoluteEncoder(m_wheelIndices.value(name));
 }
 
 int Mouse::readWheelRelativeEncoder(const QString& name) const {
     SIM_ASSERT_TR(hasWheel(name));
-    m_updateMutex.lock();
-    int encoderReading = m_wheels.value(name).readRelativeEncoder();
-    m_updateMutex.unlock();
-    return encoderReading;
+    return readWheelRelativeEncoder(m_wheelIndices.value(name));
 }
 
 void Mouse::resetWheelRelativeEncoder(const QString& name) {
     SIM_ASSERT_TR(hasWheel(name));
     m_updateMutex.lock();
-    m_wheels[name].resetRelativeEncoder();
+    m_wheels[m_wheelIndices.value(name)].resetRelativeEncoder();
     m_updateMutex.unlock();
 }
 
 bool Mouse::hasSensor(const QString& name) const {
-    return m_sensors.contains(name);
+    return m_sensorIndices.contains(name);
 }
 
 double Mouse::readSensor(const QString& name) const {
     SIM_ASSERT_TR(hasSensor(name));
-    return m_sensors.value(name).read();
+    return readSensor(m_sensorIndices.value(name));
+}
+
+int Mouse::getWheelIndex(const QString& name) const {
+    return m_wheelIndices.value(name, -1);
+}
+
+int Mouse::getSensorIndex(const QString& name) const {
+    return m_sensorIndices.value(name, -1);
+}
+
+int Mouse::getWheelCount() const {
+    return m_wheels.size();
+}
+
+int Mouse::getSensorCount() const {
+    return m_sensors.size();
+}
+
+QString Mouse::getWheelName(int index) const {
+    return m_wheelNames.at(index);
+}
+
+QString Mouse::getSensorName(int index) const {
+    return m_sensorNames.at(index);
+}
+
+RadiansPerSecond Mouse::getWheelMaxSpeed(int index) const {
+    return m_wheels.at(index).getMaxAngularVelocityMagnitude();
+}
+
+EncoderType Mouse::getWheelEncoderType(int index) const {
+    return m_wheels.at(index).getEncoderType();
+}
+
+int Mouse::readWheelAbsoluteEncoder(int index) const {
+    m_updateMutex.lock();
+    int encoderReading = m_wheels.at(index).readAbsoluteEncoder();
+    m_updateMutex.unlock();
+    return encoderReading;
+}
+
+int Mouse::readWheelRelativeEncoder(int index) const {
+    m_updateMutex.lock();
+    int encoderReading = m_wheels.at(index).readRelativeEncoder();
+    m_updateMutex.unlock();
+    return encoderReading;
+}
+
+double Mouse::readSensor(int index) const {
+    return m_sensors.at(index).read();
+}
+
+void Mouse::setWheelSpeeds(const int* indices, const RadiansPerSecond* speeds, int count) {
+    m_updateMutex.lock();
+    for (int i = 0; i < count; i += 1) {
+        SIM_ASSERT_LE(
+            std::abs(speeds[i].getRevolutionsPerMinute()),
+            getWheelMaxSpeed(indices[i]).getRevolutionsPerMinute());
+        m_wheels[indices[i]].setAngularVelocity(speeds[i]);
+    }
+    m_updateMutex.unlock();
+}
+
+void Mouse::readSensors(const int* indices, int count, double* readings) const {
+    // Holding the lock ensures that update() can't move the mouse part way
+    // through, which would give readings from two different poses
+    m_updateMutex.lock();
+    for (int i = 0; i < count; i += 1) {
+        readings[i] = m_sensors.at(indices[i]).read();
+    }
+    m_updateMutex.unlock();
 }
 
 RadiansPerSecond Mouse::readGyro() const {
@@ -410,13 +533,12 @@ void Mouse::setWheelSpeedsForMovement(double fractionOfMaxSpeed, double forwardF
 
     // Now set the wheel speeds based on the normalized factors
     QMap<QString, RadiansPerSecond> wheelSpeeds;
-    for (const auto& pair : ContainerUtilities::items(m_wheels)) {
-        SIM_ASSERT_TR(m_wheelSpeedAdjustmentFactors.contains(pair.first));
-        QPair<double, double> adjustmentFactors = m_wheelSpeedAdjustmentFactors.value(pair.first);
+    for (int i = 0; i < m_wheels.size(); i += 1) {
+        QPair<double, double> adjustmentFactors = m_wheelSpeedAdjustmentFactors.at(i);
         wheelSpeeds.insert(
-            pair.first,
+            m_wheelNames.at(i),
             (
-                pair.second.getMaxAngularVelocityMagnitude() *
+                m_wheels.at(i).getMaxAngularVelocityMagnitude() *
                 fractionOfMaxSpeed *
                 (
                     normalizedForwardFactor * adjustmentFactors.first +
@@ -435,7 +557,7 @@ QMap<QString, WheelEffect> Mouse::getWheelEffects(
 
     QMap<QString, WheelEffect> wheelEffects;
 
-    for (const auto& pair : ContainerUtilities::items(m_wheels)) {
+    for (const auto& pair : ContainerUtilities::items(wheels)) {
         wheelEffects.insert(
             pair.first,
             WheelEffect(
@@ -466,7 +588,7 @@ QMap<QString, QPair<double, double>> Mouse::getWheelSpeedAdjustmentFactors(
     QMap<QString, QPair<MetersPerSecond, RadiansPerSecond>> ratesOfChangePairs;
     for (const auto& pair : ContainerUtilities::items(wheelEffects)) {
         std::tuple<MetersPerSecond, MetersPerSecond, RadiansPerSecond> effects =
-            pair.second.getEffects(m_wheels.value(pair.first).getMaxAngularVelocityMagnitude());
+            pair.second.getEffects(wheels.value(pair.first).getMaxAngularVelocityMagnitude());
         ratesOfChangePairs.insert(
             pair.first,
             {
@@ -4,6 +4,7 @@
 #include <QPair>
 #include <QString>
 
+#include <memory>
 #include <mutex>
 #include <QVector>
 
@@ -14,8 +15,10 @@
 #include "Direction.h"
 #include "EncoderType.h"
 #include "Maze.h"
+#include "MouseGeometry.h"
 #include "Polygon.h"
 #include "Sensor.h"
+#include "WallDistanceField.h"
 #include "Wheel.h"
 #include "WheelEffect.h"
 
@@ -23,13 +26,22 @@ namespace sim {
 
 class Mouse {
 
+    // Steps many mice at once, reading and writing their state directly
+    friend class MouseBatch;
+
 public:
     Mouse(const Maze* maze);
 
-    // Initializes the mouse (body, wheels, sensors, etc.); returns true if successful, false if not
+    // Initializes the mouse (body, wheels, sensors, etc.); returns true if
+    // successful, false if not. Mice with the same file in the same maze can
+    // share a single wall distance field, rather than each building its own.
     bool initialize(
         const QString& mouseFile,
-        Direction initialDirection);
+        Direction initialDirection,
+        std::shared_ptr<const WallDistanceField> wallDistanceField = nullptr);
+
+    // The mouse's wall distance field, or nullptr if it doesn't have one
+    std::shared_ptr<const WallDistanceField> getWallDistanceField() const;
 
     // Gets the initial translation and rotation of the mouse
     Cartesian getInitialTranslation() const;
@@ -74,6 +86,10 @@ public:
     QVector<Polygon> getCurrentSensorViewPolygons(
         const Coordinate& currentTranslation, const Angle& currentRotation) const;
 
+    // Returns the compiled body, collision, center of mass, wheel, and sensor
+    // polygons, for placing all of them at once
+    const MouseGeometry& getGeometry() const;
+
     // Instruct the mouse to update its own position based on how much simulation time has elapsed
     void update(const Duration& elapsed);
 
@@ -114,6 +130,33 @@ public:
     // Read a sensor, and returns a value from 0.0 (completely free) to 1.0 (completely blocked)
     double readSensor(const QString& name) const;
 
+    // Returns the index of the wheel or sensor by a particular name, or -1 if
+    // there is no such wheel or sensor. Indices are fixed after initialization,
+    // and the index-based methods below skip the name lookups entirely.
+    int getWheelIndex(const QString& name) const;
+    int getSensorIndex(const QString& name) const;
+
+    // Returns the number of wheels and sensors, i.e., the bounds of the indices
+    int getWheelCount() const;
+    int getSensorCount() const;
+
+    // Returns the name of the wheel or sensor at a particular index
+    QString getWheelName(int index) const;
+    QString getSensorName(int index) const;
+
+    // Index-based counterparts of the methods above
+    RadiansPerSecond getWheelMaxSpeed(int index) const;
+    EncoderType getWheelEncoderType(int index) const;
+    int readWheelAbsoluteEncoder(int index) const;
+    int readWheelRelativeEncoder(int index) const;
+    double readSensor(int index) const;
+
+    // An atomic interface for setting the speeds of count wheels by index
+    void setWheelSpeeds(const int* indices, const RadiansPerSecond* speeds, int count);
+
+    // Reads count sensors by index, all from the same pose of the mouse
+    void readSensors(const int* indices, int count, double* readings) const;
+
     // Returns the value of the gyroscope
     RadiansPerSecond readGyro() const;
 
@@ -126,14 +169,21 @@ private:
     Radians m_initialRotation;
 
     // The parts of the mouse, as when positioned at m_initialTranslation and m_initialRotation
-    Polygon m_initialBodyPolygon; // The polygon of strictly the body of the mouse
-    Polygon m_initialCollisionPolygon; // The polygon containing all collidable parts of the mouse
-    Polygon m_initialCenterOfMassPolygon; // The polygon overlaying the center of mass of the mouse
-    QMap<QString, Wheel> m_wheels; // The wheels of the mouse
-    QMap<QString, Sensor> m_sensors; // The sensors on the mouse
+    MouseGeometry m_geometry; // The body, collision, center of mass, wheel, and sensor polygons
+    QVector<Wheel> m_wheels; // The wheels of the mouse, ordered by name
+    QVector<Sensor> m_sensors; // The sensors on the mouse, ordered by name
+
+    // Speeds up the sensor readings, if enabled; nullptr otherwise
+    std::shared_ptr<const WallDistanceField> m_wallDistanceField;
+
+    // The names of the wheels and sensors, and the indices of those names
+    QVector<QString> m_wheelNames;
+    QVector<QString> m_sensorNames;
+    QMap<QString, int> m_wheelIndices;
+    QMap<QString, int> m_sensorIndices;
 
     // The effect that each wheel has on mouse forward, sideways, and turn movements
-    QMap<QString, WheelEffect> m_wheelEffects;
+    QVector<WheelEffect> m_wheelEffects;
 
     // The fractions of a each wheel's max speed that cause the mouse to
     // perform the move forward and turn movements, respectively, as optimally
@@ -142,7 +192,7 @@ private:
     // moving sideways, and/or turn without moving forward or sideways.
     // Also note that the fractions are in [-1.0, 1.0], so that the max wheel
     // speed is never exceeded.
-    QMap<QString, QPair<double, double>> m_wheelSpeedAdjustmentFactors;
+    QVector<QPair<double, double>> m_wheelSpeedAdjustmentFactors;
 
     // Used to calculate the linear combination of the forward component and turn
     // component, based on curve turn radius, that cause the mouse to perform a
@@ -162,6 +212,9 @@ private:
     Polygon getCurrentPolygon(const Polygon& initialPolygon,
         const Cartesian& currentTranslation, const Radians& currentRotation) const;
 
+    // Refreshes the sensor readings at the current pose; the caller must hold m_updateMutex
+    void updateSensorReadings();
+
     // Retrieve the current position/rotation of sensor based on position/rotation of mouse
     QPair<Cartesian, Radians> getCurrentSensorPositionAndDirection(
         const Sensor& sensor,
@@ -0,0 +1,148 @@
+#include "MouseBatch.h"
+
+#include <cmath>
+#include <tuple>
+
+#include "units/Meters.h"
+#include "units/Radians.h"
+#include "units/RadiansPerSecond.h"
+
+namespace sim {
+
+MouseBatch::MouseBatch(const QVector<Mouse*>& mice) :
+        m_mice(mice),
+        m_lockedCount(0) {
+    m_active.fill(true, m_mice.size());
+    m_locked.fill(0, m_mice.size());
+    m_xs.fill(0.0, m_mice.size());
+    m_ys.fill(0.0, m_mice.size());
+    m_rotations.fill(0.0, m_mice.size());
+    m_gyros.fill(0.0, m_mice.size());
+    m_forwardRates.fill(0.0, m_mice.size());
+    m_sidewaysRates.fill(0.0, m_mice.size());
+    m_turnRates.fill(0.0, m_mice.size());
+}
+
+void MouseBatch::setActive(int mouseIndex, bool active) {
+    m_active[mouseIndex] = active;
+}
+
+bool MouseBatch::isActive(int mouseIndex) const {
+    return m_active.at(mouseIndex);
+}
+
+void MouseBatch::step(const Duration& elapsed) {
+
+    // NOTE: This is a *very* performance critical function
+
+    if (m_firstWheel.isEmpty()) {
+        layOutWheels();
+    }
+
+    // Each active mouse stays locked from gather() to scatter(), so that
+    // wheel speeds set part way through a step can't be half-applied
+    gather();
+    integrate(elapsed.getSeconds());
+    scatter(elapsed.getSeconds());
+}
+
+void MouseBatch::layOutWheels() {
+    m_firstWheel.push_back(0);
+    for (Mouse* mouse : m_mice) {
+        for (const WheelEffect& wheelEffect : mouse->m_wheelEffects) {
+            std::tuple<MetersPerSecond, MetersPerSecond, RadiansPerSecond> effects =
+                wheelEffect.getEffects(RadiansPerSecond(1.0));
+            m_unitForwardEffects.push_back(std::get<0>(effects).getMetersPerSecond());
+            m_unitSidewaysEffects.push_back(std::get<1>(effects).getMetersPerSecond());
+            m_unitTurnEffects.push_back(std::get<2>(effects).getRadiansPerSecond());
+        }
+        m_firstWheel.push_back(m_unitForwardEffects.size());
+    }
+    m_wheelSpeeds.fill(0.0, m_unitForwardEffects.size());
+}
+
+void MouseBatch::gather() {
+    m_lockedCount = 0;
+    for (int i = 0; i < m_mice.size(); i += 1) {
+        if (!m_active.at(i)) {
+            continue;
+        }
+        Mouse* mouse = m_mice.at(i);
+        mouse->m_updateMutex.lock();
+        m_locked[m_lockedCount] = i;
+        m_lockedCount += 1;
+        double* wheelSpeeds = m_wheelSpeeds.data() + m_firstWheel.at(i);
+        for (int j = 0; j < mouse->m_wheels.size(); j += 1) {
+            wheelSpeeds[j] = mouse->m_wheels.at(j).getAngularVelocity().getRadiansPerSecond();
+        }
+        m_xs[i] = mouse->m_currentTranslation.getX().getMeters();
+        m_ys[i] = mouse->m_currentTranslation.getY().getMeters();
+        m_rotations[i] = mouse->m_currentRotation.getRadiansNotBounded();
+    }
+}
+
+void MouseBatch::integrate(double seconds) {
+
+    // Inactive mice are integrated too (their results are just never written
+    // back), which keeps both loops free of branches
+    const int mouseCount = m_mice.size();
+    const int* firstWheel = m_firstWheel.constData();
+    const double* wheelSpeeds = m_wheelSpeeds.constData();
+    const double* unitForwardEffects = m_unitForwardEffects.constData();
+    const double* unitSidewaysEffects = m_unitSidewaysEffects.constData();
+    const double* unitTurnEffects = m_unitTurnEffects.constData();
+    double* forwardRates = m_forwardRates.data();
+    double* sidewaysRates = m_sidewaysRates.data();
+    double* turnRates = m_turnRates.data();
+
+    // The average effect of the wheels, in the mouse's frame of reference
+    for (int i = 0; i < mouseCount; i += 1) {
+        double forward = 0.0;
+        double sideways = 0.0;
+        double turn = 0.0;
+        for (int j = firstWheel[i]; j < firstWheel[i + 1]; j += 1) {
+            forward += unitForwardEffects[j] * wheelSpeeds[j];
+            sideways += unitSidewaysEffects[j] * wheelSpeeds[j];
+            turn += unitTurnEffects[j] * wheelSpeeds[j];
+        }
+        double wheelCount = static_cast<double>(firstWheel[i + 1] - firstWheel[i]);
+        forwardRates[i] = forward / wheelCount;
+        sidewaysRates[i] = sideways / wheelCount;
+        turnRates[i] = turn / wheelCount;
+    }
+
+    // Rotated into the maze's frame of reference and applied to the pose;
+    // this is the same formula as Mouse::update(), with one mouse per lane
+    double* xs = m_xs.data();
+    double* ys = m_ys.data();
+    double* rotations = m_rotations.data();
+    double* gyros = m_gyros.data();
+    for (int i = 0; i < mouseCount; i += 1) {
+        double cos = std::cos(rotations[i]);
+        double sin = std::sin(rotations[i]);
+        double dx = forwardRates[i] * cos + sidewaysRates[i] * sin;
+        double dy = forwardRates[i] * sin - sidewaysRates[i] * cos;
+        gyros[i] = turnRates[i];
+        rotations[i] += turnRates[i] * seconds;
+        xs[i] += dx * seconds;
+        ys[i] += dy * seconds;
+    }
+}
+
+void MouseBatch::scatter(double seconds) {
+    for (int k = 0; k < m_lockedCount; k += 1) {
+        int i = m_locked.at(k);
+        Mouse* mouse = m_mice.at(i);
+        const double* wheelSpeeds = m_wheelSpeeds.constData() + m_firstWheel.at(i);
+        for (int j = 0; j < mouse->m_wheels.size(); j += 1) {
+            mouse->m_wheels[j].updateRotation(Radians(wheelSpeeds[j] * seconds));
+        }
+        mouse->m_currentGyro = RadiansPerSecond(m_gyros.at(i));
+        mouse->m_currentRotation = Radians(m_rotations.at(i));
+        mouse->m_currentTranslation = Cartesian(Meters(m_xs.at(i)), Meters(m_ys.at(i)));
+        mouse->updateSensorReadings();
+        mouse->m_updateMutex.unlock();
+    }
+}
+
+} // namespace sim
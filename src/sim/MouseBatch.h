@@ -0,0 +1,88 @@
+#pragma once
+
+#include <QVector>
+
+#include "Mouse.h"
+#include "units/Duration.h"
+
+namespace sim {
+
+// Steps the physics of many independent mice at once.
+//
+// The poses, wheel speeds, and wheel effect coefficients of all of the mice
+// are kept as separate, contiguous arrays of doubles (one element per mouse,
+// or one per wheel), rather than being spread across each mouse's wheels and
+// wheel effects. The kinematic update is then a pair of tight loops over
+// those arrays, with no Units objects or per-mouse calls, followed by a
+// single pass that writes the results back to the mice and refreshes their
+// sensors.
+//
+// The mice are gathered at the start of every step, so they remain the one
+// source of truth: wheel speeds set by the algorithms, and teleports, are
+// picked up just as they are by Mouse::update().
+//
+// A batch is not thread-safe: setActive() and step() must be called from the
+// same thread (or otherwise never at the same time).
+class MouseBatch {
+
+public:
+
+    // The mice must outlive the batch, but needn't be initialized until the
+    // first step, since that's when their wheels are laid out in the arrays
+    MouseBatch(const QVector<Mouse*>& mice);
+
+    // Inactive mice (e.g., ones that have crashed) are neither moved nor
+    // have their sensors refreshed; all mice start out active
+    void setActive(int mouseIndex, bool active);
+    bool isActive(int mouseIndex) const;
+
+    // Equivalent to calling update(elapsed) on each active mouse
+    void step(const Duration& elapsed);
+
+private:
+
+    QVector<Mouse*> m_mice;
+    QVector<bool> m_active;
+
+    // The indices of the mice that gather() locked, and that scatter() must
+    // write back to and unlock, are the first m_lockedCount elements
+    QVector<int> m_locked;
+    int m_lockedCount;
+
+    // The wheels of mouse i are [m_firstWheel[i], m_firstWheel[i + 1])
+    QVector<int> m_firstWheel;
+
+    // Per wheel: the speed (in radians per second) as of the last gather, and
+    // the effects of a speed of one radian per second (which never change)
+    QVector<double> m_wheelSpeeds;
+    QVector<double> m_unitForwardEffects;
+    QVector<double> m_unitSidewaysEffects;
+    QVector<double> m_unitTurnEffects;
+
+    // Per mouse: the pose (in meters and radians), the gyro (in radians per
+    // second), and the summed forward, sideways, and turn effects of the wheels
+    QVector<double> m_xs;
+    QVector<double> m_ys;
+    QVector<double> m_rotations;
+    QVector<double> m_gyros;
+    QVector<double> m_forwardRates;
+    QVector<double> m_sidewaysRates;
+    QVector<double> m_turnRates;
+
+    // Fills in the per-wheel arrays (and m_firstWheel) from the mice
+    void layOutWheels();
+
+    // Locks the active mice, and copies their wheel speeds and poses into
+    // the arrays
+    void gather();
+
+    // Advances every pose in the arrays by seconds
+    void integrate(double seconds);
+
+    // Copies the arrays back into the mice that gather() locked, updates
+    // their wheels and sensors to match, and unlocks them
+    void scatter(double seconds);
+
+};
+
+} // namespace sim
@@ -0,0 +1,235 @@
+#include "MouseGeometry.h"
+
+#include <QVarLengthArray>
+
+#include "Assert.h"
+#include "GeometryUtilities.h"
+#include "units/Heading.h"
+#include "units/Meters.h"
+
+namespace sim {
+
+MouseGeometry::MouseGeometry() :
+        m_wheelCount(0),
+        m_sensorCount(0) {
+}
+
+MouseGeometry::MouseGeometry(
+        const Cartesian& initialTranslation,
+        const Radians& initialRotation,
+        const Polygon& body,
+        const Polygon& centerOfMass,
+        const QVector<Polygon>& wheels,
+        const QVector<Polygon>& sensors) :
+        m_initialTranslation(initialTranslation),
+        m_initialRotation(initialRotation),
+        m_wheelCount(wheels.size()),
+        m_sensorCount(sensors.size()) {
+
+    // The collision polygon is the hull of every point of the collidable
+    // parts; this is technically not correct since we should be using union,
+    // not convexHull, but it's a good approximation
+    QVector<Cartesian> collidablePoints = body.getVertices();
+    for (const Polygon& polygon : wheels + sensors) {
+        collidablePoints += polygon.getVertices();
+    }
+
+    addPart(body);
+    addPart(GeometryUtilities::convexHull(collidablePoints));
+    addPart(centerOfMass);
+    for (const Polygon& polygon : wheels + sensors) {
+        addPart(polygon);
+    }
+}
+
+int MouseGeometry::getBodyPart() const {
+    return 0;
+}
+
+int MouseGeometry::getCollisionPart() const {
+    return 1;
+}
+
+int MouseGeometry::getCenterOfMassPart() const {
+    return 2;
+}
+
+int MouseGeometry::getWheelPart(int index) const {
+    SIM_ASSERT_LE(0, index);
+    SIM_ASSERT_LT(index, m_wheelCount);
+    return 3 + index;
+}
+
+int MouseGeometry::getSensorPart(int index) const {
+    SIM_ASSERT_LE(0, index);
+    SIM_ASSERT_LT(index, m_sensorCount);
+    return 3 + m_wheelCount + index;
+}
+
+void MouseGeometry::transform(
+        const Coordinate& translation, const Angle& rotation, Vertices* vertices) const {
+    // Resizing to the same size never reallocates, so only the first call
+    // for a particular Vertices object allocates anything
+    vertices->xs.resize(m_xs.size());
+    vertices->ys.resize(m_ys.size());
+    transform(0, m_xs.size(), translation, rotation, vertices->xs.data(), vertices->ys.data());
+}
+
+Polygon MouseGeometry::getPolygon(int part, const Vertices& vertices) const {
+    SIM_ASSERT_EQ(vertices.xs.size(), m_xs.size());
+    const Part& range = m_parts.at(part);
+    return getPolygon(
+        part,
+        vertices.xs.constData() + range.firstVertex,
+        vertices.ys.constData() + range.firstVertex);
+}
+
+Polygon MouseGeometry::getPolygon(int part, const Coordinate& translation, const Angle& rotation) const {
+    const Part& range = m_parts.at(part);
+    QVarLengthArray<double, 64> xs(range.vertexCount);
+    QVarLengthArray<double, 64> ys(range.vertexCount);
+    transform(range.firstVertex, range.vertexCount, translation, rotation, xs.data(), ys.data());
+    return getPolygon(part, xs.constData(), ys.constData());
+}
+
+bool MouseGeometry::readCache(QDataStream& stream) {
+
+    double initialX;
+    double initialY;
+    double initialRotation;
+    int wheelCount;
+    int sensorCount;
+    QVector<double> xs;
+    QVector<double> ys;
+    QVector<int> indices;
+    int numberOfParts;
+    stream >> initialX >> initialY >> initialRotation >> wheelCount >> sensorCount
+        >> xs >> ys >> indices >> numberOfParts;
+    if (stream.status() != QDataStream::Ok || xs.size() != ys.size() ||
+            wheelCount < 0 || sensorCount < 0 ||
+            numberOfParts != 3 + wheelCount + sensorCount) {
+        return false;
+    }
+    QVector<Part> parts;
+    for (int i = 0; i < numberOfParts && stream.status() == QDataStream::Ok; i += 1) {
+        Part part;
+        stream >> part.firstVertex >> part.vertexCount >> part.firstIndex >> part.indexCount;
+        parts.push_back(part);
+    }
+    if (stream.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    // Every part must lie within the arrays, and every index must refer to
+    // one of its part's vertices, so that nothing can be read out of bounds
+    for (const Part& part : parts) {
+        if (part.firstVertex < 0 || part.vertexCount < 0 ||
+                xs.size() - part.firstVertex < part.vertexCount ||
+                part.firstIndex < 0 || part.indexCount < 0 || part.indexCount % 3 != 0 ||
+                indices.size() - part.firstIndex < part.indexCount) {
+            return false;
+        }
+        for (int i = part.firstIndex; i < part.firstIndex + part.indexCount; i += 1) {
+            if (indices.at(i) < 0 || part.vertexCount <= indices.at(i)) {
+                return false;
+            }
+        }
+    }
+
+    m_initialTranslation = Cartesian(Meters(initialX), Meters(initialY));
+    m_initialRotation = Radians(initialRotation);
+    m_wheelCount = wheelCount;
+    m_sensorCount = sensorCount;
+    m_xs = xs;
+    m_ys = ys;
+    m_indices = indices;
+    m_parts = parts;
+    return true;
+}
+
+void MouseGeometry::writeCache(QDataStream& stream) const {
+    stream
+        << m_initialTranslation.getX().getMeters()
+        << m_initialTranslation.getY().getMeters()
+        << m_initialRotation.getRadiansNotBounded()
+        << m_wheelCount
+        << m_sensorCount
+        << m_xs
+        << m_ys
+        << m_indices
+        << m_parts.size();
+    for (const Part& part : m_parts) {
+        stream << part.firstVertex << part.vertexCount << part.firstIndex << part.indexCount;
+    }
+}
+
+void MouseGeometry::addPart(const Polygon& polygon) {
+
+    QVector<Cartesian> vertices = polygon.getVertices();
+    Part part {m_xs.size(), vertices.size(), m_indices.size(), 0};
+    for (const Cartesian& vertex : vertices) {
+        m_xs.push_back(vertex.getX().getMeters());
+        m_ys.push_back(vertex.getY().getMeters());
+    }
+
+    // The triangulation doesn't introduce any new points, and it copies the
+    // coordinates of the ones it uses exactly, so we can recover the indices
+    // by comparing the points themselves
+    for (const Triangle& triangle : polygon.getTriangles()) {
+        for (const Cartesian& point : {triangle.p1, triangle.p2, triangle.p3}) {
+            int index = vertices.indexOf(point);
+            SIM_ASSERT_LE(0, index);
+            m_indices.push_back(index);
+        }
+    }
+    part.indexCount = m_indices.size() - part.firstIndex;
+    m_parts.push_back(part);
+}
+
+void MouseGeometry::transform(
+        int first, int count,
+        const Coordinate& translation, const Angle& rotation,
+        double* xs, double* ys) const {
+
+    // Rotate about the initial translation, and then move the initial
+    // translation to the current one; the sine and cosine are computed once,
+    // and the loop is simple enough for the compiler to vectorize
+    units::Heading delta(units::Angle(
+        rotation.getRadiansNotBounded() - m_initialRotation.getRadiansNotBounded()));
+    double cos = delta.getCos();
+    double sin = delta.getSin();
+    double x0 = m_initialTranslation.getX().getMeters();
+    double y0 = m_initialTranslation.getY().getMeters();
+    double x1 = translation.getX().getMeters();
+    double y1 = translation.getY().getMeters();
+
+    const double* initialXs = m_xs.constData() + first;
+    const double* initialYs = m_ys.constData() + first;
+    for (int i = 0; i < count; i += 1) {
+        double dx = initialXs[i] - x0;
+        double dy = initialYs[i] - y0;
+        xs[i] = x1 + cos * dx - sin * dy;
+        ys[i] = y1 + sin * dx + cos * dy;
+    }
+}
+
+Polygon MouseGeometry::getPolygon(int part, const double* xs, const double* ys) const {
+    const Part& range = m_parts.at(part);
+    QVector<Cartesian> vertices;
+    vertices.reserve(range.vertexCount);
+    for (int i = 0; i < range.vertexCount; i += 1) {
+        vertices.push_back(Cartesian(Meters(xs[i]), Meters(ys[i])));
+    }
+    QVector<Triangle> triangles;
+    triangles.reserve(range.indexCount / 3);
+    for (int i = range.firstIndex; i < range.firstIndex + range.indexCount; i += 3) {
+        triangles.push_back({
+            vertices.at(m_indices.at(i)),
+            vertices.at(m_indices.at(i + 1)),
+            vertices.at(m_indices.at(i + 2)),
+        });
+    }
+    return Polygon(vertices, triangles);
+}
+
+} // namespace sim
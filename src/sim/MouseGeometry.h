@@ -0,0 +1,130 @@
+#pragma once
+
+#include <QDataStream>
+#include <QVector>
+
+#include "Polygon.h"
+#include "units/Angle.h"
+#include "units/Cartesian.h"
+#include "units/Coordinate.h"
+#include "units/Radians.h"
+
+namespace sim {
+
+// The rigid (i.e., unchanging) parts of a mouse, compiled once at load time.
+//
+// The vertices of every part are stored in one contiguous array, and each
+// part is just a range of it, along with the triangulation of the part as
+// indices into the array. Placing the mouse is then a single affine transform
+// of the whole array (or of a single part's range), rather than a pair of
+// translate() and rotateAroundPoint() calls per part, each of which allocates
+// new vertices and triangles and converts every vertex to polar and back.
+//
+// The parts are, in order: the body, the collision polygon (the convex hull
+// of the body, wheels, and sensors), the center of mass, each wheel, and each
+// sensor. The wheel speed indicators and sensor views aren't rigid, and so
+// they aren't included.
+class MouseGeometry {
+
+public:
+
+    // The transformed vertices of every part; reused across calls to
+    // transform(), so that placing the mouse doesn't allocate
+    struct Vertices {
+        QVector<double> xs;
+        QVector<double> ys;
+    };
+
+    // An empty geometry, with no parts
+    MouseGeometry();
+
+    // The polygons are given at the initial translation and rotation
+    MouseGeometry(
+        const Cartesian& initialTranslation,
+        const Radians& initialRotation,
+        const Polygon& body,
+        const Polygon& centerOfMass,
+        const QVector<Polygon>& wheels,
+        const QVector<Polygon>& sensors);
+
+    // The indices of the parts
+    int getBodyPart() const;
+    int getCollisionPart() const;
+    int getCenterOfMassPart() const;
+    int getWheelPart(int index) const;
+    int getSensorPart(int index) const;
+
+    // Transforms every vertex of every part, as if the mouse were moved from
+    // its initial translation and rotation to the given ones
+    void transform(
+        const Coordinate& translation, const Angle& rotation, Vertices* vertices) const;
+
+    // Returns a part as a polygon, whose triangles are already known
+    Polygon getPolygon(int part, const Vertices& vertices) const;
+
+    // Transforms just a single part, and returns it as a polygon
+    Polygon getPolygon(int part, const Coordinate& translation, const Angle& rotation) const;
+
+    // Calls function(x1, y1, x2, y2, x3, y3) for each triangle of the part
+    template<typename Function>
+    void forEachTriangle(int part, const Vertices& vertices, Function function) const;
+
+    // Read the geometry from, or write it to, a load cache stream (see
+    // LoadCache.h); reading fails, and leaves the geometry untouched, if the
+    // stream doesn't hold a well-formed geometry
+    bool readCache(QDataStream& stream);
+    void writeCache(QDataStream& stream) const;
+
+private:
+
+    // A range of the vertex array, and the range of the index array that
+    // holds the part's triangulation (three indices per triangle, relative to
+    // the part's first vertex)
+    struct Part {
+        int firstVertex;
+        int vertexCount;
+        int firstIndex;
+        int indexCount;
+    };
+
+    Cartesian m_initialTranslation;
+    Radians m_initialRotation;
+    int m_wheelCount;
+    int m_sensorCount;
+
+    // The untransformed vertices of all parts, as separate arrays of x and y
+    // coordinates (in meters) so that the transform is a tight loop
+    QVector<double> m_xs;
+    QVector<double> m_ys;
+    QVector<int> m_indices;
+    QVector<Part> m_parts;
+
+    // Appends the polygon's vertices and triangulation to the arrays
+    void addPart(const Polygon& polygon);
+
+    // Transforms count vertices, starting at first, into xs and ys
+    void transform(
+        int first, int count,
+        const Coordinate& translation, const Angle& rotation,
+        double* xs, double* ys) const;
+
+    // Builds a polygon from a part of the given coordinate arrays, which start
+    // at the part's first vertex
+    Polygon getPolygon(int part, const double* xs, const double* ys) const;
+
+};
+
+template<typename Function>
+void MouseGeometry::forEachTriangle(int part, const Vertices& vertices, Function function) const {
+    const Part& range = m_parts.at(part);
+    const double* xs = vertices.xs.constData() + range.firstVertex;
+    const double* ys = vertices.ys.constData() + range.firstVertex;
+    for (int i = range.firstIndex; i < range.firstIndex + range.indexCount; i += 3) {
+        int a = m_indices.at(i);
+        int b = m_indices.at(i + 1);
+        int c = m_indices.at(i + 2);
+        function(xs[a], ys[a], xs[b], ys[b], xs[c], ys[c]);
+    }
+}
+
+} // namespace sim
@@ -16,21 +16,25 @@ MouseGraphic::MouseGraphic(const Mouse* mouse, BufferInterface* bufferInterface)
 
 void MouseGraphic::draw(const Coordinate& currentTranslation, const Angle& currentRotation) const {
 
+    // The body, center of mass, wheels, and sensors are all placed by a
+    // single transform of the mouse's compiled geometry
+    const MouseGeometry& geometry = m_mouse->getGeometry();
+    geometry.transform(currentTranslation, currentRotation, &m_vertices);
+
     // First, we draw the body
-    m_bufferInterface->drawMousePolygon(
-        m_mouse->getCurrentBodyPolygon(currentTranslation, currentRotation),
+    m_bufferInterface->drawMouseGeometry(
+        geometry, m_vertices, geometry.getBodyPart(),
         STRING_TO_COLOR.value(P()->mouseBodyColor()), 1.0);
 
     // Next, draw the center of mass
-    m_bufferInterface->drawMousePolygon(
-        m_mouse->getCurrentCenterOfMassPolygon(currentTranslation, currentRotation),
+    m_bufferInterface->drawMouseGeometry(
+        geometry, m_vertices, geometry.getCenterOfMassPart(),
         STRING_TO_COLOR.value(P()->mouseCenterOfMassColor()), 1.0);
 
     // Next, we draw the wheels
-    for (const Polygon& wheelPolygon :
-            m_mouse->getCurrentWheelPolygons(currentTranslation, currentRotation)) {
-        m_bufferInterface->drawMousePolygon(
-            wheelPolygon,
+    for (int i = 0; i < m_mouse->getWheelCount(); i += 1) {
+        m_bufferInterface->drawMouseGeometry(
+            geometry, m_vertices, geometry.getWheelPart(i),
             STRING_TO_COLOR.value(P()->mouseWheelColor()), 1.0);
     }
 
@@ -43,10 +47,9 @@ void MouseGraphic::draw(const Coordinate& currentTranslation, const Angle& curre
     }
 
     // Next, we draw the sensors
-    for (const Polygon& sensorPolygon :
-            m_mouse->getCurrentSensorPolygons(currentTranslation, currentRotation)) {
-        m_bufferInterface->drawMousePolygon(
-            sensorPolygon,
+    for (int i = 0; i < m_mouse->getSensorCount(); i += 1) {
+        m_bufferInterface->drawMouseGeometry(
+            geometry, m_vertices, geometry.getSensorPart(i),
             STRING_TO_COLOR.value(P()->mouseSensorColor()), 1.0);
     }
 
@@ -60,8 +63,8 @@ void MouseGraphic::draw(const Coordinate& currentTranslation, const Angle& curre
 
     // Uncomment to draw collision polygon
     /*
-    m_bufferInterface->drawMousePolygon(
-        m_mouse->getCurrentCollisionPolygon(currentTranslation, currentRotation),
+    m_bufferInterface->drawMouseGeometry(
+        geometry, m_vertices, geometry.getCollisionPart(),
         Color::GRAY, .5);
     */
 }
@@ -16,6 +16,10 @@ private:
     const Mouse* m_mouse;
     BufferInterface* m_bufferInterface;
 
+    // The transformed mouse geometry, kept around so that drawing the mouse
+    // doesn't allocate; mutable so that we can use it in draw()
+    mutable MouseGeometry::Vertices m_vertices;
+
 };
 
 } // namespace sim
@@ -2,6 +2,9 @@
 
 #include <QDebug>
 #include <QPair>
+#include <QVarLengthArray>
+
+#include <algorithm>
 
 #include "units/Meters.h"
 #include "units/MetersPerSecond.h"
@@ -28,42 +31,51 @@ MouseInterface::MouseInterface(
         MazeGraphic* mazeGraphic,
         IMouseAlgorithm* mouseAlgorithm,
         std::set<char> allowableTileTextCharacters,
-        StaticMouseAlgorithmOptions options) :
+        StaticMouseAlgorithmOptions options,
+        Random random) :
         m_maze(maze),
         m_mouse(mouse),
         m_mazeGraphic(mazeGraphic),
         m_mouseAlgorithm(mouseAlgorithm),
         m_allowableTileTextCharacters(allowableTileTextCharacters),
         m_options(options),
+        m_random(random),
         m_inOrigin(true) {
 }
 
 // TODO: MACK - kill these
 void MouseInterface::debug(const QString& str) {
+    RECORD_CALL(str);
     //Logging::getMouseLogger()->debug(str.toStdString());
 }
 
 void MouseInterface::info(const QString& str) {
+    RECORD_CALL(str);
     //Logging::getMouseLogger()->info(str.toStdString());
 }
 
 void MouseInterface::warn(const QString& str) {
+    RECORD_CALL(str);
     //Logging::getMouseLogger()->warn(str.toStdString());
 }
 
 void MouseInterface::error(const QString& str) {
+    RECORD_CALL(str);
     //Logging::getMouseLogger()->error(str.toStdString());
 }
 
 double MouseInterface::getRandom() {
-    return SimUtilities::getRandom();
+    RECORD_CALL();
+    return m_random.getDouble();
 }
 
 int MouseInterface::millis() {
+    RECORD_CALL();
     return Time::get()->elapsedSimTime().getMilliseconds();
 }
 
 void MouseInterface::delay(int milliseconds) {
+    RECORD_CALL(milliseconds);
     Seconds start = Time::get()->elapsedSimTime();
     while (Time::get()->elapsedSimTime() < start + Milliseconds(milliseconds)) {
         sim::SimUtilities::sleep(Milliseconds(P()->minSleepDuration()));
@@ -71,11 +83,13 @@ void MouseInterface::delay(int milliseconds) {
 }
 
 void MouseInterface::quit() {
+    RECORD_CALL();
     sim::SimUtilities::quit();
 }
 
 void MouseInterface::setTileColor(int x, int y, char color) {
 
+    RECORD_CALL(x, y, QChar(color));
     if (!m_maze->withinMaze(x, y)) {
         qWarning()
             << "There is no tile at position (" << x << ", " << y << ") and"
@@ -96,6 +110,7 @@ void MouseInterface::setTileColor(int x, int y, char color) {
 
 void MouseInterface::clearTileColor(int x, int y) {
 
+    RECORD_CALL(x, y);
     if (!m_maze->withinMaze(x, y)) {
         qWarning()
             << "There is no tile at position (" << x << ", " << y << "), and"
@@ -107,6 +122,7 @@ void MouseInterface::clearTileColor(int x, int y) {
 }
 
 void MouseInterface::clearAllTileColor() {
+    RECORD_CALL();
     for (QPair<int, int> position : m_tilesWithColor) {
         clearTileColorImpl(position.first, position.second);
     }
@@ -114,6 +130,7 @@ void MouseInterface::clearAllTileColor() {
 
 void MouseInterface::setTileText(int x, int y, const QString& text) {
 
+    RECORD_CALL(x, y, text);
     if (!m_maze->withinMaze(x, y)) {
         qWarning()
             << "There is no tile at position (" << x << ", " << y << "), and"
@@ -126,6 +143,7 @@ void MouseInterface::setTileText(int x, int y, const QString& text) {
 
 void MouseInterface::clearTileText(int x, int y) {
 
+    RECORD_CALL(x, y);
     if (!m_maze->withinMaze(x, y)) {
         qWarning()
             << "There is no tile at position (" << x << ", " << y << "), and"
@@ -137,6 +155,7 @@ void MouseInterface::clearTileText(int x, int y) {
 }
 
 void MouseInterface::clearAllTileText() {
+    RECORD_CALL();
     for (QPair<int, int> position : m_tilesWithText) {
         clearTileTextImpl(position.first, position.second);
     }
@@ -144,6 +163,7 @@ void MouseInterface::clearAllTileText() {
 
 void MouseInterface::declareWall(int x, int y, char direction, bool wallExists) {
 
+    RECORD_CALL(x, y, QChar(direction), wallExists);
     if (!m_maze->withinMaze(x, y)) {
         qWarning()
             << "There is no tile at position (" << x << ", " << y << "), and"
@@ -170,6 +190,7 @@ void MouseInterface::declareWall(int x, int y, char direction, bool wallExists)
 
 void MouseInterface::undeclareWall(int x, int y, char direction) {
 
+    RECORD_CALL(x, y, QChar(direction));
     if (!m_maze->withinMaze(x, y)) {
         qWarning()
             << "There is no tile at position (" << x << ", " << y << "), and"
@@ -195,6 +216,7 @@ void MouseInterface::undeclareWall(int x, int y, char direction) {
 
 void MouseInterface::setTileFogginess(int x, int y, bool foggy) {
 
+    RECORD_CALL(x, y, foggy);
     if (!m_maze->withinMaze(x, y)) {
         qWarning()
             << "There is no tile at position (" << x << ", " << y << "), and"
@@ -207,6 +229,7 @@ void MouseInterface::setTileFogginess(int x, int y, bool foggy) {
 
 void MouseInterface::declareTileDistance(int x, int y, int distance) {
 
+    RECORD_CALL(x, y, distance);
     if (!m_maze->withinMaze(x, y)) {
         qWarning()
             << "There is no tile at position (" << x << ", " << y << "), and"
@@ -229,6 +252,7 @@ void MouseInterface::declareTileDistance(int x, int y, int distance) {
 
 void MouseInterface::undeclareTileDistance(int x, int y) {
 
+    RECORD_CALL(x, y);
     if (!m_maze->withinMaze(x, y)) {
         qWarning()
             << "There is no tile at position (" << x << ", " << y << "), and"
@@ -245,11 +269,13 @@ void MouseInterface::undeclareTileDistance(int x, int y) {
 }
 
 void MouseInterface::resetPosition() {
+    RECORD_CALL();
     m_mouse->teleport(m_mouse->getInitialTranslation(), m_mouse->getInitialRotation());
 }
 
 bool MouseInterface::inputButtonPressed(int inputButton) {
 
+    RECORD_CALL(inputButton);
     if (inputButton < 0 || 9 < inputButton) {
         qWarning()
             << "There is no input button with the number " << inputButton << ","
@@ -262,6 +288,7 @@ bool MouseInterface::inputButtonPressed(int inputButton) {
 
 void MouseInterface::acknowledgeInputButtonPressed(int inputButton) {
 
+    RECORD_CALL(inputButton);
     if (inputButton < 0 || 9 < inputButton) {
         qWarning()
             << "There is no input button with the number " << inputButton << ","
@@ -277,6 +304,7 @@ void MouseInterface::acknowledgeInputButtonPressed(int inputButton) {
 
 double MouseInterface::getWheelMaxSpeed(const QString& name) {
 
+    RECORD_CALL(name);
     ENSURE_CONTINUOUS_INTERFACE
 
     if (!m_mouse->hasWheel(name)) {
@@ -291,6 +319,7 @@ double MouseInterface::getWheelMaxSpeed(const QString& name) {
 
 void MouseInterface::setWheelSpeed(const QString& name, double rpm) {
 
+    RECORD_CALL(name, rpm);
     ENSURE_CONTINUOUS_INTERFACE
 
     if (!m_mouse->hasWheel(name)) {
@@ -314,6 +343,7 @@ void MouseInterface::setWheelSpeed(const QString& name, double rpm) {
 
 double MouseInterface::getWheelEncoderTicksPerRevolution(const QString& name) {
 
+    RECORD_CALL(name);
     ENSURE_CONTINUOUS_INTERFACE
 
     if (!m_mouse->hasWheel(name)) {
@@ -328,6 +358,7 @@ double MouseInterface::getWheelEncoderTicksPerRevolution(const QString& name) {
 
 int MouseInterface::readWheelEncoder(const QString& name) {
 
+    RECORD_CALL(name);
     ENSURE_CONTINUOUS_INTERFACE
 
     if (!m_mouse->hasWheel(name)) {
@@ -347,6 +378,7 @@ int MouseInterface::readWheelEncoder(const QString& name) {
 
 void MouseInterface::resetWheelEncoder(const QString& name) {
 
+    RECORD_CALL(name);
     ENSURE_CONTINUOUS_INTERFACE
 
     if (!m_mouse->hasWheel(name)) {
@@ -372,6 +404,7 @@ void MouseInterface::resetWheelEncoder(const QString& name) {
 
 double MouseInterface::readSensor(QString name) {
 
+    RECORD_CALL(name);
     ENSURE_CONTINUOUS_INTERFACE
 
     if (!m_mouse->hasSensor(name)) {
@@ -386,13 +419,103 @@ double MouseInterface::readSensor(QString name) {
 
 double MouseInterface::readGyro() {
 
+    RECORD_CALL();
     ENSURE_CONTINUOUS_INTERFACE
 
     return m_mouse->readGyro().getDegreesPerSecond();
 }
 
+int MouseInterface::getWheelHandle(const QString& name) {
+
+    RECORD_CALL(name);
+    ENSURE_CONTINUOUS_INTERFACE
+
+    int handle = m_mouse->getWheelIndex(name);
+    if (handle < 0) {
+        qWarning()
+            << "There is no wheel called \"" << name << "\" and thus you cannot"
+            << " get a handle to it.";
+    }
+    return handle;
+}
+
+int MouseInterface::getSensorHandle(const QString& name) {
+
+    RECORD_CALL(name);
+    ENSURE_CONTINUOUS_INTERFACE
+
+    int handle = m_mouse->getSensorIndex(name);
+    if (handle < 0) {
+        qWarning()
+            << "There is no sensor called \"" << name << "\" and thus you"
+            << " cannot get a handle to it.";
+    }
+    return handle;
+}
+
+void MouseInterface::setWheelSpeed(int handle, double rpm) {
+
+    if (!isValidWheelSpeed(handle, rpm)) {
+        return;
+    }
+
+    RadiansPerSecond speed = RevolutionsPerMinute(rpm);
+    m_mouse->setWheelSpeeds(&handle, &speed, 1);
+}
+
+int MouseInterface::readWheelEncoder(int handle) {
+
+    if (!isValidWheelHandle(handle, "read its encoder")) {
+        return 0;
+    }
+
+    switch (m_mouse->getWheelEncoderType(handle)) {
+        case EncoderType::ABSOLUTE:
+            return m_mouse->readWheelAbsoluteEncoder(handle);
+        case EncoderType::RELATIVE:
+            return m_mouse->readWheelRelativeEncoder(handle);
+    }
+}
+
+double MouseInterface::readSensor(int handle) {
+
+    if (!isValidSensorHandle(handle, "read its value")) {
+        return 0.0;
+    }
+
+    return m_mouse->readSensor(handle);
+}
+
+void MouseInterface::setWheelSpeeds(const std::vector<int>& handles, const double* rpms) {
+
+    int count = static_cast<int>(handles.size());
+    QVarLengthArray<RadiansPerSecond, 8> speeds;
+    for (int i = 0; i < count; i += 1) {
+        if (!isValidWheelSpeed(handles.at(i), rpms[i])) {
+            return;
+        }
+        speeds.append(RevolutionsPerMinute(rpms[i]));
+    }
+
+    m_mouse->setWheelSpeeds(handles.data(), speeds.constData(), speeds.size());
+}
+
+void MouseInterface::readSensors(const std::vector<int>& handles, double* readings) {
+
+    int count = static_cast<int>(handles.size());
+    for (int i = 0; i < count; i += 1) {
+        if (!isValidSensorHandle(handles.at(i), "read its value")) {
+            std::fill(readings, readings + count, 0.0);
+            return;
+        }
+    }
+
+    m_mouse->readSensors(handles.data(), count, readings);
+}
+
 bool MouseInterface::wallFront() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
 
     return wallFrontImpl(
@@ -403,6 +526,7 @@ bool MouseInterface::wallFront() {
 
 bool MouseInterface::wallRight() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
 
     return wallRightImpl(
@@ -413,6 +537,7 @@ bool MouseInterface::wallRight() {
 
 bool MouseInterface::wallLeft() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
 
     return wallLeftImpl(
@@ -423,6 +548,7 @@ bool MouseInterface::wallLeft() {
 
 void MouseInterface::moveForward() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
     ENSURE_NOT_TILE_EDGE_MOVEMENTS
 
@@ -431,6 +557,7 @@ void MouseInterface::moveForward() {
 
 void MouseInterface::moveForward(int count) {
 
+    RECORD_CALL(count);
     ENSURE_DISCRETE_INTERFACE
     ENSURE_NOT_TILE_EDGE_MOVEMENTS
 
@@ -441,6 +568,7 @@ void MouseInterface::moveForward(int count) {
 
 void MouseInterface::turnLeft() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
     ENSURE_NOT_TILE_EDGE_MOVEMENTS
 
@@ -449,6 +577,7 @@ void MouseInterface::turnLeft() {
 
 void MouseInterface::turnRight() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
     ENSURE_NOT_TILE_EDGE_MOVEMENTS
 
@@ -457,6 +586,7 @@ void MouseInterface::turnRight() {
 
 void MouseInterface::turnAroundLeft() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
     ENSURE_NOT_TILE_EDGE_MOVEMENTS
 
@@ -465,6 +595,7 @@ void MouseInterface::turnAroundLeft() {
 
 void MouseInterface::turnAroundRight() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
     ENSURE_NOT_TILE_EDGE_MOVEMENTS
 
@@ -473,6 +604,7 @@ void MouseInterface::turnAroundRight() {
 
 void MouseInterface::originMoveForwardToEdge() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
     ENSURE_USE_TILE_EDGE_MOVEMENTS
     ENSURE_INSIDE_ORIGIN
@@ -483,6 +615,7 @@ void MouseInterface::originMoveForwardToEdge() {
 
 void MouseInterface::originTurnLeftInPlace() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
     ENSURE_USE_TILE_EDGE_MOVEMENTS
     ENSURE_INSIDE_ORIGIN
@@ -492,6 +625,7 @@ void MouseInterface::originTurnLeftInPlace() {
 
 void MouseInterface::originTurnRightInPlace() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
     ENSURE_USE_TILE_EDGE_MOVEMENTS
     ENSURE_INSIDE_ORIGIN
@@ -501,6 +635,7 @@ void MouseInterface::originTurnRightInPlace() {
 
 void MouseInterface::moveForwardToEdge() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
     ENSURE_USE_TILE_EDGE_MOVEMENTS
     ENSURE_OUTSIDE_ORIGIN
@@ -510,6 +645,7 @@ void MouseInterface::moveForwardToEdge() {
 
 void MouseInterface::moveForwardToEdge(int count) {
 
+    RECORD_CALL(count);
     ENSURE_DISCRETE_INTERFACE
     ENSURE_USE_TILE_EDGE_MOVEMENTS
     ENSURE_OUTSIDE_ORIGIN
@@ -521,6 +657,7 @@ void MouseInterface::moveForwardToEdge(int count) {
 
 void MouseInterface::turnLeftToEdge() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
     ENSURE_USE_TILE_EDGE_MOVEMENTS
     ENSURE_OUTSIDE_ORIGIN
@@ -530,6 +667,7 @@ void MouseInterface::turnLeftToEdge() {
 
 void MouseInterface::turnRightToEdge() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
     ENSURE_USE_TILE_EDGE_MOVEMENTS
     ENSURE_OUTSIDE_ORIGIN
@@ -539,6 +677,7 @@ void MouseInterface::turnRightToEdge() {
 
 void MouseInterface::turnAroundLeftToEdge() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
     ENSURE_USE_TILE_EDGE_MOVEMENTS
     ENSURE_OUTSIDE_ORIGIN
@@ -548,6 +687,7 @@ void MouseInterface::turnAroundLeftToEdge() {
 
 void MouseInterface::turnAroundRightToEdge() {
 
+    RECORD_CALL();
     ENSURE_DISCRETE_INTERFACE
     ENSURE_USE_TILE_EDGE_MOVEMENTS
     ENSURE_OUTSIDE_ORIGIN
@@ -557,6 +697,7 @@ void MouseInterface::turnAroundRightToEdge() {
 
 void MouseInterface::diagonalLeftLeft(int count) {
 
+    RECORD_CALL(count);
     ENSURE_DISCRETE_INTERFACE
     ENSURE_USE_TILE_EDGE_MOVEMENTS
     ENSURE_OUTSIDE_ORIGIN
@@ -566,6 +707,7 @@ void MouseInterface::diagonalLeftLeft(int count) {
 
 void MouseInterface::diagonalLeftRight(int count) {
 
+    RECORD_CALL(count);
     ENSURE_DISCRETE_INTERFACE
     ENSURE_USE_TILE_EDGE_MOVEMENTS
     ENSURE_OUTSIDE_ORIGIN
@@ -575,6 +717,7 @@ void MouseInterface::diagonalLeftRight(int count) {
 
 void MouseInterface::diagonalRightLeft(int count) {
 
+    RECORD_CALL(count);
     ENSURE_DISCRETE_INTERFACE
     ENSURE_USE_TILE_EDGE_MOVEMENTS
     ENSURE_OUTSIDE_ORIGIN
@@ -584,6 +727,7 @@ void MouseInterface::diagonalRightLeft(int count) {
 
 void MouseInterface::diagonalRightRight(int count) {
 
+    RECORD_CALL(count);
     ENSURE_DISCRETE_INTERFACE
     ENSURE_USE_TILE_EDGE_MOVEMENTS
     ENSURE_OUTSIDE_ORIGIN
@@ -593,6 +737,7 @@ void MouseInterface::diagonalRightRight(int count) {
 
 int MouseInterface::currentXTile() {
 
+    RECORD_CALL();
     ENSURE_ALLOW_OMNISCIENCE
 
     return m_mouse->getCurrentDiscretizedTranslation().first;
@@ -600,6 +745,7 @@ int MouseInterface::currentXTile() {
 
 int MouseInterface::currentYTile() {
 
+    RECORD_CALL();
     ENSURE_ALLOW_OMNISCIENCE
 
     return m_mouse->getCurrentDiscretizedTranslation().second;
@@ -607,6 +753,7 @@ int MouseInterface::currentYTile() {
 
 char MouseInterface::currentDirection() {
 
+    RECORD_CALL();
     ENSURE_ALLOW_OMNISCIENCE
 
     return DIRECTION_TO_CHAR.value(m_mouse->getCurrentDiscretizedRotation()).toLatin1();
@@ -614,6 +761,7 @@ char MouseInterface::currentDirection() {
 
 double MouseInterface::currentXPosMeters() {
 
+    RECORD_CALL();
     ENSURE_ALLOW_OMNISCIENCE
 
     return m_mouse->getCurrentTranslation().getX().getMeters();
@@ -621,6 +769,7 @@ double MouseInterface::currentXPosMeters() {
 
 double MouseInterface::currentYPosMeters() {
 
+    RECORD_CALL();
     ENSURE_ALLOW_OMNISCIENCE
 
     return m_mouse->getCurrentTranslation().getY().getMeters();
@@ -628,6 +777,7 @@ double MouseInterface::currentYPosMeters() {
 
 double MouseInterface::currentRotationDegrees() {
 
+    RECORD_CALL();
     ENSURE_ALLOW_OMNISCIENCE
 
     return m_mouse->getCurrentRotation().getDegreesZeroTo360();
@@ -653,6 +803,42 @@ void MouseInterface::ensureContinuousInterface(const QString& callingFunction) c
     }
 }
 
+bool MouseInterface::isValidWheelHandle(int handle, const char* action) const {
+    if (handle < 0 || m_mouse->getWheelCount() <= handle) {
+        qWarning()
+            << "There is no wheel with handle " << handle << " and thus you"
+            << " cannot " << action << ".";
+        return false;
+    }
+    return true;
+}
+
+bool MouseInterface::isValidSensorHandle(int handle, const char* action) const {
+    if (handle < 0 || m_mouse->getSensorCount() <= handle) {
+        qWarning()
+            << "There is no sensor with handle " << handle << " and thus you"
+            << " cannot " << action << ".";
+        return false;
+    }
+    return true;
+}
+
+bool MouseInterface::isValidWheelSpeed(int handle, double rpm) const {
+    if (!isValidWheelHandle(handle, "set its speed")) {
+        return false;
+    }
+    double maxSpeed = m_mouse->getWheelMaxSpeed(handle).getRevolutionsPerMinute();
+    if (maxSpeed < std::abs(rpm)) {
+        qWarning()
+            << "You're attempting to set the speed of wheel \""
+            << m_mouse->getWheelName(handle) << "\" to " << rpm << " rpm,"
+            << " which has magnitude greater than the max speed of "
+            << maxSpeed << " rpm. Thus, the wheel speed was not set.";
+        return false;
+    }
+    return true;
+}
+
 void MouseInterface::ensureAllowOmniscience(const QString& callingFunction) const {
     if (!m_mouseAlgorithm->allowOmniscience()) {
         qCritical()
@@ -2,11 +2,15 @@
 
 #include <QPair>
 
+#include <vector>
+
 #include "InterfaceType.h"
 #include "MazeGraphic.h"
 #include "Mouse.h"
 #include "StaticMouseAlgorithmOptions.h"
 #include "Param.h"
+#include "Random.h"
+#include "Recorder.h"
 
 #define ENSURE_DISCRETE_INTERFACE ensureDiscreteInterface(__func__);
 #define ENSURE_CONTINUOUS_INTERFACE ensureContinuousInterface(__func__);
@@ -15,6 +19,11 @@
 #define ENSURE_USE_TILE_EDGE_MOVEMENTS ensureUseTileEdgeMovements(__func__);
 #define ENSURE_INSIDE_ORIGIN ensureInsideOrigin(__func__);
 #define ENSURE_OUTSIDE_ORIGIN ensureOutsideOrigin(__func__);
+#define RECORD_CALL(...) do {\
+    if (Recorder::isRecording()) {\
+        Recorder::get()->recordCall(__func__, {__VA_ARGS__});\
+    }\
+} while (0)
 
 // We have to forward declare the class (as opposed to including it) so as to
 // avoid a circular dependency; IMouseAlgorithm.h already includes this file
@@ -31,7 +40,8 @@ public:
         MazeGraphic* mazeGraphic,
         IMouseAlgorithm* mouseAlgorithm,
         std::set<char> allowableTileTextCharacters,
-        StaticMouseAlgorithmOptions options);
+        StaticMouseAlgorithmOptions options,
+        Random random);
 
     // ----- Any interface methods ----- //
 
@@ -98,6 +108,28 @@ public:
     // Returns deg/s of rotation
     double readGyro();
 
+    // ----- Continuous interface handle methods ----- //
+
+    // Resolve the name of a wheel or sensor to a handle, or to -1 if there is
+    // no such wheel or sensor. The methods below that take handles skip the
+    // name lookups and interface checks (which are done here, once) and are
+    // not recorded, so that they can be called from within tight control loops
+    int getWheelHandle(const QString& name);
+    int getSensorHandle(const QString& name);
+
+    // Handle-based counterparts of setWheelSpeed, readWheelEncoder, and readSensor
+    void setWheelSpeed(int handle, double rpm);
+    int readWheelEncoder(int handle);
+    double readSensor(int handle);
+
+    // Set the speeds of many wheels at once, where rpms[i] is the speed of
+    // the wheel given by handles[i]; if any speed is invalid, none are set
+    void setWheelSpeeds(const std::vector<int>& handles, const double* rpms);
+
+    // Read many sensors at once, where readings[i] is set to the reading of
+    // the sensor given by handles[i]; all readings come from the same pose
+    void readSensors(const std::vector<int>& handles, double* readings);
+
     // ----- Any discrete interface methods ----- //
 
     bool wallFront();
@@ -153,6 +185,10 @@ private:
     std::set<char> m_allowableTileTextCharacters;
     StaticMouseAlgorithmOptions m_options;
 
+    // The algorithm's own stream, so that its random numbers don't depend on
+    // what else (e.g., maze generation) has drawn from the simulation's
+    Random m_random;
+
     // Whether or not the mouse has moved out the origin
     bool m_inOrigin;
 
@@ -163,6 +199,13 @@ private:
     // Helper methods for checking particular conditions and failing hard
     void ensureDiscreteInterface(const QString& callingFunction) const;
     void ensureContinuousInterface(const QString& callingFunction) const;
+
+    // Helper methods for validating handles (and wheel speeds); each warns
+    // if the value is invalid. Note that action is a plain string so that
+    // nothing is allocated when the handle is valid.
+    bool isValidWheelHandle(int handle, const char* action) const;
+    bool isValidSensorHandle(int handle, const char* action) const;
+    bool isValidWheelSpeed(int handle, double rpm) const;
     void ensureAllowOmniscience(const QString& callingFunction) const;
     void ensureNotTileEdgeMovements(const QString& callingFunction) const;
     void ensureUseTileEdgeMovements(const QString& callingFunction) const;
@@ -5,7 +5,10 @@
 
 #include "Assert.h"
 #include "EncoderType.h"
+#include "ContainerUtilities.h"
 #include "GeometryUtilities.h"
+#include "LoadCache.h"
+#include "Param.h"
 #include "SimUtilities.h"
 #include "units/RevolutionsPerMinute.h"
 
@@ -39,157 +42,316 @@ const QString MouseParser::HALF_WIDTH_TAG = "Half-Width";
 
 MouseParser::MouseParser(const QString& filePath, bool* success) :
         m_forwardDirection(Radians(0)),
-        m_centerOfMass(Cartesian(Meters(0), Meters(0))) {
+        m_centerOfMass(Cartesian(Meters(0), Meters(0))),
+        m_filePath(filePath) {
+
+    // Only valid mouse files are ever cached, so if we can load the
+    // definitions, there's nothing left to validate
+    if (LoadCache::load(filePath, [this](QDataStream& stream) {
+            return readCache(stream);
+        })) {
+        return;
+    }
+
     pugi::xml_parse_result result = m_doc.load_file(filePath.toStdString().c_str());
     if (!result) {
         qWarning()
             << "Unable to read mouse parameters in \"" << filePath << "\" - "
             << result.description();
         *success = false;
+        return;
     }
-    else {
-        m_root = m_doc.child(MOUSE_TAG.toStdString().c_str());
-        m_forwardDirection = Radians(Degrees(
-            getDoubleIfHasDouble(m_root, FORWARD_DIRECTION_TAG, success)));
-        pugi::xml_node centerOfMassNode = getContainerNode(m_root, CENTER_OF_MASS_TAG, success);
-        double x = getDoubleIfHasDouble(centerOfMassNode, X_TAG, success);
-        double y = getDoubleIfHasDouble(centerOfMassNode, Y_TAG, success);
-        m_centerOfMass = Cartesian(Meters(x), Meters(y));
+
+    bool valid = true;
+    m_root = m_doc.child(MOUSE_TAG.toStdString().c_str());
+    m_forwardDirection = Radians(Degrees(
+        getDoubleIfHasDouble(m_root, FORWARD_DIRECTION_TAG, &valid)));
+    pugi::xml_node centerOfMassNode = getContainerNode(m_root, CENTER_OF_MASS_TAG, &valid);
+    double x = getDoubleIfHasDouble(centerOfMassNode, X_TAG, &valid);
+    double y = getDoubleIfHasDouble(centerOfMassNode, Y_TAG, &valid);
+    m_centerOfMass = Cartesian(Meters(x), Meters(y));
+    parseBody(&valid);
+    parseWheels(&valid);
+    parseSensors(&valid);
+
+    if (!valid) {
+        *success = false;
+        return;
     }
+    LoadCache::save(filePath, [this](QDataStream& stream) {
+        writeCache(stream);
+    });
 }
 
 Polygon MouseParser::getBody(
-        const Cartesian& initialTranslation, const Radians& initialRotation, bool* success) {
+        const Cartesian& initialTranslation, const Radians& initialRotation) {
 
     Cartesian alignmentTranslation = initialTranslation - m_centerOfMass;
     Radians alignmentRotation = initialRotation - m_forwardDirection;
 
-    pugi::xml_node body = m_root.child(BODY_TAG.toStdString().c_str());
-    if (body.begin() == body.end()) {
-        qWarning() << "No \"" << BODY_TAG << "\" tag found.";
-        *success = false;
-    }
-
     QVector<Cartesian> vertices;
-    for (pugi::xml_node vertex : body.children(VERTEX_TAG.toStdString().c_str())) {
-        double x = getDoubleIfHasDouble(vertex, X_TAG, success);
-        double y = getDoubleIfHasDouble(vertex, Y_TAG, success);
+    for (const Cartesian& vertex : m_bodyVertices) {
         vertices.push_back(
             alignVertex(
-                Cartesian(Meters(x), Meters(y)),
+                vertex,
                 alignmentTranslation,
                 alignmentRotation,
                 initialTranslation));
     }
+    return Polygon(vertices);
+}
 
-    if (vertices.size() < 3) {
-        qWarning()
-            << "Invalid mouse \"" << BODY_TAG << "\" - less than three valid"
-            << " vertices were specified.";
-        *success = false;
+bool MouseParser::getGeometry(
+        const Cartesian& initialTranslation,
+        const Radians& initialRotation,
+        MouseGeometry* geometry) const {
+    if (m_geometryKey.isEmpty() ||
+            m_geometryKey != getGeometryKey(initialTranslation, initialRotation)) {
+        return false;
     }
+    *geometry = m_geometry;
+    return true;
+}
 
-    Polygon bodyPolygon;
-    if (success) {
-        bodyPolygon = Polygon(vertices);
-        if (bodyPolygon.getTriangles().size() == 0) {
-            qWarning()
-                << "Invalid mouse \"" << BODY_TAG << "\" - the vertices"
-                << " specified do not constitute a simple polygon.";
-            *success = false;
-        }
-    }
+void MouseParser::cacheGeometry(
+        const Cartesian& initialTranslation,
+        const Radians& initialRotation,
+        const MouseGeometry& geometry) {
+    m_geometryKey = getGeometryKey(initialTranslation, initialRotation);
+    m_geometry = geometry;
+    LoadCache::save(m_filePath, [this](QDataStream& stream) {
+        writeCache(stream);
+    });
+}
 
-    if (!*success) {
-        return NULL_POLYGON;
-    }
-    return bodyPolygon;
+QVector<double> MouseParser::getGeometryKey(
+        const Cartesian& initialTranslation,
+        const Radians& initialRotation) const {
+    // The geometry is compared exactly, rather than transformed from some
+    // other pose, so that runs with and without the cache are identical
+    return {
+        initialTranslation.getX().getMeters(),
+        initialTranslation.getY().getMeters(),
+        initialRotation.getRadiansNotBounded(),
+        static_cast<double>(P()->numberOfCircleApproximationPoints()),
+    };
 }
 
 QMap<QString, Wheel> MouseParser::getWheels(
-        const Cartesian& initialTranslation,
-        const Radians& initialRotation,
-        bool* success) {
+        const Cartesian& initialTranslation, const Radians& initialRotation) {
 
     Cartesian alignmentTranslation = initialTranslation - m_centerOfMass;
     Radians alignmentRotation = initialRotation - m_forwardDirection;
 
     QMap<QString, Wheel> wheels;
-    for (pugi::xml_node wheel : m_root.children(WHEEL_TAG.toStdString().c_str())) {
-
-        QString name = getNameIfNonemptyAndUnique("wheel", wheel, wheels, success);
-        double diameter = getDoubleIfHasDoubleAndNonNegative(wheel, DIAMETER_TAG, success);
-        double width = getDoubleIfHasDoubleAndNonNegative(wheel, WIDTH_TAG, success);
-        pugi::xml_node position = getContainerNode(wheel, POSITION_TAG, success);
-        double x = getDoubleIfHasDouble(position, X_TAG, success);
-        double y = getDoubleIfHasDouble(position, Y_TAG, success);
-        double direction = getDoubleIfHasDouble(wheel, DIRECTION_TAG, success);
-        double maxAngularVelocityMagnitude = getDoubleIfHasDoubleAndNonNegative(
-            wheel, MAX_SPEED_TAG, success);
-        EncoderType encoderType = getEncoderTypeIfValid(wheel, success);
-        double encoderTicksPerRevolution = getDoubleIfHasDoubleAndNonNegative(
-            wheel, ENCODER_TICKS_PER_REVOLUTION_TAG, success);
-
-        if (success) {
-            wheels.insert(
-                name,
-                Wheel(
-                    Meters(diameter),
-                    Meters(width),
-                    alignVertex(
-                        Cartesian(Meters(x), Meters(y)),
-                        alignmentTranslation,
-                        alignmentRotation,
-                        initialTranslation),
-                    Degrees(direction) + alignmentRotation,
-                    RevolutionsPerMinute(maxAngularVelocityMagnitude),
-                    encoderType, 
-                    encoderTicksPerRevolution));
-        }
+    for (const auto& pair : ContainerUtilities::items(m_wheels)) {
+        const WheelDefinition& wheel = pair.second;
+        wheels.insert(
+            pair.first,
+            Wheel(
+                Meters(wheel.diameter),
+                Meters(wheel.width),
+                alignVertex(
+                    Cartesian(Meters(wheel.x), Meters(wheel.y)),
+                    alignmentTranslation,
+                    alignmentRotation,
+                    initialTranslation),
+                Degrees(wheel.direction) + alignmentRotation,
+                RevolutionsPerMinute(wheel.maxSpeed),
+                wheel.encoderType,
+                wheel.encoderTicksPerRevolution));
     }
-
     return wheels;
 }
 
 QMap<QString, Sensor> MouseParser::getSensors(
         const Cartesian& initialTranslation,
         const Radians& initialRotation,
-        const Maze& maze,
-        bool* success) {
+        const Maze& maze) {
 
     Cartesian alignmentTranslation = initialTranslation - m_centerOfMass;
     Radians alignmentRotation = initialRotation - m_forwardDirection;
 
     QMap<QString, Sensor> sensors;
-    for (pugi::xml_node sensor : m_root.children(SENSOR_TAG.toStdString().c_str())) {
+    for (const auto& pair : ContainerUtilities::items(m_sensors)) {
+        const SensorDefinition& sensor = pair.second;
+        sensors.insert(
+            pair.first,
+            Sensor(
+                Meters(sensor.radius),
+                Meters(sensor.range),
+                Degrees(sensor.halfWidth),
+                alignVertex(
+                    Cartesian(Meters(sensor.x), Meters(sensor.y)),
+                    alignmentTranslation,
+                    alignmentRotation,
+                    initialTranslation),
+                Degrees(sensor.direction) + alignmentRotation,
+                maze));
+    }
+    return sensors;
+}
+
+void MouseParser::parseBody(bool* success) {
 
-        QString name = getNameIfNonemptyAndUnique("sensor", sensor, sensors, success);
-        double radius = getDoubleIfHasDoubleAndNonNegative(sensor, RADIUS_TAG, success);
-        double range = getDoubleIfHasDoubleAndNonNegative(sensor, RANGE_TAG, success);
-        double halfWidth = getDoubleIfHasDoubleAndNonNegative(sensor, HALF_WIDTH_TAG, success);
+    pugi::xml_node body = m_root.child(BODY_TAG.toStdString().c_str());
+    if (body.begin() == body.end()) {
+        qWarning() << "No \"" << BODY_TAG << "\" tag found.";
+        *success = false;
+    }
+
+    for (pugi::xml_node vertex : body.children(VERTEX_TAG.toStdString().c_str())) {
+        double x = getDoubleIfHasDouble(vertex, X_TAG, success);
+        double y = getDoubleIfHasDouble(vertex, Y_TAG, success);
+        m_bodyVertices.push_back(Cartesian(Meters(x), Meters(y)));
+    }
+
+    if (m_bodyVertices.size() < 3) {
+        qWarning()
+            << "Invalid mouse \"" << BODY_TAG << "\" - less than three valid"
+            << " vertices were specified.";
+        *success = false;
+    }
+
+    // Whether or not the polygon is simple doesn't change when it's aligned,
+    // so we can check it before it is
+    else if (Polygon(m_bodyVertices).getTriangles().size() == 0) {
+        qWarning()
+            << "Invalid mouse \"" << BODY_TAG << "\" - the vertices"
+            << " specified do not constitute a simple polygon.";
+        *success = false;
+    }
+}
+
+void MouseParser::parseWheels(bool* success) {
+    for (pugi::xml_node wheel : m_root.children(WHEEL_TAG.toStdString().c_str())) {
+        QString name = getNameIfNonemptyAndUnique("wheel", wheel, m_wheels, success);
+        WheelDefinition definition;
+        definition.diameter = getDoubleIfHasDoubleAndNonNegative(wheel, DIAMETER_TAG, success);
+        definition.width = getDoubleIfHasDoubleAndNonNegative(wheel, WIDTH_TAG, success);
+        pugi::xml_node position = getContainerNode(wheel, POSITION_TAG, success);
+        definition.x = getDoubleIfHasDouble(position, X_TAG, success);
+        definition.y = getDoubleIfHasDouble(position, Y_TAG, success);
+        definition.direction = getDoubleIfHasDouble(wheel, DIRECTION_TAG, success);
+        definition.maxSpeed = getDoubleIfHasDoubleAndNonNegative(wheel, MAX_SPEED_TAG, success);
+        definition.encoderType = getEncoderTypeIfValid(wheel, success);
+        definition.encoderTicksPerRevolution = getDoubleIfHasDoubleAndNonNegative(
+            wheel, ENCODER_TICKS_PER_REVOLUTION_TAG, success);
+        m_wheels.insert(name, definition);
+    }
+}
+
+void MouseParser::parseSensors(bool* success) {
+    for (pugi::xml_node sensor : m_root.children(SENSOR_TAG.toStdString().c_str())) {
+        QString name = getNameIfNonemptyAndUnique("sensor", sensor, m_sensors, success);
+        SensorDefinition definition;
+        definition.radius = getDoubleIfHasDoubleAndNonNegative(sensor, RADIUS_TAG, success);
+        definition.range = getDoubleIfHasDoubleAndNonNegative(sensor, RANGE_TAG, success);
+        definition.halfWidth = getDoubleIfHasDoubleAndNonNegative(sensor, HALF_WIDTH_TAG, success);
         pugi::xml_node position = getContainerNode(sensor, POSITION_TAG, success);
-        double x = getDoubleIfHasDouble(position, X_TAG, success);
-        double y = getDoubleIfHasDouble(position, Y_TAG, success);
-        double direction = getDoubleIfHasDouble(sensor, DIRECTION_TAG, success);
-
-        if (success) {
-            sensors.insert(
-                name,
-                Sensor(
-                    Meters(radius),
-                    Meters(range), 
-                    Degrees(halfWidth),
-                    alignVertex(
-                        Cartesian(Meters(x), Meters(y)),
-                        alignmentTranslation,
-                        alignmentRotation,
-                        initialTranslation),
-                    Degrees(direction) + alignmentRotation,
-                    maze));
+        definition.x = getDoubleIfHasDouble(position, X_TAG, success);
+        definition.y = getDoubleIfHasDouble(position, Y_TAG, success);
+        definition.direction = getDoubleIfHasDouble(sensor, DIRECTION_TAG, success);
+        m_sensors.insert(name, definition);
+    }
+}
+
+bool MouseParser::readCache(QDataStream& stream) {
+
+    double forwardDirection;
+    double centerOfMassX;
+    double centerOfMassY;
+    int numberOfVertices;
+    stream >> forwardDirection >> centerOfMassX >> centerOfMassY >> numberOfVertices;
+    if (stream.status() != QDataStream::Ok || numberOfVertices < 3) {
+        return false;
+    }
+    QVector<Cartesian> bodyVertices;
+    for (int i = 0; i < numberOfVertices; i += 1) {
+        double x;
+        double y;
+        stream >> x >> y;
+        bodyVertices.push_back(Cartesian(Meters(x), Meters(y)));
+    }
+
+    int numberOfWheels;
+    stream >> numberOfWheels;
+    QMap<QString, WheelDefinition> wheels;
+    for (int i = 0; i < numberOfWheels && stream.status() == QDataStream::Ok; i += 1) {
+        QString name;
+        WheelDefinition wheel;
+        int encoderType;
+        stream >> name >> wheel.diameter >> wheel.width >> wheel.x >> wheel.y
+            >> wheel.direction >> wheel.maxSpeed >> encoderType
+            >> wheel.encoderTicksPerRevolution;
+        if (!ENCODER_TYPE_TO_STRING.contains(static_cast<EncoderType>(encoderType))) {
+            return false;
         }
+        wheel.encoderType = static_cast<EncoderType>(encoderType);
+        wheels.insert(name, wheel);
     }
 
-    return sensors;
+    int numberOfSensors;
+    stream >> numberOfSensors;
+    QMap<QString, SensorDefinition> sensors;
+    for (int i = 0; i < numberOfSensors && stream.status() == QDataStream::Ok; i += 1) {
+        QString name;
+        SensorDefinition sensor;
+        stream >> name >> sensor.radius >> sensor.range >> sensor.halfWidth
+            >> sensor.x >> sensor.y >> sensor.direction;
+        sensors.insert(name, sensor);
+    }
+
+    // The geometry is optional, and is only cached once a mouse has been
+    // initialized from the definitions
+    QVector<double> geometryKey;
+    MouseGeometry geometry;
+    stream >> geometryKey;
+    if (stream.status() == QDataStream::Ok && !geometryKey.isEmpty() &&
+            !geometry.readCache(stream)) {
+        return false;
+    }
+
+    // Nothing is assigned unless the whole blob could be read
+    if (stream.status() != QDataStream::Ok) {
+        return false;
+    }
+    m_forwardDirection = Radians(forwardDirection);
+    m_centerOfMass = Cartesian(Meters(centerOfMassX), Meters(centerOfMassY));
+    m_bodyVertices = bodyVertices;
+    m_wheels = wheels;
+    m_sensors = sensors;
+    m_geometryKey = geometryKey;
+    m_geometry = geometry;
+    return true;
+}
+
+void MouseParser::writeCache(QDataStream& stream) const {
+    stream
+        << m_forwardDirection.getRadiansNotBounded()
+        << m_centerOfMass.getX().getMeters()
+        << m_centerOfMass.getY().getMeters()
+        << m_bodyVertices.size();
+    for (const Cartesian& vertex : m_bodyVertices) {
+        stream << vertex.getX().getMeters() << vertex.getY().getMeters();
+    }
+    stream << m_wheels.size();
+    for (const auto& pair : ContainerUtilities::items(m_wheels)) {
+        const WheelDefinition& wheel = pair.second;
+        stream << pair.first << wheel.diameter << wheel.width << wheel.x << wheel.y
+            << wheel.direction << wheel.maxSpeed << static_cast<int>(wheel.encoderType)
+            << wheel.encoderTicksPerRevolution;
+    }
+    stream << m_sensors.size();
+    for (const auto& pair : ContainerUtilities::items(m_sensors)) {
+        const SensorDefinition& sensor = pair.second;
+        stream << pair.first << sensor.radius << sensor.range << sensor.halfWidth
+            << sensor.x << sensor.y << sensor.direction;
+    }
+    stream << m_geometryKey;
+    if (!m_geometryKey.isEmpty()) {
+        m_geometry.writeCache(stream);
+    }
 }
 
 double MouseParser::getDoubleIfHasDouble(const pugi::xml_node& node, const QString& tag, bool* success) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <QDataStream>
 #include <QDebug>
 #include <QMap>
 #include <QString>
@@ -8,8 +9,10 @@
 #include <QString>
 #include <QVector>
 
+#include "EncoderType.h"
 #include "Logging.h"
 #include "Maze.h"
+#include "MouseGeometry.h"
 #include "Polygon.h"
 #include "Sensor.h"
 #include "units/Cartesian.h"
@@ -22,30 +25,91 @@ class MouseParser {
 
 public:
 
+    // Parses and validates the entire mouse file, or loads the result of
+    // having done so from the load cache; success is false if it's invalid
     MouseParser(const QString& filePath, bool* success);
 
+    // The parts of a valid mouse, aligned with its initial translation and rotation
     Polygon getBody(
         const Cartesian& initialTranslation,
-        const Radians& initialRotation,
-        bool* success);
+        const Radians& initialRotation);
 
     QMap<QString, Wheel> getWheels(
         const Cartesian& initialTranslation,
-        const Radians& initialRotation,
-        bool* success);
+        const Radians& initialRotation);
 
     QMap<QString, Sensor> getSensors(
         const Cartesian& initialTranslation,
         const Radians& initialRotation,
-        const Maze& maze,
-        bool* success);
+        const Maze& maze);
+
+    // The compiled geometry (see MouseGeometry.h) of a mouse with the given
+    // initial translation and rotation, if it was cached along with the
+    // definitions of the mouse; returns false if it wasn't
+    bool getGeometry(
+        const Cartesian& initialTranslation,
+        const Radians& initialRotation,
+        MouseGeometry* geometry) const;
+
+    // Caches the geometry compiled for a mouse with the given initial
+    // translation and rotation, along with the definitions of the mouse
+    void cacheGeometry(
+        const Cartesian& initialTranslation,
+        const Radians& initialRotation,
+        const MouseGeometry& geometry);
 
 private:
+
+    // The validated contents of the mouse file, as specified in the file
+    // (i.e., in meters and degrees, and not yet aligned)
+    struct WheelDefinition {
+        double diameter;
+        double width;
+        double x;
+        double y;
+        double direction;
+        double maxSpeed;
+        EncoderType encoderType;
+        double encoderTicksPerRevolution;
+    };
+    struct SensorDefinition {
+        double radius;
+        double range;
+        double halfWidth;
+        double x;
+        double y;
+        double direction;
+    };
+
     // We have to keep m_doc around so valgrind doesn't complain
     pugi::xml_document m_doc;
     pugi::xml_node m_root;
     Radians m_forwardDirection;
     Cartesian m_centerOfMass;
+    QVector<Cartesian> m_bodyVertices;
+    QMap<QString, WheelDefinition> m_wheels;
+    QMap<QString, SensorDefinition> m_sensors;
+
+    // The path of the mouse file, which the load cache is keyed by
+    QString m_filePath;
+
+    // The cached geometry, if any, and everything that it depends on other
+    // than the definitions (see getGeometryKey); the key is empty if there
+    // is no cached geometry
+    QVector<double> m_geometryKey;
+    MouseGeometry m_geometry;
+    QVector<double> getGeometryKey(
+        const Cartesian& initialTranslation,
+        const Radians& initialRotation) const;
+
+    // Fill in the definitions from m_root, warning about anything invalid
+    void parseBody(bool* success);
+    void parseWheels(bool* success);
+    void parseSensors(bool* success);
+
+    // Read the definitions from, or write them to, a load cache stream
+    bool readCache(QDataStream& stream);
+    void writeCache(QDataStream& stream) const;
 
     double getDoubleIfHasDouble(const pugi::xml_node& node, const QString& tag, bool* success);
     double getDoubleIfHasDoubleAndNonNegative(
@@ -1,5 +1,6 @@
 #include "Param.h"
 
+#include <QDataStream>
 #include <QDebug>
 
 #include <limits>
@@ -10,12 +11,34 @@
 #include "Directory.h"
 #include "LayoutType.h"
 #include "Logging.h"
+#include "LoadCache.h"
 #include "MazeFileType.h"
 #include "ParamParser.h"
 #include "TileTextAlignment.h"
 
 namespace sim {
 
+namespace {
+
+template<class T>
+void streamValue(QDataStream& stream, bool reading, T& value) {
+    if (reading) {
+        stream >> value;
+    }
+    else {
+        stream << value;
+    }
+}
+
+// QDataStream has no operators for plain chars
+void streamValue(QDataStream& stream, bool reading, char& value) {
+    qint8 character = value;
+    streamValue(stream, reading, character);
+    value = character;
+}
+
+} // namespace
+
 Param* P() {
     return Param::getInstance();
 }
@@ -31,8 +54,35 @@ Param* Param::getInstance() {
 
 Param::Param() {
 
-    // Create the parameter parser object
-    ParamParser parser(Directory::get()->getResDirectory() + "parameters.xml");
+    // Parsing and validating the parameters is a noticeable part of starting
+    // the simulator, so we use the values from the last run if we can. The
+    // values are only cached if there was nothing to warn about, so that the
+    // warnings are printed every time until the file is fixed.
+    QString filePath = Directory::get()->getResDirectory() + "parameters.xml";
+    bool useRandomSeed = false;
+    bool loaded = LoadCache::load(filePath, [&](QDataStream& stream) {
+        streamValues(stream, true);
+        stream >> useRandomSeed;
+        return true;
+    });
+    if (!loaded) {
+        ParamParser parser(filePath);
+        parse(parser, &useRandomSeed);
+        if (!parser.printedWarnings()) {
+            LoadCache::save(filePath, [&](QDataStream& stream) {
+                streamValues(stream, false);
+                stream << useRandomSeed;
+            });
+        }
+    }
+
+    // A random seed is, of course, different for every run
+    if (!useRandomSeed) {
+        m_randomSeed = std::random_device()();
+    }
+}
+
+void Param::parse(ParamParser& parser, bool* useRandomSeed) {
 
     // Graphical Parameters
     m_defaultWindowWidth = parser.getIntIfHasIntAndNotLessThan(
@@ -61,6 +111,8 @@ Param::Param() {
         "default-rotate-zoomed-map", false);
     m_frameRate = parser.getIntIfHasIntAndInRange(
         "frame-rate", 60, 1, 120);
+    m_idleFrameRate = parser.getIntIfHasIntAndInRange(
+        "idle-frame-rate", 4, 1, m_frameRate);
     m_printLateFrames = parser.getBoolIfHasBool(
         "print-late-frames", false);
     m_tileBaseColor = parser.getStringIfHasStringAndIsColor(
@@ -115,17 +167,23 @@ Param::Param() {
         "default-wireframe-mode", false);
     m_distanceCorrectTileBaseColor = parser.getStringIfHasStringAndIsColor(
         "distance-correct-tile-base-color", COLOR_TO_STRING.value(Color::DARK_YELLOW));
+    m_mazeChunkSize = parser.getIntIfHasIntAndInRange(
+        "maze-chunk-size", 16, 1, 256);
+    m_maxResidentMazeChunks = parser.getIntIfHasIntAndInRange(
+        "max-resident-maze-chunks", 64, 1, 4096);
+    m_minDetailedTilePixels = parser.getDoubleIfHasDoubleAndInRange(
+        "min-detailed-tile-pixels", 4.0, 0.0, 64.0);
 
     // Simulation Parameters
-    bool useRandomSeed = parser.getBoolIfHasBool(
+    *useRandomSeed = parser.getBoolIfHasBool(
         "use-random-seed", false);
-    if (useRandomSeed && !parser.hasIntValue("random-seed")) {
+    if (*useRandomSeed && !parser.hasIntValue("random-seed")) {
         qWarning()
             << "The value of use-random-seed is true but no valid random-seed"
             << " value was provided. Setting \"use-random-seed\" to false.";
-        useRandomSeed = false;
+        *useRandomSeed = false;
     }
-    m_randomSeed = (useRandomSeed ? parser.getIntValue("random-seed") : std::random_device()());
+    m_randomSeed = (*useRandomSeed ? parser.getIntValue("random-seed") : std::random_device()());
     m_glutInitDuration = parser.getDoubleIfHasDoubleAndInRange(
         "glut-init-duration", 0.1, 0.0, 5.0);
     m_defaultPaused = parser.getBoolIfHasBool(
@@ -156,8 +214,24 @@ Param::Param() {
         "number-of-circle-approximation-points", 8, 3, 30);
     m_numberOfSensorEdgePoints = parser.getIntIfHasIntAndInRange(
         "number-of-sensor-edge-points", 3, 2, 10);
+    m_sensorDistanceFieldHeadings = parser.getIntIfHasIntAndInRange(
+        "sensor-distance-field-headings", 0, 0, 1024);
+    m_sensorDistanceFieldCellsPerTile = parser.getIntIfHasIntAndInRange(
+        "sensor-distance-field-cells-per-tile", 8, 1, 64);
     m_numberOfArchivedRuns = parser.getIntIfHasIntAndInRange(
-        "number-of-archived-runs", 20, 1, 1000);
+        "number-of-archived-runs", 20, 1, 100000);
+    m_archivedRunsMaxMegabytes = parser.getIntIfHasIntAndInRange(
+        "archived-runs-max-megabytes", 1024, 1, 1048576);
+    m_recordRun = parser.getBoolIfHasBool(
+        "record-run", true);
+    m_recordingKeyframeInterval = parser.getIntIfHasIntAndInRange(
+        "recording-keyframe-interval", 100, 1, 10000);
+    m_replayRun = parser.getStringIfHasString(
+        "replay-run", "");
+    m_useReplayRun = parser.getBoolIfHasBool(
+        "use-replay-run", false);
+    m_replaySeekStep = parser.getDoubleIfHasDoubleAndInRange(
+        "replay-seek-step", 1.0, 0.001, 60.0);
 
     // Maze Parameters
     m_wallWidth = parser.getDoubleIfHasDoubleAndInRange(
@@ -169,9 +243,9 @@ Param::Param() {
     m_useMazeFile = parser.getBoolIfHasBool(
         "use-maze-file", false);
     m_generatedMazeWidth = parser.getIntIfHasIntAndInRange(
-        "generated-maze-width", 16, 1, 256);
+        "generated-maze-width", 16, 1, 4096);
     m_generatedMazeHeight = parser.getIntIfHasIntAndInRange(
-        "generated-maze-height", 16, 1, 256);
+        "generated-maze-height", 16, 1, 4096);
     m_mazeAlgorithm = parser.getStringIfHasString(
         "maze-algorithm", "Tomasz");
     m_saveGeneratedMaze = parser.getBoolIfHasBool(
@@ -188,6 +262,102 @@ Param::Param() {
     // Mouse parameters
     m_mouseAlgorithm = parser.getStringIfHasString(
         "mouse-algorithm", "RightWallFollow");
+    m_numberOfMice = parser.getIntIfHasIntAndInRange(
+        "number-of-mice", 1, 1, 64);
+}
+
+void Param::streamValues(QDataStream& stream, bool reading) {
+
+    // Graphics parameters
+    streamValue(stream, reading, m_defaultWindowWidth);
+    streamValue(stream, reading, m_defaultWindowHeight);
+    streamValue(stream, reading, m_defaultLayoutType);
+    streamValue(stream, reading, m_windowBorderWidth);
+    streamValue(stream, reading, m_headerTextFont);
+    streamValue(stream, reading, m_headerTextHeight);
+    streamValue(stream, reading, m_headerRowSpacing);
+    streamValue(stream, reading, m_headerColumnSpacing);
+    streamValue(stream, reading, m_minZoomedMapScale);
+    streamValue(stream, reading, m_maxZoomedMapScale);
+    streamValue(stream, reading, m_defaultZoomedMapScale);
+    streamValue(stream, reading, m_defaultRotateZoomedMap);
+    streamValue(stream, reading, m_frameRate);
+    streamValue(stream, reading, m_idleFrameRate);
+    streamValue(stream, reading, m_printLateFrames);
+    streamValue(stream, reading, m_tileBaseColor);
+    streamValue(stream, reading, m_tileWallColor);
+    streamValue(stream, reading, m_tileCornerColor);
+    streamValue(stream, reading, m_tileFogColor);
+    streamValue(stream, reading, m_tileTextFontImage);
+    streamValue(stream, reading, m_tileTextBorderFraction);
+    streamValue(stream, reading, m_tileTextAlignment);
+    streamValue(stream, reading, m_tileUndeclaredWallColor);
+    streamValue(stream, reading, m_tileUndeclaredNoWallColor);
+    streamValue(stream, reading, m_tileIncorrectlyDeclaredWallColor);
+    streamValue(stream, reading, m_tileIncorrectlyDeclaredNoWallColor);
+    streamValue(stream, reading, m_mouseBodyColor);
+    streamValue(stream, reading, m_mouseCenterOfMassColor);
+    streamValue(stream, reading, m_mouseWheelColor);
+    streamValue(stream, reading, m_mouseWheelSpeedIndicatorColor);
+    streamValue(stream, reading, m_mouseSensorColor);
+    streamValue(stream, reading, m_mouseViewColor);
+    streamValue(stream, reading, m_defaultWallTruthVisible);
+    streamValue(stream, reading, m_defaultTileColorsVisible);
+    streamValue(stream, reading, m_defaultTileFogVisible);
+    streamValue(stream, reading, m_defaultTileTextVisible);
+    streamValue(stream, reading, m_defaultTileDistanceVisible);
+    streamValue(stream, reading, m_defaultHeaderVisible);
+    streamValue(stream, reading, m_tileFogAlpha);
+    streamValue(stream, reading, m_defaultWireframeMode);
+    streamValue(stream, reading, m_distanceCorrectTileBaseColor);
+    streamValue(stream, reading, m_mazeChunkSize);
+    streamValue(stream, reading, m_maxResidentMazeChunks);
+    streamValue(stream, reading, m_minDetailedTilePixels);
+
+    // Simulation parameters
+    streamValue(stream, reading, m_randomSeed);
+    streamValue(stream, reading, m_glutInitDuration);
+    streamValue(stream, reading, m_defaultPaused);
+    streamValue(stream, reading, m_minSimSpeed);
+    streamValue(stream, reading, m_maxSimSpeed);
+    streamValue(stream, reading, m_defaultSimSpeed);
+    streamValue(stream, reading, m_collisionDetectionEnabled);
+    streamValue(stream, reading, m_crashMessage);
+    streamValue(stream, reading, m_defaultTileTextCharacter);
+    streamValue(stream, reading, m_minSleepDuration);
+    streamValue(stream, reading, m_mousePositionUpdateRate);
+    streamValue(stream, reading, m_printLateMousePostitionUpdates);
+    streamValue(stream, reading, m_collisionDetectionRate);
+    streamValue(stream, reading, m_printLateCollisionDetections);
+    streamValue(stream, reading, m_numberOfCircleApproximationPoints);
+    streamValue(stream, reading, m_numberOfSensorEdgePoints);
+    streamValue(stream, reading, m_sensorDistanceFieldHeadings);
+    streamValue(stream, reading, m_sensorDistanceFieldCellsPerTile);
+    streamValue(stream, reading, m_numberOfArchivedRuns);
+    streamValue(stream, reading, m_archivedRunsMaxMegabytes);
+    streamValue(stream, reading, m_recordRun);
+    streamValue(stream, reading, m_recordingKeyframeInterval);
+    streamValue(stream, reading, m_replayRun);
+    streamValue(stream, reading, m_useReplayRun);
+    streamValue(stream, reading, m_replaySeekStep);
+
+    // Maze parameters
+    streamValue(stream, reading, m_wallWidth);
+    streamValue(stream, reading, m_wallLength);
+    streamValue(stream, reading, m_mazeFile);
+    streamValue(stream, reading, m_useMazeFile);
+    streamValue(stream, reading, m_generatedMazeWidth);
+    streamValue(stream, reading, m_generatedMazeHeight);
+    streamValue(stream, reading, m_mazeAlgorithm);
+    streamValue(stream, reading, m_saveGeneratedMaze);
+    streamValue(stream, reading, m_generatedMazeFile);
+    streamValue(stream, reading, m_generatedMazeType);
+    streamValue(stream, reading, m_mazeMirrored);
+    streamValue(stream, reading, m_mazeRotations);
+
+    // Mouse parameters
+    streamValue(stream, reading, m_mouseAlgorithm);
+    streamValue(stream, reading, m_numberOfMice);
 }
 
 int Param::defaultWindowWidth() {
@@ -242,6 +412,10 @@ int Param::frameRate() {
     return m_frameRate;
 }
 
+int Param::idleFrameRate() {
+    return m_idleFrameRate;
+}
+
 bool Param::printLateFrames() {
     return m_printLateFrames;
 }
@@ -350,6 +524,18 @@ QString Param::distanceCorrectTileBaseColor() {
     return m_distanceCorrectTileBaseColor;
 }
 
+int Param::mazeChunkSize() {
+    return m_mazeChunkSize;
+}
+
+int Param::maxResidentMazeChunks() {
+    return m_maxResidentMazeChunks;
+}
+
+double Param::minDetailedTilePixels() {
+    return m_minDetailedTilePixels;
+}
+
 int Param::randomSeed() {
     return m_randomSeed;
 }
@@ -414,10 +600,42 @@ int Param::numberOfSensorEdgePoints() {
     return m_numberOfSensorEdgePoints;
 }
 
+int Param::sensorDistanceFieldHeadings() {
+    return m_sensorDistanceFieldHeadings;
+}
+
+int Param::sensorDistanceFieldCellsPerTile() {
+    return m_sensorDistanceFieldCellsPerTile;
+}
+
 int Param::numberOfArchivedRuns() {
     return m_numberOfArchivedRuns;
 }
 
+int Param::archivedRunsMaxMegabytes() {
+    return m_archivedRunsMaxMegabytes;
+}
+
+bool Param::recordRun() {
+    return m_recordRun;
+}
+
+int Param::recordingKeyframeInterval() {
+    return m_recordingKeyframeInterval;
+}
+
+QString Param::replayRun() {
+    return m_replayRun;
+}
+
+bool Param::useReplayRun() {
+    return m_useReplayRun;
+}
+
+double Param::replaySeekStep() {
+    return m_replaySeekStep;
+}
+
 QString Param::mazeFile() {
     return m_mazeFile;
 }
@@ -470,4 +688,8 @@ QString Param::mouseAlgorithm() {
     return m_mouseAlgorithm;
 }
 
+int Param::numberOfMice() {
+    return m_numberOfMice;
+}
+
 } // namespace sim
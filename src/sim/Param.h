@@ -1,9 +1,12 @@
 #pragma once
 
+#include <QDataStream>
 #include <QString>
 
 namespace sim {
 
+class ParamParser;
+
 // Wrapper for the static call to Param::getInstance()
 class Param;
 Param* P();
@@ -29,6 +32,7 @@ public:
     double defaultZoomedMapScale();
     bool defaultRotateZoomedMap();
     int frameRate();
+    int idleFrameRate();
     bool printLateFrames();
     QString tileBaseColor();
     QString tileWallColor();
@@ -56,6 +60,9 @@ public:
     double tileFogAlpha();
     bool defaultWireframeMode();
     QString distanceCorrectTileBaseColor();
+    int mazeChunkSize();
+    int maxResidentMazeChunks();
+    double minDetailedTilePixels();
 
     // Simulation parameters
     int randomSeed();
@@ -74,7 +81,15 @@ public:
     bool printLateCollisionDetections();
     int numberOfCircleApproximationPoints();
     int numberOfSensorEdgePoints();
+    int sensorDistanceFieldHeadings();
+    int sensorDistanceFieldCellsPerTile();
     int numberOfArchivedRuns();
+    int archivedRunsMaxMegabytes();
+    bool recordRun();
+    int recordingKeyframeInterval();
+    QString replayRun();
+    bool useReplayRun();
+    double replaySeekStep();
 
     // Maze parameters
     double wallWidth();
@@ -92,12 +107,19 @@ public:
 
     // Mouse parameters
     QString mouseAlgorithm();
+    int numberOfMice();
 
 private:
 
     // A private constructor is used to ensure only one instance of this class exists
     Param();
 
+    // Sets all of the values from the parameters file, validating each of them
+    void parse(ParamParser& parser, bool* useRandomSeed);
+
+    // Reads all of the values from, or writes them to, a load cache stream
+    void streamValues(QDataStream& stream, bool reading);
+
     // A pointer to the actual instance of the class
     static Param* INSTANCE;
 
@@ -115,6 +137,7 @@ private:
     double m_defaultZoomedMapScale;
     bool m_defaultRotateZoomedMap;
     int m_frameRate;
+    int m_idleFrameRate;
     bool m_printLateFrames;
     QString m_tileBaseColor;
     QString m_tileWallColor;
@@ -142,6 +165,9 @@ private:
     double m_tileFogAlpha;
     bool m_defaultWireframeMode;
     QString m_distanceCorrectTileBaseColor;
+    int m_mazeChunkSize;
+    int m_maxResidentMazeChunks;
+    double m_minDetailedTilePixels;
 
     // Simulation parameters
     int m_randomSeed;
@@ -160,7 +186,15 @@ private:
     bool m_printLateCollisionDetections;
     int m_numberOfCircleApproximationPoints;
     int m_numberOfSensorEdgePoints;
+    int m_sensorDistanceFieldHeadings;
+    int m_sensorDistanceFieldCellsPerTile;
     int m_numberOfArchivedRuns;
+    int m_archivedRunsMaxMegabytes;
+    bool m_recordRun;
+    int m_recordingKeyframeInterval;
+    QString m_replayRun;
+    bool m_useReplayRun;
+    double m_replaySeekStep;
 
     // Maze parameters
     double m_wallWidth;
@@ -178,6 +212,7 @@ private:
 
     // Mouse parameters
     QString m_mouseAlgorithm;
+    int m_numberOfMice;
 };
 
 } // namespace sim
@@ -14,7 +14,8 @@ namespace sim {
 
 const QString ParamParser::PARAMETERS_TAG = "parameters";
 
-ParamParser::ParamParser(const QString& filePath) {
+ParamParser::ParamParser(const QString& filePath) :
+        m_printedWarnings(false) {
     m_fileIsReadable = m_doc.load_file(filePath.toStdString().c_str());
     if (!m_fileIsReadable) {
         qWarning()
@@ -150,8 +151,13 @@ QString ParamParser::getStringIfHasStringAndIsTileTextAlignment(const QString& t
     return getStringIfHasStringAndIsSpecial("tile text alignment", tag, defaultValue, STRING_TO_TILE_TEXT_ALIGNMENT);
 }
 
+bool ParamParser::printedWarnings() const {
+    return m_printedWarnings;
+}
+
 void ParamParser::printTagNotFound(const QString& type, const QString& tag, const QString& defaultValue) {
     if (m_fileIsReadable) {
+        m_printedWarnings = true;
         qWarning()
             << "Could not find " << type << " parameter \"" << tag << "\"."
             << " Using default value of " << defaultValue << ".";
@@ -160,6 +166,7 @@ void ParamParser::printTagNotFound(const QString& type, const QString& tag, cons
 
 void ParamParser::printLessThan(const QString& type, const QString& tag, const QString& value,
     const QString& defaultValue, const QString& min) {
+    m_printedWarnings = true;
     qWarning()
         << "The value of the " << type << " parameter \"" << tag << "\" is "
         << value << " and is less than the minimum allowed value of " << min
@@ -168,6 +175,7 @@ void ParamParser::printLessThan(const QString& type, const QString& tag, const Q
 
 void ParamParser::printGreaterThan(const QString& type, const QString& tag, const QString& value,
     const QString& defaultValue, const QString& max) {
+    m_printedWarnings = true;
     qWarning()
         << "The value of the " << type << " parameter \"" << tag << "\" is "
         << value << " and is greater than the maximum allowed value of " << max
@@ -179,6 +187,7 @@ void ParamParser::printNotSpecialString(
         const QString& tag,
         const QString& value,
         const QString& defaultValue) {
+    m_printedWarnings = true;
     qWarning()
         << "The value of string parameter \"" << tag << "\" is \"" << value
         << "\" and is not a valid " << type << ". Using default value of \""
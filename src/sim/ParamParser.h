@@ -50,11 +50,15 @@ public:
     QString getStringIfHasStringAndIsMazeFileType(const QString& tag, const QString& defaultValue);
     QString getStringIfHasStringAndIsTileTextAlignment(const QString& tag, const QString& defaultValue);
 
+    // Whether or not any of the above have warned about a missing or invalid value
+    bool printedWarnings() const;
+
 private:
     // We have to keep m_doc around so valgrind doesn't complain
     pugi::xml_document m_doc;
     pugi::xml_node m_root;
     pugi::xml_parse_result m_fileIsReadable;
+    bool m_printedWarnings;
 
     static const QString PARAMETERS_TAG;
 
@@ -38,6 +38,10 @@ private:
     // of the polygon specified by the vertices argument.
     Polygon(const QVector<Cartesian>& vertices, const QVector<Triangle>& triangles);
 
+    // The compiled mouse geometry keeps its own triangulations, and so it
+    // needs the special constructor, too
+    friend class MouseGeometry;
+
     // Tells us whether or not the polygon has already performed triangulation.
     // This is used in the copy constructor, and allows us to be lazy without
     // throwing away information.
@@ -0,0 +1,193 @@
+#include "Random.h"
+
+#include <algorithm>
+
+namespace sim {
+
+namespace {
+
+// The Philox4x32 multipliers and key increments (the latter are the golden
+// ratio and sqrt(3) - 1, in 32 bit fixed point)
+const uint32_t MULTIPLIER_0 = 0xD2511F53;
+const uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+const uint32_t WEYL_0 = 0x9E3779B9;
+const uint32_t WEYL_1 = 0xBB67AE85;
+const int ROUNDS = 10;
+
+// Derived streams are the outputs of a differently keyed generator, so that
+// they have nothing to do with the numbers of the stream they're derived from
+const uint32_t STREAM_KEY_0 = 0x243F6A88;
+const uint32_t STREAM_KEY_1 = 0x85A308D3;
+
+} // namespace
+
+Random::Random(uint64_t seed) :
+        m_key{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+        m_stream(0),
+        m_position(0),
+        m_blockNumber(0),
+        m_hasBlock(false) {
+}
+
+Random::Random(const uint32_t key[2], uint64_t stream) :
+        m_key{key[0], key[1]},
+        m_stream(stream),
+        m_position(0),
+        m_blockNumber(0),
+        m_hasBlock(false) {
+}
+
+Random Random::getStream(uint64_t id) const {
+    Random hash(m_key, m_stream);
+    hash.m_key[0] ^= STREAM_KEY_0;
+    hash.m_key[1] ^= STREAM_KEY_1;
+    uint32_t block[4];
+    hash.generateBlock(id, block);
+    return Random(m_key, block[0] | (static_cast<uint64_t>(block[1]) << 32));
+}
+
+uint32_t Random::getUint32() {
+    uint64_t blockNumber = m_position / 4;
+    if (!m_hasBlock || m_blockNumber != blockNumber) {
+        generateBlock(blockNumber, m_block);
+        m_blockNumber = blockNumber;
+        m_hasBlock = true;
+    }
+    uint32_t value = m_block[m_position % 4];
+    m_position += 1;
+    return value;
+}
+
+double Random::getDouble() {
+    uint32_t high = getUint32();
+    uint32_t low = getUint32();
+    return toDouble(high, low);
+}
+
+void Random::skip(uint64_t count) {
+    m_position += count;
+}
+
+uint64_t Random::getPosition() const {
+    return m_position;
+}
+
+void Random::fill(uint32_t* values, int count) {
+
+    // Finish off the current block one number at a time, then generate whole
+    // blocks, LANES at a time, and then start on the last block
+    int i = 0;
+    while (i < count && m_position % 4 != 0) {
+        values[i] = getUint32();
+        i += 1;
+    }
+    while (4 <= count - i) {
+        int blocks = std::min(LANES, (count - i) / 4);
+        generateBlocks(m_position / 4, blocks, values + i);
+        m_position += 4 * blocks;
+        i += 4 * blocks;
+    }
+    while (i < count) {
+        values[i] = getUint32();
+        i += 1;
+    }
+}
+
+void Random::fill(double* values, int count) {
+    uint32_t words[8 * LANES];
+    int i = 0;
+    while (i < count) {
+        int doubles = std::min(count - i, 4 * LANES);
+        fill(words, 2 * doubles);
+        for (int j = 0; j < doubles; j += 1) {
+            values[i + j] = toDouble(words[2 * j], words[2 * j + 1]);
+        }
+        i += doubles;
+    }
+}
+
+void Random::generateBlock(uint64_t block, uint32_t* values) const {
+
+    // NOTE: This is a performance critical function
+
+    // The same rounds as generateBlocks() does, for a single lane
+    uint32_t c0 = static_cast<uint32_t>(block);
+    uint32_t c1 = static_cast<uint32_t>(block >> 32);
+    uint32_t c2 = static_cast<uint32_t>(m_stream);
+    uint32_t c3 = static_cast<uint32_t>(m_stream >> 32);
+    uint32_t k0 = m_key[0];
+    uint32_t k1 = m_key[1];
+    for (int round = 0; round < ROUNDS; round += 1) {
+        uint64_t product0 = static_cast<uint64_t>(MULTIPLIER_0) * c0;
+        uint64_t product1 = static_cast<uint64_t>(MULTIPLIER_1) * c2;
+        uint32_t n0 = static_cast<uint32_t>(product1 >> 32) ^ c1 ^ k0;
+        uint32_t n2 = static_cast<uint32_t>(product0 >> 32) ^ c3 ^ k1;
+        c0 = n0;
+        c1 = static_cast<uint32_t>(product1);
+        c2 = n2;
+        c3 = static_cast<uint32_t>(product0);
+        k0 += WEYL_0;
+        k1 += WEYL_1;
+    }
+
+    values[0] = c0;
+    values[1] = c1;
+    values[2] = c2;
+    values[3] = c3;
+}
+
+void Random::generateBlocks(uint64_t firstBlock, int count, uint32_t* values) const {
+
+    // NOTE: This is a performance critical function
+
+    // Doing all of the lanes for a single block would be LANES times the work
+    if (count == 1) {
+        generateBlock(firstBlock, values);
+        return;
+    }
+
+    // The counter of each block is its number, followed by the stream
+    uint32_t c0[LANES];
+    uint32_t c1[LANES];
+    uint32_t c2[LANES];
+    uint32_t c3[LANES];
+    for (int i = 0; i < LANES; i += 1) {
+        uint64_t block = firstBlock + i;
+        c0[i] = static_cast<uint32_t>(block);
+        c1[i] = static_cast<uint32_t>(block >> 32);
+        c2[i] = static_cast<uint32_t>(m_stream);
+        c3[i] = static_cast<uint32_t>(m_stream >> 32);
+    }
+
+    // The rounds are always done for every lane, with no branches, so that
+    // the loops are vectorized; the lanes past count are just thrown away
+    uint32_t k0 = m_key[0];
+    uint32_t k1 = m_key[1];
+    for (int round = 0; round < ROUNDS; round += 1) {
+        for (int i = 0; i < LANES; i += 1) {
+            uint64_t product0 = static_cast<uint64_t>(MULTIPLIER_0) * c0[i];
+            uint64_t product1 = static_cast<uint64_t>(MULTIPLIER_1) * c2[i];
+            uint32_t n0 = static_cast<uint32_t>(product1 >> 32) ^ c1[i] ^ k0;
+            uint32_t n2 = static_cast<uint32_t>(product0 >> 32) ^ c3[i] ^ k1;
+            c0[i] = n0;
+            c1[i] = static_cast<uint32_t>(product1);
+            c2[i] = n2;
+            c3[i] = static_cast<uint32_t>(product0);
+        }
+        k0 += WEYL_0;
+        k1 += WEYL_1;
+    }
+
+    for (int i = 0; i < count; i += 1) {
+        values[4 * i + 0] = c0[i];
+        values[4 * i + 1] = c1[i];
+        values[4 * i + 2] = c2[i];
+        values[4 * i + 3] = c3[i];
+    }
+}
+
+double Random::toDouble(uint32_t high, uint32_t low) {
+    return ((high >> 5) * 67108864.0 + (low >> 6)) / 9007199254740992.0;
+}
+
+} // namespace sim
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstdint>
+
+namespace sim {
+
+// A counter-based random number generator (Philox4x32-10, from "Parallel
+// Random Numbers: As Easy as 1, 2, 3" by Salmon et al.).
+//
+// Rather than carrying state from one number to the next, each block of four
+// 32 bit numbers is a pure function of the seed, the stream, and the block's
+// position in the stream. This means that skipping ahead is free, that
+// blocks can be generated independently of one another (and so many at
+// once), and that streams derived from the same seed never overlap.
+//
+// Each simulation owns a root Random, seeded by the random seed parameter,
+// and every consumer of random numbers is given a stream of its own, derived
+// from the root. A Random isn't thread-safe, but since no two consumers share
+// one, none of them need to lock, and the numbers that each consumer sees
+// don't depend on how the threads are scheduled.
+class Random {
+
+public:
+
+    // The consumers of the random numbers of a simulation, each of which
+    // draws from its own stream of the root Random
+    enum Stream : uint64_t {
+        MAZE_GENERATION = 1,
+        MOUSE_ALGORITHM = 2,
+        SENSOR_NOISE = 3,
+    };
+
+    explicit Random(uint64_t seed = 0);
+
+    // A stream that's independent of this one, and of every other stream
+    // derived from this one with a different id. Streams may be derived from
+    // derived streams too, e.g., one per mouse from the MOUSE_ALGORITHM stream.
+    Random getStream(uint64_t id) const;
+
+    // Returns a number in [0, 2^32)
+    uint32_t getUint32();
+
+    // Returns a double in [0.0, 1.0), with 53 random bits (which uses two
+    // 32 bit numbers)
+    double getDouble();
+
+    // Skips over the next count 32 bit numbers, in constant time
+    void skip(uint64_t count);
+
+    // The number of 32 bit numbers that have been used (or skipped) so far
+    uint64_t getPosition() const;
+
+    // The same numbers as count calls to getUint32() or getDouble(),
+    // respectively, but generated many blocks at a time
+    void fill(uint32_t* values, int count);
+    void fill(double* values, int count);
+
+private:
+
+    // The number of blocks that fill() generates at once; the rounds are done
+    // for all of them in lock step, which the compiler can vectorize
+    static const int LANES = 8;
+
+    uint32_t m_key[2];
+    uint64_t m_stream;
+    uint64_t m_position;
+
+    // The block that m_position is in, if it's been generated
+    uint32_t m_block[4];
+    uint64_t m_blockNumber;
+    bool m_hasBlock;
+
+    Random(const uint32_t key[2], uint64_t stream);
+
+    // Generates a single block, without the other lanes that
+    // generateBlocks() always does the rounds for
+    void generateBlock(uint64_t block, uint32_t* values) const;
+
+    // Generates the given number of consecutive blocks, starting at the given
+    // block number, which must be at most LANES
+    void generateBlocks(uint64_t firstBlock, int count, uint32_t* values) const;
+
+    static double toDouble(uint32_t high, uint32_t low);
+
+};
+
+} // namespace sim
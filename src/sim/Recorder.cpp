@@ -0,0 +1,181 @@
+#include "Recorder.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QtEndian>
+
+#include <cmath>
+
+#include "Assert.h"
+#include "Directory.h"
+#include "Param.h"
+#include "RecordingFormat.h"
+#include "SimUtilities.h"
+#include "Time.h"
+
+namespace sim {
+
+Recorder* Recorder::INSTANCE = nullptr;
+
+void Recorder::init(const QString& runId) {
+    SIM_ASSERT_TR(nullptr == INSTANCE);
+    INSTANCE = new Recorder(runId);
+    SimUtilities::addQuitHook([]() {
+        INSTANCE->close();
+    });
+}
+
+Recorder* Recorder::get() {
+    SIM_ASSERT_FA(nullptr == INSTANCE);
+    return INSTANCE;
+}
+
+bool Recorder::isRecording() {
+    return nullptr != INSTANCE && INSTANCE->m_recording.load(std::memory_order_relaxed);
+}
+
+void Recorder::recordCall(const QString& method, const QVector<QVariant>& arguments) {
+
+    if (!isRecording()) {
+        return;
+    }
+
+    // Read the time while holding the lock, so that records are in time order
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_dataFile.isOpen()) {
+        return;
+    }
+    qint64 time = std::llround(
+        Time::get()->elapsedSimTime().getSeconds() * RecordingFormat::TIME_SCALE);
+    QByteArray buffer;
+
+    // Write the name of the method the first time we see it
+    if (!m_methodIds.contains(method)) {
+        m_methodIds.insert(method, m_methodIds.size());
+        appendRecordStart(&buffer, static_cast<unsigned char>(RecordType::NAME), time);
+        RecordingFormat::appendVarint(&buffer, m_methodIds.value(method));
+        RecordingFormat::appendString(&buffer, method);
+    }
+
+    appendRecordStart(&buffer, static_cast<unsigned char>(RecordType::CALL), time);
+    RecordingFormat::appendVarint(&buffer, m_methodIds.value(method));
+    RecordingFormat::appendVarint(&buffer, arguments.size());
+    for (const QVariant& argument : arguments) {
+        RecordingFormat::appendArgument(&buffer, argument);
+    }
+
+    m_dataFile.write(buffer);
+}
+
+void Recorder::recordPose(const Coordinate& translation, const Angle& rotation) {
+
+    if (!isRecording()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_dataFile.isOpen()) {
+        return;
+    }
+    qint64 time = std::llround(
+        Time::get()->elapsedSimTime().getSeconds() * RecordingFormat::TIME_SCALE);
+    qint64 x = std::llround(translation.getX().getMeters() * RecordingFormat::DISTANCE_SCALE);
+    qint64 y = std::llround(translation.getY().getMeters() * RecordingFormat::DISTANCE_SCALE);
+    qint64 rotationValue = std::llround(
+        rotation.getRadiansNotBounded() * RecordingFormat::ANGLE_SCALE);
+    QByteArray buffer;
+
+    // Every so often, write an absolute pose so that playback can start from
+    // that point, and add it to the index so that it can be found quickly
+    bool keyframe =
+        m_posesSinceKeyframe < 0 || P()->recordingKeyframeInterval() <= m_posesSinceKeyframe;
+    if (keyframe) {
+        buffer.append(static_cast<char>(RecordType::KEYFRAME));
+        RecordingFormat::appendFixed(&buffer, time);
+        RecordingFormat::appendFixed(&buffer, x);
+        RecordingFormat::appendFixed(&buffer, y);
+        RecordingFormat::appendFixed(&buffer, rotationValue);
+        m_previousTime = time;
+        m_posesSinceKeyframe = 0;
+    }
+
+    // Otherwise, just write the change in pose
+    else {
+        appendRecordStart(&buffer, static_cast<unsigned char>(RecordType::POSE), time);
+        RecordingFormat::appendVarint(&buffer, x - m_previousX);
+        RecordingFormat::appendVarint(&buffer, y - m_previousY);
+        RecordingFormat::appendVarint(&buffer, rotationValue - m_previousRotation);
+        m_posesSinceKeyframe += 1;
+    }
+
+    m_previousX = x;
+    m_previousY = y;
+    m_previousRotation = rotationValue;
+
+    qint64 offset = m_dataFile.pos();
+    m_dataFile.write(buffer);
+
+    // The keyframe's data is flushed before its index entry is written, so
+    // that the index never points past the data that's on disk
+    if (keyframe) {
+        m_dataFile.flush();
+        uchar entry[RecordingFormat::INDEX_ENTRY_SIZE];
+        qToLittleEndian<qint64>(time, entry);
+        qToLittleEndian<qint64>(offset, entry + 8);
+        m_indexFile.write(reinterpret_cast<const char*>(entry), sizeof(entry));
+        m_indexFile.flush();
+    }
+}
+
+void Recorder::close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_recording = false;
+    m_dataFile.close();
+    m_indexFile.close();
+}
+
+Recorder::Recorder(const QString& runId) :
+        m_recording(false),
+        m_previousTime(0),
+        m_previousX(0),
+        m_previousY(0),
+        m_previousRotation(0),
+        m_posesSinceKeyframe(-1) {
+
+    // Don't record the replay of another run
+    if (!P()->recordRun() || P()->useReplayRun()) {
+        return;
+    }
+
+    QString runDirectory = Directory::get()->getRunDirectory() + runId + "/";
+    if (!QDir().mkpath(runDirectory)) {
+        qWarning()
+            << "Unable to create the directory \"" << runDirectory << "\", and"
+            << " thus the run will not be recorded.";
+        return;
+    }
+
+    m_dataFile.setFileName(runDirectory + RecordingFormat::DATA_FILE_NAME);
+    m_indexFile.setFileName(runDirectory + RecordingFormat::INDEX_FILE_NAME);
+    if (!m_dataFile.open(QIODevice::WriteOnly | QIODevice::Append) ||
+        !m_indexFile.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        qWarning()
+            << "Unable to open the recording files in \"" << runDirectory << "\","
+            << " and thus the run will not be recorded.";
+        m_dataFile.close();
+        m_indexFile.close();
+        return;
+    }
+
+    m_dataFile.write(RecordingFormat::MAGIC);
+    m_dataFile.putChar(static_cast<char>(RecordingFormat::VERSION));
+    m_recording = true;
+}
+
+void Recorder::appendRecordStart(QByteArray* buffer, unsigned char type, qint64 time) {
+    buffer->append(static_cast<char>(type));
+    RecordingFormat::appendVarint(buffer, time - m_previousTime);
+    m_previousTime = time;
+}
+
+} // namespace sim
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <QFile>
+#include <QMap>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+#include <atomic>
+#include <mutex>
+
+#include "units/Angle.h"
+#include "units/Coordinate.h"
+
+namespace sim {
+
+class Recorder {
+
+public:
+
+    // Should only be called once, at start time; if recording is disabled,
+    // the Recorder still exists, but all of the record methods are no-ops
+    static void init(const QString& runId);
+
+    // Retrieve the Recorder singleton
+    static Recorder* get();
+
+    // Whether or not the run is being recorded, which is false if the
+    // Recorder hasn't been initialized; cheap enough to be checked before
+    // building the arguments of a record
+    static bool isRecording();
+
+    // Records a MouseInterface call, its arguments, and the current sim time
+    void recordCall(const QString& method, const QVector<QVariant>& arguments);
+
+    // Records the pose of the mouse at the current sim time
+    void recordPose(const Coordinate& translation, const Angle& rotation);
+
+    // Flushes and closes the recording files, after which nothing more is
+    // recorded; called when the simulation quits
+    void close();
+
+private:
+
+    // A private constructor is used to ensure
+    // only one instance of this class exists
+    Recorder(const QString& runId);
+
+    // A pointer to the actual instance of the class
+    static Recorder* INSTANCE;
+
+    // Set once the recording files have been opened
+    std::atomic<bool> m_recording;
+
+    // Calls and poses come from different threads
+    std::mutex m_mutex;
+
+    // The append-only data and index files (see RecordingFormat.h), which
+    // are flushed at each keyframe, so that little is lost if we're killed
+    QFile m_dataFile;
+    QFile m_indexFile;
+
+    // Ids of the methods whose names have already been written
+    QMap<QString, qint64> m_methodIds;
+
+    // The quantized time of the previous record, and the quantized pose of
+    // the previous pose record, which subsequent records are relative to
+    qint64 m_previousTime;
+    qint64 m_previousX;
+    qint64 m_previousY;
+    qint64 m_previousRotation;
+
+    // The number of pose records written since the most recent keyframe
+    int m_posesSinceKeyframe;
+
+    // Appends the record type and the time delta, and updates m_previousTime
+    void appendRecordStart(QByteArray* buffer, unsigned char type, qint64 time);
+
+};
+
+} // namespace sim
@@ -0,0 +1,164 @@
+#include "RecordingFormat.h"
+
+#include <QtEndian>
+
+#include <cstring>
+
+namespace sim {
+
+const QString RecordingFormat::DATA_FILE_NAME = "recording.bin";
+const QString RecordingFormat::INDEX_FILE_NAME = "recording.idx";
+
+const QByteArray RecordingFormat::MAGIC = "MMSR";
+
+const double RecordingFormat::TIME_SCALE = 1000000.0;
+const double RecordingFormat::DISTANCE_SCALE = 1000000.0;
+const double RecordingFormat::ANGLE_SCALE = 1000000.0;
+
+// The tags that precede each of the call arguments
+static const unsigned char ARGUMENT_INT = 0;
+static const unsigned char ARGUMENT_DOUBLE = 1;
+static const unsigned char ARGUMENT_BOOL = 2;
+static const unsigned char ARGUMENT_CHAR = 3;
+static const unsigned char ARGUMENT_STRING = 4;
+
+void RecordingFormat::appendVarint(QByteArray* buffer, qint64 value) {
+    // Zigzag encode the value, so that small negative values are small too
+    quint64 zigzag = (static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63);
+    while (0x80 <= zigzag) {
+        buffer->append(static_cast<char>((zigzag & 0x7F) | 0x80));
+        zigzag >>= 7;
+    }
+    buffer->append(static_cast<char>(zigzag));
+}
+
+void RecordingFormat::appendFixed(QByteArray* buffer, qint64 value) {
+    uchar bytes[8];
+    qToLittleEndian<qint64>(value, bytes);
+    buffer->append(reinterpret_cast<const char*>(bytes), 8);
+}
+
+void RecordingFormat::appendString(QByteArray* buffer, const QString& value) {
+    QByteArray utf8 = value.toUtf8();
+    appendVarint(buffer, utf8.size());
+    buffer->append(utf8);
+}
+
+void RecordingFormat::appendArgument(QByteArray* buffer, const QVariant& argument) {
+    switch (argument.userType()) {
+        case QMetaType::Int:
+            buffer->append(static_cast<char>(ARGUMENT_INT));
+            appendVarint(buffer, argument.toInt());
+            break;
+        case QMetaType::Double: {
+            double value = argument.toDouble();
+            qint64 bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            buffer->append(static_cast<char>(ARGUMENT_DOUBLE));
+            appendFixed(buffer, bits);
+            break;
+        }
+        case QMetaType::Bool:
+            buffer->append(static_cast<char>(ARGUMENT_BOOL));
+            buffer->append(static_cast<char>(argument.toBool() ? 1 : 0));
+            break;
+        case QMetaType::QChar:
+            buffer->append(static_cast<char>(ARGUMENT_CHAR));
+            buffer->append(argument.toChar().toLatin1());
+            break;
+        default:
+            buffer->append(static_cast<char>(ARGUMENT_STRING));
+            appendString(buffer, argument.toString());
+            break;
+    }
+}
+
+bool RecordingFormat::readVarint(const uchar* data, qint64 size, qint64* offset, qint64* value) {
+    quint64 zigzag = 0;
+    int shift = 0;
+    for (qint64 i = *offset; i < size && shift < 64; i += 1) {
+        zigzag |= static_cast<quint64>(data[i] & 0x7F) << shift;
+        if ((data[i] & 0x80) == 0) {
+            *value = static_cast<qint64>(zigzag >> 1) ^ -static_cast<qint64>(zigzag & 1);
+            *offset = i + 1;
+            return true;
+        }
+        shift += 7;
+    }
+    return false;
+}
+
+bool RecordingFormat::readFixed(const uchar* data, qint64 size, qint64* offset, qint64* value) {
+    if (size < *offset + 8) {
+        return false;
+    }
+    *value = qFromLittleEndian<qint64>(data + *offset);
+    *offset += 8;
+    return true;
+}
+
+bool RecordingFormat::readString(const uchar* data, qint64 size, qint64* offset, QString* value) {
+    qint64 position = *offset;
+    qint64 length = 0;
+    if (!readVarint(data, size, &position, &length) || length < 0 || size < position + length) {
+        return false;
+    }
+    *value = QString::fromUtf8(reinterpret_cast<const char*>(data + position), length);
+    *offset = position + length;
+    return true;
+}
+
+bool RecordingFormat::readArgument(const uchar* data, qint64 size, qint64* offset, QVariant* argument) {
+    if (size <= *offset) {
+        return false;
+    }
+    qint64 position = *offset + 1;
+    switch (data[*offset]) {
+        case ARGUMENT_INT: {
+            qint64 value = 0;
+            if (!readVarint(data, size, &position, &value)) {
+                return false;
+            }
+            *argument = static_cast<int>(value);
+            break;
+        }
+        case ARGUMENT_DOUBLE: {
+            qint64 bits = 0;
+            if (!readFixed(data, size, &position, &bits)) {
+                return false;
+            }
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            *argument = value;
+            break;
+        }
+        case ARGUMENT_BOOL:
+        case ARGUMENT_CHAR: {
+            if (size <= position) {
+                return false;
+            }
+            if (data[*offset] == ARGUMENT_BOOL) {
+                *argument = (data[position] != 0);
+            }
+            else {
+                *argument = QChar::fromLatin1(static_cast<char>(data[position]));
+            }
+            position += 1;
+            break;
+        }
+        case ARGUMENT_STRING: {
+            QString value;
+            if (!readString(data, size, &position, &value)) {
+                return false;
+            }
+            *argument = value;
+            break;
+        }
+        default:
+            return false;
+    }
+    *offset = position;
+    return true;
+}
+
+} // namespace sim
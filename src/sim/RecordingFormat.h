@@ -0,0 +1,73 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QVariant>
+
+namespace sim {
+
+// A recording consists of two append-only files in the run directory:
+//
+// 1) The data file, which begins with MAGIC and VERSION, and is followed by
+//    a sequence of records. Each record begins with a RecordType byte and a
+//    zigzag varint encoding of the sim time (in microseconds) that has passed
+//    since the previous record. KEYFRAME records reset the time base and the
+//    pose to absolute, fixed width values; POSE records hold varint deltas of
+//    the pose relative to the previous pose; CALL records hold a method id and
+//    the arguments of a MouseInterface call; NAME records map a method id to
+//    the name of the method, and always precede the first use of that id.
+//
+// 2) The index file, which is a sequence of fixed width (time, offset) pairs,
+//    one per KEYFRAME record, so that it can be binary searched in place.
+//
+// All multi-byte fixed width values are little endian, so that both files can
+// be memory-mapped and read without any intermediate parsing.
+
+enum class RecordType : unsigned char {
+    KEYFRAME,
+    POSE,
+    CALL,
+    NAME,
+};
+
+class RecordingFormat {
+
+public:
+
+    // The RecordingFormat class is not constructible
+    RecordingFormat() = delete;
+
+    // The names of the files, relative to the directory of the run
+    static const QString DATA_FILE_NAME;
+    static const QString INDEX_FILE_NAME;
+
+    // Identifies the data file, and the version of its layout
+    static const QByteArray MAGIC;
+    static const unsigned char VERSION = 1;
+
+    // The size, in bytes, of the data file header and of a single index entry
+    static const int HEADER_SIZE = 5;
+    static const int INDEX_ENTRY_SIZE = 16;
+
+    // The number of quantized units per second, meter, and radian
+    static const double TIME_SCALE;
+    static const double DISTANCE_SCALE;
+    static const double ANGLE_SCALE;
+
+    // Append values to a buffer
+    static void appendVarint(QByteArray* buffer, qint64 value);
+    static void appendFixed(QByteArray* buffer, qint64 value);
+    static void appendString(QByteArray* buffer, const QString& value);
+    static void appendArgument(QByteArray* buffer, const QVariant& argument);
+
+    // Read values from a buffer, starting at and then advancing the offset;
+    // each returns false (and leaves the offset untouched) if the buffer ends
+    // before the value does, which happens if a recording was cut short
+    static bool readVarint(const uchar* data, qint64 size, qint64* offset, qint64* value);
+    static bool readFixed(const uchar* data, qint64 size, qint64* offset, qint64* value);
+    static bool readString(const uchar* data, qint64 size, qint64* offset, QString* value);
+    static bool readArgument(const uchar* data, qint64 size, qint64* offset, QVariant* argument);
+
+};
+
+} // namespace sim
@@ -0,0 +1,611 @@
+#include "Replayer.h"
+
+#include <QDebug>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cmath>
+
+#include "../mouse/IMouseAlgorithm.h"
+#include "Assert.h"
+#include "Directory.h"
+#include "Param.h"
+#include "RecordingFormat.h"
+#include "SimUtilities.h"
+#include "State.h"
+#include "Time.h"
+#include "units/Meters.h"
+#include "units/Radians.h"
+
+namespace sim {
+
+bool Replayer::TileState::operator==(const TileState& other) const {
+    return
+        color == other.color &&
+        rowsOfText == other.rowsOfText &&
+        declaredWalls == other.declaredWalls &&
+        foggy == other.foggy;
+}
+
+bool Replayer::TileState::operator!=(const TileState& other) const {
+    return !(*this == other);
+}
+
+Replayer::Replayer(
+        const QString& runId,
+        Model* model,
+        MazeGraphic* mazeGraphic,
+        const IMouseAlgorithm* mouseAlgorithm,
+        const StaticMouseAlgorithmOptions& options,
+        const QSet<QChar>& allowableTileTextCharacters) :
+        m_model(model),
+        m_mazeGraphic(mazeGraphic),
+        m_options(options),
+        m_allowableTileTextCharacters(allowableTileTextCharacters),
+        m_declareBothWallHalves(
+            mouseAlgorithm != nullptr && mouseAlgorithm->declareBothWallHalves()),
+        m_declareWallOnRead(
+            mouseAlgorithm != nullptr && mouseAlgorithm->declareWallOnRead()),
+        m_setTileTextWhenDistanceDeclared(
+            mouseAlgorithm != nullptr && mouseAlgorithm->setTileTextWhenDistanceDeclared()),
+        m_setTileBaseColorWhenDistanceDeclaredCorrectly(
+            mouseAlgorithm != nullptr &&
+            mouseAlgorithm->setTileBaseColorWhenDistanceDeclaredCorrectly()),
+        m_data(nullptr),
+        m_index(nullptr),
+        m_dataSize(0),
+        m_indexCount(0),
+        m_duration(0),
+        m_currentTime(0),
+        m_reverse(false) {
+
+    QString runDirectory = Directory::get()->getRunDirectory() + runId + "/";
+    m_dataFile.setFileName(runDirectory + RecordingFormat::DATA_FILE_NAME);
+    m_indexFile.setFileName(runDirectory + RecordingFormat::INDEX_FILE_NAME);
+    if (!m_dataFile.open(QIODevice::ReadOnly) || !m_indexFile.open(QIODevice::ReadOnly)) {
+        qCritical()
+            << "Unable to open the recording of run \"" << runId << "\" in \""
+            << runDirectory << "\".";
+        SimUtilities::quit();
+    }
+
+    // Map both of the files into memory, rather than reading them
+    m_data = m_dataFile.map(0, m_dataFile.size());
+    m_dataSize = m_dataFile.size();
+    if (0 < m_indexFile.size()) {
+        m_index = m_indexFile.map(0, m_indexFile.size());
+    }
+    if (m_data == nullptr ||
+        m_dataSize < RecordingFormat::HEADER_SIZE ||
+        QByteArray(reinterpret_cast<const char*>(m_data), RecordingFormat::MAGIC.size())
+            != RecordingFormat::MAGIC ||
+        m_data[RecordingFormat::MAGIC.size()] != RecordingFormat::VERSION) {
+        qCritical()
+            << "The file \"" << m_dataFile.fileName() << "\" is not a"
+            << " recording, or was recorded by an incompatible version.";
+        SimUtilities::quit();
+    }
+
+    // Every tile starts out as it was before any calls
+    int numberOfTiles = m_model->getMaze()->getWidth() * m_model->getMaze()->getHeight();
+    m_tiles.fill({STRING_TO_COLOR.value(P()->tileBaseColor()), {}, {}, true}, numberOfTiles);
+    m_tileChanged.fill(false, numberOfTiles);
+
+    // Scan the records once, to learn the method names and the duration. If
+    // the run was cut short, the last record may be incomplete, so we only
+    // consider the data up to the end of the last complete record.
+    //
+    // Along the way, the calls are applied, and the tile states are saved at
+    // some of the keyframes, so that seeking only has to apply the calls
+    // since the nearest snapshot. A snapshot is only taken once there have
+    // been at least as many calls as there are tiles since the previous one,
+    // so the snapshots take no more memory than the calls themselves, and
+    // restoring one costs no more than applying those calls would.
+    Cursor cursor = {RecordingFormat::HEADER_SIZE, 0, 0, 0, 0};
+    Record record;
+    m_snapshots.push_back({cursor, m_tiles});
+    int callsSinceSnapshot = 0;
+    while (readRecord(&cursor, &record)) {
+        if (record.type == static_cast<unsigned char>(RecordType::NAME)) {
+            if (m_methodNames.size() <= record.methodId) {
+                m_methodNames.resize(record.methodId + 1);
+            }
+            m_methodNames[record.methodId] = record.name;
+        }
+        else if (record.type == static_cast<unsigned char>(RecordType::CALL)) {
+            applyCall(cursor, record);
+            callsSinceSnapshot += 1;
+        }
+        else if (record.type == static_cast<unsigned char>(RecordType::KEYFRAME) &&
+                numberOfTiles <= callsSinceSnapshot) {
+            m_snapshots.push_back({cursor, m_tiles});
+            callsSinceSnapshot = 0;
+        }
+        m_duration = cursor.time;
+    }
+    m_dataSize = cursor.offset;
+
+    // Likewise, ignore any keyframes that point past the last complete record
+    if (m_index != nullptr) {
+        m_indexCount = m_indexFile.size() / RecordingFormat::INDEX_ENTRY_SIZE;
+        while (0 < m_indexCount && m_dataSize <= qFromLittleEndian<qint64>(
+                m_index + (m_indexCount - 1) * RecordingFormat::INDEX_ENTRY_SIZE + 8)) {
+            m_indexCount -= 1;
+        }
+    }
+
+    // The maze graphic starts out showing the first snapshot
+    m_tiles = m_snapshots.first().tiles;
+    m_shownTiles = m_tiles;
+    for (int index : m_changedTiles) {
+        m_tileChanged[index] = false;
+    }
+    m_changedTiles.clear();
+    m_callCursor = m_snapshots.first().cursor;
+
+    qInfo()
+        << "Replaying run \"" << runId << "\", which is "
+        << SimUtilities::formatSeconds(m_duration / RecordingFormat::TIME_SCALE)
+        << " of sim time long.";
+}
+
+Seconds Replayer::getDuration() {
+    return Seconds(m_duration / RecordingFormat::TIME_SCALE);
+}
+
+Seconds Replayer::getCurrentTime() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return Seconds(m_currentTime / RecordingFormat::TIME_SCALE);
+}
+
+void Replayer::seek(const Duration& time) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    seekImpl(std::llround(time.getSeconds() * RecordingFormat::TIME_SCALE));
+}
+
+void Replayer::step(const Duration& delta, bool forward) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    qint64 microseconds = std::llround(delta.getSeconds() * RecordingFormat::TIME_SCALE);
+    seekImpl(m_currentTime + (forward ? microseconds : -microseconds));
+}
+
+void Replayer::toggleReverse() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_reverse = !m_reverse;
+}
+
+void Replayer::play() {
+
+    // Start from the beginning of the recording
+    seek(Seconds(0));
+
+    while (true) {
+
+        // In order to ensure we're sleeping the correct amount of time, we time
+        // the seek operation and take it into account when we sleep.
+        double start(SimUtilities::getHighResTimestamp());
+
+        // Advance the playback by the amount of sim time in one frame
+        if (!S()->paused()) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            qint64 delta = std::llround(
+                S()->simSpeed() / P()->frameRate() * RecordingFormat::TIME_SCALE);
+            seekImpl(m_currentTime + (m_reverse ? -delta : delta));
+        }
+
+        // Sleep the appropriate amount of time, based on the seek duration
+        double end(SimUtilities::getHighResTimestamp());
+        double duration = end - start;
+        SimUtilities::sleep(Seconds(std::max(0.0, 1.0 / P()->frameRate() - duration)));
+    }
+}
+
+bool Replayer::readRecord(Cursor* cursor, Record* record) const {
+
+    if (m_dataSize <= cursor->offset) {
+        return false;
+    }
+
+    // Decode into a copy, so that an incomplete record leaves the cursor as is
+    Cursor next = *cursor;
+    record->type = m_data[next.offset];
+    next.offset += 1;
+
+    // Keyframes hold absolute values, everything else is relative
+    if (record->type == static_cast<unsigned char>(RecordType::KEYFRAME)) {
+        if (!RecordingFormat::readFixed(m_data, m_dataSize, &next.offset, &next.time) ||
+            !RecordingFormat::readFixed(m_data, m_dataSize, &next.offset, &next.x) ||
+            !RecordingFormat::readFixed(m_data, m_dataSize, &next.offset, &next.y) ||
+            !RecordingFormat::readFixed(m_data, m_dataSize, &next.offset, &next.rotation)) {
+            return false;
+        }
+        *cursor = next;
+        return true;
+    }
+
+    qint64 timeDelta = 0;
+    if (!RecordingFormat::readVarint(m_data, m_dataSize, &next.offset, &timeDelta)) {
+        return false;
+    }
+    next.time += timeDelta;
+
+    if (record->type == static_cast<unsigned char>(RecordType::POSE)) {
+        qint64 dx = 0;
+        qint64 dy = 0;
+        qint64 dr = 0;
+        if (!RecordingFormat::readVarint(m_data, m_dataSize, &next.offset, &dx) ||
+            !RecordingFormat::readVarint(m_data, m_dataSize, &next.offset, &dy) ||
+            !RecordingFormat::readVarint(m_data, m_dataSize, &next.offset, &dr)) {
+            return false;
+        }
+        next.x += dx;
+        next.y += dy;
+        next.rotation += dr;
+    }
+    else if (record->type == static_cast<unsigned char>(RecordType::CALL)) {
+        qint64 count = 0;
+        if (!RecordingFormat::readVarint(m_data, m_dataSize, &next.offset, &record->methodId) ||
+            !RecordingFormat::readVarint(m_data, m_dataSize, &next.offset, &count)) {
+            return false;
+        }
+        record->arguments.clear();
+        for (qint64 i = 0; i < count; i += 1) {
+            QVariant argument;
+            if (!RecordingFormat::readArgument(m_data, m_dataSize, &next.offset, &argument)) {
+                return false;
+            }
+            record->arguments.push_back(argument);
+        }
+    }
+    else if (record->type == static_cast<unsigned char>(RecordType::NAME)) {
+        if (!RecordingFormat::readVarint(m_data, m_dataSize, &next.offset, &record->methodId) ||
+            !RecordingFormat::readString(m_data, m_dataSize, &next.offset, &record->name)) {
+            return false;
+        }
+    }
+    else {
+        return false;
+    }
+
+    *cursor = next;
+    return true;
+}
+
+Replayer::Cursor Replayer::getKeyframeCursor(qint64 time) const {
+
+    // Binary search the index for the last keyframe at or before the time
+    qint64 low = 0;
+    qint64 high = m_indexCount;
+    while (low < high) {
+        qint64 middle = low + (high - low) / 2;
+        qint64 keyframeTime = qFromLittleEndian<qint64>(
+            m_index + middle * RecordingFormat::INDEX_ENTRY_SIZE);
+        if (keyframeTime <= time) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+
+    // If there's no such keyframe, start from the first record
+    if (low == 0) {
+        return {RecordingFormat::HEADER_SIZE, 0, 0, 0, 0};
+    }
+    qint64 offset = qFromLittleEndian<qint64>(
+        m_index + (low - 1) * RecordingFormat::INDEX_ENTRY_SIZE + 8);
+    return {offset, 0, 0, 0, 0};
+}
+
+void Replayer::seekImpl(qint64 time) {
+
+    time = std::max(static_cast<qint64>(0), std::min(m_duration, time));
+
+    // The effects of calls can't be undone one at a time, so seeking
+    // backwards starts from the latest snapshot at or before the time, as
+    // does seeking forwards past it
+    const Snapshot& snapshot = getSnapshot(time);
+    if (time < m_callCursor.time || m_callCursor.offset < snapshot.cursor.offset) {
+        restoreSnapshot(snapshot);
+    }
+    Cursor next = m_callCursor;
+    Record record;
+    while (readRecord(&next, &record) && next.time <= time) {
+        if (record.type == static_cast<unsigned char>(RecordType::CALL)) {
+            applyCall(next, record);
+        }
+        m_callCursor = next;
+    }
+    showTiles();
+
+    // Decode the pose from the nearest keyframe, rather than from the start
+    Cursor poseCursor = getKeyframeCursor(time);
+    next = poseCursor;
+    bool hasPose = false;
+    while (readRecord(&next, &record) && next.time <= time) {
+        if (record.type == static_cast<unsigned char>(RecordType::KEYFRAME) ||
+            record.type == static_cast<unsigned char>(RecordType::POSE)) {
+            hasPose = true;
+        }
+        poseCursor = next;
+    }
+    if (hasPose) {
+        m_model->getMouse()->teleport(
+            Cartesian(
+                Meters(poseCursor.x / RecordingFormat::DISTANCE_SCALE),
+                Meters(poseCursor.y / RecordingFormat::DISTANCE_SCALE)),
+            Radians(poseCursor.rotation / RecordingFormat::ANGLE_SCALE));
+    }
+
+    // Keep the sim time in sync, so that the logs and header make sense
+    Time::get()->setElapsedSimTime(Seconds(time / RecordingFormat::TIME_SCALE));
+    m_currentTime = time;
+}
+
+const Replayer::Snapshot& Replayer::getSnapshot(qint64 time) const {
+    // The first snapshot is at the start, so there's always one at or before
+    auto snapshot = std::upper_bound(m_snapshots.begin(), m_snapshots.end(), time,
+        [](qint64 time, const Snapshot& snapshot) {
+            return time < snapshot.cursor.time;
+        });
+    return *(snapshot - 1);
+}
+
+void Replayer::restoreSnapshot(const Snapshot& snapshot) {
+    m_tiles = snapshot.tiles;
+    for (int index = 0; index < m_tiles.size(); index += 1) {
+        if (!m_tileChanged.at(index) && m_tiles.at(index) != m_shownTiles.at(index)) {
+            m_tileChanged[index] = true;
+            m_changedTiles.push_back(index);
+        }
+    }
+    m_callCursor = snapshot.cursor;
+}
+
+void Replayer::applyCall(const Cursor& cursor, const Record& record) {
+
+    if (m_methodNames.size() <= record.methodId) {
+        return;
+    }
+    const QString& method = m_methodNames.at(record.methodId);
+    const QVector<QVariant>& arguments = record.arguments;
+
+    // Reading a wall may declare it, which depends on the pose at the time
+    // of the read, which the cursor has kept track of
+    if (method.startsWith("wall")) {
+        m_model->getMouse()->teleport(
+            Cartesian(
+                Meters(cursor.x / RecordingFormat::DISTANCE_SCALE),
+                Meters(cursor.y / RecordingFormat::DISTANCE_SCALE)),
+            Radians(cursor.rotation / RecordingFormat::ANGLE_SCALE));
+    }
+
+    // Only the calls that affect the maze graphic are applied; movements are
+    // already captured by the poses, and everything else has no visible effect
+    static const QMap<QString, int> argumentCounts {
+        {"setTileColor", 3},
+        {"clearTileColor", 2},
+        {"clearAllTileColor", 0},
+        {"setTileText", 3},
+        {"clearTileText", 2},
+        {"clearAllTileText", 0},
+        {"declareWall", 4},
+        {"undeclareWall", 3},
+        {"setTileFogginess", 3},
+        {"declareTileDistance", 3},
+        {"undeclareTileDistance", 2},
+        {"wallFront", 0},
+        {"wallRight", 0},
+        {"wallLeft", 0},
+    };
+    if (argumentCounts.value(method, -1) != arguments.size()) {
+        return;
+    }
+
+    // The calls that were rejected when they were made (e.g., for a tile
+    // that doesn't exist) are ignored here, without any warnings
+    Color baseColor = STRING_TO_COLOR.value(P()->tileBaseColor());
+    int x = arguments.isEmpty() ? 0 : arguments.at(0).toInt();
+    int y = arguments.size() < 2 ? 0 : arguments.at(1).toInt();
+    if (method == "setTileColor") {
+        char color = arguments.at(2).toChar().toLatin1();
+        TileState* tile = changeTile(x, y);
+        if (tile != nullptr && CHAR_TO_COLOR.contains(color)) {
+            tile->color = CHAR_TO_COLOR.value(color);
+        }
+    }
+    else if (method == "clearTileColor") {
+        TileState* tile = changeTile(x, y);
+        if (tile != nullptr) {
+            tile->color = baseColor;
+        }
+    }
+    else if (method == "clearAllTileColor") {
+        for (int i = 0; i < m_tiles.size(); i += 1) {
+            if (m_tiles.at(i).color != baseColor) {
+                changeTile(i / m_model->getMaze()->getHeight(),
+                    i % m_model->getMaze()->getHeight())->color = baseColor;
+            }
+        }
+    }
+    else if (method == "setTileText") {
+        TileState* tile = changeTile(x, y);
+        if (tile != nullptr) {
+            tile->rowsOfText = getRowsOfText(arguments.at(2).toString());
+        }
+    }
+    else if (method == "clearTileText") {
+        TileState* tile = changeTile(x, y);
+        if (tile != nullptr) {
+            tile->rowsOfText.clear();
+        }
+    }
+    else if (method == "clearAllTileText") {
+        for (int i = 0; i < m_tiles.size(); i += 1) {
+            if (!m_tiles.at(i).rowsOfText.isEmpty()) {
+                changeTile(i / m_model->getMaze()->getHeight(),
+                    i % m_model->getMaze()->getHeight())->rowsOfText.clear();
+            }
+        }
+    }
+    else if (method == "declareWall" || method == "undeclareWall") {
+        QChar direction = arguments.at(2).toChar();
+        if (m_model->getMaze()->withinMaze(x, y) && CHAR_TO_DIRECTION.contains(direction)) {
+            declareWall(x, y, CHAR_TO_DIRECTION.value(direction),
+                method == "undeclareWall" ? -1 : (arguments.at(3).toBool() ? 1 : 0));
+        }
+    }
+    else if (method == "setTileFogginess") {
+        TileState* tile = changeTile(x, y);
+        if (tile != nullptr) {
+            tile->foggy = arguments.at(2).toBool();
+        }
+    }
+    else if (method == "declareTileDistance") {
+        int distance = arguments.at(2).toInt();
+        TileState* tile = changeTile(x, y);
+        if (tile == nullptr) {
+            return;
+        }
+        if (m_setTileTextWhenDistanceDeclared) {
+            tile->rowsOfText = getRowsOfText(0 <= distance ? QString::number(distance) : "inf");
+        }
+        if (m_setTileBaseColorWhenDistanceDeclaredCorrectly) {
+            int actualDistance = m_model->getMaze()->getTile(x, y)->getDistance();
+            // A negative distance is interpreted to mean infinity
+            if (distance == actualDistance || (distance < 0 && actualDistance < 0)) {
+                tile->color = STRING_TO_COLOR.value(P()->distanceCorrectTileBaseColor());
+            }
+        }
+    }
+    else if (method == "undeclareTileDistance") {
+        TileState* tile = changeTile(x, y);
+        if (tile == nullptr) {
+            return;
+        }
+        if (m_setTileTextWhenDistanceDeclared) {
+            tile->rowsOfText.clear();
+        }
+        if (m_setTileBaseColorWhenDistanceDeclaredCorrectly) {
+            tile->color = baseColor;
+        }
+    }
+    else if (method == "wallFront") {
+        readWall(m_model->getMouse()->getCurrentDiscretizedRotation());
+    }
+    else if (method == "wallRight") {
+        readWall(DIRECTION_ROTATE_RIGHT.value(
+            m_model->getMouse()->getCurrentDiscretizedRotation()));
+    }
+    else if (method == "wallLeft") {
+        readWall(DIRECTION_ROTATE_LEFT.value(
+            m_model->getMouse()->getCurrentDiscretizedRotation()));
+    }
+}
+
+Replayer::TileState* Replayer::changeTile(int x, int y) {
+    if (!m_model->getMaze()->withinMaze(x, y)) {
+        return nullptr;
+    }
+    int index = x * m_model->getMaze()->getHeight() + y;
+    if (!m_tileChanged.at(index)) {
+        m_tileChanged[index] = true;
+        m_changedTiles.push_back(index);
+    }
+    return &m_tiles[index];
+}
+
+void Replayer::declareWall(int x, int y, Direction direction, int wallExists) {
+    if (wallExists < 0) {
+        changeTile(x, y)->declaredWalls.remove(direction);
+    }
+    else {
+        changeTile(x, y)->declaredWalls[direction] = (wallExists == 1);
+    }
+    if (!m_declareBothWallHalves) {
+        return;
+    }
+    static const QMap<Direction, QPair<int, int>> OFFSETS {
+        {Direction::NORTH, { 0,  1}},
+        {Direction::EAST,  { 1,  0}},
+        {Direction::SOUTH, { 0, -1}},
+        {Direction::WEST,  {-1,  0}},
+    };
+    int oppositeX = x + OFFSETS.value(direction).first;
+    int oppositeY = y + OFFSETS.value(direction).second;
+    TileState* opposite = changeTile(oppositeX, oppositeY);
+    if (opposite == nullptr) {
+        return;
+    }
+    Direction oppositeDirection = DIRECTION_OPPOSITE.value(direction);
+    if (wallExists < 0) {
+        opposite->declaredWalls.remove(oppositeDirection);
+    }
+    else {
+        opposite->declaredWalls[oppositeDirection] = (wallExists == 1);
+    }
+}
+
+void Replayer::readWall(Direction direction) {
+    if (!m_declareWallOnRead) {
+        return;
+    }
+    QPair<int, int> position = m_model->getMouse()->getCurrentDiscretizedTranslation();
+    if (!m_model->getMaze()->withinMaze(position.first, position.second)) {
+        return;
+    }
+    bool wallExists = m_model->getMaze()->getTile(position.first, position.second)->isWall(direction);
+    declareWall(position.first, position.second, direction, wallExists ? 1 : 0);
+}
+
+QVector<QString> Replayer::getRowsOfText(const QString& text) const {
+    QVector<QString> rowsOfText;
+    int row = 0;
+    int index = 0;
+    while (row < m_options.tileTextNumberOfRows && index < text.size()) {
+        QString rowOfText;
+        while (index < (row + 1) * m_options.tileTextNumberOfCols && index < text.size()) {
+            QChar c = text.at(index);
+            rowOfText += m_allowableTileTextCharacters.contains(c) ?
+                c : QChar(P()->defaultTileTextCharacter());
+            index += 1;
+        }
+        rowsOfText.push_back(rowOfText);
+        row += 1;
+    }
+    return rowsOfText;
+}
+
+void Replayer::showTiles() {
+    int height = m_model->getMaze()->getHeight();
+    for (int index : m_changedTiles) {
+        const TileState& tile = m_tiles.at(index);
+        TileState& shown = m_shownTiles[index];
+        int x = index / height;
+        int y = index % height;
+        if (tile.color != shown.color) {
+            m_mazeGraphic->setTileColor(x, y, tile.color);
+        }
+        if (tile.rowsOfText != shown.rowsOfText) {
+            m_mazeGraphic->setTileText(x, y, tile.rowsOfText);
+        }
+        if (tile.declaredWalls != shown.declaredWalls) {
+            for (Direction direction : DIRECTIONS) {
+                if (!tile.declaredWalls.contains(direction)) {
+                    m_mazeGraphic->undeclareWall(x, y, direction);
+                }
+                else {
+                    m_mazeGraphic->declareWall(x, y, direction, tile.declaredWalls.value(direction));
+                }
+            }
+        }
+        if (tile.foggy != shown.foggy) {
+            m_mazeGraphic->setTileFogginess(x, y, tile.foggy);
+        }
+        shown = tile;
+        m_tileChanged[index] = false;
+    }
+    m_changedTiles.clear();
+}
+
+} // namespace sim
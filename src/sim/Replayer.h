@@ -0,0 +1,179 @@
+#pragma once
+
+#include <QFile>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+#include <mutex>
+
+#include "Color.h"
+#include "Direction.h"
+#include "MazeGraphic.h"
+#include "Model.h"
+#include "StaticMouseAlgorithmOptions.h"
+#include "units/Duration.h"
+#include "units/Seconds.h"
+
+// Forward declared, just as in MouseInterface.h
+class IMouseAlgorithm;
+
+namespace sim {
+
+class Replayer {
+
+public:
+
+    // Memory-maps the recording of the given run. The effects of the
+    // recorded calls are reproduced on the maze graphic directly, just as the
+    // MouseInterface would have produced them. Some of those effects depend on
+    // the dynamic options of the mouse algorithm that made the calls (e.g.,
+    // whether reading a wall declares it); if there's no mouse algorithm, the
+    // calls only have the effects that don't depend on any option.
+    Replayer(
+        const QString& runId,
+        Model* model,
+        MazeGraphic* mazeGraphic,
+        const IMouseAlgorithm* mouseAlgorithm,
+        const StaticMouseAlgorithmOptions& options,
+        const QSet<QChar>& allowableTileTextCharacters);
+
+    // The sim time of the last record, and the sim time being shown
+    Seconds getDuration();
+    Seconds getCurrentTime();
+
+    // Moves the playback to any sim time, forwards or backwards
+    void seek(const Duration& time);
+    void step(const Duration& delta, bool forward);
+
+    // Toggles between forwards and backwards playback
+    void toggleReverse();
+
+    // Advances the playback, at the current sim speed, until the program exits
+    void play();
+
+private:
+
+    // The state needed to decode a record, since records are relative
+    struct Cursor {
+        qint64 offset;
+        qint64 time;
+        qint64 x;
+        qint64 y;
+        qint64 rotation;
+    };
+
+    // A single decoded record
+    struct Record {
+        unsigned char type;
+        qint64 methodId;
+        QString name;
+        QVector<QVariant> arguments;
+    };
+
+    // What the maze graphic shows of a tile, as set by the recorded calls
+    struct TileState {
+        Color color;
+        QVector<QString> rowsOfText;
+        QMap<Direction, bool> declaredWalls;
+        bool foggy;
+        bool operator==(const TileState& other) const;
+        bool operator!=(const TileState& other) const;
+    };
+
+    // The tile states once every call before the cursor has been applied
+    struct Snapshot {
+        Cursor cursor;
+        QVector<TileState> tiles;
+    };
+
+    Model* m_model;
+    MazeGraphic* m_mazeGraphic;
+    StaticMouseAlgorithmOptions m_options;
+    QSet<QChar> m_allowableTileTextCharacters;
+
+    // The dynamic options of the mouse algorithm, all false if there's none
+    bool m_declareBothWallHalves;
+    bool m_declareWallOnRead;
+    bool m_setTileTextWhenDistanceDeclared;
+    bool m_setTileBaseColorWhenDistanceDeclaredCorrectly;
+
+    // Seek may be called from the graphics thread and the playback thread
+    std::mutex m_mutex;
+
+    // The memory-mapped data and index files (see RecordingFormat.h)
+    QFile m_dataFile;
+    QFile m_indexFile;
+    const uchar* m_data;
+    const uchar* m_index;
+    qint64 m_dataSize;
+    qint64 m_indexCount;
+
+    // The names of the recorded methods, indexed by method id
+    QVector<QString> m_methodNames;
+
+    // The time of the last record, and the time being shown
+    qint64 m_duration;
+    qint64 m_currentTime;
+
+    // The position just past the last call that was applied
+    Cursor m_callCursor;
+
+    // Whether or not the playback is running backwards
+    bool m_reverse;
+
+    // The state of each tile as of the call cursor, the state that the maze
+    // graphic is showing, and the tiles whose states may differ between the
+    // two, which are indexed by x * height + y
+    QVector<TileState> m_tiles;
+    QVector<TileState> m_shownTiles;
+    QVector<int> m_changedTiles;
+    QVector<bool> m_tileChanged;
+
+    // The tile states at the start, and at some of the keyframes, in order
+    QVector<Snapshot> m_snapshots;
+
+    // Reads the record at cursor.offset and advances the cursor, or returns
+    // false if there are no more complete records
+    bool readRecord(Cursor* cursor, Record* record) const;
+
+    // Returns the cursor of the latest keyframe at or before the given time
+    Cursor getKeyframeCursor(qint64 time) const;
+
+    // Implementation of seek, for which m_mutex must already be held
+    void seekImpl(qint64 time);
+
+    // The latest snapshot at or before the given time
+    const Snapshot& getSnapshot(qint64 time) const;
+
+    // Restores the tile states and the call cursor to those of the snapshot
+    void restoreSnapshot(const Snapshot& snapshot);
+
+    // Applies the effects of a recorded call, at the cursor just past it, to
+    // the tile states
+    void applyCall(const Cursor& cursor, const Record& record);
+
+    // The state of the tile, which is marked as changed, or nullptr if
+    // there's no such tile
+    TileState* changeTile(int x, int y);
+
+    // Declares or undeclares (if wallExists is -1) the wall, and its other
+    // half if both halves are declared
+    void declareWall(int x, int y, Direction direction, int wallExists);
+
+    // Reads the wall of the mouse's tile in the given direction, which
+    // declares it if walls are declared on read
+    void readWall(Direction direction);
+
+    // Splits the text into the rows shown on a tile, just as the
+    // MouseInterface does, replacing the characters that can't be shown
+    QVector<QString> getRowsOfText(const QString& text) const;
+
+    // Updates the maze graphic with the tiles whose states have changed
+    void showTiles();
+
+};
+
+} // namespace sim
@@ -0,0 +1,449 @@
+#include "RunArchive.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QtEndian>
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+#include "Assert.h"
+#include "Directory.h"
+#include "Param.h"
+#include "SimUtilities.h"
+
+namespace sim {
+
+namespace {
+
+// The names of the archive's directory and files, and of the locks
+const char ARCHIVE_DIRECTORY_NAME[] = "archive";
+const char ARCHIVE_LOCK_FILE_NAME[] = "archive.lock";
+const char LOCK_SUFFIX[] = ".lock";
+const char PACK_SUFFIX[] = ".pack";
+const char INDEX_SUFFIX[] = ".index";
+
+// Files are compressed a chunk at a time, so that a large recording is never
+// read into memory all at once
+const qint64 CHUNK_SIZE = 1024 * 1024;
+
+// The number of segments that the limits are split into
+const int SEGMENTS_PER_LIMIT = 4;
+
+// The number of suffixes tried when the run id is already taken
+const int MAX_RUN_ID_SUFFIX = 100;
+
+} // namespace
+
+RunArchive* RunArchive::INSTANCE = nullptr;
+
+QString RunArchive::init(const QString& runId) {
+    SIM_ASSERT_TR(nullptr == INSTANCE);
+    INSTANCE = new RunArchive();
+
+    // The lock is taken before the run's directory exists, so that there's
+    // no window in which another simulator could pack (and remove) it. A run
+    // id is only ours if we hold its lock and nothing else has used it yet.
+    if (!QDir().mkpath(Directory::get()->getRunDirectory())) {
+        qCritical()
+            << "Unable to create the directory \""
+            << Directory::get()->getRunDirectory() << "\".";
+        SimUtilities::quit();
+    }
+    for (int suffix = 1; suffix <= MAX_RUN_ID_SUFFIX; suffix += 1) {
+        QString id = suffix == 1 ? runId : runId + "-" + QString::number(suffix);
+        std::unique_ptr<QLockFile> lock = makeLock(getRunLockPath(id));
+        if (!lock->tryLock(0)) {
+            if (lock->error() != QLockFile::LockFailedError) {
+                break;
+            }
+            continue;
+        }
+        if (QDir(Directory::get()->getRunDirectory() + id).exists()) {
+            continue;
+        }
+        INSTANCE->m_runId = id;
+        INSTANCE->m_runLock = std::move(lock);
+        return id;
+    }
+    qCritical()
+        << "Unable to lock the run \"" << runId << "\" in \""
+        << Directory::get()->getRunDirectory() << "\".";
+    SimUtilities::quit();
+    return runId;
+}
+
+RunArchive* RunArchive::get() {
+    SIM_ASSERT_FA(nullptr == INSTANCE);
+    return INSTANCE;
+}
+
+bool RunArchive::extract(const QString& runId) {
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    load(false);
+    if (!m_runIds.contains(runId)) {
+        return false;
+    }
+
+    QString runDirectory = Directory::get()->getRunDirectory() + runId + "/";
+    for (const Segment& segment : m_segments) {
+        QFile pack(getPackPath(segment.name));
+        for (const Entry& entry : segment.entries) {
+            if (entry.runId != runId || entry.path.isEmpty()) {
+                continue;
+            }
+            QString path = runDirectory + entry.path;
+            QFile file(path);
+            if (!QDir().mkpath(QFileInfo(path).absolutePath()) ||
+                !file.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+                (!pack.isOpen() && !pack.open(QIODevice::ReadOnly)) ||
+                !pack.seek(entry.offset)) {
+                qWarning() << "Unable to restore \"" << path << "\" from the archive.";
+                return false;
+            }
+            while (pack.pos() < entry.offset + entry.size) {
+                uchar size[4];
+                QByteArray chunk;
+                if (pack.read(reinterpret_cast<char*>(size), 4) == 4) {
+                    chunk = qUncompress(pack.read(qFromLittleEndian<quint32>(size)));
+                }
+                if (chunk.isEmpty() || file.write(chunk) != chunk.size()) {
+                    qWarning() << "Unable to restore \"" << path << "\" from the archive.";
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+RunArchive::RunArchive() :
+        m_stopping(false) {
+}
+
+void RunArchive::start() {
+
+    // The run being replayed must be restored before the archive is pruned;
+    // if it can't be, the Replayer will complain that it doesn't exist
+    if (P()->useReplayRun() &&
+            !QDir(Directory::get()->getRunDirectory() + P()->replayRun()).exists()) {
+        extract(P()->replayRun());
+    }
+
+    m_thread = std::thread([this]() {
+        maintain();
+    });
+    SimUtilities::addQuitHook([]() {
+        INSTANCE->stop();
+    });
+}
+
+void RunArchive::stop() {
+    m_stopping = true;
+    if (m_thread.joinable() && m_thread.get_id() != std::this_thread::get_id()) {
+        m_thread.join();
+    }
+}
+
+void RunArchive::maintain() {
+
+    // Only one simulator at a time may change the archive; if another one
+    // already is, it'll pack our previous runs too
+    if (!QDir().mkpath(getArchiveDirectory())) {
+        qWarning() << "Unable to create the directory \"" << getArchiveDirectory() << "\".";
+        return;
+    }
+    std::unique_ptr<QLockFile> archiveLock = makeLock(getArchiveDirectory() + ARCHIVE_LOCK_FILE_NAME);
+    if (!archiveLock->tryLock(0)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        load(true);
+    }
+
+    // Run ids are datetimes, so sorting them by name packs the oldest first.
+    // The lock is only held for one run at a time, so that extract() doesn't
+    // have to wait for all of them.
+    QString runDirectory = Directory::get()->getRunDirectory();
+    QStringList runIds = QDir(runDirectory).entryList(
+        QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    for (const QString& runId : runIds) {
+        if (m_stopping) {
+            return;
+        }
+        if (runId == ARCHIVE_DIRECTORY_NAME || runId == m_runId ||
+                (P()->useReplayRun() && runId == P()->replayRun())) {
+            continue;
+        }
+        std::unique_ptr<QLockFile> runLock = makeLock(getRunLockPath(runId));
+        if (!runLock->tryLock(0)) {
+            continue;
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_runIds.contains(runId) || pack(runId)) {
+            runLock->unlock();
+            QDir(runDirectory + runId).removeRecursively();
+        }
+        else {
+            qWarning() << "Unable to archive the run \"" << runId << "\".";
+        }
+    }
+
+    // The locks of runs that have been killed are left behind, and once
+    // their directories are gone, nothing else would ever remove them
+    QStringList lockNames = QDir(runDirectory).entryList(
+        QStringList(QString("*") + LOCK_SUFFIX), QDir::Files);
+    for (const QString& lockName : lockNames) {
+        if (m_stopping) {
+            return;
+        }
+        QString runId = lockName.left(lockName.size() - QString(LOCK_SUFFIX).size());
+        std::unique_ptr<QLockFile> runLock = makeLock(getRunLockPath(runId));
+        if (!QDir(runDirectory + runId).exists() && runLock->tryLock(0)) {
+            runLock->unlock();
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    prune();
+}
+
+void RunArchive::load(bool repair) {
+
+    m_segments.clear();
+    m_runIds.clear();
+
+    QDir archiveDirectory(getArchiveDirectory());
+    QStringList indexNames = archiveDirectory.entryList(
+        QStringList(QString("*") + INDEX_SUFFIX), QDir::Files, QDir::Name);
+    for (const QString& indexName : indexNames) {
+
+        Segment segment;
+        segment.name = indexName.left(indexName.size() - QString(INDEX_SUFFIX).size());
+        segment.numberOfRuns = 0;
+        QFile index(getIndexPath(segment.name));
+        if (!index.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+
+        // Only the entries of complete runs are kept; the data of the runs
+        // is in the same order as the runs, so everything after the last
+        // complete run is garbage
+        QDataStream stream(&index);
+        stream.setVersion(QDataStream::Qt_5_0);
+        QVector<Entry> entries;
+        qint64 indexSize = 0;
+        qint64 packSize = 0;
+        while (!stream.atEnd()) {
+            Entry entry;
+            stream >> entry.runId >> entry.path >> entry.offset >> entry.size;
+            if (stream.status() != QDataStream::Ok) {
+                break;
+            }
+            entries.push_back(entry);
+            if (entry.path.isEmpty()) {
+                segment.entries += entries;
+                segment.numberOfRuns += 1;
+                m_runIds.insert(entry.runId);
+                entries.clear();
+                indexSize = index.pos();
+                packSize = entry.offset;
+            }
+        }
+        index.close();
+
+        if (repair) {
+            if (indexSize < index.size()) {
+                index.resize(indexSize);
+            }
+            QFile pack(getPackPath(segment.name));
+            if (packSize < pack.size()) {
+                pack.resize(packSize);
+            }
+        }
+        segment.bytes = indexSize + packSize;
+        m_segments.push_back(segment);
+    }
+
+    if (repair) {
+        QStringList packNames = archiveDirectory.entryList(
+            QStringList(QString("*") + PACK_SUFFIX), QDir::Files, QDir::Name);
+        for (const QString& packName : packNames) {
+            QString name = packName.left(packName.size() - QString(PACK_SUFFIX).size());
+            if (!indexNames.contains(name + INDEX_SUFFIX)) {
+                QFile::remove(getPackPath(name));
+            }
+        }
+    }
+}
+
+bool RunArchive::pack(const QString& runId) {
+
+    QString runDirectory = Directory::get()->getRunDirectory() + runId + "/";
+    QStringList paths;
+    QDirIterator iterator(runDirectory, QDir::Files | QDir::Hidden, QDirIterator::Subdirectories);
+    while (iterator.hasNext()) {
+        paths << QDir(runDirectory).relativeFilePath(iterator.next());
+    }
+    if (paths.isEmpty()) {
+        return true;
+    }
+    paths.sort();
+
+    // A new segment is only added to the list once its index has been
+    // written, so that a failure never leaves a segment without an index
+    bool newSegment =
+        m_segments.isEmpty() ||
+        getMaxRunsPerSegment() <= m_segments.last().numberOfRuns ||
+        getMaxBytesPerSegment() <= m_segments.last().bytes;
+    Segment segment;
+    if (newSegment) {
+        segment.name = runId;
+        segment.numberOfRuns = 0;
+        segment.bytes = 0;
+    }
+    else {
+        segment = m_segments.last();
+    }
+
+    QFile pack(getPackPath(segment.name));
+    if (!pack.open(QIODevice::WriteOnly | QIODevice::Append)) {
+        return false;
+    }
+    QVector<Entry> entries;
+    for (const QString& path : paths) {
+        Entry entry;
+        if (!appendFile(&pack, runId, path, &entry)) {
+            return false;
+        }
+        entries.push_back(entry);
+    }
+    entries.push_back({runId, QString(), pack.size(), 0});
+    if (!pack.flush()) {
+        return false;
+    }
+
+    // All of the entries are written at once, so that they're (almost always)
+    // either all there or not there at all
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+    for (const Entry& entry : entries) {
+        stream << entry.runId << entry.path << entry.offset << entry.size;
+    }
+    QFile index(getIndexPath(segment.name));
+    if (!index.open(QIODevice::WriteOnly | QIODevice::Append) ||
+        index.write(bytes) != bytes.size() ||
+        !index.flush()) {
+        return false;
+    }
+
+    segment.entries += entries;
+    segment.numberOfRuns += 1;
+    segment.bytes = index.size() + pack.size();
+    if (newSegment) {
+        m_segments.push_back(segment);
+    }
+    else {
+        m_segments.last() = segment;
+    }
+    m_runIds.insert(runId);
+    return true;
+}
+
+bool RunArchive::appendFile(QFile* pack, const QString& runId, const QString& path, Entry* entry) {
+    QFile file(Directory::get()->getRunDirectory() + runId + "/" + path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    entry->runId = runId;
+    entry->path = path;
+    entry->offset = pack->size();
+    while (!file.atEnd()) {
+        QByteArray chunk = qCompress(file.read(CHUNK_SIZE));
+        uchar size[4];
+        qToLittleEndian<quint32>(chunk.size(), size);
+        if (pack->write(reinterpret_cast<const char*>(size), 4) != 4 ||
+            pack->write(chunk) != chunk.size()) {
+            return false;
+        }
+    }
+    entry->size = pack->size() - entry->offset;
+    return true;
+}
+
+void RunArchive::prune() {
+
+    // The current run counts toward the limit on the number of runs
+    int numberOfRuns = 1;
+    qint64 bytes = 0;
+    for (const Segment& segment : m_segments) {
+        numberOfRuns += segment.numberOfRuns;
+        bytes += segment.bytes;
+    }
+
+    // The index is removed first, so that if the pack can't be, it's just
+    // garbage, which is removed the next time the archive is loaded. An
+    // index that's already gone counts as removed.
+    while (1 < m_segments.size() &&
+            (P()->numberOfArchivedRuns() < numberOfRuns || getMaxBytes() < bytes)) {
+        const Segment& oldest = m_segments.first();
+        if (!QFile::remove(getIndexPath(oldest.name)) &&
+                QFile::exists(getIndexPath(oldest.name))) {
+            qWarning() << "Unable to remove \"" << getIndexPath(oldest.name) << "\".";
+            return;
+        }
+        QFile::remove(getPackPath(oldest.name));
+        for (const Entry& entry : oldest.entries) {
+            m_runIds.remove(entry.runId);
+        }
+        numberOfRuns -= oldest.numberOfRuns;
+        bytes -= oldest.bytes;
+        m_segments.removeFirst();
+    }
+}
+
+qint64 RunArchive::getMaxBytes() const {
+    return static_cast<qint64>(P()->archivedRunsMaxMegabytes()) * 1024 * 1024;
+}
+
+int RunArchive::getMaxRunsPerSegment() const {
+    return std::max(1, P()->numberOfArchivedRuns() / SEGMENTS_PER_LIMIT);
+}
+
+qint64 RunArchive::getMaxBytesPerSegment() const {
+    return std::max(static_cast<qint64>(1), getMaxBytes() / SEGMENTS_PER_LIMIT);
+}
+
+QString RunArchive::getArchiveDirectory() {
+    return Directory::get()->getRunDirectory() + ARCHIVE_DIRECTORY_NAME + "/";
+}
+
+QString RunArchive::getRunLockPath(const QString& runId) {
+    return Directory::get()->getRunDirectory() + runId + LOCK_SUFFIX;
+}
+
+QString RunArchive::getPackPath(const QString& name) {
+    return getArchiveDirectory() + name + PACK_SUFFIX;
+}
+
+QString RunArchive::getIndexPath(const QString& name) {
+    return getArchiveDirectory() + name + INDEX_SUFFIX;
+}
+
+std::unique_ptr<QLockFile> RunArchive::makeLock(const QString& path) {
+
+    // A lock is only stale once its process has died, no matter how long
+    // that process has been running
+    std::unique_ptr<QLockFile> lock(new QLockFile(path));
+    lock->setStaleLockTime(std::numeric_limits<int>::max());
+    return lock;
+}
+
+} // namespace sim
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <QFile>
+#include <QLockFile>
+#include <QSet>
+#include <QString>
+#include <QVector>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace sim {
+
+// Every run writes its logs and its recording to a directory of its own in
+// the run/ directory. Rather than keeping thousands of those directories
+// around, the previous runs are packed into an archive in run/archive/, and
+// their directories are removed.
+//
+// The archive is a sequence of segments, each of which is a pair of
+// append-only files, named after the first run packed into the segment:
+//
+// 1) The pack file, which holds the contents of the files of the runs. Each
+//    file is a sequence of chunks, each of which is a little endian 32 bit
+//    size followed by that many bytes of qCompress()ed data.
+//
+// 2) The index file, which is a QDataStream of (run id, path of the file
+//    relative to the run's directory, offset, size) entries, one per file,
+//    followed by an entry with an empty path that marks the run as complete.
+//
+// A run's entries are only appended once the contents of all of its files
+// have been written, and its directory is only removed once its entries have
+// been written, so a run is never lost if the simulator is killed while
+// packing it; the incomplete data and entries are simply ignored, and later
+// truncated. Runs are only ever removed a whole segment (the oldest) at a
+// time, once there are too many runs or bytes.
+//
+// Packing and pruning are done on a background thread, so that they never
+// hold up startup. Many simulators may be running at once; each holds a lock
+// on its own run, in run/, next to the run's directory, so that no other
+// simulator packs it, and only one of them at a time may change the archive.
+class RunArchive {
+
+public:
+
+    // Should only be called once, at start time, before anything creates the
+    // run's directory. Locks the run, and returns its id, which is the given
+    // id, unless another simulator already has a run with that id (e.g., if
+    // they were started in the same second), in which case a suffix is added
+    // to make it unique. Quits if the run can't be locked.
+    static QString init(const QString& runId);
+
+    // Retrieve the RunArchive singleton
+    static RunArchive* get();
+
+    // Should only be called once, after the Param object exists; if a run is
+    // being replayed, and it has been archived, it's restored to its
+    // directory before this returns, and then the background thread is started
+    void start();
+
+    // Stops the background thread, once it's done with the run that it's
+    // packing (if any); called when the simulation quits, so that the thread
+    // isn't still using the files while the process exits
+    void stop();
+
+    // Restores the files of an archived run to its directory; returns false
+    // if the run isn't in the archive or couldn't be restored
+    bool extract(const QString& runId);
+
+private:
+
+    // A private constructor is used to ensure
+    // only one instance of this class exists
+    RunArchive();
+
+    // A pointer to the actual instance of the class
+    static RunArchive* INSTANCE;
+
+    struct Entry {
+        QString runId;
+        QString path;
+        qint64 offset;
+        qint64 size;
+    };
+
+    struct Segment {
+        QString name;
+        QVector<Entry> entries;
+        int numberOfRuns;
+        qint64 bytes;
+    };
+
+    QString m_runId;
+
+    // Held for as long as the simulator is running
+    std::unique_ptr<QLockFile> m_runLock;
+
+    // Packs and prunes, checking whether it's been stopped between runs
+    std::thread m_thread;
+    std::atomic<bool> m_stopping;
+
+    // Guards the segments, which are shared by the background thread and
+    // extract(), along with the ids of the (complete) runs in them
+    std::mutex m_mutex;
+    QVector<Segment> m_segments;
+    QSet<QString> m_runIds;
+
+    // Packs the previous runs, and then removes the oldest segments
+    void maintain();
+
+    // Loads the index of every segment; if repairing, which may only be done
+    // while holding the archive lock, also truncates the data and entries of
+    // incomplete runs, and removes any pack without an index
+    void load(bool repair);
+
+    // Appends the files of the run to the newest segment (or to a new one,
+    // if it's full), and returns whether or not all of them were appended
+    bool pack(const QString& runId);
+    bool appendFile(QFile* pack, const QString& runId, const QString& path, Entry* entry);
+
+    void prune();
+
+    // The limit on the bytes of the whole archive, and the maximum number of
+    // runs and bytes of a single segment, which are small enough that removing
+    // whole segments keeps the archive close to the limits
+    qint64 getMaxBytes() const;
+    int getMaxRunsPerSegment() const;
+    qint64 getMaxBytesPerSegment() const;
+
+    static QString getArchiveDirectory();
+    static QString getRunLockPath(const QString& runId);
+    static QString getPackPath(const QString& name);
+    static QString getIndexPath(const QString& name);
+    static std::unique_ptr<QLockFile> makeLock(const QString& path);
+
+};
+
+} // namespace sim
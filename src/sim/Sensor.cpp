@@ -6,6 +6,7 @@
 #include "CPMath.h"
 #include "GeometryUtilities.h"
 #include "Param.h"
+#include "units/Heading.h"
 #include "units/Polar.h"
 
 namespace sim {
@@ -45,6 +46,10 @@ Sensor::Sensor(
     updateReading(m_initialPosition, m_initialDirection, maze);
 }
 
+Meters Sensor::getRange() const {
+    return m_range;
+}
+
 Cartesian Sensor::getInitialPosition() const {
     return m_initialPosition;
 }
@@ -64,8 +69,9 @@ const Polygon& Sensor::getInitialViewPolygon() const {
 Polygon Sensor::getCurrentViewPolygon(
         const Cartesian& currentPosition,
         const Radians& currentDirection,
-        const Maze& maze) const {
-    return getViewPolygon(currentPosition, currentDirection, maze);
+        const Maze& maze,
+        const WallDistanceField* wallDistanceField) const {
+    return getViewPolygon(currentPosition, currentDirection, maze, wallDistanceField);
 }
 
 double Sensor::read() const {
@@ -75,12 +81,13 @@ double Sensor::read() const {
 void Sensor::updateReading(
         const Cartesian& currentPosition,
         const Radians& currentDirection,
-        const Maze& maze) {
+        const Maze& maze,
+        const WallDistanceField* wallDistanceField) {
 
     m_currentReading = std::max(
         0.0,
         1.0 -
-            getViewPolygon(currentPosition, currentDirection, maze).area() /
+            getViewPolygon(currentPosition, currentDirection, maze, wallDistanceField).area() /
             getInitialViewPolygon().area());
 
     SIM_ASSERT_LE(0.0, m_currentReading);
@@ -90,7 +97,8 @@ void Sensor::updateReading(
 Polygon Sensor::getViewPolygon(
         const Cartesian& currentPosition,
         const Radians& currentDirection,
-        const Maze& maze) const {
+        const Maze& maze,
+        const WallDistanceField* wallDistanceField) const {
 
     // Calling this function causes triangulation of a polygon
 
@@ -99,16 +107,23 @@ Polygon Sensor::getViewPolygon(
 
     QVector<Cartesian> polygon {currentPosition};
 
-    for (double i = -1; i <= 1; i += 2.0 / (P()->numberOfSensorEdgePoints() - 1)) {
+    // Rather than computing the sine and cosine of each ray's direction, start
+    // at one edge of the view and rotate the ray by the same step each time
+    double step = 2.0 / (P()->numberOfSensorEdgePoints() - 1);
+    units::Heading stepRotation(units::Angle(m_halfWidth.getRadiansNotBounded() * step));
+    units::Heading firstDirection(units::Angle(
+        currentDirection.getRadiansNotBounded() - m_halfWidth.getRadiansNotBounded()));
+    units::Length rayX = units::Length(m_range.getMeters()) * firstDirection.getCos();
+    units::Length rayY = units::Length(m_range.getMeters()) * firstDirection.getSin();
+
+    for (double i = -1; i <= 1; i += step) {
+        Cartesian end = currentPosition + Cartesian(Meters(rayX.getValue()), Meters(rayY.getValue()));
         polygon.push_back(
-            GeometryUtilities::castRay(
-                currentPosition,
-                currentPosition + Polar(m_range, currentDirection + (m_halfWidth * i)),
-                maze,
-                halfWallWidth,
-                tileLength
-            )
+            wallDistanceField != nullptr ?
+            wallDistanceField->castRay(currentPosition, end, maze) :
+            GeometryUtilities::castRay(currentPosition, end, maze, halfWallWidth, tileLength)
         );
+        stepRotation.rotate(&rayX, &rayY);
     }
 
     return Polygon(polygon);
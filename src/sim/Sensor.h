@@ -9,6 +9,7 @@
 
 #include "Maze.h"
 #include "Polygon.h"
+#include "WallDistanceField.h"
 
 namespace sim {
 
@@ -24,20 +25,24 @@ public:
         const Angle& direction,
         const Maze& maze);
 
+    Meters getRange() const;
     Cartesian getInitialPosition() const;
     Radians getInitialDirection() const;
     const Polygon& getInitialPolygon() const;
     const Polygon& getInitialViewPolygon() const;
+    // The wall distance field, if given, must have been built for the maze
     Polygon getCurrentViewPolygon(
         const Cartesian& currentPosition,
         const Radians& currentDirection,
-        const Maze& maze) const;
+        const Maze& maze,
+        const WallDistanceField* wallDistanceField = nullptr) const;
 
     double read() const;
     void updateReading(
         const Cartesian& currentPosition,
         const Radians& currentDirection,
-        const Maze& maze);
+        const Maze& maze,
+        const WallDistanceField* wallDistanceField = nullptr);
 
 private:
     Meters m_range;
@@ -53,7 +58,8 @@ private:
     Polygon getViewPolygon(
         const Cartesian& currentPosition,
         const Radians& currentDirection,
-        const Maze& maze) const;
+        const Maze& maze,
+        const WallDistanceField* wallDistanceField) const;
 };
 
 } // namespace sim
@@ -10,11 +10,11 @@
 #include <glut/glut.h>
 #include <iostream>
 #include <iterator>
+#include <mutex>
 #include <sstream>
 #include <QString>
 #include <sys/stat.h>
 #include <thread>
-#include <random>
 
 #ifdef _WIN32
     #include "Windows.h"
@@ -23,29 +23,41 @@
 #endif
 
 #include "Assert.h"
-#include "Directory.h"
 #include "Logging.h"
-#include "Param.h"
 #include "State.h"
 #include "units/Seconds.h"
 
 namespace sim {
 
-void SimUtilities::quit() {
-    // TODO: MACK - make a better API for exiting from each of the threads
-    exit(1);
+namespace {
+
+std::mutex QUIT_HOOKS_MUTEX;
+QVector<std::function<void()>> QUIT_HOOKS;
+
+} // namespace
+
+void SimUtilities::addQuitHook(const std::function<void()>& hook) {
+    std::lock_guard<std::mutex> lock(QUIT_HOOKS_MUTEX);
+    QUIT_HOOKS.push_back(hook);
 }
 
-double SimUtilities::getRandom() {
-    
-    // The '- 1' ensures that the random number is never 1.
-    // This matches the python implementation where random is [0,1).
-    // This is particularly useful if you want to index into array like so
-    // array[std::floor(random * <number of elements>)] without having to check
-    // the condition if this function returns 1.
-    
-    static std::mt19937 generator(P()->randomSeed());
-    return std::abs(static_cast<double>(generator()) - 1) / static_cast<double>(generator.max());
+void SimUtilities::quit() {
+
+    // If many threads quit at once, only the first runs the hooks and exits;
+    // the rest wait for it, since exit() may only be called once
+    static std::once_flag quitting;
+    std::call_once(quitting, []() {
+        QVector<std::function<void()>> hooks;
+        {
+            std::lock_guard<std::mutex> lock(QUIT_HOOKS_MUTEX);
+            hooks = QUIT_HOOKS;
+        }
+        for (int i = hooks.size() - 1; 0 <= i; i -= 1) {
+            hooks.at(i)();
+        }
+        // TODO: MACK - make a better API for exiting from each of the threads
+        exit(1);
+    });
 }
 
 void SimUtilities::sleep(const Duration& duration) {
@@ -207,20 +219,4 @@ QVector<QString> SimUtilities::getDirectoryContents(const QString& path) {
     return contents;
 }
 
-void SimUtilities::removeExcessArchivedRuns() {
-    // Information about each run is stored in the run/ directory. As it turns
-    // out, this information can pile up pretty quickly. We should remove the
-    // oldest stuff so that the run/ directory doesn't get too full.
-    QVector<QString> contents = getDirectoryContents(Directory::get()->getRunDirectory());
-    std::sort(contents.begin(), contents.end());
-    for (int i = 2; i < static_cast<int>(contents.size()) - P()->numberOfArchivedRuns(); i += 1) {
-#ifdef _WIN32
-        // TODO: upforgrabs
-        // Implement a windows version of directory removal
-#else
-        system((QString("rm -rf \"") + contents.at(i) + QString("\"")).toStdString().c_str());
-#endif
-    }
-}
-
 } // namespace sim
@@ -3,6 +3,7 @@
 #include <QPair>
 
 #include <algorithm>
+#include <functional>
 #include <QString>
 #include <QVector>
 
@@ -19,12 +20,14 @@ public:
     // The SimUtilities class is not constructible
     SimUtilities() = delete;
 
+    // Adds a function to be called when the simulation quits, before the
+    // program exits, e.g., to flush files; the hooks are called in the
+    // reverse of the order in which they were added
+    static void addQuitHook(const std::function<void()>& hook);
+
     // Quits the simulation
     static void quit();
 
-    // Returns a double in [0.0, 1.0]
-    static double getRandom();
-
     // Sleeps the current thread for ms milliseconds
     static void sleep(const Duration& duration);
 
@@ -61,9 +64,6 @@ public:
     // Returns a vector of strings of paths of the given directory's contents
     static QVector<QString> getDirectoryContents(const QString& path);
 
-    // Remove oldest runs from the run/ directory if necessary
-    static void removeExcessArchivedRuns();
-
     // A simple pair-comparitor function
     template <class T>
     static bool lessThan(const QPair<T, T>& one, const QPair<T, T>& two) {
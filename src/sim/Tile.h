@@ -1,10 +1,9 @@
 #pragma once
 
-#include <QMap>
-#include <QVector>
+#include <QPair>
 
 #include "Direction.h"
-#include "Polygon.h"
+#include "units/Cartesian.h"
 
 namespace sim {
 
@@ -17,34 +16,41 @@ public:
     int getY() const;
     void setPos(int x, int y);
 
+    // The tiles on the edges of the maze are a bit bigger than the rest, so
+    // each tile needs to know the size of the maze that it's in
+    void setMazeSize(int mazeWidth, int mazeHeight);
+
     bool isWall(Direction direction) const;
     void setWall(Direction direction, bool isWall);
 
     int getDistance() const;
     void setDistance(int distance);
 
-    Polygon getFullPolygon() const;
-    Polygon getInteriorPolygon() const;
-    Polygon getWallPolygon(Direction direction) const;
-    QVector<Polygon> getCornerPolygons() const;
+    // The parts of the tile, all of which are axis-aligned rectangles, given
+    // by their lower left and upper right points. These are derived from the
+    // position of the tile whenever they're asked for, rather than being
+    // stored, so that tiles are small and cheap to construct and copy.
+    QPair<Cartesian, Cartesian> getFullRectangle() const;
+    QPair<Cartesian, Cartesian> getInteriorRectangle() const;
+    QPair<Cartesian, Cartesian> getWallRectangle(Direction direction) const;
 
-    void initPolygons(int mazeWidth, int mazeHeight);
+    // The corners are, in order, the lower left, upper left, upper right, and
+    // lower right corners
+    QPair<Cartesian, Cartesian> getCornerRectangle(int cornerNumber) const;
 
 private:
     int m_x;
     int m_y;
-    QMap<Direction, bool> m_walls;
+    int m_mazeWidth;
+    int m_mazeHeight;
     int m_distance;
 
-    Polygon m_fullPolygon;
-    Polygon m_interiorPolygon;
-    QMap<Direction, Polygon> m_wallPolygons;
-    QVector<Polygon> m_cornerPolygons;
+    // One bit per direction, in the order of the Direction enum
+    unsigned char m_walls;
 
-    void initFullPolygon(int mazeWidth, int mazeHeight);
-    void initInteriorPolygon(int mazeWidth, int mazeHeight);
-    void initWallPolygons(int mazeWWidth, int mazeHeight);
-    void initCornerPolygons(int mazeWWidth, int mazeHeight);
+    // The full and interior rectangles, as the edge coordinates in meters
+    void getFullBounds(double* left, double* bottom, double* right, double* top) const;
+    void getInteriorBounds(double* left, double* bottom, double* right, double* top) const;
 };
 
 } // namespace sim
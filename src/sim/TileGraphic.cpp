@@ -51,56 +51,53 @@ void TileGraphic::setText(const QVector<QString>& rowsOfText) {
     updateText();
 }
 
+Color TileGraphic::getBaseColor() const {
+    return S()->tileColorsVisible() ? m_color : STRING_TO_COLOR.value(P()->tileBaseColor());
+}
+
+double TileGraphic::getFogAlpha() const {
+    return m_foggy && S()->tileFogVisible() ? P()->tileFogAlpha() : 0.0;
+}
+
 void TileGraphic::draw() const {
 
-    // Note that the order in which we call insertIntoGraphicCpuBuffer
-    // determines the order in which the polygons are drawn. Also note that the
-    // *StartingIndex methods in GrahicsUtilities.h depend upon this order.
+    // Each part of the tile has a fixed place in the buffers (see the
+    // *StartingIndex methods in BufferInterface.h), and this only touches the
+    // places of this tile, so many tiles may be drawn at once
+    int x = m_tile->getX();
+    int y = m_tile->getY();
+    QPair<Cartesian, Cartesian> fullRectangle = m_tile->getFullRectangle();
 
     // Draw the base of the tile
-    m_bufferInterface->insertIntoGraphicCpuBuffer(
-        m_tile->getFullPolygon(),
-        S()->tileColorsVisible() ? m_color : STRING_TO_COLOR.value(P()->tileBaseColor()),
-        1.0);
+    m_bufferInterface->drawTileGraphicBase(x, y, fullRectangle, getBaseColor());
 
     // Draw each of the walls of the tile
     for (Direction direction : DIRECTIONS) {
         QPair<Color, float> colorAndAlpha = deduceWallColorAndAlpha(direction);
-        m_bufferInterface->insertIntoGraphicCpuBuffer(
-            m_tile->getWallPolygon(direction),
+        m_bufferInterface->drawTileGraphicWall(x, y, direction,
+            m_tile->getWallRectangle(direction),
             colorAndAlpha.first,
             colorAndAlpha.second);
     }
 
     // Draw the corners of the tile
-    for (Polygon polygon : m_tile->getCornerPolygons()) {
-        m_bufferInterface->insertIntoGraphicCpuBuffer(
-            polygon,
-            STRING_TO_COLOR.value(P()->tileCornerColor()),
-            1.0);
+    for (int i = 0; i < 4; i += 1) {
+        m_bufferInterface->drawTileGraphicCorner(x, y, i,
+            m_tile->getCornerRectangle(i),
+            STRING_TO_COLOR.value(P()->tileCornerColor()));
     }
 
     // Draw the fog
-    m_bufferInterface->insertIntoGraphicCpuBuffer(
-        m_tile->getFullPolygon(),
+    m_bufferInterface->drawTileGraphicFog(x, y, fullRectangle,
         STRING_TO_COLOR.value(P()->tileFogColor()),
-        m_foggy && S()->tileFogVisible() ? P()->tileFogAlpha() : 0.0);
-
+        getFogAlpha());
 
-    // Insert all of the triangle texture objects into the buffer ...
-    QPair<int, int> maxRowsAndCols = m_bufferInterface->getTileGraphicTextMaxSize();
-    for (int row = 0; row < maxRowsAndCols.first; row += 1) {
-        for (int col = 0; col < maxRowsAndCols.second; col += 1) {
-            m_bufferInterface->insertIntoTextureCpuBuffer();
-        }
-    }
-    // ... and then populate those triangle texture objects with data
+    // Populate the tile's triangle texture objects with data
     updateText();
 }
 
 void TileGraphic::updateColor() const {
-    m_bufferInterface->updateTileGraphicBaseColor(m_tile->getX(), m_tile->getY(),
-        S()->tileColorsVisible() ? m_color : STRING_TO_COLOR.value(P()->tileBaseColor()));
+    m_bufferInterface->updateTileGraphicBaseColor(m_tile->getX(), m_tile->getY(), getBaseColor());
 }
 
 void TileGraphic::updateWalls() const {
@@ -110,8 +107,7 @@ void TileGraphic::updateWalls() const {
 }
 
 void TileGraphic::updateFog() const {
-    m_bufferInterface->updateTileGraphicFog(m_tile->getX(), m_tile->getY(),
-        m_foggy && S()->tileFogVisible() ? P()->tileFogAlpha() : 0.0);
+    m_bufferInterface->updateTileGraphicFog(m_tile->getX(), m_tile->getY(), getFogAlpha());
 }
 
 void TileGraphic::updateText() const {
@@ -24,6 +24,12 @@ public:
     void setFogginess(bool foggy);
     void setText(const QVector<QString>& rowsOfText);
 
+    // The base color, wall colors and alphas, and fog alpha of the tile, as
+    // they're currently drawn
+    Color getBaseColor() const;
+    QPair<Color, float> deduceWallColorAndAlpha(Direction direction) const;
+    double getFogAlpha() const;
+
     void draw() const;
     void updateColor() const;
     void updateWalls() const;
@@ -40,7 +46,6 @@ private:
     QVector<QString> m_rowsOfText;
 
     void updateWall(Direction direction) const;
-    QPair<Color, float> deduceWallColorAndAlpha(Direction direction) const;
 };
 
 } // namespace sim
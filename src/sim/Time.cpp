@@ -33,6 +33,10 @@ void Time::incrementElapsedSimTime(const Duration& duration) {
     m_elapsedSimTime += duration;
 }
 
+void Time::setElapsedSimTime(const Duration& duration) {
+    m_elapsedSimTime = Seconds(duration);
+}
+
 Time::Time() :
     m_startTimestamp(Seconds(SimUtilities::getHighResTimestamp())),
     m_elapsedSimTime(Seconds(0)) {
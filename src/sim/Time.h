@@ -17,6 +17,9 @@ public:
 
     void incrementElapsedSimTime(const Duration& duration);
 
+    // Jumps to an arbitrary sim time, e.g., when seeking through a replay
+    void setElapsedSimTime(const Duration& duration);
+
 private:
 
     // A private constructor is used to ensure
@@ -3,12 +3,11 @@
 #include <algorithm>
 #include <QPair>
 
-#include "Assert.h"
 #include "CPMath.h"
 
 namespace sim {
 
-QVector<float> TransformationMatrix::getFullMapTransformationMatrix(
+Matrix4 TransformationMatrix::getFullMapTransformationMatrix(
         const Distance& wallWidth,
         QPair<double, double> physicalMazeSize,
         QPair<int, int> fullMapPosition,
@@ -41,12 +40,8 @@ QVector<float> TransformationMatrix::getFullMapTransformationMatrix(
     //                                 |       |
     //                                 X-------+---
     //
-    QVector<float> initialTranslationMatrix = {
-        1.0, 0.0, 0.0, static_cast<float>(0.5 * wallWidth.getMeters()),
-        0.0, 1.0, 0.0, static_cast<float>(0.5 * wallWidth.getMeters()),
-        0.0, 0.0, 1.0,                                             0.0,
-        0.0, 0.0, 0.0,                                             1.0,
-    };
+    Matrix4 initialTranslationMatrix = Matrix4::translation(
+        0.5 * wallWidth.getMeters(), 0.5 * wallWidth.getMeters());
 
     // Ensure that the maze width and height always appear equally scaled.
     double physicalWidth = physicalMazeSize.first;
@@ -69,12 +64,7 @@ QVector<float> TransformationMatrix::getFullMapTransformationMatrix(
     double horizontalScaling = openGlWidth / physicalWidth;
     double verticalScaling = openGlHeight / physicalHeight;
 
-    QVector<float> scalingMatrix = {
-        static_cast<float>(horizontalScaling),                                 0.0, 0.0, 0.0,
-                                          0.0, static_cast<float>(verticalScaling), 0.0, 0.0,
-                                          0.0,                                 0.0, 1.0, 0.0,
-                                          0.0,                                 0.0, 0.0, 1.0,
-    };
+    Matrix4 scalingMatrix = Matrix4::scaling(horizontalScaling, verticalScaling);
     
     // Step 3: Construct the translation matrix. Note that here we ensure that
     // the maze is centered within the map boundaries.
@@ -82,22 +72,14 @@ QVector<float> TransformationMatrix::getFullMapTransformationMatrix(
     double pixelLowerLeftCornerY = fullMapPosition.second + 0.5 * (fullMapSize.second - pixelHeight);
     QPair<double, double> openGlLowerLeftCorner =
         mapPixelCoordinateToOpenGlCoordinate({pixelLowerLeftCornerX, pixelLowerLeftCornerY}, windowSize);
-    QVector<float> translationMatrix = {
-        1.0, 0.0, 0.0,  static_cast<float>(openGlLowerLeftCorner.first),
-        0.0, 1.0, 0.0, static_cast<float>(openGlLowerLeftCorner.second),
-        0.0, 0.0, 1.0,                                              0.0,
-        0.0, 0.0, 0.0,                                              1.0,
-    };
+    Matrix4 translationMatrix = Matrix4::translation(
+        openGlLowerLeftCorner.first, openGlLowerLeftCorner.second);
 
     // Step 4: Compose the matrices
-    QVector<float> transformationMatrix =
-        multiply4x4Matrices(translationMatrix,
-        multiply4x4Matrices(scalingMatrix,
-                            initialTranslationMatrix));
-    return transformationMatrix;
+    return translationMatrix * scalingMatrix * initialTranslationMatrix;
 }
 
-QVector<float> TransformationMatrix::getZoomedMapTransformationMatrix(
+Matrix4 TransformationMatrix::getZoomedMapTransformationMatrix(
     QPair<double, double> physicalMazeSize,
     QPair<int, int> zoomedMapPosition,
     QPair<int, int> zoomedMapSize,
@@ -136,12 +118,7 @@ QVector<float> TransformationMatrix::getZoomedMapTransformationMatrix(
     double horizontalScaling = openGlWidth / physicalWidth;
     double verticalScaling = openGlHeight / physicalHeight;
 
-    QVector<float> scalingMatrix = {
-        static_cast<float>(horizontalScaling),                                 0.0, 0.0, 0.0,
-                                          0.0, static_cast<float>(verticalScaling), 0.0, 0.0,
-                                          0.0,                                 0.0, 1.0, 0.0,
-                                          0.0,                                 0.0, 0.0, 1.0,
-    };
+    Matrix4 scalingMatrix = Matrix4::scaling(horizontalScaling, verticalScaling);
 
     // Step 2: Construct the translation matrix. We must ensure that the mouse
     // starts (static translation) and stays (dynamic translation) at the
@@ -169,12 +146,7 @@ QVector<float> TransformationMatrix::getZoomedMapTransformationMatrix(
     // Combine the transalations and form the translation matrix
     double horizontalTranslation = staticTranslation.first -  dynamicTranslation.first + openGlOrigin.first;
     double verticalTranslation = staticTranslation.second - dynamicTranslation.second + openGlOrigin.second;
-    QVector<float> translationMatrix = {
-        1.0, 0.0, 0.0, static_cast<float>(horizontalTranslation), 
-        0.0, 1.0, 0.0,   static_cast<float>(verticalTranslation),
-        0.0, 0.0, 1.0,                                       0.0,
-        0.0, 0.0, 0.0,                                       1.0,
-    };
+    Matrix4 translationMatrix = Matrix4::translation(horizontalTranslation, verticalTranslation);
 
     // Step 3: Construct a few other transformation matrices needed for
     // rotating the maze. In order to properly rotate the maze, we must first
@@ -184,46 +156,26 @@ QVector<float> TransformationMatrix::getZoomedMapTransformationMatrix(
 
     // We subtract Degrees(90) here since we want forward to face NORTH
     double theta = (Degrees(currentMouseRotation) - Degrees(90)).getRadiansZeroTo2pi();
-    QVector<float> rotationMatrix = {
-        static_cast<float>( std::cos(theta)), static_cast<float>(std::sin(theta)), 0.0, 0.0,
-        static_cast<float>(-std::sin(theta)), static_cast<float>(std::cos(theta)), 0.0, 0.0,
-                                    0.0,                            0.0, 1.0, 0.0,
-                                    0.0,                            0.0, 0.0, 1.0,
-    };
-
-    QVector<float> inverseScalingMatrix = {
-        static_cast<float>(1.0/horizontalScaling),                                     0.0, 0.0, 0.0,
-                                              0.0, static_cast<float>(1.0/verticalScaling), 0.0, 0.0,
-                                              0.0,                                     0.0, 1.0, 0.0,
-                                              0.0,                                     0.0, 0.0, 1.0,
-    };
+    Matrix4 rotationMatrix = Matrix4::rotation(theta);
+    Matrix4 inverseScalingMatrix = Matrix4::scaling(1.0/horizontalScaling, 1.0/verticalScaling);
 
     QPair<double, double> zoomedMapCenterOpenGl =
         mapPixelCoordinateToOpenGlCoordinate({zoomedMapCenterXPixels, zoomedMapCenterYPixels}, windowSize);
 
-    QVector<float> translateToOriginMatrix = {
-        1.0, 0.0, 0.0,  static_cast<float>(zoomedMapCenterOpenGl.first),
-        0.0, 1.0, 0.0, static_cast<float>(zoomedMapCenterOpenGl.second),
-        0.0, 0.0, 1.0,                                              0.0,
-        0.0, 0.0, 0.0,                                              1.0,
-    };
-
-    QVector<float> inverseTranslateToOriginMatrix = {
-        1.0, 0.0, 0.0,  static_cast<float>(-zoomedMapCenterOpenGl.first),
-        0.0, 1.0, 0.0, static_cast<float>(-zoomedMapCenterOpenGl.second),
-        0.0, 0.0, 1.0,                                               0.0,
-        0.0, 0.0, 0.0,                                               1.0,
-    };
+    Matrix4 translateToOriginMatrix = Matrix4::translation(
+        zoomedMapCenterOpenGl.first, zoomedMapCenterOpenGl.second);
+    Matrix4 inverseTranslateToOriginMatrix = Matrix4::translation(
+        -zoomedMapCenterOpenGl.first, -zoomedMapCenterOpenGl.second);
 
-    QVector<float> zoomedMapCameraMatrix = multiply4x4Matrices(translationMatrix, scalingMatrix);
+    Matrix4 zoomedMapCameraMatrix = translationMatrix * scalingMatrix;
     if (rotateZoomedMap) {
         zoomedMapCameraMatrix =
-            multiply4x4Matrices(translateToOriginMatrix,
-            multiply4x4Matrices(scalingMatrix,
-            multiply4x4Matrices(rotationMatrix,
-            multiply4x4Matrices(inverseScalingMatrix,
-            multiply4x4Matrices(inverseTranslateToOriginMatrix,
-                                zoomedMapCameraMatrix)))));
+            translateToOriginMatrix *
+            (scalingMatrix *
+            (rotationMatrix *
+            (inverseScalingMatrix *
+            (inverseTranslateToOriginMatrix *
+             zoomedMapCameraMatrix))));
     }
 
     return zoomedMapCameraMatrix;
@@ -238,23 +190,4 @@ QPair<double, double> TransformationMatrix::mapPixelCoordinateToOpenGlCoordinate
     };
 }
 
-QVector<float> TransformationMatrix::multiply4x4Matrices(
-        QVector<float> left,
-        QVector<float> right) {
-    SIM_ASSERT_EQ(left.size(), 16);
-    SIM_ASSERT_EQ(right.size(), 16);
-    QVector<float> result;
-    for (int i = 0; i < 4; i++) {
-        for (int j = 0; j < 4; j++) {
-            double value = 0.0;
-            for (int k = 0; k < 4; k++) {
-                value += left.at(4*i+k) * right.at(4*k+j);
-            }
-            result.push_back(value);
-        }
-    }
-    SIM_ASSERT_EQ(result.size(), 16);
-    return result;
-}
-
 } // namespace sim
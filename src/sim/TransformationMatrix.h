@@ -1,8 +1,8 @@
 #pragma once
 
 #include <QPair>
-#include <QVector>
 
+#include "Matrix4.h"
 #include "units/Cartesian.h"
 #include "units/Degrees.h"
 
@@ -16,7 +16,7 @@ public:
     TransformationMatrix() = delete;
 
     // Retrieve the 4x4 transformation matrix for the full map
-    static QVector<float> getFullMapTransformationMatrix(
+    static Matrix4 getFullMapTransformationMatrix(
         const Distance& wallWidth,
         QPair<double, double> physicalMazeSize,
         QPair<int, int> fullMapPosition,
@@ -24,7 +24,7 @@ public:
         QPair<int, int> windowSize);
 
     // Retrieve the 4x4 transformation matrices for zoomed map
-    static QVector<float> getZoomedMapTransformationMatrix(
+    static Matrix4 getZoomedMapTransformationMatrix(
         QPair<double, double> physicalMazeSize,
         QPair<int, int> zoomedMapPosition,
         QPair<int, int> zoomedMapSize,
@@ -44,11 +44,6 @@ private:
         QPair<double, double> coordinate,
         QPair<int, int> windowSize);
 
-    // Multiplies two 4x4 matrices together
-    static QVector<float> multiply4x4Matrices(
-        QVector<float> left,
-        QVector<float> right);
-
 };
 
 } // namespace sim
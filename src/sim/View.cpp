@@ -5,12 +5,16 @@
 #include <QDebug>
 #include <QPair>
 
+#include <algorithm>
+#include <cmath>
+
 #include "../mouse/IMouseAlgorithm.h"
 #include "BufferInterface.h"
 #include "Directory.h"
 #include "Layout.h"
 #include "Logging.h"
 #include "Param.h"
+#include "Replayer.h"
 #include "SimUtilities.h"
 #include "State.h"
 #include "TransformationMatrix.h"
@@ -18,20 +22,34 @@
 
 namespace sim {
 
-View::View(Model* model, int argc, char* argv[], const GlutFunctions& functions) : m_model(model) {
+View::View(Model* model, int argc, char* argv[], const GlutFunctions& functions) :
+        m_model(model),
+        m_frameScheduler(P()->frameRate(), P()->idleFrameRate()),
+        m_frameTimer(functions.frameTimer),
+        m_frameTimerChain(0),
+        m_replayer(nullptr),
+        m_polygonVertexBufferObjectCapacity(0) {
+
+    // NaN is never equal to anything, so the first frame computes the matrices
+    m_fullMapMatrixKey.fill(NAN);
+    m_zoomedMapMatrixKey.fill(NAN);
 
     m_bufferInterface = new BufferInterface(
         {m_model->getMaze()->getWidth(), m_model->getMaze()->getHeight()},
+        P()->mazeChunkSize(),
         &m_graphicCpuBuffer,
         &m_textureCpuBuffer
     );
 
     m_mazeGraphic = new MazeGraphic(model->getMaze(), m_bufferInterface);
-    m_mouseGraphic = new MouseGraphic(model->getMouse(), m_bufferInterface);
+    for (int i = 0; i < model->getNumberOfMice(); i += 1) {
+        m_mouseGraphics.push_back(new MouseGraphic(model->getMouse(i), m_bufferInterface));
+    }
 
     initGraphics(argc, argv, functions);
     initPolygonProgram();
     initTextureProgram();
+    initOverview();
 
     m_screenPixelsPerMeter = glutGet(GLUT_SCREEN_WIDTH) / (glutGet(GLUT_SCREEN_WIDTH_MM) / 1000.0);
     m_fontImageMap = getFontImageMap();
@@ -43,7 +61,11 @@ MazeGraphic* View::getMazeGraphic() {
 }
 
 MouseGraphic* View::getMouseGraphic() {
-    return m_mouseGraphic;
+    return getMouseGraphic(0);
+}
+
+MouseGraphic* View::getMouseGraphic(int index) {
+    return m_mouseGraphics.at(index);
 }
 
 void View::setMouseAlgorithmAndOptions(
@@ -54,10 +76,13 @@ void View::setMouseAlgorithmAndOptions(
     m_header->setMouseAlgorithmAndOptions(mouseAlgorithm, options);
 }
 
+void View::setReplayer(Replayer* replayer) {
+    m_replayer = replayer;
+}
+
 void View::refresh() {
 
-    // In order to ensure we're sleeping the correct amount of time, we time
-    // the drawing operation and take it into account when we sleep.
+    // Time the drawing operation, so that we can tell when a frame is late
     double start(SimUtilities::getHighResTimestamp());
 
     // First, clear fog as necessary
@@ -76,31 +101,149 @@ void View::refresh() {
     // Determine the starting index of the mouse
     static const int mouseTrianglesStartingIndex = m_graphicCpuBuffer.size();
 
-    // Get the current mouse translation and rotation
+    // Get the current mouse translation and rotation; the zoomed map follows
+    // the first mouse
     Cartesian currentMouseTranslation = m_model->getMouse()->getCurrentTranslation();
     Radians currentMouseRotation = m_model->getMouse()->getCurrentRotation();
 
-    // Make space for mouse updates and fill the CPU buffer with new mouse triangles
+    // Make space for mouse updates and fill the CPU buffer with new mouse
+    // triangles. The mice are all drawn into the same part of the buffer, after
+    // the maze, so that they're drawn with a single call. The first mouse is
+    // drawn last, so that it's on top.
     m_graphicCpuBuffer.erase(
         m_graphicCpuBuffer.begin() + mouseTrianglesStartingIndex,
         m_graphicCpuBuffer.end());
+    for (int i = m_mouseGraphics.size() - 1; 0 < i; i -= 1) {
+        Mouse* mouse = m_model->getMouse(i);
+        getMouseGraphic(i)->draw(mouse->getCurrentTranslation(), mouse->getCurrentRotation());
+    }
     getMouseGraphic()->draw(currentMouseTranslation, currentMouseRotation);
 
+    // Remember where the mice were drawn, so that ticks can tell if they move
+    m_drawnMousePoses.resize(3 * m_model->getNumberOfMice());
+    for (int i = 0; i < m_model->getNumberOfMice(); i += 1) {
+        Mouse* mouse = m_model->getMouse(i);
+        m_drawnMousePoses[3 * i + 0] = mouse->getCurrentTranslation().getX().getMeters();
+        m_drawnMousePoses[3 * i + 1] = mouse->getCurrentTranslation().getY().getMeters();
+        m_drawnMousePoses[3 * i + 2] = mouse->getCurrentRotation().getRadiansNotBounded();
+    }
+
+    // Get the sizes and positions of each of the maps
+    QPair<int, int> fullMapPosition = Layout::getFullMapPosition(
+        m_windowWidth, m_windowHeight, m_header->getHeight(), P()->windowBorderWidth(), S()->layoutType());
+    QPair<int, int> fullMapSize = Layout::getFullMapSize(
+        m_windowWidth, m_windowHeight, m_header->getHeight(), P()->windowBorderWidth(), S()->layoutType());
+    QPair<int, int> zoomedMapPosition = Layout::getZoomedMapPosition(
+        m_windowWidth, m_windowHeight, m_header->getHeight(), P()->windowBorderWidth(), S()->layoutType());
+    QPair<int, int> zoomedMapSize = Layout::getZoomedMapSize(
+        m_windowWidth, m_windowHeight, m_header->getHeight(), P()->windowBorderWidth(), S()->layoutType());
+
+    // Get the physical size of the maze (in meters)
+    double tileLength = P()->wallWidth() + P()->wallLength();
+    double physicalMazeWidth = P()->wallWidth() + m_model->getMaze()->getWidth() * tileLength;
+    double physicalMazeHeight = P()->wallWidth() + m_model->getMaze()->getHeight() * tileLength;
+    QPair<double, double> physicalMazeSize = {physicalMazeWidth, physicalMazeHeight};
+
+    // The full map shows every chunk of the maze, whereas the zoomed map only
+    // shows those near the mouse. Since the zoomed map may be rotated, any
+    // part of the maze within half of its diagonal of the mouse may be seen.
+    const MazeChunks& chunks = m_bufferInterface->getChunks();
+    QVector<int> fullMapChunks = chunks.getChunksIntersecting(
+        0, 0, m_model->getMaze()->getWidth() - 1, m_model->getMaze()->getHeight() - 1);
+    double zoomedMapPixelsPerMeter = m_screenPixelsPerMeter * S()->zoomedMapScale();
+    double zoomedMapRadius =
+        0.5 * std::hypot(zoomedMapSize.first, zoomedMapSize.second) / zoomedMapPixelsPerMeter;
+    double mouseX = currentMouseTranslation.getX().getMeters();
+    double mouseY = currentMouseTranslation.getY().getMeters();
+    QVector<int> zoomedMapChunks = chunks.getChunksIntersecting(
+        static_cast<int>(std::floor((mouseX - zoomedMapRadius) / tileLength)),
+        static_cast<int>(std::floor((mouseY - zoomedMapRadius) / tileLength)),
+        static_cast<int>(std::floor((mouseX + zoomedMapRadius) / tileLength)),
+        static_cast<int>(std::floor((mouseY + zoomedMapRadius) / tileLength)));
+
+    // Draw the tiles of a map if they're big enough to make out, and if all
+    // of its chunks fit in the buffers at once; otherwise, draw the overview.
+    // The zoomed map never shows a chunk that the full map doesn't.
+    double fullMapPixelsPerMeter = std::min(
+        fullMapSize.first / physicalMazeWidth, fullMapSize.second / physicalMazeHeight);
+    bool fullMapDetailed =
+        P()->minDetailedTilePixels() <= fullMapPixelsPerMeter * tileLength &&
+        m_mazeGraphic->stream(fullMapChunks);
+    bool zoomedMapDetailed =
+        P()->minDetailedTilePixels() <= zoomedMapPixelsPerMeter * tileLength &&
+        (fullMapDetailed || m_mazeGraphic->stream(zoomedMapChunks));
+    if (!fullMapDetailed || !zoomedMapDetailed) {
+        updateOverviewTexture();
+    }
+
+    // Each map's matrix is shared by all of the map's draw calls
+    std::array<double, 9> fullMapMatrixKey = {{
+        P()->wallWidth(),
+        physicalMazeWidth,
+        physicalMazeHeight,
+        static_cast<double>(fullMapPosition.first),
+        static_cast<double>(fullMapPosition.second),
+        static_cast<double>(fullMapSize.first),
+        static_cast<double>(fullMapSize.second),
+        static_cast<double>(m_windowWidth),
+        static_cast<double>(m_windowHeight),
+    }};
+    if (fullMapMatrixKey != m_fullMapMatrixKey) {
+        m_fullMapMatrix = TransformationMatrix::getFullMapTransformationMatrix(
+            Meters(P()->wallWidth()),
+            physicalMazeSize,
+            fullMapPosition,
+            fullMapSize,
+            {m_windowWidth, m_windowHeight});
+        m_fullMapMatrixKey = fullMapMatrixKey;
+    }
+    Cartesian initialMouseTranslation = m_model->getMouse()->getInitialTranslation();
+    std::array<double, 16> zoomedMapMatrixKey = {{
+        physicalMazeWidth,
+        physicalMazeHeight,
+        static_cast<double>(zoomedMapPosition.first),
+        static_cast<double>(zoomedMapPosition.second),
+        static_cast<double>(zoomedMapSize.first),
+        static_cast<double>(zoomedMapSize.second),
+        static_cast<double>(m_windowWidth),
+        static_cast<double>(m_windowHeight),
+        m_screenPixelsPerMeter,
+        S()->zoomedMapScale(),
+        S()->rotateZoomedMap() ? 1.0 : 0.0,
+        initialMouseTranslation.getX().getMeters(),
+        initialMouseTranslation.getY().getMeters(),
+        mouseX,
+        mouseY,
+        currentMouseRotation.getRadiansNotBounded(),
+    }};
+    if (zoomedMapMatrixKey != m_zoomedMapMatrixKey) {
+        m_zoomedMapMatrix = TransformationMatrix::getZoomedMapTransformationMatrix(
+            physicalMazeSize,
+            zoomedMapPosition,
+            zoomedMapSize,
+            {m_windowWidth, m_windowHeight},
+            m_screenPixelsPerMeter,
+            S()->zoomedMapScale(),
+            S()->rotateZoomedMap(),
+            initialMouseTranslation,
+            currentMouseTranslation,
+            currentMouseRotation);
+        m_zoomedMapMatrixKey = zoomedMapMatrixKey;
+    }
+
     // Clear the screen
     glClear(GL_COLOR_BUFFER_BIT);
 
     // Enable scissoring so that the maps are only draw in specified locations.
     glEnable(GL_SCISSOR_TEST);
 
-    // Re-populate both vertex buffer objects and then draw the tiles, the tile text, and then the mouse
-    repopulateVertexBufferObjects();
-    drawFullAndZoomedMaps(currentMouseTranslation, currentMouseRotation,
-        m_polygonProgram, m_polygonVertexArrayObjectId, 0, 3 * mouseTrianglesStartingIndex);
-    drawFullAndZoomedMaps(currentMouseTranslation, currentMouseRotation,
-        m_textureProgram, m_textureVertexArrayObjectId, 0, 3 * m_textureCpuBuffer.size());
-    drawFullAndZoomedMaps(currentMouseTranslation, currentMouseRotation,
-        m_polygonProgram, m_polygonVertexArrayObjectId, 3 * mouseTrianglesStartingIndex,
-        3 * (m_graphicCpuBuffer.size() - mouseTrianglesStartingIndex));
+    // Re-populate both vertex buffer objects, and then draw the tiles, the
+    // tile text, and the mice of each map
+    repopulateVertexBufferObjects(mouseTrianglesStartingIndex);
+    drawMap(fullMapPosition, fullMapSize, m_fullMapMatrix,
+        fullMapChunks, fullMapDetailed, mouseTrianglesStartingIndex);
+    drawMap(zoomedMapPosition, zoomedMapSize, m_zoomedMapMatrix,
+        zoomedMapChunks, zoomedMapDetailed, mouseTrianglesStartingIndex);
 
     // Disable scissoring so that the glClear can take effect, and so that
     // drawn text isn't clipped at all
@@ -119,18 +262,31 @@ void View::refresh() {
     double end(SimUtilities::getHighResTimestamp());
     double duration = end - start;
 
-    // Notify the user of a late frame
-    // TODO: MACK - make variables for these long expressions
-    if (P()->printLateFrames() && duration > 1.0/P()->frameRate()) {
+    // Notify the user of a late frame; there's no need to sleep otherwise,
+    // since the frame timer decides when the next frame is drawn
+    double period = 1.0 / P()->frameRate();
+    if (P()->printLateFrames() && duration > period) {
         qWarning()
-            << "A frame was late by " << duration - 1.0/P()->frameRate()
+            << "A frame was late by " << duration - period
             << " seconds, which is "
-            << (duration - 1.0/P()->frameRate())/(1.0/P()->frameRate()) * 100
+            << (duration - period) / period * 100
             << " percent late.";
     }
+}
+
+void View::tick(int value) {
 
-    // Sleep the appropriate amount of time, base on the drawing duration
-    SimUtilities::sleep(Seconds(std::max(0.0, 1.0/P()->frameRate() - duration)));
+    // A tick of a chain of timers that's been replaced by a newer one
+    if (value != m_frameTimerChain) {
+        return;
+    }
+
+    double now(SimUtilities::getHighResTimestamp());
+    bool changed = m_bufferInterface->getTileGraphicsChanged() || miceMoved();
+    if (m_frameScheduler.tick(now, changed, S()->paused())) {
+        glutPostRedisplay();
+    }
+    glutTimerFunc(m_frameScheduler.getMillisecondsUntilNextTick(now), m_frameTimer, value);
 }
 
 void View::updateWindowSize(int width, int height) {
@@ -138,6 +294,7 @@ void View::updateWindowSize(int width, int height) {
     m_windowHeight = height;
     m_header->updateWindowSize(width, height);
     glViewport(0, 0, width, height);
+    requestFrame();
 }
 
 QSet<QChar> View::getAllowableTileTextCharacters() {
@@ -164,8 +321,9 @@ void View::keyPress(unsigned char key, int x, int y) {
     // sure to update wiki/Keys.md
 
     if (key == 'p') {
-        // Toggle pause (only in discrete mode)
-        if (STRING_TO_INTERFACE_TYPE.value(m_options.interfaceType) == InterfaceType::DISCRETE) {
+        // Toggle pause (only in discrete mode, or when replaying)
+        if (m_replayer != nullptr ||
+                STRING_TO_INTERFACE_TYPE.value(m_options.interfaceType) == InterfaceType::DISCRETE) {
             S()->setPaused(!S()->paused());
         }
         else {
@@ -176,8 +334,9 @@ void View::keyPress(unsigned char key, int x, int y) {
         }
     }
     else if (key == 'f') {
-        // Faster (only in discrete mode)
-        if (STRING_TO_INTERFACE_TYPE.value(m_options.interfaceType) == InterfaceType::DISCRETE) {
+        // Faster (only in discrete mode, or when replaying)
+        if (m_replayer != nullptr ||
+                STRING_TO_INTERFACE_TYPE.value(m_options.interfaceType) == InterfaceType::DISCRETE) {
             S()->setSimSpeed(S()->simSpeed() * 1.5);
         }
         else {
@@ -188,8 +347,9 @@ void View::keyPress(unsigned char key, int x, int y) {
         }
     }
     else if (key == 's') {
-        // Slower (only in discrete mode)
-        if (STRING_TO_INTERFACE_TYPE.value(m_options.interfaceType) == InterfaceType::DISCRETE) {
+        // Slower (only in discrete mode, or when replaying)
+        if (m_replayer != nullptr ||
+                STRING_TO_INTERFACE_TYPE.value(m_options.interfaceType) == InterfaceType::DISCRETE) {
             S()->setSimSpeed(S()->simSpeed() / 1.5);
         }
         else {
@@ -199,6 +359,24 @@ void View::keyPress(unsigned char key, int x, int y) {
                 << " mode.";
         }
     }
+    else if (key == '[' || key == ']') {
+        // Seek backwards or forwards (only when replaying)
+        if (m_replayer != nullptr) {
+            m_replayer->step(Seconds(P()->replaySeekStep()), key == ']');
+        }
+        else {
+            qWarning() << "Seeking is only allowed when replaying a run.";
+        }
+    }
+    else if (key == 'b') {
+        // Toggle backwards playback (only when replaying)
+        if (m_replayer != nullptr) {
+            m_replayer->toggleReverse();
+        }
+        else {
+            qWarning() << "Backwards playback is only allowed when replaying a run.";
+        }
+    }
     else if (key == 'l') {
         // Cycle through the available layouts
         S()->setLayoutType(LAYOUT_TYPE_CYCLE.value(S()->layoutType()));
@@ -267,6 +445,9 @@ void View::keyPress(unsigned char key, int x, int y) {
                 << " acknowledged as pressed; pressing it has no effect.";
         }
     }
+
+    // Many keys change how things are drawn, so just draw a new frame
+    requestFrame();
 }
 
 void View::specialKeyPress(int key, int x, int y) {
@@ -276,6 +457,7 @@ void View::specialKeyPress(int key, int x, int y) {
     if (ARROW_KEYS.contains(INT_TO_KEY.value(key))) {
         S()->setArrowKeyIsPressed(INT_TO_KEY.value(key), true);
     }
+    requestFrame();
 }
 
 void View::specialKeyRelease(int key, int x, int y) {
@@ -285,6 +467,34 @@ void View::specialKeyRelease(int key, int x, int y) {
     if (ARROW_KEYS.contains(INT_TO_KEY.value(key))) {
         S()->setArrowKeyIsPressed(INT_TO_KEY.value(key), false);
     }
+    requestFrame();
+}
+
+void View::requestFrame() {
+    double now(SimUtilities::getHighResTimestamp());
+    if (m_frameScheduler.wake(now)) {
+        m_frameTimerChain += 1;
+        glutTimerFunc(
+            m_frameScheduler.getMillisecondsUntilNextTick(now),
+            m_frameTimer,
+            m_frameTimerChain);
+    }
+    glutPostRedisplay();
+}
+
+bool View::miceMoved() {
+    if (m_drawnMousePoses.size() != 3 * m_model->getNumberOfMice()) {
+        return true;
+    }
+    for (int i = 0; i < m_model->getNumberOfMice(); i += 1) {
+        Mouse* mouse = m_model->getMouse(i);
+        if (m_drawnMousePoses.at(3 * i + 0) != mouse->getCurrentTranslation().getX().getMeters() ||
+            m_drawnMousePoses.at(3 * i + 1) != mouse->getCurrentTranslation().getY().getMeters() ||
+            m_drawnMousePoses.at(3 * i + 2) != mouse->getCurrentRotation().getRadiansNotBounded()) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void View::initGraphics(int argc, char* argv[], const GlutFunctions& functions) {
@@ -302,7 +512,7 @@ void View::initGraphics(int argc, char* argv[], const GlutFunctions& functions)
     glEnable(GL_BLEND);
     glPolygonMode(GL_FRONT_AND_BACK, S()->wireframeMode() ? GL_LINE : GL_FILL);
     glutDisplayFunc(functions.refresh);
-    glutIdleFunc(functions.refresh);
+    glutTimerFunc(0, functions.frameTimer, m_frameTimerChain);
     glutReshapeFunc(functions.windowResize);
     glutKeyboardFunc(functions.keyPress);
     glutSpecialFunc(functions.specialKeyPress);
@@ -384,6 +594,69 @@ void View::initTextureProgram() {
     glBindVertexArray(0);
 }
 
+void View::initOverview() {
+
+    // Each chunk is a quad, with the same texels as the chunk has tiles,
+    // walls, and posts. Texel k (in either dimension) is centered on k half
+    // tiles from the origin, which is the center of the lower left post.
+    const MazeChunks& chunks = m_bufferInterface->getChunks();
+    double halfTileLength = (P()->wallWidth() + P()->wallLength()) / 2.0;
+    double overviewWidth = m_mazeGraphic->getOverviewWidth();
+    double overviewHeight = m_mazeGraphic->getOverviewHeight();
+    QVector<TriangleTexture> quads;
+    for (int chunk = 0; chunk < chunks.getNumberOfChunks(); chunk += 1) {
+        int left, bottom, right, top;
+        chunks.getTileBounds(chunk, &left, &bottom, &right, &top);
+        double x1 = (2 * left - 0.5) * halfTileLength;
+        double y1 = (2 * bottom - 0.5) * halfTileLength;
+        double x2 = (2 * right + 0.5) * halfTileLength;
+        double y2 = (2 * top + 0.5) * halfTileLength;
+        double u1 = (2 * left) / overviewWidth;
+        double v1 = (2 * bottom) / overviewHeight;
+        double u2 = (2 * right + 1) / overviewWidth;
+        double v2 = (2 * top + 1) / overviewHeight;
+        quads.append({{x1, y1, u1, v1}, {x1, y2, u1, v2}, {x2, y2, u2, v2}});
+        quads.append({{x1, y1, u1, v1}, {x2, y2, u2, v2}, {x2, y1, u2, v1}});
+    }
+
+    // Generate the overview vertex array object and vertex buffer object,
+    // which never change, and set up the texture program's attribute pointers
+    glGenVertexArrays(1, &m_overviewVertexArrayObjectId);
+    glBindVertexArray(m_overviewVertexArrayObjectId);
+    glGenBuffers(1, &m_overviewVertexBufferObjectId);
+    glBindBuffer(GL_ARRAY_BUFFER, m_overviewVertexBufferObjectId);
+    glBufferData(GL_ARRAY_BUFFER, quads.size() * sizeof(TriangleTexture), quads.constData(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(m_textureProgram->attrib("coordinate"));
+    glVertexAttribPointer(m_textureProgram->attrib("coordinate"),
+        2, GL_DOUBLE, GL_FALSE, 4 * sizeof(double), NULL);
+    glEnableVertexAttribArray(m_textureProgram->attrib("textureCoordinate"));
+    glVertexAttribPointer(m_textureProgram->attrib("textureCoordinate"),
+        2, GL_DOUBLE, GL_TRUE, 4 * sizeof(double), (char*) NULL + 2 * sizeof(double));
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+
+    // Allocate the overview texture, whose texels are filled in (by
+    // updateOverviewTexture()) the first time that the overview is drawn
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    if (maxTextureSize < m_mazeGraphic->getOverviewWidth() ||
+            maxTextureSize < m_mazeGraphic->getOverviewHeight()) {
+        qWarning()
+            << "The maze is too large for its overview to fit in a texture, and"
+            << "so it may not be shown when the maze is zoomed out.";
+    }
+    glGenTextures(1, &m_overviewTextureObjectId);
+    glBindTexture(GL_TEXTURE_2D, m_overviewTextureObjectId);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
+        m_mazeGraphic->getOverviewWidth(), m_mazeGraphic->getOverviewHeight(),
+        0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
 QMap<QChar, QPair<double, double>> View::getFontImageMap() {
 
     // These values must perfectly reflect the font image being used, or else
@@ -410,86 +683,139 @@ QMap<QChar, QPair<double, double>> View::getFontImageMap() {
     return fontImageMap;
 }
 
-void View::repopulateVertexBufferObjects() {
+void View::repopulateVertexBufferObjects(int mouseTrianglesStartingIndex) {
 
-    // Clear the polygon vertex buffer object and re-populate it with data
+    // The tiles' parts of the buffers, which are most of them, are only
+    // uploaded when they've changed; the mice are uploaded every frame
+    bool tilesChanged = m_bufferInterface->takeTileGraphicsChanged();
+
+    // Re-populate the polygon vertex buffer object, making it bigger (with
+    // room for the mice to grow) if need be
+    bool polygonTilesChanged = tilesChanged;
     glBindBuffer(GL_ARRAY_BUFFER, m_polygonVertexBufferObjectId);
-    glBufferData(GL_ARRAY_BUFFER, m_graphicCpuBuffer.size() * sizeof(TriangleGraphic), NULL, GL_DYNAMIC_DRAW);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, m_graphicCpuBuffer.size() * sizeof(TriangleGraphic),
-        &m_graphicCpuBuffer.front());
+    if (m_polygonVertexBufferObjectCapacity < m_graphicCpuBuffer.size()) {
+        m_polygonVertexBufferObjectCapacity =
+            2 * m_graphicCpuBuffer.size() - mouseTrianglesStartingIndex;
+        glBufferData(GL_ARRAY_BUFFER, m_polygonVertexBufferObjectCapacity * sizeof(TriangleGraphic),
+            NULL, GL_DYNAMIC_DRAW);
+        polygonTilesChanged = true;
+    }
+    if (polygonTilesChanged) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, mouseTrianglesStartingIndex * sizeof(TriangleGraphic),
+            m_graphicCpuBuffer.constData());
+    }
+    glBufferSubData(GL_ARRAY_BUFFER,
+        mouseTrianglesStartingIndex * sizeof(TriangleGraphic),
+        (m_graphicCpuBuffer.size() - mouseTrianglesStartingIndex) * sizeof(TriangleGraphic),
+        m_graphicCpuBuffer.constData() + mouseTrianglesStartingIndex);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-    // Clear the texture vertex buffer object and re-populate it with data
-    glBindBuffer(GL_ARRAY_BUFFER, m_textureVertexBufferObjectId);
-    glBufferData(GL_ARRAY_BUFFER, m_textureCpuBuffer.size() * sizeof(TriangleTexture), NULL, GL_DYNAMIC_DRAW);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, m_textureCpuBuffer.size() * sizeof(TriangleTexture),
-        &m_textureCpuBuffer.front());
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    // Clear the texture vertex buffer object and re-populate it with data,
+    // since it only holds tile text
+    if (tilesChanged) {
+        glBindBuffer(GL_ARRAY_BUFFER, m_textureVertexBufferObjectId);
+        glBufferData(GL_ARRAY_BUFFER, m_textureCpuBuffer.size() * sizeof(TriangleTexture), NULL, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, m_textureCpuBuffer.size() * sizeof(TriangleTexture),
+            m_textureCpuBuffer.constData());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
 }
 
-void View::drawFullAndZoomedMaps(
-        const Coordinate& currentMouseTranslation, const Angle& currentMouseRotation,
-        tdogl::Program* program, int vaoId, int vboStartingIndex, int vboEndingIndex) {
+void View::updateOverviewTexture() {
 
-    // Get the sizes and positions of each of the maps.
-    QPair<int, int> fullMapPosition = Layout::getFullMapPosition(
-        m_windowWidth, m_windowHeight, m_header->getHeight(), P()->windowBorderWidth(), S()->layoutType());
-    QPair<int, int> fullMapSize = Layout::getFullMapSize(
-        m_windowWidth, m_windowHeight, m_header->getHeight(), P()->windowBorderWidth(), S()->layoutType());
-    QPair<int, int> zoomedMapPosition = Layout::getZoomedMapPosition(
-        m_windowWidth, m_windowHeight, m_header->getHeight(), P()->windowBorderWidth(), S()->layoutType());
-    QPair<int, int> zoomedMapSize = Layout::getZoomedMapSize(
-        m_windowWidth, m_windowHeight, m_header->getHeight(), P()->windowBorderWidth(), S()->layoutType());
+    // Only the chunks of the overview that have changed are uploaded, each
+    // straight out of the overview as a whole
+    QVector<int> chunks = m_mazeGraphic->updateOverview();
+    if (chunks.isEmpty()) {
+        return;
+    }
+    const QVector<unsigned char>& overview = m_mazeGraphic->getOverview();
+    glBindTexture(GL_TEXTURE_2D, m_overviewTextureObjectId);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, m_mazeGraphic->getOverviewWidth());
+    for (int chunk : chunks) {
+        int left, bottom, right, top;
+        m_bufferInterface->getChunks().getTileBounds(chunk, &left, &bottom, &right, &top);
+        glPixelStorei(GL_UNPACK_SKIP_PIXELS, 2 * left);
+        glPixelStorei(GL_UNPACK_SKIP_ROWS, 2 * bottom);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 2 * left, 2 * bottom,
+            2 * (right - left) + 1, 2 * (top - bottom) + 1,
+            GL_RGBA, GL_UNSIGNED_BYTE, overview.constData());
+    }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
 
-    // Get the physical size of the maze (in meters)
-    double physicalMazeWidth = P()->wallWidth() + m_model->getMaze()->getWidth() * (P()->wallWidth() + P()->wallLength());
-    double physicalMazeHeight = P()->wallWidth() + m_model->getMaze()->getHeight() * (P()->wallWidth() + P()->wallLength());
-    QPair<double, double> physicalMazeSize = {physicalMazeWidth, physicalMazeHeight};
+void View::drawMap(
+        QPair<int, int> mapPosition, QPair<int, int> mapSize,
+        const Matrix4& transformationMatrix,
+        const QVector<int>& chunks, bool detailed, int mouseTrianglesStartingIndex) {
+
+    glScissor(mapPosition.first, mapPosition.second, mapSize.first, mapSize.second);
+
+    // Draw either the tiles and their text, chunk by chunk, or the overview ...
+    if (detailed) {
+        QVector<QPair<int, int>> tileTriangles;
+        QVector<QPair<int, int>> textTriangles;
+        for (int chunk : chunks) {
+            tileTriangles.append(m_bufferInterface->getChunkTriangleGraphics(chunk));
+            textTriangles.append(m_bufferInterface->getChunkTriangleTextures(chunk));
+        }
+        drawTriangles(m_polygonProgram, m_polygonVertexArrayObjectId, 0,
+            transformationMatrix, tileTriangles);
+        drawTriangles(m_textureProgram, m_textureVertexArrayObjectId, m_textureAtlas->object(),
+            transformationMatrix, textTriangles);
+    }
+    else {
+        QVector<QPair<int, int>> overviewTriangles;
+        for (int chunk : chunks) {
+            overviewTriangles.append({2 * chunk, 2});
+        }
+        drawTriangles(m_textureProgram, m_overviewVertexArrayObjectId, m_overviewTextureObjectId,
+            transformationMatrix, overviewTriangles);
+    }
+
+    // ... and then the mice, on top
+    drawTriangles(m_polygonProgram, m_polygonVertexArrayObjectId, 0, transformationMatrix,
+        {{mouseTrianglesStartingIndex, m_graphicCpuBuffer.size() - mouseTrianglesStartingIndex}});
+}
+
+void View::drawTriangles(
+        tdogl::Program* program, GLuint vaoId, GLuint textureObjectId,
+        const Matrix4& transformationMatrix, QVector<QPair<int, int>> ranges) {
 
     // Start using the program and vertex array object
     program->use();
     glBindVertexArray(vaoId);
 
-    // If it's the texture program, bind the texture and set the uniform
-    if (program == m_textureProgram) {
+    // If there's a texture, bind it and set the uniform
+    if (textureObjectId != 0) {
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, m_textureAtlas->object());
+        glBindTexture(GL_TEXTURE_2D, textureObjectId);
         program->setUniform("_texture", 0);
     }
 
-    // Render the full map
-    glScissor(fullMapPosition.first, fullMapPosition.second, fullMapSize.first, fullMapSize.second);
-    program->setUniformMatrix4("transformationMatrix",
-        &TransformationMatrix::getFullMapTransformationMatrix(
-            Meters(P()->wallWidth()),
-            physicalMazeSize,
-            fullMapPosition,
-            fullMapSize,
-            {m_windowWidth, m_windowHeight}).front(), 1, GL_TRUE);
-    glDrawArrays(GL_TRIANGLES, vboStartingIndex, vboEndingIndex);
-
-    // Render the zoomed map
-    glScissor(zoomedMapPosition.first, zoomedMapPosition.second, zoomedMapSize.first, zoomedMapSize.second);
-    program->setUniformMatrix4("transformationMatrix",
-        &TransformationMatrix::getZoomedMapTransformationMatrix(
-            physicalMazeSize,
-            zoomedMapPosition,
-            zoomedMapSize,
-            {m_windowWidth, m_windowHeight},
-            m_screenPixelsPerMeter,
-            S()->zoomedMapScale(),
-            S()->rotateZoomedMap(),
-            m_model->getMouse()->getInitialTranslation(),
-            currentMouseTranslation,
-            currentMouseRotation).front(), 1, GL_TRUE);
-    glDrawArrays(GL_TRIANGLES, vboStartingIndex, vboEndingIndex);
+    // Ranges that are next to each other in the buffer (e.g., the chunks of
+    // any maze small enough to fit in the buffers) are drawn all at once
+    program->setUniformMatrix4("transformationMatrix", transformationMatrix.data(), 1, GL_TRUE);
+    std::sort(ranges.begin(), ranges.end());
+    int i = 0;
+    while (i < ranges.size()) {
+        int first = ranges.at(i).first;
+        int count = ranges.at(i).second;
+        i += 1;
+        while (i < ranges.size() && ranges.at(i).first == first + count) {
+            count += ranges.at(i).second;
+            i += 1;
+        }
+        glDrawArrays(GL_TRIANGLES, 3 * first, 3 * count);
+    }
 
-    // Stop using the program and vertex array object
+    // Stop using the program, vertex array object, and texture
     glBindVertexArray(0);
     program->stopUsing();
-
-    // If it's the texture program, we should additionally unbind the texture
-    if (program == m_textureProgram) {
+    if (textureObjectId != 0) {
         glBindTexture(GL_TEXTURE_2D, 0);
     }
 }
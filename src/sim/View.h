@@ -5,12 +5,16 @@
 #include <QSet>
 #include <QVector>
 
+#include <array>
+
 #include <glut/glut.h>
 #include <tdogl/Program.h>
 #include <tdogl/Texture.h>
 
+#include "FrameScheduler.h"
 #include "GlutFunctions.h"
 #include "Header.h"
+#include "Matrix4.h"
 #include "MazeGraphic.h"
 #include "Model.h"
 #include "MouseGraphic.h"
@@ -22,19 +26,34 @@ class IMouseAlgorithm;
 
 namespace sim {
 
+// Forward declared, since the Replayer drives the model that the View shows
+class Replayer;
+
 class View {
 
 public:
     View(Model* model, int argc, char* argv[], const GlutFunctions& functions);
 
     MazeGraphic* getMazeGraphic();
+
+    // The graphic of the first mouse, and of each mouse, respectively
     MouseGraphic* getMouseGraphic();
+    MouseGraphic* getMouseGraphic(int index);
 
     void setMouseAlgorithmAndOptions(
         IMouseAlgorithm* mouseAlgorithm,
         StaticMouseAlgorithmOptions options);
 
+    // Enables the replay controls
+    void setReplayer(Replayer* replayer);
+
+    // Draws a frame; only called by GLUT, when a redisplay has been posted
     void refresh();
+
+    // Called by the frame timer, which posts a redisplay if anything has
+    // changed; the value identifies the chain of timers that it belongs to
+    void tick(int value);
+
     void updateWindowSize(int width, int height);
 
     QSet<QChar> getAllowableTileTextCharacters();
@@ -44,6 +63,9 @@ public:
     void specialKeyPress(int key, int x, int y);
     void specialKeyRelease(int key, int x, int y);
 
+    // A map from char to x and y location in the font image
+    static QMap<QChar, QPair<double, double>> getFontImageMap();
+
 private:
 
     // CPU-side buffers, and interface
@@ -54,7 +76,7 @@ private:
     // The model and graphic objects
     Model* m_model;
     MazeGraphic* m_mazeGraphic;
-    MouseGraphic* m_mouseGraphic;
+    QVector<MouseGraphic*> m_mouseGraphics; // Parallel to the model's mice
 
     // The window size, in pixels
     int m_windowWidth;
@@ -65,36 +87,81 @@ private:
 
     // A map from char to x and y location in the font image
     QMap<QChar, QPair<double, double>> m_fontImageMap;
-    QMap<QChar, QPair<double, double>> getFontImageMap();
 
     // Window header object
     Header* m_header;
 
+    // The transformation matrix of each map, and everything that it was
+    // computed from (the window size, the layout of the maps, the zoom, and
+    // the pose of the mouse); a matrix is only recomputed when one of those
+    // changes, which, for the full map, is hardly ever
+    std::array<double, 9> m_fullMapMatrixKey;
+    Matrix4 m_fullMapMatrix;
+    std::array<double, 16> m_zoomedMapMatrixKey;
+    Matrix4 m_zoomedMapMatrix;
+
+    // Decides when to draw, and the timer that it's driven by. GLUT timers
+    // can't be cancelled, so when the scheduler wakes from idle, a new chain
+    // of timers is started, and the ticks of the old chain are ignored.
+    FrameScheduler m_frameScheduler;
+    void (*m_frameTimer)(int value);
+    int m_frameTimerChain;
+
+    // The translation and rotation of each mouse, as of the last frame, three
+    // values per mouse, so that ticks can tell whether or not any has moved
+    QVector<double> m_drawnMousePoses;
+
     // Used to determine whether or not to automatically clear fog
     IMouseAlgorithm* m_mouseAlgorithm;
     StaticMouseAlgorithmOptions m_options;
 
+    // The replay of a previous run, or nullptr if not replaying
+    Replayer* m_replayer;
+
     // Polygon program variables
     tdogl::Program* m_polygonProgram;
     GLuint m_polygonVertexArrayObjectId;
     GLuint m_polygonVertexBufferObjectId;
 
+    // The number of triangles that the polygon vertex buffer object has room
+    // for, which may be more than are in use
+    int m_polygonVertexBufferObjectCapacity;
+
     // Texture program variables
     tdogl::Texture* m_textureAtlas;
     tdogl::Program* m_textureProgram;
     GLuint m_textureVertexArrayObjectId;
     GLuint m_textureVertexBufferObjectId;
 
+    // The maze overview (see MazeGraphic.h), which is drawn with the texture
+    // program, as one textured quad per chunk
+    GLuint m_overviewTextureObjectId;
+    GLuint m_overviewVertexArrayObjectId;
+    GLuint m_overviewVertexBufferObjectId;
+
     // Initialize all of the graphics
     void initGraphics(int argc, char* argv[], const GlutFunctions& functions);
     void initPolygonProgram();
     void initTextureProgram();
+    void initOverview();
+
+    // Frame scheduling helper methods
+    void requestFrame();
+    bool miceMoved();
 
     // Drawing helper methods
-    void repopulateVertexBufferObjects();
-    void drawFullAndZoomedMaps(
-        const Coordinate& currentMouseTranslation, const Angle& currentMouseRotation,
-        tdogl::Program* program, int vaoId, int vboStartingIndex, int vboEndingIndex);
+    void repopulateVertexBufferObjects(int mouseTrianglesStartingIndex);
+    void updateOverviewTexture();
+    void drawMap(
+        QPair<int, int> mapPosition, QPair<int, int> mapSize,
+        const Matrix4& transformationMatrix,
+        const QVector<int>& chunks, bool detailed, int mouseTrianglesStartingIndex);
+
+    // Draws ranges of triangles, each given by its first triangle and its
+    // number of triangles, from the vertex array object
+    void drawTriangles(
+        tdogl::Program* program, GLuint vaoId, GLuint textureObjectId,
+        const Matrix4& transformationMatrix, QVector<QPair<int, int>> ranges);
 
 };
 
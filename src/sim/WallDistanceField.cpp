@@ -0,0 +1,227 @@
+#include "WallDistanceField.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "CPMath.h"
+#include "Direction.h"
+#include "GeometryUtilities.h"
+#include "Param.h"
+
+namespace sim {
+
+WallDistanceField::WallDistanceField() :
+        m_width(0),
+        m_height(0),
+        m_headings(0),
+        m_cellLength(0.0),
+        m_halfWallWidth(0.0),
+        m_tileLength(0.0) {
+}
+
+WallDistanceField::WallDistanceField(
+        const Maze& maze,
+        int cellsPerTile,
+        int headings,
+        const Meters& maxDistance) :
+        m_width(maze.getWidth() * cellsPerTile),
+        m_height(maze.getHeight() * cellsPerTile),
+        m_headings(headings),
+        m_halfWallWidth(P()->wallWidth() / 2.0),
+        m_tileLength(P()->wallLength() + P()->wallWidth()) {
+
+    m_cellLength = m_tileLength / cellsPerTile;
+    m_distances.fill(0.0f, m_width * m_height * m_headings);
+
+    // Each thread takes every nth column; the distances are written through a
+    // raw pointer so that the threads never cause the vector to detach
+    QVector<unsigned char> walls = getWalls(maze);
+    float* distances = m_distances.data();
+    int numberOfThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::vector<std::thread> threads;
+    for (int i = 0; i < numberOfThreads; i += 1) {
+        threads.emplace_back([&, i]() {
+            for (int column = i; column < m_width; column += numberOfThreads) {
+                buildColumn(
+                    walls, maze.getWidth(), maze.getHeight(),
+                    column, maxDistance.getMeters(), distances);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+bool WallDistanceField::isEmpty() const {
+    return m_distances.isEmpty();
+}
+
+Cartesian WallDistanceField::castRay(
+        const Cartesian& start, const Cartesian& end, const Maze& maze) const {
+
+    static Meters halfWallWidth = Meters(P()->wallWidth() / 2.0);
+    static Meters tileLength = Meters(P()->wallLength() + P()->wallWidth());
+
+    if (isEmpty()) {
+        return GeometryUtilities::castRay(start, end, maze, halfWallWidth, tileLength);
+    }
+
+    double dx = (end.getX() - start.getX()).getMeters();
+    double dy = (end.getY() - start.getY()).getMeters();
+    double length = std::sqrt(dx * dx + dy * dy);
+    int x = static_cast<int>(std::floor(start.getX().getMeters() / m_cellLength));
+    int y = static_cast<int>(std::floor(start.getY().getMeters() / m_cellLength));
+    if (length == 0.0 || x < 0 || m_width <= x || y < 0 || m_height <= y) {
+        return GeometryUtilities::castRay(start, end, maze, halfWallWidth, tileLength);
+    }
+
+    double heading = std::atan2(dy, dx);
+    if (heading < 0.0) {
+        heading += M_TWOPI;
+    }
+    int sector = std::min(m_headings - 1, static_cast<int>(heading / (M_TWOPI / m_headings)));
+    double distance = m_distances.at((x * m_height + y) * m_headings + sector);
+
+    // Nothing is within reach, so the ray goes all the way
+    if (length <= distance) {
+        return end;
+    }
+
+    // Otherwise skip the part of the ray that's guaranteed to be clear
+    Cartesian skipped = start + Cartesian(
+        Meters(dx * distance / length), Meters(dy * distance / length));
+    return GeometryUtilities::castRay(skipped, end, maze, halfWallWidth, tileLength);
+}
+
+QVector<unsigned char> WallDistanceField::getWalls(const Maze& maze) const {
+    QVector<unsigned char> walls(maze.getWidth() * maze.getHeight(), 0);
+    for (int x = 0; x < maze.getWidth(); x += 1) {
+        for (int y = 0; y < maze.getHeight(); y += 1) {
+            for (int i = 0; i < DIRECTIONS.size(); i += 1) {
+                if (maze.getTile(x, y)->isWall(DIRECTIONS.at(i))) {
+                    walls[x * maze.getHeight() + y] |= 1 << i;
+                }
+            }
+        }
+    }
+    for (int x = 0; x < maze.getWidth(); x += 1) {
+        for (int y = 0; y < maze.getHeight(); y += 1) {
+            unsigned char& tile = walls[x * maze.getHeight() + y];
+            int north = DIRECTIONS.indexOf(Direction::NORTH);
+            int east = DIRECTIONS.indexOf(Direction::EAST);
+            int south = DIRECTIONS.indexOf(Direction::SOUTH);
+            int west = DIRECTIONS.indexOf(Direction::WEST);
+            if (y + 1 < maze.getHeight() && (walls.at(x * maze.getHeight() + y + 1) & (1 << south))) {
+                tile |= 1 << north;
+            }
+            if (x + 1 < maze.getWidth() && (walls.at((x + 1) * maze.getHeight() + y) & (1 << west))) {
+                tile |= 1 << east;
+            }
+            if (0 < y && (walls.at(x * maze.getHeight() + y - 1) & (1 << north))) {
+                tile |= 1 << south;
+            }
+            if (0 < x && (walls.at((x - 1) * maze.getHeight() + y) & (1 << east))) {
+                tile |= 1 << west;
+            }
+        }
+    }
+    return walls;
+}
+
+double WallDistanceField::getClearance(
+        const QVector<unsigned char>& walls, int mazeWidth, int mazeHeight,
+        double x, double y) const {
+
+    // Everything outside of the maze counts as a wall; we're more cautious
+    // than castRay() here, but rays never leave the maze in the first place
+    double clearance = std::min(
+        std::min(x, mazeWidth * m_tileLength - x),
+        std::min(y, mazeHeight * m_tileLength - y));
+    if (clearance <= 0.0) {
+        return 0.0;
+    }
+
+    auto distanceToRectangle = [x, y](double x0, double y0, double x1, double y1) {
+        double dx = std::max(0.0, std::max(x0 - x, x - x1));
+        double dy = std::max(0.0, std::max(y0 - y, y - y1));
+        return std::sqrt(dx * dx + dy * dy);
+    };
+
+    // Every corner is a wall, so the nearest wall is always less than a tile
+    // away, and thus belongs to one of the tiles around the point's tile
+    int tx = static_cast<int>(std::floor(x / m_tileLength));
+    int ty = static_cast<int>(std::floor(y / m_tileLength));
+    double w = m_halfWallWidth;
+    double l = m_tileLength;
+    for (int i = tx - 1; i <= tx + 1; i += 1) {
+        for (int j = ty - 1; j <= ty + 1; j += 1) {
+            clearance = std::min(clearance, distanceToRectangle(
+                i * l - w, j * l - w, i * l + w, j * l + w));
+            if (i < 0 || mazeWidth <= i || j < 0 || mazeHeight <= j) {
+                continue;
+            }
+            unsigned char tile = walls.at(i * mazeHeight + j);
+            if (tile & (1 << DIRECTIONS.indexOf(Direction::NORTH))) {
+                clearance = std::min(clearance, distanceToRectangle(
+                    i * l - w, (j + 1) * l - w, (i + 1) * l + w, (j + 1) * l + w));
+            }
+            if (tile & (1 << DIRECTIONS.indexOf(Direction::EAST))) {
+                clearance = std::min(clearance, distanceToRectangle(
+                    (i + 1) * l - w, j * l - w, (i + 1) * l + w, (j + 1) * l + w));
+            }
+            if (tile & (1 << DIRECTIONS.indexOf(Direction::SOUTH))) {
+                clearance = std::min(clearance, distanceToRectangle(
+                    i * l - w, j * l - w, (i + 1) * l + w, j * l + w));
+            }
+            if (tile & (1 << DIRECTIONS.indexOf(Direction::WEST))) {
+                clearance = std::min(clearance, distanceToRectangle(
+                    i * l - w, j * l - w, i * l + w, (j + 1) * l + w));
+            }
+        }
+    }
+    return clearance;
+}
+
+void WallDistanceField::buildColumn(
+        const QVector<unsigned char>& walls, int mazeWidth, int mazeHeight,
+        int column, double maxDistance, float* distances) const {
+
+    // A ray from anywhere in the cell, with a heading anywhere in the sector,
+    // is never farther than radius + t * spread from the ray from the center
+    // of the cell, with the heading in the center of the sector, after both
+    // have traveled a distance of t
+    double radius = m_cellLength * std::sqrt(2.0) / 2.0;
+    double spread = 2.0 * std::sin(M_PI / m_headings / 2.0);
+
+    for (int row = 0; row < m_height; row += 1) {
+        double cx = (column + 0.5) * m_cellLength;
+        double cy = (row + 0.5) * m_cellLength;
+        for (int sector = 0; sector < m_headings; sector += 1) {
+            double heading = (sector + 0.5) * M_TWOPI / m_headings;
+            double ux = std::cos(heading);
+            double uy = std::sin(heading);
+
+            // March along the center ray for as long as the margin between the
+            // clearance and the spread of the rays is positive. The margin
+            // changes by at most 1 + spread per meter, so each step is safe.
+            double t = 0.0;
+            for (int step = 0; step < 1000 && t < maxDistance; step += 1) {
+                double margin = getClearance(
+                    walls, mazeWidth, mazeHeight, cx + t * ux, cy + t * uy)
+                    - radius - t * spread;
+                if (margin < 1e-5) {
+                    break;
+                }
+                t = std::min(maxDistance, t + margin / (1.0 + spread));
+            }
+
+            // Round down, so that converting to float can't make it unsafe
+            distances[(column * m_height + row) * m_headings + sector] =
+                static_cast<float>(std::max(0.0, t - 1e-6));
+        }
+    }
+}
+
+} // namespace sim
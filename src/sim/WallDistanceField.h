@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QVector>
+
+#include "Maze.h"
+#include "units/Cartesian.h"
+#include "units/Meters.h"
+
+namespace sim {
+
+// An optional acceleration structure for casting rays in a (static) maze.
+//
+// The maze is divided into a raster of square cells, some number of cells
+// per tile in each dimension, and the full circle into equal heading sectors.
+// For each cell and sector, we store a distance that any ray starting in the
+// cell with a heading in the sector is guaranteed to travel without reaching
+// a wall or corner. Casting a ray is thus a table lookup, followed by an
+// exact (but short) GeometryUtilities::castRay from the point that the ray
+// can safely skip to, which gives the same result as casting the whole ray.
+//
+// The distances are conservative, rather than interpolated, so that sensor
+// readings don't depend on whether or not the field is being used.
+class WallDistanceField {
+
+public:
+
+    // An empty field, whose castRay() is just GeometryUtilities::castRay()
+    WallDistanceField();
+
+    // Builds the field for the maze, in parallel over columns of cells. No
+    // distance greater than maxDistance (e.g., the longest sensor range) is
+    // stored, which bounds the time it takes to build the field.
+    WallDistanceField(
+        const Maze& maze,
+        int cellsPerTile,
+        int headings,
+        const Meters& maxDistance);
+
+    bool isEmpty() const;
+
+    // Returns exactly what GeometryUtilities::castRay() would return for the
+    // maze that the field was built for
+    Cartesian castRay(
+        const Cartesian& start, const Cartesian& end, const Maze& maze) const;
+
+private:
+
+    // The dimensions of the raster, in cells
+    int m_width;
+    int m_height;
+    int m_headings;
+
+    // In meters, to keep the unit classes out of the build loop
+    double m_cellLength;
+    double m_halfWallWidth;
+    double m_tileLength;
+
+    // The safe distance for each cell (column-major) and heading sector
+    QVector<float> m_distances;
+
+    // The wall bits (1 << DIRECTIONS.indexOf(direction)) of each tile,
+    // where a wall exists if either of the tiles on its sides says it does
+    QVector<unsigned char> getWalls(const Maze& maze) const;
+
+    // The distance from (x, y) to the nearest wall, corner, or point outside
+    // of the maze, or zero if (x, y) is in (or on) one
+    double getClearance(
+        const QVector<unsigned char>& walls, int mazeWidth, int mazeHeight,
+        double x, double y) const;
+
+    // Fills in the safe distances for a single column of cells
+    void buildColumn(
+        const QVector<unsigned char>& walls, int mazeWidth, int mazeHeight,
+        int column, double maxDistance, float* distances) const;
+
+};
+
+} // namespace sim
@@ -9,6 +9,7 @@
 #include "GeometryUtilities.h"
 #include "Logging.h"
 #include "Param.h"
+#include "Recorder.h"
 #include "SimUtilities.h"
 #include "State.h"
 #include "Time.h"
@@ -18,36 +19,75 @@ namespace sim {
 
 World::World(
         const Maze* maze,
-        Mouse* mouse) :
+        const QVector<Mouse*>& mice) :
         m_maze(maze),
-        m_mouse(mouse),
-        m_bestTimeToCenter(Seconds(-1)),
-        m_timeOfOriginDeparture(Seconds(-1)),
-        m_closestDistanceToCenter(-1) {
+        m_mice(mice),
+        m_crashed(mice.size()),
+        m_batch(new MouseBatch(mice)) {
+    Progress progress {
+        Seconds(-1),
+        Seconds(-1),
+        QVector<bool>(maze->getWidth() * maze->getHeight(), false),
+        0,
+        -1,
+    };
+    m_progress.fill(progress, m_mice.size());
+    for (std::atomic<bool>& crashed : m_crashed) {
+        crashed.store(false);
+    }
 }
 
 void World::setOptions(StaticMouseAlgorithmOptions options) {
     m_options = options;
 }
 
-Seconds World::getBestTimeToCenter() const {
-    return m_bestTimeToCenter;
+Seconds World::getBestTimeToCenter(int mouseIndex) const {
+    return m_progress.at(mouseIndex).bestTimeToCenter;
 }
 
-Seconds World::getTimeSinceOriginDeparture() const {
+Seconds World::getTimeSinceOriginDeparture(int mouseIndex) const {
     // If we haven't left the origin yet, return -1
-    if (m_timeOfOriginDeparture < Seconds(0)) {
+    Seconds timeOfOriginDeparture = m_progress.at(mouseIndex).timeOfOriginDeparture;
+    if (timeOfOriginDeparture < Seconds(0)) {
         return Seconds(-1);
     }
-    return Time::get()->elapsedSimTime() - m_timeOfOriginDeparture;
+    return Time::get()->elapsedSimTime() - timeOfOriginDeparture;
+}
+
+int World::getNumberOfTilesTraversed(int mouseIndex) const {
+    return m_progress.at(mouseIndex).numberOfTilesTraversed;
 }
 
-int World::getNumberOfTilesTraversed() const {
-    return m_traversedTileLocations.size();
+int World::getClosestDistanceToCenter(int mouseIndex) const {
+    return m_progress.at(mouseIndex).closestDistanceToCenter;
 }
 
-int World::getClosestDistanceToCenter() const {
-    return m_closestDistanceToCenter;
+bool World::hasCrashed(int mouseIndex) const {
+    return m_crashed.at(mouseIndex).load();
+}
+
+void World::step(const Duration& elapsed) {
+
+    // Crashes are only applied between steps, so a mouse that crashes part
+    // way through this one is still moved (and has its progress updated)
+    // along with the others, and stops with the next step
+    for (int i = 0; i < m_mice.size(); i += 1) {
+        m_batch->setActive(i, !m_crashed.at(i).load());
+    }
+
+    // First move all of the mice, and only then look at where they ended up,
+    // so that the physics (which touches just the mice) and the bookkeeping
+    // (which touches just the progress and the maze) each happen in one pass
+    m_batch->step(elapsed);
+
+    // Only the first mouse is recorded, so that the run can be replayed
+    Recorder::get()->recordPose(m_mice.at(0)->getCurrentTranslation(), m_mice.at(0)->getCurrentRotation());
+
+    for (int i = 0; i < m_mice.size(); i += 1) {
+        if (m_batch->isActive(i)) {
+            updateProgress(i);
+        }
+    }
 }
 
 void World::simulate() {
@@ -61,7 +101,7 @@ void World::simulate() {
     double start(SimUtilities::getHighResTimestamp());
     int limit = 1000;
     for (int i = 0; i < limit; i += 1) {
-        m_mouse->update(Seconds(1.0 / P()->mousePositionUpdateRate()) * S()->simSpeed());
+        step(Seconds(1.0 / P()->mousePositionUpdateRate()) * S()->simSpeed());
     }
     double end(SimUtilities::getHighResTimestamp());
     double duration = end - start;
@@ -77,7 +117,7 @@ void World::simulate() {
         // the mouse position update operation and take it into account when we sleep.
         double start(SimUtilities::getHighResTimestamp());
 
-        // If we've crashed, let this thread exit
+        // If all of the mice have crashed, let this thread exit
         if (S()->crashed()) {
             collisionDetector.join();
             return;
@@ -96,53 +136,8 @@ void World::simulate() {
         // Update the sim time
         Time::get()->incrementElapsedSimTime(elapsedSimTimeForThisIteration);
 
-        // Update the position of the mouse
-        m_mouse->update(elapsedSimTimeForThisIteration);
-
-        // Retrieve the current discretized location of the mouse, and
-        // the tile at that location, for use with the next few code blocks
-        QPair<int, int> location = m_mouse->getCurrentDiscretizedTranslation();
-        const Tile* tileAtLocation = m_maze->getTile(location.first, location.second);
-
-        // Whether or not this is a newly traversed tile
-        bool newLocation = !m_traversedTileLocations.contains(location);
-
-        // Update the set of traversed tiles
-        if (newLocation) {
-            m_traversedTileLocations.insert(location);
-            if (m_closestDistanceToCenter == -1 ||
-                    tileAtLocation->getDistance() < m_closestDistanceToCenter) {
-                m_closestDistanceToCenter = tileAtLocation->getDistance(); 
-            }
-        }
-
-        // If we've returned to the origin, reset the departure time
-        if (location.first == 0 && location.second == 0) {
-            if (Seconds(0) < m_timeOfOriginDeparture) {
-                m_timeOfOriginDeparture = Seconds(-1);
-            }
-        }
-
-        // Otherwise, if we've just left the origin, update the departure time
-        else if (m_timeOfOriginDeparture < Seconds(0)) {
-            m_timeOfOriginDeparture = Time::get()->elapsedSimTime();
-        }
-
-        // Separately, if we're in the center, update the best time to center
-        if (m_maze->isCenterTile(location.first, location.second)) {
-            Seconds timeToCenter = Time::get()->elapsedSimTime() - m_timeOfOriginDeparture;
-            if (m_bestTimeToCenter < Seconds(0) || timeToCenter < m_bestTimeToCenter) {
-                m_bestTimeToCenter = timeToCenter;
-            }
-        }
-
-        // If we're ever outside of the maze, crash. It would be cool to have
-        // some "out of bounds" state but I haven't implemented that yet. We
-        // continue here to make sure that we join with the other thread.
-        if (!m_maze->withinMaze(location.first, location.second)) {
-            S()->setCrashed();
-            continue;
-        }
+        // Update the positions and progress of all of the mice
+        step(elapsedSimTimeForThisIteration);
 
         // Get the duration of the mouse position update, in seconds. Note that this duration
         // is simply the total number of real seconds that have passed, which is exactly
@@ -166,6 +161,65 @@ void World::simulate() {
     */
 }
 
+void World::updateProgress(int mouseIndex) {
+
+    Progress& progress = m_progress[mouseIndex];
+
+    // Retrieve the current discretized location of the mouse, for use with
+    // the next few code blocks
+    QPair<int, int> location = m_mice.at(mouseIndex)->getCurrentDiscretizedTranslation();
+
+    // If we're ever outside of the maze, crash. It would be cool to have
+    // some "out of bounds" state but I haven't implemented that yet.
+    if (!m_maze->withinMaze(location.first, location.second)) {
+        setCrashed(mouseIndex);
+        return;
+    }
+
+    // Update the set of traversed tiles, if this is a newly traversed tile
+    int tileIndex = location.first * m_maze->getHeight() + location.second;
+    if (!progress.traversedTiles.at(tileIndex)) {
+        progress.traversedTiles[tileIndex] = true;
+        progress.numberOfTilesTraversed += 1;
+        int distance = m_maze->getTile(location.first, location.second)->getDistance();
+        if (progress.closestDistanceToCenter == -1 || distance < progress.closestDistanceToCenter) {
+            progress.closestDistanceToCenter = distance;
+        }
+    }
+
+    // If we've returned to the origin, reset the departure time
+    if (location.first == 0 && location.second == 0) {
+        if (Seconds(0) < progress.timeOfOriginDeparture) {
+            progress.timeOfOriginDeparture = Seconds(-1);
+        }
+    }
+
+    // Otherwise, if we've just left the origin, update the departure time
+    else if (progress.timeOfOriginDeparture < Seconds(0)) {
+        progress.timeOfOriginDeparture = Time::get()->elapsedSimTime();
+    }
+
+    // Separately, if we're in the center, update the best time to center
+    if (m_maze->isCenterTile(location.first, location.second)) {
+        Seconds timeToCenter = Time::get()->elapsedSimTime() - progress.timeOfOriginDeparture;
+        if (progress.bestTimeToCenter < Seconds(0) || timeToCenter < progress.bestTimeToCenter) {
+            progress.bestTimeToCenter = timeToCenter;
+        }
+    }
+}
+
+void World::setCrashed(int mouseIndex) {
+    // Called by both the physics and the collision detection threads, so
+    // this only sets the flag, which the next step picks up
+    m_crashed[mouseIndex].store(true);
+    for (const std::atomic<bool>& crashed : m_crashed) {
+        if (!crashed.load()) {
+            return;
+        }
+    }
+    S()->setCrashed();
+}
+
 void World::checkCollision() {
 
     // If collision detectino isn't enabled, let this thread exit
@@ -188,23 +242,35 @@ void World::checkCollision() {
         static const Meters halfWallWidth = Meters(P()->wallWidth() / 2.0);
         static const Meters tileLength = Meters(P()->wallLength() + P()->wallWidth());
 
-        // Retrieve the current collision polygon
-        QVector<Cartesian> currentCollisionPolygonVertices =
-            m_mouse->getCurrentCollisionPolygon(
-                m_mouse->getCurrentTranslation(), m_mouse->getCurrentRotation()).getVertices();
-
-        // Check for collisions
-        for (int i = 0; i < currentCollisionPolygonVertices.size(); i += 1) {
-            int j = (i + 1) % currentCollisionPolygonVertices.size();
-            Cartesian v1 = currentCollisionPolygonVertices.at(i);
-            Cartesian v2 = currentCollisionPolygonVertices.at(j);
-            // If a wall has come between the two vertices, then we have a collision
-            if (GeometryUtilities::castRay(v1, v2, *m_maze, halfWallWidth, tileLength) != v2) {
-                S()->setCrashed();
-                return; // If we've crashed, let this thread exit
+        // Check each mouse that hasn't crashed yet for collisions
+        for (int i = 0; i < m_mice.size(); i += 1) {
+            if (m_crashed.at(i).load()) {
+                continue;
+            }
+
+            // Retrieve the current collision polygon
+            QVector<Cartesian> currentCollisionPolygonVertices =
+                m_mice.at(i)->getCurrentCollisionPolygon(
+                    m_mice.at(i)->getCurrentTranslation(), m_mice.at(i)->getCurrentRotation()).getVertices();
+
+            // Check for collisions
+            for (int j = 0; j < currentCollisionPolygonVertices.size(); j += 1) {
+                int k = (j + 1) % currentCollisionPolygonVertices.size();
+                Cartesian v1 = currentCollisionPolygonVertices.at(j);
+                Cartesian v2 = currentCollisionPolygonVertices.at(k);
+                // If a wall has come between the two vertices, then we have a collision
+                if (GeometryUtilities::castRay(v1, v2, *m_maze, halfWallWidth, tileLength) != v2) {
+                    setCrashed(i);
+                    break;
+                }
             }
         }
 
+        // If every mouse has crashed, let this thread exit
+        if (S()->crashed()) {
+            return;
+        }
+
         // Get the duration of the collision detection, in seconds
         double end(sim::SimUtilities::getHighResTimestamp());
         double duration = end - start;
@@ -1,12 +1,18 @@
 #pragma once
 
 #include <QPair>
-#include <set>
+#include <QVector>
+
+#include <atomic>
+#include <memory>
+#include <vector>
 
 #include "InterfaceType.h"
 #include "Maze.h"
 #include "Mouse.h"
+#include "MouseBatch.h"
 #include "StaticMouseAlgorithmOptions.h"
+#include "units/Duration.h"
 #include "units/Seconds.h"
 
 namespace sim {
@@ -14,28 +20,54 @@ namespace sim {
 class World {
 
 public:
-    World(const Maze* maze, Mouse* mouse);
+    World(const Maze* maze, const QVector<Mouse*>& mice);
     void setOptions(StaticMouseAlgorithmOptions options);
 
-    Seconds getBestTimeToCenter() const;
-    Seconds getTimeSinceOriginDeparture() const;
+    // The progress of each mouse, by its index in the model
+    Seconds getBestTimeToCenter(int mouseIndex = 0) const;
+    Seconds getTimeSinceOriginDeparture(int mouseIndex = 0) const;
+
+    int getNumberOfTilesTraversed(int mouseIndex = 0) const;
+    int getClosestDistanceToCenter(int mouseIndex = 0) const;
 
-    int getNumberOfTilesTraversed() const;
-    int getClosestDistanceToCenter() const;
+    // Whether or not a particular mouse has crashed; the simulation as a
+    // whole has only crashed once all of the mice have
+    bool hasCrashed(int mouseIndex = 0) const;
+
+    // Moves every mouse that hasn't crashed forward by elapsed sim time, and
+    // then updates the progress of each of them
+    void step(const Duration& elapsed);
 
     void simulate();
 
 private:
+
+    // Everything that the world tracks about a single mouse
+    struct Progress {
+        Seconds bestTimeToCenter;
+        Seconds timeOfOriginDeparture;
+        QVector<bool> traversedTiles; // Column-major, like the maze
+        int numberOfTilesTraversed;
+        int closestDistanceToCenter;
+    };
+
     const Maze* m_maze;
-    Mouse* m_mouse;
+    QVector<Mouse*> m_mice;
     StaticMouseAlgorithmOptions m_options;
-    
-    Seconds m_bestTimeToCenter;
-    Seconds m_timeOfOriginDeparture;
 
-    std::set<QPair<int, int>> m_traversedTileLocations;
-    int m_closestDistanceToCenter;
+    // Parallel to m_mice
+    QVector<Progress> m_progress;
+
+    // Also parallel to m_mice, but kept apart from the progress, since a
+    // mouse may be crashed by the collision detection thread at any time;
+    // each step reads the flags once, before it moves any mice
+    std::vector<std::atomic<bool>> m_crashed;
+
+    // Moves all of the mice at once; only ever touched by step()
+    std::unique_ptr<MouseBatch> m_batch;
 
+    void updateProgress(int mouseIndex);
+    void setCrashed(int mouseIndex);
     void checkCollision();
 };
 
@@ -19,20 +19,18 @@ double Angle::getDegreesZeroTo360() const {
     return getDegrees(true);
 }
 
-double Angle::getRadiansNotBounded() const {
-    return getRadians(false);
-}
-
 double Angle::getDegreesNotBounded() const {
     return getDegrees(false);
 }
 
 double Angle::getSin() const {
-    return std::sin(getRadiansZeroTo2pi());
+    // No need to bound the angle first, since sin is periodic
+    return std::sin(m_radians);
 }
 
 double Angle::getCos() const {
-    return std::cos(getRadiansZeroTo2pi());
+    // No need to bound the angle first, since cos is periodic
+    return std::cos(m_radians);
 }
 
 bool Angle::operator<(const Angle& angle) const {
@@ -24,4 +24,9 @@ private:
 
 };
 
+// Unlike the bounded getter, this is trivial, so it is inline
+inline double Angle::getRadiansNotBounded() const {
+    return m_radians;
+}
+
 } // namespace sim
@@ -10,10 +10,6 @@ AngularVelocity::AngularVelocity() : m_radiansPerSecond(0) {
 AngularVelocity::~AngularVelocity() {
 }
 
-double AngularVelocity::getRadiansPerSecond() const {
-    return m_radiansPerSecond;
-}
-
 double AngularVelocity::getDegreesPerSecond() const {
     static const double degreesPerRadian = 360.0 / M_TWOPI;
     return degreesPerRadian * getRadiansPerSecond();
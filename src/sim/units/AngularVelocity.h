@@ -23,4 +23,8 @@ protected:
 
 };
 
+inline double AngularVelocity::getRadiansPerSecond() const {
+    return m_radiansPerSecond;
+}
+
 } // namespace sim
@@ -10,14 +10,6 @@ Coordinate::Coordinate() : m_x(Meters(0.0)), m_y(Meters(0.0)) {
 Coordinate::~Coordinate() {
 }
 
-Meters Coordinate::getX() const {
-    return m_x;
-}
-
-Meters Coordinate::getY() const {
-    return m_y;
-}
-
 Meters Coordinate::getRho() const {
     return Meters(std::hypot(m_x.getMeters(), m_y.getMeters()));
 }
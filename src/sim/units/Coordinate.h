@@ -24,4 +24,12 @@ protected:
 
 };
 
+inline Meters Coordinate::getX() const {
+    return m_x;
+}
+
+inline Meters Coordinate::getY() const {
+    return m_y;
+}
+
 } // namespace sim
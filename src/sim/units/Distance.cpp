@@ -8,10 +8,6 @@ Distance::Distance() : m_meters(0.0) {
 Distance::~Distance() {
 }
 
-double Distance::getMeters() const {
-    return m_meters;
-}
-
 double Distance::getCentimeters() const {
     static const double centimetersPerMeter = 100.0;
     return centimetersPerMeter * getMeters();
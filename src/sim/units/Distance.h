@@ -22,4 +22,9 @@ protected:
 
 };
 
+// Every arithmetic operation on distances goes through this, so it is inline
+inline double Distance::getMeters() const {
+    return m_meters;
+}
+
 } // namespace sim
@@ -8,10 +8,6 @@ Duration::Duration() : m_seconds(0) {
 Duration::~Duration() {
 }
 
-double Duration::getSeconds() const {
-    return m_seconds;
-}
-
 double Duration::getMilliseconds() const {
     static const double millisecondsPerSecond = 1000.0;
     return millisecondsPerSecond * getSeconds();
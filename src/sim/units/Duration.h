@@ -17,4 +17,8 @@ protected:
 
 };
 
+inline double Duration::getSeconds() const {
+    return m_seconds;
+}
+
 } // namespace sim
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cmath>
+
+#include "Angle.h"
+#include "Quantity.h"
+
+namespace sim {
+
+namespace units {
+
+// An angle whose sine and cosine are computed once, at construction, rather
+// than every time they're needed. This is meant for hot loops that rotate
+// many points by the same angle, or that look at the same angle repeatedly.
+//
+// Unlike sim::Angle, there's no range reduction: sin and cos are periodic,
+// so the unbounded angle gives the same results (to within rounding).
+class Heading {
+
+public:
+    Heading() : m_angle(), m_sin(0.0), m_cos(1.0) {
+    }
+    explicit Heading(units::Angle angle) :
+            m_angle(angle),
+            m_sin(std::sin(angle.getValue())),
+            m_cos(std::cos(angle.getValue())) {
+    }
+    explicit Heading(const sim::Angle& angle) :
+            Heading(units::Angle(angle.getRadiansNotBounded())) {
+    }
+
+    units::Angle getAngle() const {
+        return m_angle;
+    }
+    double getSin() const {
+        return m_sin;
+    }
+    double getCos() const {
+        return m_cos;
+    }
+
+    // Rotates the vector (x, y) by the angle, in place
+    template<typename T>
+    void rotate(T* x, T* y) const {
+        T rotatedX = *x * m_cos - *y * m_sin;
+        T rotatedY = *x * m_sin + *y * m_cos;
+        *x = rotatedX;
+        *y = rotatedY;
+    }
+
+private:
+    units::Angle m_angle;
+    double m_sin;
+    double m_cos;
+
+};
+
+} // namespace units
+
+} // namespace sim
@@ -0,0 +1,148 @@
+#pragma once
+
+namespace sim {
+
+namespace units {
+
+// A header-only counterpart to the unit classes in this directory, for code
+// that's performance critical.
+//
+// A Quantity is nothing but a double, in SI units (meters, seconds, radians),
+// tagged at compile time with the exponents of its dimensions. Every
+// operation is constexpr and inline, there are no virtual functions, and so
+// the types are trivially copyable and cost exactly as much as the doubles
+// they wrap. Quantities of different dimensions can't be added or compared,
+// multiplying and dividing them yields the right dimension, and a quantity
+// whose dimensions cancel out is just a double.
+//
+// Values are created and read in particular units by multiplying by and
+// dividing by the unit constants below, e.g., 5.0 * CENTIMETER, or
+// speed.in(REVOLUTION_PER_MINUTE), all of which folds away at compile time.
+template<int LENGTH, int TIME, int ANGLE>
+class Quantity;
+
+// The type of the product or quotient of two quantities
+template<int LENGTH, int TIME, int ANGLE>
+struct QuantityType {
+    typedef Quantity<LENGTH, TIME, ANGLE> type;
+};
+template<>
+struct QuantityType<0, 0, 0> {
+    typedef double type;
+};
+
+template<int LENGTH, int TIME, int ANGLE>
+class Quantity {
+
+public:
+    constexpr Quantity() : m_value(0.0) {
+    }
+
+    // The value in SI units
+    constexpr explicit Quantity(double value) : m_value(value) {
+    }
+    constexpr double getValue() const {
+        return m_value;
+    }
+
+    // The value in some other unit of the same dimension
+    constexpr double in(Quantity unit) const {
+        return m_value / unit.m_value;
+    }
+
+    constexpr Quantity operator+(Quantity other) const {
+        return Quantity(m_value + other.m_value);
+    }
+    constexpr Quantity operator-(Quantity other) const {
+        return Quantity(m_value - other.m_value);
+    }
+    constexpr Quantity operator-() const {
+        return Quantity(-m_value);
+    }
+    constexpr Quantity operator*(double factor) const {
+        return Quantity(m_value * factor);
+    }
+    constexpr Quantity operator/(double factor) const {
+        return Quantity(m_value / factor);
+    }
+
+    template<int L, int T, int A>
+    constexpr typename QuantityType<LENGTH + L, TIME + T, ANGLE + A>::type
+    operator*(Quantity<L, T, A> other) const {
+        return typename QuantityType<LENGTH + L, TIME + T, ANGLE + A>::type(
+            m_value * other.getValue());
+    }
+    template<int L, int T, int A>
+    constexpr typename QuantityType<LENGTH - L, TIME - T, ANGLE - A>::type
+    operator/(Quantity<L, T, A> other) const {
+        return typename QuantityType<LENGTH - L, TIME - T, ANGLE - A>::type(
+            m_value / other.getValue());
+    }
+
+    Quantity& operator+=(Quantity other) {
+        m_value += other.m_value;
+        return *this;
+    }
+    Quantity& operator-=(Quantity other) {
+        m_value -= other.m_value;
+        return *this;
+    }
+
+    constexpr bool operator==(Quantity other) const {
+        return m_value == other.m_value;
+    }
+    constexpr bool operator!=(Quantity other) const {
+        return m_value != other.m_value;
+    }
+    constexpr bool operator<(Quantity other) const {
+        return m_value < other.m_value;
+    }
+    constexpr bool operator<=(Quantity other) const {
+        return m_value <= other.m_value;
+    }
+    constexpr bool operator>(Quantity other) const {
+        return m_value > other.m_value;
+    }
+    constexpr bool operator>=(Quantity other) const {
+        return m_value >= other.m_value;
+    }
+
+private:
+    double m_value;
+
+};
+
+template<int LENGTH, int TIME, int ANGLE>
+constexpr Quantity<LENGTH, TIME, ANGLE> operator*(double factor, Quantity<LENGTH, TIME, ANGLE> quantity) {
+    return quantity * factor;
+}
+
+template<int LENGTH, int TIME, int ANGLE>
+constexpr Quantity<LENGTH, TIME, ANGLE> abs(Quantity<LENGTH, TIME, ANGLE> quantity) {
+    return quantity.getValue() < 0.0 ? -quantity : quantity;
+}
+
+typedef Quantity<1, 0, 0> Length;
+typedef Quantity<2, 0, 0> Area;
+typedef Quantity<0, 1, 0> Time;
+typedef Quantity<0, 0, 1> Angle;
+typedef Quantity<1, -1, 0> Speed;
+typedef Quantity<0, -1, 1> AngularVelocity;
+
+constexpr Length METER(1.0);
+constexpr Length CENTIMETER(0.01);
+constexpr Area SQUARE_METER(1.0);
+constexpr Time SECOND(1.0);
+constexpr Time MILLISECOND(0.001);
+constexpr Time MICROSECOND(0.000001);
+constexpr Angle RADIAN(1.0);
+constexpr Angle DEGREE(3.14159265358979323846 / 180.0);
+constexpr Angle REVOLUTION(2.0 * 3.14159265358979323846);
+constexpr Speed METER_PER_SECOND(1.0);
+constexpr AngularVelocity RADIAN_PER_SECOND(1.0);
+constexpr AngularVelocity DEGREE_PER_SECOND(3.14159265358979323846 / 180.0);
+constexpr AngularVelocity REVOLUTION_PER_MINUTE(2.0 * 3.14159265358979323846 / 60.0);
+
+} // namespace units
+
+} // namespace sim
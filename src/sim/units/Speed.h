@@ -15,4 +15,8 @@ protected:
 
 };
 
+inline double Speed::getMetersPerSecond() const {
+    return m_metersPerSecond;
+}
+
 } // namespace sim
@@ -0,0 +1,143 @@
+#include "Allocations.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace harness {
+
+namespace {
+
+// Each block is preceded by a header, which records the size of the block and
+// the generation in which it was allocated (zero if it wasn't counted); the
+// union keeps the block itself aligned for any type
+union Header {
+    struct {
+        std::size_t size;
+        unsigned long generation;
+    } info;
+    std::max_align_t alignment;
+};
+
+unsigned long generation = 1;
+int pauseDepth = 0;
+
+long long allocationCount = 0;
+long long deallocationCount = 0;
+long long liveBytes = 0;
+long long peakBytes = 0;
+
+void* allocate(std::size_t size) {
+    Header* header = static_cast<Header*>(std::malloc(sizeof(Header) + size));
+    if (header == nullptr) {
+        throw std::bad_alloc();
+    }
+    header->info.size = size;
+    header->info.generation = (0 < pauseDepth ? 0 : generation);
+    if (header->info.generation != 0) {
+        allocationCount += 1;
+        liveBytes += size;
+        if (peakBytes < liveBytes) {
+            peakBytes = liveBytes;
+        }
+    }
+    return header + 1;
+}
+
+void deallocate(void* block) {
+    if (block == nullptr) {
+        return;
+    }
+    Header* header = static_cast<Header*>(block) - 1;
+    if (header->info.generation == generation) {
+        deallocationCount += 1;
+        liveBytes -= header->info.size;
+    }
+    std::free(header);
+}
+
+} // namespace
+
+void Allocations::reset() {
+    generation += 1;
+    allocationCount = 0;
+    deallocationCount = 0;
+    liveBytes = 0;
+    peakBytes = 0;
+}
+
+long long Allocations::getAllocationCount() {
+    return allocationCount;
+}
+
+long long Allocations::getDeallocationCount() {
+    return deallocationCount;
+}
+
+long long Allocations::getLiveBytes() {
+    return liveBytes;
+}
+
+long long Allocations::getPeakBytes() {
+    return peakBytes;
+}
+
+Allocations::Pause::Pause() {
+    pauseDepth += 1;
+}
+
+Allocations::Pause::~Pause() {
+    pauseDepth -= 1;
+}
+
+} // namespace harness
+
+void* operator new(std::size_t size) {
+    return harness::allocate(size);
+}
+
+void* operator new[](std::size_t size) {
+    return harness::allocate(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return harness::allocate(size);
+    }
+    catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    try {
+        return harness::allocate(size);
+    }
+    catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void operator delete(void* block) noexcept {
+    harness::deallocate(block);
+}
+
+void operator delete[](void* block) noexcept {
+    harness::deallocate(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+    harness::deallocate(block);
+}
+
+void operator delete[](void* block, std::size_t) noexcept {
+    harness::deallocate(block);
+}
+
+void operator delete(void* block, const std::nothrow_t&) noexcept {
+    harness::deallocate(block);
+}
+
+void operator delete[](void* block, const std::nothrow_t&) noexcept {
+    harness::deallocate(block);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+namespace harness {
+
+// Counts the heap allocations that are made through operator new and operator
+// delete, which Allocations.cpp replaces for the whole program. The counts are
+// plain integers, since the harness runs each algorithm on the main thread.
+//
+// Only operator new is counted, not malloc: Qt's containers (QVector, QString,
+// QMap, etc.) and its implicitly shared data allocate through malloc, realloc
+// and free, so an algorithm that keeps its state in Qt containers will look
+// cheaper than it is. The standard containers, and anything else that's
+// allocated with new, are counted in full. Hooking malloc as well isn't
+// portable (and operator new itself allocates through it), so compare
+// algorithms whose containers are of the same kind.
+class Allocations {
+
+public:
+
+    // The Allocations class is not constructible
+    Allocations() = delete;
+
+    // Zeroes all of the counts; blocks that were allocated before the reset
+    // (or while paused) are never counted, not even when they're freed
+    static void reset();
+
+    // The number of allocations and deallocations since the last reset
+    static long long getAllocationCount();
+    static long long getDeallocationCount();
+
+    // The number of bytes that were allocated since the last reset and are
+    // still live, and the most that were ever live at once
+    static long long getLiveBytes();
+    static long long getPeakBytes();
+
+    // Allocations that are made while a Pause exists aren't counted, which
+    // keeps the harness's own bookkeeping out of the algorithm's numbers
+    class Pause {
+    public:
+        Pause();
+        ~Pause();
+    };
+
+};
+
+} // namespace harness
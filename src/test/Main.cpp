@@ -1,7 +1,43 @@
+// A headless, discrete-only test harness for the mouse algorithms. Each
+// algorithm is run in each maze (through a stubbed out MouseInterface, see
+// MouseInterface.cpp) until it returns, crashes, or makes too many moves, and
+// the heap usage of each run is printed as a line of JSON:
+//
+//     test [--moves <limit>] [--algorithm <name>]... [--all-orientations] [<maze.map>]...
+//
+// If no mazes are given, the built-in maze is used; if no algorithms are
+// given, every algorithm that can run without the simulator is used. With
+// --all-orientations, each maze is also run in each of its other seven
+// orientations (mirrored and/or rotated), all of which share its walls.
+
+#include <QDebug>
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QPair>
+#include <QStringList>
+#include <QVector>
+
 #include <iostream>
 
-int main(int argc, char* argv[]) {
-    std::cout << R"(
+#include "../mouse/doNothing/DoNothing.h"
+#include "../mouse/floodFill/FloodFill.h"
+#include "../mouse/forward/Forward.h"
+#include "../mouse/leftWallFollow/LeftWallFollow.h"
+#include "../mouse/mackAlgo/MackAlgo.h"
+#include "../mouse/mackAlgoTwo/MackAlgoTwo.h"
+#include "../mouse/randomizedWallFollow/RandomizedWallFollow.h"
+#include "../mouse/rightWallFollow/RightWallFollow.h"
+#include "Allocations.h"
+#include "Maze.h"
+#include "Run.h"
+
+namespace {
+
+// Enough for an algorithm to explore a 32x32 maze, and then some
+const int DEFAULT_MOVE_LIMIT = 10000;
+
+const char* BUILT_IN_MAZE = R"(
 +---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+
 |                                                               |
 +   +---+---+---+---+---+---+---+---+---+---+---+---+---+---+   +
@@ -35,6 +71,157 @@ int main(int argc, char* argv[]) {
 +   +   +---+---+---+---+---+---+---+---+---+---+---+---+---+   +
 |   |                                                           |
 +---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+---+
-    )" << std::endl;
+)";
+
+// The algorithms that only use the discrete interface, and that don't depend
+// on any other part of the simulator (e.g., Manual reads the keyboard)
+const QStringList ALGORITHMS {
+    "DoNothing",
+    "FloodFill",
+    "Forward",
+    "LeftWallFollow",
+    "MackAlgo",
+    "MackAlgoTwo",
+    "RandomizedWallFollow",
+    "RightWallFollow",
+};
+
+IMouseAlgorithm* createAlgorithm(const QString& name) {
+
+    #define ALGO(NAME, INSTANCE)\
+    if (name == NAME) {\
+        return INSTANCE;\
+    }
+
+    ALGO("DoNothing", new doNothing::DoNothing());
+    ALGO("FloodFill", new floodFill::FloodFill());
+    ALGO("Forward", new forward::Forward());
+    ALGO("LeftWallFollow", new leftWallFollow::LeftWallFollow());
+    ALGO("MackAlgo", new mackAlgo::MackAlgo());
+    ALGO("MackAlgoTwo", new mackAlgoTwo::MackAlgoTwo());
+    ALGO("RandomizedWallFollow", new randomizedWallFollow::RandomizedWallFollow());
+    ALGO("RightWallFollow", new rightWallFollow::RightWallFollow());
+
+    return nullptr;
+}
+
+// Runs the algorithm in the maze, and returns the results of the run
+QJsonObject runAlgorithm(const QString& algorithmName, const harness::Maze& maze, int moveLimit) {
+
+    // Everything from the construction of the algorithm to its deletion is
+    // counted, so anything that's still live afterwards has been leaked. Some
+    // algorithms print to stdout, which is reserved for the results.
+    std::streambuf* stdoutBuffer = std::cout.rdbuf(std::cerr.rdbuf());
+    harness::Allocations::reset();
+    IMouseAlgorithm* algorithm = createAlgorithm(algorithmName);
+    harness::Run run(&maze, algorithm, moveLimit);
+    harness::Outcome outcome = run.execute();
+    delete algorithm;
+    std::cout.rdbuf(stdoutBuffer);
+
+    long long allocations = harness::Allocations::getAllocationCount();
+    long long deallocations = harness::Allocations::getDeallocationCount();
+    long long peakBytes = harness::Allocations::getPeakBytes();
+    long long leakedBytes = harness::Allocations::getLiveBytes();
+
+    QJsonObject result;
+    result.insert("outcome", harness::OUTCOME_TO_STRING.value(outcome));
+    if (run.getError() != nullptr) {
+        result.insert("error", run.getError());
+    }
+    result.insert("moves", run.getMoveCount());
+    result.insert("centerMove", run.getCenterMove());
+    result.insert("allocations", allocations);
+    result.insert("deallocations", deallocations);
+    result.insert("allocationsPerMove",
+        0 < run.getMoveCount() ? static_cast<double>(allocations) / run.getMoveCount() : 0.0);
+    result.insert("peakBytes", peakBytes);
+    result.insert("leakedBytes", leakedBytes);
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+
+    int moveLimit = DEFAULT_MOVE_LIMIT;
+    QStringList algorithmNames;
+    QStringList mazePaths;
+    bool allOrientations = false;
+    for (int i = 1; i < argc; i += 1) {
+        QString argument = QString::fromLocal8Bit(argv[i]);
+        if ((argument == "--moves" || argument == "--algorithm") && i + 1 < argc) {
+            i += 1;
+            QString value = QString::fromLocal8Bit(argv[i]);
+            if (argument == "--moves") {
+                moveLimit = value.toInt();
+            }
+            else {
+                algorithmNames.append(value);
+            }
+        }
+        else if (argument == "--all-orientations") {
+            allOrientations = true;
+        }
+        else {
+            mazePaths.append(argument);
+        }
+    }
+    if (moveLimit <= 0) {
+        qCritical().noquote() << "The move limit must be a positive integer.";
+        return 1;
+    }
+    for (const QString& name : algorithmNames) {
+        if (!ALGORITHMS.contains(name)) {
+            qCritical().noquote()
+                << "\"" + name + "\" is not one of the algorithms that can be"
+                << "run by the harness:" << ALGORITHMS.join(", ");
+            return 1;
+        }
+    }
+    if (algorithmNames.isEmpty()) {
+        algorithmNames = ALGORITHMS;
+    }
+
+    QVector<QPair<QString, harness::Maze>> mazes;
+    if (mazePaths.isEmpty()) {
+        mazes.append({"built-in", harness::Maze::fromMap(BUILT_IN_MAZE)});
+    }
+    for (const QString& path : mazePaths) {
+        QFile file(path);
+        harness::Maze maze;
+        if (file.open(QIODevice::ReadOnly)) {
+            maze = harness::Maze::fromMap(QString(file.readAll()));
+        }
+        if (maze.getWidth() == 0) {
+            qCritical().noquote()
+                << "Unable to read \"" + path + "\" as a maze in the .map format.";
+            return 1;
+        }
+        mazes.append({path, maze});
+    }
+
+    if (allOrientations) {
+        QVector<QPair<QString, harness::Maze>> orientedMazes;
+        for (const QPair<QString, harness::Maze>& maze : mazes) {
+            for (const sim::MazeTransform& transform : sim::MazeTransform::all()) {
+                orientedMazes.append({maze.first, maze.second.transformed(transform)});
+            }
+        }
+        mazes = orientedMazes;
+    }
+
+    for (const QString& algorithmName : algorithmNames) {
+        for (const QPair<QString, harness::Maze>& maze : mazes) {
+            QJsonObject result = runAlgorithm(algorithmName, maze.second, moveLimit);
+            result.insert("algorithm", algorithmName);
+            result.insert("maze", maze.first);
+            result.insert("orientation", maze.second.getTransform().getName());
+            result.insert("width", maze.second.getWidth());
+            result.insert("height", maze.second.getHeight());
+            std::cout << QJsonDocument(result).toJson(QJsonDocument::Compact).toStdString() << std::endl;
+        }
+    }
+
     return 0;
 }
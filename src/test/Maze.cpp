@@ -0,0 +1,100 @@
+#include "Maze.h"
+
+#include <QStringList>
+
+namespace harness {
+
+Maze::Maze() :
+        m_width(0),
+        m_height(0),
+        m_originalWidth(0),
+        m_originalHeight(0) {
+}
+
+Maze Maze::fromMap(const QString& text) {
+
+    // Ignore blank lines, as well as carriage returns
+    QStringList lines;
+    for (QString line : text.split("\n")) {
+        line.remove("\r");
+        if (!line.trimmed().isEmpty()) {
+            lines.append(line);
+        }
+    }
+
+    // Every tile contributes four characters to each line, and each row of
+    // tiles contributes two lines, plus one more of each for the last post
+    if (lines.size() < 3 || lines.size() % 2 != 1 || lines.at(0).size() % 4 != 1) {
+        return Maze();
+    }
+
+    // Lines may be missing trailing spaces, but we treat those as open
+    auto at = [&](int line, int column) {
+        return column < lines.at(line).size() ? lines.at(line).at(column) : QChar(' ');
+    };
+
+    Maze maze;
+    maze.m_width = lines.at(0).size() / 4;
+    maze.m_height = lines.size() / 2;
+    maze.m_originalWidth = maze.m_width;
+    maze.m_originalHeight = maze.m_height;
+    maze.m_walls.fill(0, maze.m_width * maze.m_height);
+    for (int x = 0; x < maze.m_width; x += 1) {
+        for (int y = 0; y < maze.m_height; y += 1) {
+            int row = 2 * (maze.m_height - 1 - y) + 1;
+            maze.setWall(x, y, 0, at(row - 1, 4 * x + 2) != ' ');
+            maze.setWall(x, y, 1, at(row, 4 * x + 4) != ' ');
+            maze.setWall(x, y, 2, at(row + 1, 4 * x + 2) != ' ');
+            maze.setWall(x, y, 3, at(row, 4 * x) != ' ');
+        }
+    }
+    return maze;
+}
+
+Maze Maze::transformed(const sim::MazeTransform& transform) const {
+    Maze maze(*this);
+    maze.m_transform = transform.after(m_transform);
+    maze.m_width = maze.m_transform.getWidth(m_originalWidth, m_originalHeight);
+    maze.m_height = maze.m_transform.getHeight(m_originalWidth, m_originalHeight);
+    return maze;
+}
+
+const sim::MazeTransform& Maze::getTransform() const {
+    return m_transform;
+}
+
+int Maze::getWidth() const {
+    return m_width;
+}
+
+int Maze::getHeight() const {
+    return m_height;
+}
+
+bool Maze::withinMaze(int x, int y) const {
+    return 0 <= x && x < m_width && 0 <= y && y < m_height;
+}
+
+bool Maze::isWall(int x, int y, int direction) const {
+    if (!withinMaze(x, y) || !withinMaze(x + DX[direction], y + DY[direction])) {
+        return true;
+    }
+    m_transform.getOriginalPosition(m_originalWidth, m_originalHeight, &x, &y);
+    direction = m_transform.getOriginalDirection(direction);
+    return m_walls.at(x * m_originalHeight + y) & (1 << direction);
+}
+
+bool Maze::isCenter(int x, int y) const {
+    return (
+        (x == m_width / 2 || x == (m_width - 1) / 2) &&
+        (y == m_height / 2 || y == (m_height - 1) / 2)
+    );
+}
+
+void Maze::setWall(int x, int y, int direction, bool isWall) {
+    // Only used while parsing, before there's any transform
+    unsigned char& walls = m_walls[x * m_originalHeight + y];
+    walls = (isWall ? walls | (1 << direction) : walls & ~(1 << direction));
+}
+
+} // namespace harness
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+#include "../sim/MazeTransform.h"
+
+namespace harness {
+
+// Directions are 0 (north), 1 (east), 2 (south), and 3 (west), so that
+// turning right is adding one, and turning left is adding three
+static const int DX[] = {0, 1, 0, -1};
+static const int DY[] = {1, 0, -1, 0};
+static const char DIRECTION_CHARS[] = {'n', 'e', 's', 'w'};
+
+class Maze {
+
+public:
+
+    // An empty maze, with no tiles
+    Maze();
+
+    // Parses a maze in the .map format, in which tiles are three characters
+    // wide and walls are any character other than a space, e.g.:
+    //
+    //     +---+---+
+    //     |       |
+    //     +   +   +
+    //     |   |   |
+    //     +---+---+
+    //
+    // Returns an empty maze if the text isn't in that format
+    static Maze fromMap(const QString& text);
+
+    // The same maze, mirrored and/or rotated (on top of any transform that
+    // this maze already has). The walls aren't copied: the view shares them
+    // with this maze, and maps every query back through the transform.
+    Maze transformed(const sim::MazeTransform& transform) const;
+    const sim::MazeTransform& getTransform() const;
+
+    int getWidth() const;
+    int getHeight() const;
+    bool withinMaze(int x, int y) const;
+
+    // Walls on the outside edge of the maze always exist
+    bool isWall(int x, int y, int direction) const;
+
+    // Whether or not the tile is one of the (one, two, or four) center tiles
+    bool isCenter(int x, int y) const;
+
+private:
+
+    // The size of the maze as it's seen, i.e., after the transform
+    int m_width;
+    int m_height;
+
+    // Maps positions and directions in this view to the walls below
+    sim::MazeTransform m_transform;
+
+    // The walls of the maze as it was parsed, which are implicitly shared by
+    // all of the transformed views of it. Bit d is set if there is a wall in
+    // direction d; indexed by x * originalHeight + y.
+    int m_originalWidth;
+    int m_originalHeight;
+    QVector<unsigned char> m_walls;
+
+    void setWall(int x, int y, int direction, bool isWall);
+
+};
+
+} // namespace harness
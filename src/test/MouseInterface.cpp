@@ -0,0 +1,328 @@
+// A stand-in for src/sim/MouseInterface.cpp, which implements the same class
+// on top of a harness::Run instead of the simulator. Only the discrete
+// interface is supported; logging, tile colors and text, and declared walls
+// and distances are all dropped, since there's nothing to draw them on. The
+// methods neither record calls nor allocate, so that every allocation that is
+// counted during a run is one that the algorithm made itself.
+
+#include "../sim/MouseInterface.h"
+
+#include "../mouse/IMouseAlgorithm.h"
+#include "Run.h"
+
+namespace sim {
+
+namespace {
+
+harness::Run* run() {
+    return harness::Run::get();
+}
+
+void require(bool condition, const char* error) {
+    if (!condition) {
+        run()->stop(harness::Outcome::ERROR, error);
+    }
+}
+
+} // namespace
+
+MouseInterface::MouseInterface(
+        const Maze* maze,
+        Mouse* mouse,
+        MazeGraphic* mazeGraphic,
+        IMouseAlgorithm* mouseAlgorithm,
+        std::set<char> allowableTileTextCharacters,
+        StaticMouseAlgorithmOptions options,
+        Random random) :
+        m_maze(maze),
+        m_mouse(mouse),
+        m_mazeGraphic(mazeGraphic),
+        m_mouseAlgorithm(mouseAlgorithm),
+        m_allowableTileTextCharacters(allowableTileTextCharacters),
+        m_options(options),
+        m_random(random),
+        m_inOrigin(true) {
+}
+
+void MouseInterface::debug(const QString& str) {
+}
+
+void MouseInterface::info(const QString& str) {
+}
+
+void MouseInterface::warn(const QString& str) {
+}
+
+void MouseInterface::error(const QString& str) {
+}
+
+double MouseInterface::getRandom() {
+    return m_random.getDouble();
+}
+
+int MouseInterface::millis() {
+    return run()->getMillis();
+}
+
+void MouseInterface::delay(int milliseconds) {
+    run()->delay(milliseconds);
+}
+
+void MouseInterface::quit() {
+    run()->stop(harness::Outcome::QUIT);
+}
+
+void MouseInterface::setTileColor(int x, int y, char color) {
+}
+
+void MouseInterface::clearTileColor(int x, int y) {
+}
+
+void MouseInterface::clearAllTileColor() {
+}
+
+void MouseInterface::setTileText(int x, int y, const QString& text) {
+}
+
+void MouseInterface::clearTileText(int x, int y) {
+}
+
+void MouseInterface::clearAllTileText() {
+}
+
+void MouseInterface::declareWall(int x, int y, char direction, bool wallExists) {
+}
+
+void MouseInterface::undeclareWall(int x, int y, char direction) {
+}
+
+void MouseInterface::setTileFogginess(int x, int y, bool foggy) {
+}
+
+void MouseInterface::declareTileDistance(int x, int y, int distance) {
+}
+
+void MouseInterface::undeclareTileDistance(int x, int y) {
+}
+
+void MouseInterface::resetPosition() {
+    run()->resetPosition();
+    m_inOrigin = true;
+}
+
+bool MouseInterface::inputButtonPressed(int inputButton) {
+    return false;
+}
+
+void MouseInterface::acknowledgeInputButtonPressed(int inputButton) {
+}
+
+double MouseInterface::getWheelMaxSpeed(const QString& name) {
+    run()->stop(harness::Outcome::ERROR, "The continuous interface isn't supported");
+}
+
+void MouseInterface::setWheelSpeed(const QString& name, double rpm) {
+    run()->stop(harness::Outcome::ERROR, "The continuous interface isn't supported");
+}
+
+double MouseInterface::getWheelEncoderTicksPerRevolution(const QString& name) {
+    run()->stop(harness::Outcome::ERROR, "The continuous interface isn't supported");
+}
+
+int MouseInterface::readWheelEncoder(const QString& name) {
+    run()->stop(harness::Outcome::ERROR, "The continuous interface isn't supported");
+}
+
+void MouseInterface::resetWheelEncoder(const QString& name) {
+    run()->stop(harness::Outcome::ERROR, "The continuous interface isn't supported");
+}
+
+double MouseInterface::readSensor(QString name) {
+    run()->stop(harness::Outcome::ERROR, "The continuous interface isn't supported");
+}
+
+double MouseInterface::readGyro() {
+    run()->stop(harness::Outcome::ERROR, "The continuous interface isn't supported");
+}
+
+int MouseInterface::getWheelHandle(const QString& name) {
+    run()->stop(harness::Outcome::ERROR, "The continuous interface isn't supported");
+}
+
+int MouseInterface::getSensorHandle(const QString& name) {
+    run()->stop(harness::Outcome::ERROR, "The continuous interface isn't supported");
+}
+
+void MouseInterface::setWheelSpeed(int handle, double rpm) {
+    run()->stop(harness::Outcome::ERROR, "The continuous interface isn't supported");
+}
+
+int MouseInterface::readWheelEncoder(int handle) {
+    run()->stop(harness::Outcome::ERROR, "The continuous interface isn't supported");
+}
+
+double MouseInterface::readSensor(int handle) {
+    run()->stop(harness::Outcome::ERROR, "The continuous interface isn't supported");
+}
+
+void MouseInterface::setWheelSpeeds(const std::vector<int>& handles, const double* rpms) {
+    run()->stop(harness::Outcome::ERROR, "The continuous interface isn't supported");
+}
+
+void MouseInterface::readSensors(const std::vector<int>& handles, double* readings) {
+    run()->stop(harness::Outcome::ERROR, "The continuous interface isn't supported");
+}
+
+bool MouseInterface::wallFront() {
+    return run()->getMaze()->isWall(run()->getX(), run()->getY(), run()->getDirection());
+}
+
+bool MouseInterface::wallRight() {
+    return run()->getMaze()->isWall(run()->getX(), run()->getY(), (run()->getDirection() + 1) % 4);
+}
+
+bool MouseInterface::wallLeft() {
+    return run()->getMaze()->isWall(run()->getX(), run()->getY(), (run()->getDirection() + 3) % 4);
+}
+
+void MouseInterface::moveForward() {
+    require(!m_mouseAlgorithm->useTileEdgeMovements(), "moveForward() is not a tile edge movement");
+    run()->moveForward();
+}
+
+void MouseInterface::moveForward(int count) {
+    require(!m_mouseAlgorithm->useTileEdgeMovements(), "moveForward() is not a tile edge movement");
+    for (int i = 0; i < count; i += 1) {
+        run()->moveForward();
+    }
+}
+
+void MouseInterface::turnLeft() {
+    require(!m_mouseAlgorithm->useTileEdgeMovements(), "turnLeft() is not a tile edge movement");
+    run()->turn(-1);
+}
+
+void MouseInterface::turnRight() {
+    require(!m_mouseAlgorithm->useTileEdgeMovements(), "turnRight() is not a tile edge movement");
+    run()->turn(1);
+}
+
+void MouseInterface::turnAroundLeft() {
+    require(!m_mouseAlgorithm->useTileEdgeMovements(), "turnAroundLeft() is not a tile edge movement");
+    run()->turn(-2);
+}
+
+void MouseInterface::turnAroundRight() {
+    require(!m_mouseAlgorithm->useTileEdgeMovements(), "turnAroundRight() is not a tile edge movement");
+    run()->turn(2);
+}
+
+void MouseInterface::originMoveForwardToEdge() {
+    require(m_mouseAlgorithm->useTileEdgeMovements(), "originMoveForwardToEdge() is a tile edge movement");
+    require(m_inOrigin, "originMoveForwardToEdge() must be called from the origin");
+    run()->moveForward();
+    m_inOrigin = false;
+}
+
+void MouseInterface::originTurnLeftInPlace() {
+    require(m_mouseAlgorithm->useTileEdgeMovements(), "originTurnLeftInPlace() is a tile edge movement");
+    require(m_inOrigin, "originTurnLeftInPlace() must be called from the origin");
+    run()->turn(-1);
+}
+
+void MouseInterface::originTurnRightInPlace() {
+    require(m_mouseAlgorithm->useTileEdgeMovements(), "originTurnRightInPlace() is a tile edge movement");
+    require(m_inOrigin, "originTurnRightInPlace() must be called from the origin");
+    run()->turn(1);
+}
+
+void MouseInterface::moveForwardToEdge() {
+    require(m_mouseAlgorithm->useTileEdgeMovements(), "moveForwardToEdge() is a tile edge movement");
+    require(!m_inOrigin, "moveForwardToEdge() can't be called from the origin");
+    run()->moveForward();
+}
+
+void MouseInterface::moveForwardToEdge(int count) {
+    require(m_mouseAlgorithm->useTileEdgeMovements(), "moveForwardToEdge() is a tile edge movement");
+    require(!m_inOrigin, "moveForwardToEdge() can't be called from the origin");
+    for (int i = 0; i < count; i += 1) {
+        run()->moveForward();
+    }
+}
+
+void MouseInterface::turnLeftToEdge() {
+    require(m_mouseAlgorithm->useTileEdgeMovements(), "turnLeftToEdge() is a tile edge movement");
+    require(!m_inOrigin, "turnLeftToEdge() can't be called from the origin");
+    run()->turnToEdge(true);
+}
+
+void MouseInterface::turnRightToEdge() {
+    require(m_mouseAlgorithm->useTileEdgeMovements(), "turnRightToEdge() is a tile edge movement");
+    require(!m_inOrigin, "turnRightToEdge() can't be called from the origin");
+    run()->turnToEdge(false);
+}
+
+void MouseInterface::turnAroundLeftToEdge() {
+    require(m_mouseAlgorithm->useTileEdgeMovements(), "turnAroundLeftToEdge() is a tile edge movement");
+    require(!m_inOrigin, "turnAroundLeftToEdge() can't be called from the origin");
+    run()->turnAroundToEdge();
+}
+
+void MouseInterface::turnAroundRightToEdge() {
+    require(m_mouseAlgorithm->useTileEdgeMovements(), "turnAroundRightToEdge() is a tile edge movement");
+    require(!m_inOrigin, "turnAroundRightToEdge() can't be called from the origin");
+    run()->turnAroundToEdge();
+}
+
+void MouseInterface::diagonalLeftLeft(int count) {
+    require(m_mouseAlgorithm->useTileEdgeMovements(), "diagonalLeftLeft() is a tile edge movement");
+    require(!m_inOrigin, "diagonalLeftLeft() can't be called from the origin");
+    run()->diagonal(count, true, true);
+}
+
+void MouseInterface::diagonalLeftRight(int count) {
+    require(m_mouseAlgorithm->useTileEdgeMovements(), "diagonalLeftRight() is a tile edge movement");
+    require(!m_inOrigin, "diagonalLeftRight() can't be called from the origin");
+    run()->diagonal(count, true, false);
+}
+
+void MouseInterface::diagonalRightLeft(int count) {
+    require(m_mouseAlgorithm->useTileEdgeMovements(), "diagonalRightLeft() is a tile edge movement");
+    require(!m_inOrigin, "diagonalRightLeft() can't be called from the origin");
+    run()->diagonal(count, false, true);
+}
+
+void MouseInterface::diagonalRightRight(int count) {
+    require(m_mouseAlgorithm->useTileEdgeMovements(), "diagonalRightRight() is a tile edge movement");
+    require(!m_inOrigin, "diagonalRightRight() can't be called from the origin");
+    run()->diagonal(count, false, false);
+}
+
+int MouseInterface::currentXTile() {
+    require(m_mouseAlgorithm->allowOmniscience(), "currentXTile() requires omniscience");
+    return run()->getX();
+}
+
+int MouseInterface::currentYTile() {
+    require(m_mouseAlgorithm->allowOmniscience(), "currentYTile() requires omniscience");
+    return run()->getY();
+}
+
+char MouseInterface::currentDirection() {
+    require(m_mouseAlgorithm->allowOmniscience(), "currentDirection() requires omniscience");
+    return harness::DIRECTION_CHARS[run()->getDirection()];
+}
+
+double MouseInterface::currentXPosMeters() {
+    run()->stop(harness::Outcome::ERROR, "currentXPosMeters() isn't supported");
+}
+
+double MouseInterface::currentYPosMeters() {
+    run()->stop(harness::Outcome::ERROR, "currentYPosMeters() isn't supported");
+}
+
+double MouseInterface::currentRotationDegrees() {
+    run()->stop(harness::Outcome::ERROR, "currentRotationDegrees() isn't supported");
+}
+
+} // namespace sim
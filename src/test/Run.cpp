@@ -0,0 +1,190 @@
+#include "Run.h"
+
+#include "Allocations.h"
+
+namespace harness {
+
+Run* Run::CURRENT = nullptr;
+
+Run::Run(const Maze* maze, IMouseAlgorithm* algorithm, int moveLimit) :
+        m_maze(maze),
+        m_algorithm(algorithm),
+        m_moveLimit(moveLimit),
+        m_outcome(Outcome::RETURNED),
+        m_error(nullptr),
+        m_moveCount(0),
+        m_centerMove(-1),
+        m_x(0),
+        m_y(0),
+        m_direction(0),
+        m_millis(0) {
+}
+
+Run* Run::get() {
+    return CURRENT;
+}
+
+Outcome Run::execute() {
+
+    // The MouseInterface is part of the harness, not the algorithm, so its
+    // allocations aren't counted
+    sim::MouseInterface* mouseInterface = nullptr;
+    {
+        Allocations::Pause pause;
+        sim::StaticMouseAlgorithmOptions options;
+        options.mouseFile = QString::fromStdString(m_algorithm->mouseFile());
+        options.interfaceType = QString::fromStdString(m_algorithm->interfaceType());
+        options.initialDirection = QString::fromStdString(m_algorithm->initialDirection());
+        options.tileTextNumberOfRows = m_algorithm->tileTextNumberOfRows();
+        options.tileTextNumberOfCols = m_algorithm->tileTextNumberOfCols();
+        options.wheelSpeedFraction = m_algorithm->wheelSpeedFraction();
+        // The algorithm's random numbers are seeded the same way for every
+        // run, so that runs are reproducible
+        mouseInterface = new sim::MouseInterface(
+            nullptr, nullptr, nullptr, m_algorithm, {}, options,
+            sim::Random(0).getStream(sim::Random::MOUSE_ALGORITHM));
+    }
+
+    // The mouse always starts facing north, and we don't check whether or not
+    // the maze is official, since none of the discrete algorithms care
+    CURRENT = this;
+    try {
+        m_algorithm->solve(m_maze->getWidth(), m_maze->getHeight(), false, 'n', mouseInterface);
+        m_outcome = Outcome::RETURNED;
+    }
+    catch (const Stop&) {
+    }
+    CURRENT = nullptr;
+
+    {
+        Allocations::Pause pause;
+        delete mouseInterface;
+    }
+    return m_outcome;
+}
+
+void Run::stop(Outcome outcome, const char* error) {
+    m_outcome = outcome;
+    m_error = error;
+    throw Stop();
+}
+
+const char* Run::getError() const {
+    return m_error;
+}
+
+int Run::getMoveCount() const {
+    return m_moveCount;
+}
+
+int Run::getCenterMove() const {
+    return m_centerMove;
+}
+
+const Maze* Run::getMaze() const {
+    return m_maze;
+}
+
+int Run::getX() const {
+    return m_x;
+}
+
+int Run::getY() const {
+    return m_y;
+}
+
+int Run::getDirection() const {
+    return m_direction;
+}
+
+int Run::getMillis() const {
+    return m_millis;
+}
+
+void Run::delay(int milliseconds) {
+    if (0 < milliseconds) {
+        m_millis += milliseconds;
+    }
+}
+
+void Run::resetPosition() {
+    m_x = 0;
+    m_y = 0;
+    m_direction = 0;
+}
+
+void Run::moveForward() {
+    step();
+    countMove();
+}
+
+void Run::turn(int quarterTurnsRight) {
+    m_direction = ((m_direction + quarterTurnsRight) % 4 + 4) % 4;
+    countMove();
+}
+
+void Run::turnToEdge(bool turnLeft) {
+    m_direction = (m_direction + (turnLeft ? 3 : 1)) % 4;
+    step();
+    countMove();
+}
+
+void Run::turnAroundToEdge() {
+
+    // Turn around in the middle of the tile, and go back the way we came
+    m_direction = (m_direction + 2) % 4;
+    m_x += DX[m_direction];
+    m_y += DY[m_direction];
+    if (!m_maze->withinMaze(m_x, m_y)) {
+        stop(Outcome::CRASHED);
+    }
+    countMove();
+}
+
+void Run::diagonal(int count, bool startLeft, bool endLeft) {
+
+    // Just like the simulator, we only check that the number of segments lines
+    // up with the turns, not that the path is actually clear
+    if ((startLeft == endLeft) != (count % 2 == 1)) {
+        stop(Outcome::CRASHED);
+    }
+
+    // Work in half tiles, starting from the edge the mouse just crossed;
+    // each segment moves half a tile forward and half a tile to the side
+    int side = (m_direction + (startLeft ? 3 : 1)) % 4;
+    int x = 2 * m_x + 1 - DX[m_direction] + count * (DX[m_direction] + DX[side]);
+    int y = 2 * m_y + 1 - DY[m_direction] + count * (DY[m_direction] + DY[side]);
+    if (startLeft == endLeft) {
+        m_direction = side;
+    }
+
+    // The mouse ends up on an edge, and then crosses into the next tile
+    x += DX[m_direction] - 1;
+    y += DY[m_direction] - 1;
+    if (x < 0 || y < 0 || !m_maze->withinMaze(x / 2, y / 2)) {
+        stop(Outcome::CRASHED);
+    }
+    m_x = x / 2;
+    m_y = y / 2;
+    countMove();
+}
+
+void Run::step() {
+    if (m_maze->isWall(m_x, m_y, m_direction)) {
+        stop(Outcome::CRASHED);
+    }
+    m_x += DX[m_direction];
+    m_y += DY[m_direction];
+}
+
+void Run::countMove() {
+    m_moveCount += 1;
+    if (m_centerMove == -1 && m_maze->isCenter(m_x, m_y)) {
+        m_centerMove = m_moveCount;
+    }
+    if (m_moveLimit <= m_moveCount) {
+        stop(Outcome::MOVE_LIMIT);
+    }
+}
+
+} // namespace harness
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <QMap>
+#include <QString>
+
+#include "../mouse/IMouseAlgorithm.h"
+#include "Maze.h"
+
+namespace harness {
+
+// How a run ended
+enum class Outcome {
+    RETURNED,
+    QUIT,
+    CRASHED,
+    MOVE_LIMIT,
+    ERROR,
+};
+
+static const QMap<Outcome, QString> OUTCOME_TO_STRING {
+    {Outcome::RETURNED, "RETURNED"},
+    {Outcome::QUIT, "QUIT"},
+    {Outcome::CRASHED, "CRASHED"},
+    {Outcome::MOVE_LIMIT, "MOVE_LIMIT"},
+    {Outcome::ERROR, "ERROR"},
+};
+
+// A single, discrete run of an algorithm in a maze, without any graphics,
+// physics, or sim time. The MouseInterface is stubbed out (see
+// MouseInterface.cpp), and its methods act on the run that is in progress.
+class Run {
+
+public:
+
+    Run(const Maze* maze, IMouseAlgorithm* algorithm, int moveLimit);
+
+    // The run that is in progress, for use by the MouseInterface
+    static Run* get();
+
+    // Calls the algorithm's solve() until it returns or the run is stopped
+    Outcome execute();
+
+    // Ends the run by unwinding the algorithm's stack, and thus can only be
+    // called from within a MouseInterface method; error should be a literal
+    [[noreturn]] void stop(Outcome outcome, const char* error = nullptr);
+
+    // The reason for an ERROR outcome, or nullptr
+    const char* getError() const;
+
+    // The number of moves (each tile traversed and each turn) so far, and
+    // the move on which the mouse first reached the center, or -1
+    int getMoveCount() const;
+    int getCenterMove() const;
+
+    // The state of the mouse, which starts in the origin, facing north
+    const Maze* getMaze() const;
+    int getX() const;
+    int getY() const;
+    int getDirection() const;
+
+    // For the misc MouseInterface methods, where time only passes via delay()
+    int getMillis() const;
+    void delay(int milliseconds);
+
+    // Movements, which stop the run with CRASHED if they'd hit a wall. For
+    // tile edge movements, the mouse's tile is the one it has just entered.
+    void resetPosition();
+    void moveForward();
+    void turn(int quarterTurnsRight);
+    void turnToEdge(bool turnLeft);
+    void turnAroundToEdge();
+    void diagonal(int count, bool startLeft, bool endLeft);
+
+private:
+
+    // The run that is in progress
+    static Run* CURRENT;
+
+    const Maze* m_maze;
+    IMouseAlgorithm* m_algorithm;
+    int m_moveLimit;
+
+    Outcome m_outcome;
+    const char* m_error;
+    int m_moveCount;
+    int m_centerMove;
+
+    int m_x;
+    int m_y;
+    int m_direction;
+
+    int m_millis;
+
+    // Moves one tile forward if there's no wall in the way
+    void step();
+
+    // Counts a move, and stops the run if the limit has been reached
+    void countMove();
+
+};
+
+// Thrown by Run::stop(), and caught by Run::execute()
+struct Stop {
+};
+
+} // namespace harness
@@ -1,8 +1,28 @@
 CONFIG += qt
 CONFIG += object_parallel_to_source
+QT -= gui
 
 SOURCES += $$files(*.cpp, true)
 
+HEADERS += $$files(*.h, true)
+
+# The algorithms that the harness runs (see Main.cpp), the units that the
+# simulator headers they include depend on, the maze transforms, and the
+# random numbers; the harness supplies its own MouseInterface.cpp in place of
+# the simulator's
+SOURCES += ../mouse/IMouseAlgorithm.cpp
+SOURCES += $$files(../mouse/doNothing/*.cpp)
+SOURCES += $$files(../mouse/floodFill/*.cpp)
+SOURCES += $$files(../mouse/forward/*.cpp)
+SOURCES += $$files(../mouse/leftWallFollow/*.cpp)
+SOURCES += $$files(../mouse/mackAlgo/*.cpp)
+SOURCES += $$files(../mouse/mackAlgoTwo/*.cpp)
+SOURCES += $$files(../mouse/randomizedWallFollow/*.cpp)
+SOURCES += $$files(../mouse/rightWallFollow/*.cpp)
+SOURCES += $$files(../sim/units/*.cpp)
+SOURCES += ../sim/MazeTransform.cpp
+SOURCES += ../sim/Random.cpp
+
 # TODO: MACK - make this some sort of variable
 DESTDIR     = ../../build/bin/test
 MOC_DIR     = ../../build/moc/test